@@ -0,0 +1,68 @@
+//
+//  DaemonEntryPoint.cpp
+//  KanVestDaemon
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "Daemon/KanVestDaemon.hpp"
+
+#include <csignal>
+
+static const std::filesystem::path DefaultUniverseFilePath = "../../../KanVest/UserData/DaemonUniverse.yaml";
+
+static void OnSignal([[maybe_unused]] int signal)
+{
+  KanVest::Daemon::Stop();
+}
+
+[[nodiscard]] int ExecuteKanVestDaemon(std::span<const char*> args)
+{
+  // Only core engine (logger and profiler) is required, no window or renderer context is created
+  if (!KanViz::CoreEngine::Initialize())
+  {
+    std::cerr << "Failed to initialize the KanViz engine.\n";
+    return EXIT_FAILURE;
+  }
+
+  std::filesystem::path universeFilePath = args.size() > 1 ? std::filesystem::path(args[1]) : DefaultUniverseFilePath;
+  KanVest::DaemonSpecification specification = KanVest::Daemon::LoadSpecification(universeFilePath);
+
+  if (!KanVest::Daemon::Initialize(specification))
+  {
+    std::cerr << "Failed to initialize KanVest daemon.\n";
+    [[maybe_unused]] bool shutdown = KanViz::CoreEngine::Shutdown();
+    return EXIT_FAILURE;
+  }
+
+  std::signal(SIGINT, OnSignal);
+  std::signal(SIGTERM, OnSignal);
+
+  KanVest::Daemon::Run();
+  KanVest::Daemon::Shutdown();
+
+  if (!KanViz::CoreEngine::Shutdown())
+  {
+    std::cerr << "Failed to shutdown the KanViz engine.\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/// This function is the Entry point of the headless daemon
+/// - Parameters:
+///   - argc: Number of arguments passed from binary
+///   - argv: Arguments ... argv[1] is optional universe file path
+[[nodiscard]] int main(int argc, const char* argv[])
+{
+  std::cout << "  Executing : " << argv[0] << "\n";
+
+  std::span args(argv, argv + argc);
+  for (size_t i = 1; i < args.size(); ++i)
+  {
+    std::cout << "    Arg[" << i << "]   : " << args[i] << "\n";
+  }
+
+  return ExecuteKanVestDaemon(args);
+}
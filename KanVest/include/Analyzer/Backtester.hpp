@@ -0,0 +1,173 @@
+//
+//  Backtester.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/CandleColumns.hpp"
+#include "Stock/FetchWorkerPool.hpp"
+
+#include "Analyzer/Screener.hpp"
+#include "Analyzer/Indicators/MovingAverageKernel.hpp"
+
+namespace KanVest
+{
+  /// This structure stores the trading cost model, defaults are NSE equity delivery
+  struct BacktestCostModel
+  {
+    double brokeragePercent = 0.03;     //< Brokerage per order, percent of turnover
+    double brokerageCap = 20.0;         //< Maximum brokerage per order
+    double sttPercent = 0.1;            //< Securities transaction tax, both sides
+    double exchangePercent = 0.00297;   //< Exchange transaction charges
+    double gstPercent = 18.0;           //< GST on brokerage and exchange charges
+    double stampDutyPercent = 0.015;    //< Stamp duty, buy side only
+    double slippageBps = 5.0;           //< Adverse fill price move in basis points
+
+    /// This function returns the charges of order
+    /// - Parameters:
+    ///   - turnover: order value
+    ///   - buy: buy order
+    double GetCharges(double turnover, bool buy) const;
+  };
+
+  /// This structure stores the backtest settings
+  struct BacktestSettings
+  {
+    double initialCapital = 100000.0;
+    double positionFraction = 1.0;      //< Fraction of equity invested on entry
+    BacktestCostModel costs;
+  };
+
+  /// This structure stores the closed trade
+  struct BacktestTrade
+  {
+    uint32_t entryTimestamp = 0;
+    uint32_t exitTimestamp = 0;
+    double entryPrice = 0.0;
+    double exitPrice = 0.0;
+    uint64_t quantity = 0;
+    double pnl = 0.0;                   //< Profit after charges of both orders
+  };
+
+  /// This structure stores the performance of strategy
+  struct BacktestMetrics
+  {
+    double finalEquity = 0.0;
+    double totalReturnPercent = 0.0;
+    double maxDrawdownPercent = 0.0;
+    double sharpe = 0.0;                //< Annualized from per bar returns
+    double winRatePercent = 0.0;
+    double charges = 0.0;
+    size_t trades = 0;
+  };
+
+  /// This structure stores the backtest run statistics
+  struct BacktestStats
+  {
+    uint64_t simulatedBars = 0;         //< Bars simulated, summed over combinations
+    uint32_t threads = 0;
+    double indicatorMs = 0.0;           //< Time to compute shared operand series
+    double elapsedMs = 0.0;
+
+    /// This function returns the simulated bars per second
+    double BarsPerSecond() const { return elapsedMs > 0.0 ? simulatedBars * 1000.0 / elapsedMs : 0.0; }
+    /// This function returns the simulated bars per second per thread
+    double BarsPerSecondPerThread() const { return threads ? BarsPerSecond() / threads : 0.0; }
+  };
+
+  /// This structure stores the backtest result of one strategy
+  struct BacktestResult
+  {
+    BacktestMetrics metrics;
+    std::vector<double> equity;         //< Marked to market at close of each bar
+    std::vector<BacktestTrade> trades;
+    BacktestStats stats;
+    std::string error;
+  };
+
+  /// This structure stores the swept parameter range, used as {name} in strategy expressions
+  struct BacktestParameter
+  {
+    std::string name;
+    double first = 0.0;
+    double last = 0.0;
+    double step = 1.0;
+  };
+
+  /// This structure stores the parameter sweep result. Combinations are sorted by total return, best first
+  struct BacktestSweepResult
+  {
+    struct Combination
+    {
+      std::vector<double> parameters;   //< In order of sweep parameters
+      BacktestMetrics metrics;
+    };
+
+    std::vector<Combination> combinations;
+    BacktestStats stats;
+    std::string error;
+  };
+
+  /// This class backtests the long only strategy given by entry and exit screener expressions. Signals are taken at
+  /// close of bar and filled at open of next bar with slippage and charges. Operand series are computed once per run
+  /// with indicator kernels and shared by all parameter combinations of sweep
+  class Backtester
+  {
+  public:
+    static constexpr size_t MaxCombinations = 100000;
+
+    /// This function starts the worker threads used by parameter sweep
+    /// - Parameter threadCount: number of threads. 0 selects hardware concurrency
+    static void Initialize(uint32_t threadCount = 0);
+    /// This function stops the worker threads
+    static void Shutdown();
+
+    /// This function backtests the strategy over stock history
+    /// - Parameters:
+    ///   - stockData: stock data, split / bonus adjusted if symbol has actions
+    ///   - entry: entry expression (e.g. "close > SMA50 and RSI14 < 40")
+    ///   - exit: exit expression (e.g. "close < SMA50")
+    ///   - settings: backtest settings
+    [[nodiscard("Backtest result is not used")]] static BacktestResult Run(const StockData& stockData, const std::string& entry,
+                                                                           const std::string& exit, const BacktestSettings& settings = {});
+
+    /// This function backtests every combination of parameters. Parameters are substituted in expressions as {name},
+    /// e.g. entry "EMA{fast} > EMA{slow}", exit "EMA{fast} < EMA{slow}". Runs on caller thread if not initialized
+    /// - Parameters:
+    ///   - stockData: stock data, split / bonus adjusted if symbol has actions
+    ///   - entry: entry expression template
+    ///   - exit: exit expression template
+    ///   - parameters: swept parameters
+    ///   - settings: backtest settings
+    [[nodiscard("Sweep result is not used")]] static BacktestSweepResult Sweep(const StockData& stockData, const std::string& entry, const std::string& exit,
+                                                                               const std::vector<BacktestParameter>& parameters, const BacktestSettings& settings = {});
+
+    /// This function computes the series of operands over columns, row k of output is operand k. Value at bar i is same as
+    /// screener value of operand over bars [0, i], NaN while warming up. SMA / EMA of all periods and true range are shared
+    /// - Parameters:
+    ///   - columns: candle columns
+    ///   - operands: screener operands
+    ///   - output: output matrix, resized to operands x bars
+    static void ComputeOperandSeries(const CandleColumns& columns, const std::vector<ScreenerOperand>& operands, IndicatorMatrix& output);
+
+  private:
+    /// This function simulates the strategy
+    /// - Parameters:
+    ///   - columns: candle columns
+    ///   - series: operand series
+    ///   - entry, exit: compiled filters
+    ///   - entryRows, exitRows: series row of each filter operand
+    ///   - settings: backtest settings
+    ///   - equity: equity curve output, optional
+    ///   - trades: trades output, optional
+    static BacktestMetrics Simulate(const CandleColumns& columns, const IndicatorMatrix& series, const ScreenerFilter& entry, const ScreenerFilter& exit,
+                                    const std::vector<uint32_t>& entryRows, const std::vector<uint32_t>& exitRows, const BacktestSettings& settings,
+                                    std::vector<double>* equity, std::vector<BacktestTrade>* trades);
+
+    inline static FetchWorkerPool s_workerPool;
+    inline static uint32_t s_threads = 0;
+  };
+} // namespace KanVest
@@ -0,0 +1,86 @@
+//
+//  BarReplay.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/StockMetadata.hpp"
+
+namespace KanVest
+{
+  /// This structure stores the replay progress and its cost
+  struct ReplayStats
+  {
+    size_t position = 0;            //< Candles replayed so far
+    size_t total = 0;               //< Candles of stored series
+    uint64_t barsReplayed = 0;      //< Candles appended since start
+    uint64_t updates = 0;           //< Frames that appended candles
+
+    double frameMs = 0.0;           //< Average frame time of last second
+    double maxFrameMs = 0.0;        //< Worst frame time of last second
+    double barsPerSecond = 0.0;     //< Candles appended in last second
+    double lastUpdateMs = 0.0;      //< Append and analysis of last update
+    double updateUsPerBar = 0.0;    //< Average append and analysis cost per candle since start
+  };
+
+  /// This class replays the stored candle series of one symbol. Candles are appended to stock manager at replay speed
+  /// and analyzed once per frame with all candles due in it, so indicators advance incrementally and nothing is
+  /// recomputed per candle. Fetches of replayed symbol are paused until replay stops
+  class BarReplay
+  {
+  public:
+    static constexpr double MinSpeed = 1.0;       //< Candles per second
+    static constexpr double MaxSpeed = 1000.0;
+
+    /// This function starts the replay of stored series, first candles up to start are shown at once
+    /// - Parameters:
+    ///   - source: stored stock data, replayed as is
+    ///   - start: number of candles shown at start, clamped to [1, candles - 1]
+    /// - Returns: false if series has less than two candles
+    static bool Start(const StockData& source, size_t start);
+    /// This function stops the replay and restores live data of symbol
+    static void Stop();
+
+    /// This function advances the replay by time elapsed since last call. Must be called once per frame
+    /// - Returns: candles appended
+    static size_t Update();
+    /// This function appends next candles immediately, also while paused
+    /// - Parameter bars: number of candles
+    /// - Returns: candles appended
+    static size_t Step(size_t bars = 1);
+
+    static void SetPlaying(bool playing) { s_playing = playing and s_active; }
+    /// This function sets the replay speed in candles per second, clamped to [MinSpeed, MaxSpeed]
+    /// - Parameter speed: candles per second
+    static void SetSpeed(double speed) { s_speed = std::clamp(speed, MinSpeed, MaxSpeed); }
+
+    static bool IsActive() { return s_active; }
+    static bool IsPlaying() { return s_playing; }
+    static double GetSpeed() { return s_speed; }
+    static const std::string& GetSymbol() { return s_source.symbol; }
+    static const ReplayStats& GetStats() { return s_stats; }
+
+  private:
+    /// This function appends next candles to stock manager and analyzes the replayed data
+    /// - Parameter bars: number of candles
+    static size_t Advance(size_t bars);
+
+    inline static StockData s_source;
+    inline static StockData s_replayData;       //< Candles replayed so far, same as data served by stock manager
+    inline static bool s_active = false;
+    inline static bool s_playing = false;
+    inline static double s_speed = 10.0;
+    inline static double s_pendingBars = 0.0;   //< Fraction of candle carried to next frame
+    inline static double s_prevClose = 0.0;     //< Close of session before last replayed candle
+
+    inline static ReplayStats s_stats;
+    inline static KanViz::Timer s_frameTimer;
+    inline static KanViz::Timer s_windowTimer;
+    inline static uint64_t s_windowFrames = 0, s_windowBars = 0;
+    inline static double s_windowFrameMs = 0.0, s_windowMaxFrameMs = 0.0;
+    inline static double s_totalUpdateMs = 0.0;
+  };
+} // namespace KanVest
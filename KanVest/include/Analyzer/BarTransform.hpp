@@ -0,0 +1,141 @@
+//
+//  BarTransform.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/StockMetadata.hpp"
+#include "Stock/CandleColumns.hpp"
+
+namespace KanVest
+{
+  /// This enum stores the bar types derived from time candles
+  enum class BarType : uint8_t
+  {
+    Time,           //< Base candles as is
+    HeikinAshi,     //< Averaged candles, one per base candle
+    Renko,          //< Fixed size bricks of close price, reversal needs two bricks
+    Range,          //< Bars of fixed high - low range, price path inside candle is open, nearer extreme, other extreme, close
+    CandleCount,    //< Fixed number of base candles per bar (provider gives no ticks, so candle count stands for tick count)
+    Count
+  };
+
+  /// This structure stores the settings of bar transform
+  struct BarTransformSettings
+  {
+    BarType type = BarType::Time;
+    double boxSize = 0.0;         //< Renko brick / range bar size, 0 for ATR based size
+    size_t atrPeriod = 14;        //< ATR period of automatic box size
+    double atrMultiple = 1.0;     //< Automatic box size is this multiple of ATR
+    size_t candlesPerBar = 5;     //< Base candles per bar of CandleCount type
+
+    bool operator==(const BarTransformSettings& other) const = default;
+  };
+
+  /// This structure stores the statistics of bar transform
+  struct BarTransformStats
+  {
+    size_t inputBars = 0;
+    size_t outputBars = 0;
+    double rebuildMs = 0.0;       //< Time of last full transform
+    double lastUpdateUs = 0.0;    //< Time of last incremental sync
+
+    /// This function returns the base candles transformed per second by full transform
+    double BarsPerSecond() const { return rebuildMs > 0.0 ? static_cast<double>(inputBars) * 1000.0 / rebuildMs : 0.0; }
+  };
+
+  /// This class transforms time candles into alternative bars as they arrive. Output bars are candle columns, last bar
+  /// may be forming. Each base candle is processed once in O(bars it produces); forming base candle update restores the
+  /// state saved before it (transform state and last output bar) and processes it again, so update is exact and O(1)
+  class BarTransformer
+  {
+  public:
+    static constexpr double TickSize = 0.05;    //< Automatic box size is rounded to ticks
+
+    /// This function sets the transform settings. Bars are rebuilt by next sync if settings changed
+    /// - Parameter settings: transform settings
+    void SetSettings(const BarTransformSettings& settings);
+
+    /// This function syncs the bars with stock data, processing only what changed since last sync
+    /// - Parameter data: stock data
+    /// - Returns: number of base candles processed
+    size_t Sync(const StockData& data);
+
+    /// This function appends a base candle
+    /// - Parameter candle: new candle
+    void Append(const CandleData& candle);
+    /// This function replaces the last base candle (forming candle)
+    /// - Parameter candle: updated candle
+    void UpdateLast(const CandleData& candle);
+
+    /// This function fills stock data with transformed bars, for chart and indicators. Symbol is tagged with bar type
+    /// so analysis cache keeps transformed series apart from time candles. Output filled by previous call keeps its bars
+    /// before first changed one, only tail is rewritten. Revision changes on rebuild and when a bar before last one given
+    /// out is changed (e.g. Renko bricks of forming candle reversed)
+    /// - Parameters:
+    ///   - base: stock data of base candles
+    ///   - output: output stock data
+    /// - Returns: number of bars written
+    size_t ToStockData(const StockData& base, StockData& output);
+
+    const CandleColumns& GetBars() const { return m_bars; }
+    const BarTransformSettings& GetSettings() const { return m_settings; }
+    const BarTransformStats& GetStats() const { return m_stats; }
+    /// This function returns the Renko brick / range bar size in use
+    double GetBoxSize() const { return m_boxSize; }
+
+    /// This function returns the box size from ATR of candles, rounded to ticks
+    /// - Parameters:
+    ///   - history: candle history
+    ///   - period: ATR period
+    ///   - multiple: multiple of ATR
+    static double ComputeBoxSize(const std::vector<CandleData>& history, size_t period, double multiple);
+    /// This function returns the name of bar type
+    /// - Parameter type: bar type
+    static std::string_view GetName(BarType type);
+
+  private:
+    /// This structure stores the transform state, restored before forming base candle is processed again
+    struct State
+    {
+      size_t bars = 0;              //< Output bars
+      CandleData lastBar {};        //< Last output bar, range / count bars update it in place
+      double haOpen = 0.0, haClose = 0.0;
+      int64_t brickTop = 0, brickBottom = 0;    //< Renko levels in boxes
+      uint64_t pendingVolume = 0;   //< Renko volume since last brick
+      bool started = false;
+      size_t formingCandles = 0;    //< Base candles in last bar of CandleCount type
+    };
+
+    void Rebuild(const std::vector<CandleData>& history);
+    void Process(const CandleData& candle);
+    void Restore(const State& state);
+
+    void PushBar(const CandleData& bar);
+    void SetLastBar(const CandleData& bar);
+    CandleData GetLastBar() const;
+
+    void ProcessRenko(const CandleData& candle);
+    void ProcessRange(const CandleData& candle);
+
+    BarTransformSettings m_settings;
+    bool m_dirty = true;
+    double m_boxSize = TickSize;
+
+    // Base series identity and its last two candles, enough to detect append, forming update and revision
+    std::string m_symbol, m_range, m_granularity;
+    uint32_t m_firstTimestamp = 0;
+    uint64_t m_baseRevision = 0;
+    uint64_t m_revision = 0;      //< Incremented by rebuild, given to transformed stock data
+    size_t m_inputs = 0;
+    CandleData m_previousInput {}, m_lastInput {};
+
+    State m_state, m_checkpoint;
+    CandleColumns m_bars;
+    size_t m_firstChangedBar = 0; //< First bar changed since last ToStockData
+    BarTransformStats m_stats;
+  };
+} // namespace KanVest
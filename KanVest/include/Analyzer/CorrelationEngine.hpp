@@ -0,0 +1,103 @@
+//
+//  CorrelationEngine.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/StockMetadata.hpp"
+
+namespace KanVest
+{
+  /// This structure stores the correlation engine statistics
+  struct CorrelationStats
+  {
+    uint64_t fullRecomputes = 0;
+    uint64_t incrementalUpdates = 0;
+    double lastRecomputeMs = 0.0;
+    double lastUpdateMs = 0.0;
+  };
+
+  /// This class computes the N x N rolling correlation / covariance of log returns over window of bars.
+  /// Engine keeps the window sums and cross products of returns. New bar is a rank 2 update of cross products (add new
+  /// row, remove oldest), O(N^2) instead of O(N^2 W) recompute. Full recompute is cache blocked, and done on symbol
+  /// change, gaps and periodically to bound the drift of incremental sums
+  class CorrelationEngine
+  {
+  public:
+    static constexpr size_t BlockSize = 64;           //< Symbols per cache block of cross product kernel
+    static constexpr uint64_t ResyncUpdates = 1000;   //< Incremental updates between full recomputes
+
+    /// This function sets the number of returns in window. Engine is reset
+    /// - Parameter window: bars in window
+    void SetWindow(size_t window);
+
+    /// This function synchronizes the engine with stocks. Closes are aligned on timestamps common to all stocks.
+    /// Bars after last synchronized bar are applied incrementally, revised last bar is replaced
+    /// - Parameter stocks: stock data of symbols
+    /// - Returns: true if matrix changed
+    bool Sync(const std::vector<StockData>& stocks);
+
+    /// This function resets the engine with returns of window
+    /// - Parameters:
+    ///   - symbols: symbols
+    ///   - returns: return rows, each row has one return per symbol (oldest first)
+    void Reset(const std::vector<std::string>& symbols, const std::vector<std::vector<double>>& returns);
+    /// This function appends the returns of new bar, dropping oldest bar if window is full
+    /// - Parameter returns: return of each symbol
+    void Append(const double* returns);
+    /// This function replaces the returns of newest bar (forming candle update)
+    /// - Parameter returns: return of each symbol
+    void ReplaceLast(const double* returns);
+    /// This function recomputes the window sums from returns
+    void Recompute();
+
+    /// This function returns the correlation matrix, row major N x N. NaN if symbol has no variance
+    const std::vector<double>& GetCorrelation();
+    /// This function returns the sample covariance matrix, row major N x N
+    const std::vector<double>& GetCovariance();
+
+    const std::vector<std::string>& GetSymbols() const { return m_symbols; }
+    size_t Size() const { return m_symbols.size(); }
+    size_t GetWindow() const { return m_window; }
+    size_t GetBars() const { return m_filled; }
+    const CorrelationStats& GetStats() const { return m_stats; }
+
+  private:
+    /// This function returns the return row of bar, 0 is oldest
+    /// - Parameter bar: bar index in window
+    const double* Row(size_t bar) const { return m_returns.data() + ((m_head + bar) % m_window) * m_symbols.size(); }
+    /// This function adds outer products of rows to upper triangle of cross products
+    /// - Parameters:
+    ///   - add: row to add
+    ///   - remove: row to remove, optional
+    void RankUpdate(const double* add, const double* remove);
+    /// This function derives the correlation and covariance from window sums
+    void UpdateMatrices();
+
+    size_t m_window = 250;
+    std::vector<std::string> m_symbols;
+
+    // Return rows in ring, m_head is oldest
+    std::vector<double> m_returns;
+    size_t m_head = 0;
+    size_t m_filled = 0;
+
+    // Window sums, cross products are upper triangle of N x N
+    std::vector<double> m_sums;
+    std::vector<double> m_cross;
+    uint64_t m_updatesSinceRecompute = 0;
+
+    std::vector<double> m_correlation;
+    std::vector<double> m_covariance;
+    bool m_dirty = true;
+
+    // Last synchronized bar
+    uint32_t m_lastTimestamp = 0;
+    std::vector<double> m_lastCloses;
+
+    CorrelationStats m_stats;
+  };
+} // namespace KanVest
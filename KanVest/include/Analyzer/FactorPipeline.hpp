@@ -0,0 +1,122 @@
+//
+//  FactorPipeline.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Analyzer/Screener.hpp"
+
+namespace KanVest
+{
+  /// This enum stores the factor types computed per symbol from last bars
+  enum class FactorType : uint8_t
+  {
+    Momentum,         //< Return over period bars, %
+    Volatility,       //< Standard deviation of log returns over period bars, %
+    DistanceFromMA,   //< Distance of close from SMA of period, %
+    RSI,              //< Wilder RSI of period
+    RelativeVolume,   //< Last volume / average volume of period
+    Count
+  };
+
+  /// This structure stores the factor and its weight in composite score
+  struct FactorDefinition
+  {
+    FactorType type = FactorType::Momentum;
+    int period = 20;
+    double weight = 1.0;    //< Negative weight prefers low values (e.g. low volatility)
+
+    /// This function returns the factor name, e.g. MOM20, VOL20, DIST50, RSI14, RVOL20
+    std::string GetName() const;
+  };
+
+  /// This structure stores the pipeline settings
+  struct FactorSettings
+  {
+    std::vector<FactorDefinition> factors = {
+      {FactorType::Momentum, 120, 1.0}, {FactorType::Momentum, 20, 0.5}, {FactorType::Volatility, 20, -0.5}, {FactorType::DistanceFromMA, 50, 0.5}
+    };
+    double winsorizeFraction = 0.025;   //< Share of values clipped at each tail before z-score
+    size_t topN = 20;                   //< Symbols in leaderboard
+  };
+
+  /// This structure stores one row of leaderboard
+  struct FactorLeader
+  {
+    size_t rank = 0;                //< 1 is best
+    size_t symbol = 0;              //< Symbol index of universe
+    std::string name;
+    double composite = 0.0;
+    std::vector<double> zScores;    //< Z-score of each factor, in order of settings
+  };
+
+  /// This structure stores the pipeline run statistics
+  struct FactorStats
+  {
+    size_t symbols = 0;
+    size_t factors = 0;
+    size_t scored = 0;              //< Symbols with at least one factor value
+    uint32_t threads = 0;
+    double computeMs = 0.0;         //< Per symbol factor values, parallel
+    double normalizeMs = 0.0;       //< Winsorize and z-score of each factor
+    double rankMs = 0.0;            //< Composite score and top N
+    double elapsedMs = 0.0;
+  };
+
+  /// This structure stores the pipeline result. Factor columns are factor major: value of factor f for symbol s is at
+  /// f * symbols + s. Values not available (short history) are NaN
+  struct FactorResult
+  {
+    std::vector<std::string> factorNames;
+    std::vector<double> values;         //< Raw factor values
+    std::vector<double> zScores;        //< Winsorized z-scores, sign of weight not applied
+    std::vector<double> composite;      //< Weighted sum of z-scores over available factors, per symbol
+    std::vector<FactorLeader> leaderboard;
+    FactorStats stats;
+
+    /// This function returns the rank of symbol by composite score (1 is best), 0 if not scored. O(symbols), no sort
+    /// - Parameter symbol: symbol index of universe
+    size_t GetRank(size_t symbol) const;
+  };
+
+  /// This class scores the universe cross-sectionally. Factor values of each symbol are computed in parallel from
+  /// universe columns; each factor is winsorized at tail quantiles (nth_element, O(n)) and z-scored across universe;
+  /// composite is weighted sum of z-scores and only top N are ordered (partial sort, O(n log N))
+  class FactorPipeline
+  {
+  public:
+    /// This function scores the universe
+    /// - Parameters:
+    ///   - universe: universe columns
+    ///   - settings: factors, weights and leaderboard size
+    ///   - result: output result, its memory is reused
+    static void Run(const ScreenerUniverse& universe, const FactorSettings& settings, FactorResult& result);
+
+    /// This function computes the factor value of symbol from universe columns
+    /// - Parameters:
+    ///   - factor: factor definition
+    ///   - universe: universe columns
+    ///   - symbol: symbol index
+    static double ComputeFactor(const FactorDefinition& factor, const ScreenerUniverse& universe, size_t symbol);
+
+    /// This function winsorizes values at tail quantiles and replaces them by z-scores. NaN values are kept and skipped
+    /// - Parameters:
+    ///   - values: values, updated in place
+    ///   - count: number of values
+    ///   - fraction: share of values clipped at each tail
+    ///   - scratch: scratch buffer, its memory is reused
+    static void Standardize(double* values, size_t count, double fraction, std::vector<double>& scratch);
+
+    /// This function parses the factor name (e.g. MOM120, VOL20, DIST50, RSI14, RVOL20)
+    /// - Parameters:
+    ///   - name: factor name, case insensitive
+    ///   - weight: weight in composite
+    static std::optional<FactorDefinition> ParseFactor(const std::string& name, double weight = 1.0);
+    /// This function returns the name prefix of factor type
+    /// - Parameter type: factor type
+    static std::string_view GetPrefix(FactorType type);
+  };
+} // namespace KanVest
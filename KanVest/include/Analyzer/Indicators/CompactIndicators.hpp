@@ -0,0 +1,35 @@
+//
+//  CompactIndicators.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/CompactCandle.hpp"
+
+namespace KanVest
+{
+  /// This class stores the integer native indicator kernels working directly on compact fixed point candles.
+  /// Sums are accumulated in int64, so moving averages are exact and never drift
+  class CompactIndicators
+  {
+  public:
+    /// This function returns the fixed point sum of last `period` closes, -1 if not enough candles
+    /// - Parameters:
+    ///   - series: compact series
+    ///   - period: window size
+    static int64_t LastCloseSum(const CompactCandleSeries& series, size_t period);
+    /// This function returns highest high (fixed point) of last `period` candles, including the last candle
+    /// - Parameters:
+    ///   - series: compact series
+    ///   - period: number of candles
+    static int32_t HighestHigh(const CompactCandleSeries& series, size_t period);
+    /// This function returns lowest low (fixed point) of last `period` candles, including the last candle
+    /// - Parameters:
+    ///   - series: compact series
+    ///   - period: number of candles
+    static int32_t LowestLow(const CompactCandleSeries& series, size_t period);
+  };
+} // namespace KanVest
@@ -0,0 +1,109 @@
+//
+//  IndicatorGraph.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/CandleColumns.hpp"
+
+#include <unordered_set>
+
+namespace KanVest
+{
+  /// This structure stores the indicator graph evaluation statistics
+  struct IndicatorGraphStats
+  {
+    uint64_t computedNodes = 0;     //< Nodes evaluated by graph
+    uint64_t independentNodes = 0;  //< Nodes that evaluating each requested indicator independently would need
+    uint64_t computedBars = 0;      //< Bars processed by evaluated nodes
+    uint64_t independentBars = 0;
+
+    /// This function returns the percentage of computation saved by sharing intermediates
+    double SavedPercent() const { return independentBars ? 100.0 * (1.0 - static_cast<double>(computedBars) / independentBars) : 0.0; }
+  };
+
+  /// This class evaluates indicators as nodes of dependency graph. Each node declares its inputs by name, shared
+  /// intermediates (EMA(12) for MACD and its signal, SMA(20) for Bollinger bands ...) are computed once per input and
+  /// only nodes needed by requested outputs are evaluated, in topological order. Computed values are kept when input
+  /// changes, nodes evaluate only the bars from first changed candle on next request.
+  ///
+  /// Node names:
+  /// - Sources             : Close, Open, High, Low, Volume
+  /// - Averages            : SMA(p), EMA(p), StdDev(p)
+  /// - MACD                : MACD(fast,slow), MACDSignal(fast,slow,signal), MACDHistogram(fast,slow,signal)
+  /// - Bollinger bands     : BollingerUpper(p,k), BollingerLower(p,k)
+  /// - Volatility          : TrueRange, ATR(p)
+  /// - Stochastic          : HighestHigh(p), LowestLow(p), StochasticK(p), StochasticD(p,d)
+  /// - Momentum            : AverageGain(p), AverageLoss(p), RSI(p)
+  /// - Note: Values before warm up are NaN, except SMA / EMA which follow MovingAverage (0 / seeded)
+  class IndicatorGraph
+  {
+  public:
+    /// This function sets the candle input. Values of computed nodes before begin are kept
+    /// - Parameters:
+    ///   - columns: candle columns
+    ///   - begin: first changed candle, 0 if whole input changed
+    void SetInput(const CandleColumns& columns, size_t begin);
+
+    /// This function returns the values of indicator, evaluating it and missing dependencies
+    /// - Parameter name: indicator node name
+    const std::vector<double>& Get(const std::string& name);
+    /// This function evaluates all indicators, shared dependencies are evaluated once
+    /// - Parameter names: indicator node names
+    void Evaluate(const std::vector<std::string>& names);
+
+    /// This function checks if indicator name is valid node
+    /// - Parameter name: indicator node name
+    static bool IsValidNode(const std::string& name);
+
+    /// This function returns the evaluation statistics
+    const IndicatorGraphStats& GetStats() const { return m_stats; }
+    /// This function returns the number of bars in input
+    size_t Size() const { return m_size; }
+    /// This function returns the memory used by computed values in bytes
+    size_t GetMemoryUsage() const;
+
+  private:
+    // Output is sized to input and holds previous values, function writes values from begin
+    using ComputeFunction = std::function<void(const std::vector<const std::vector<double>*>& inputs, const std::vector<double>& args, size_t begin,
+                                               std::vector<double>& output)>;
+
+    struct Node
+    {
+      std::vector<std::string> inputs;
+      std::vector<double> args;
+      ComputeFunction compute;
+      bool valid = false;
+    };
+
+    /// This function builds the node from name
+    /// - Parameter name: indicator node name
+    static Node MakeNode(const std::string& name);
+    /// This function returns the node definition, parsed once per name
+    /// - Parameter name: indicator node name
+    const Node& GetNode(const std::string& name);
+    /// This function appends the dependency closure of name (not yet computed) to order, inputs first
+    /// - Parameters:
+    ///   - name: indicator node name
+    ///   - order: evaluation order
+    ///   - scheduled: nodes already in order
+    ///   - skipComputed: skip nodes with values of current input
+    void Schedule(const std::string& name, std::vector<std::string>& order, std::unordered_set<std::string>& scheduled, bool skipComputed);
+
+    /// This function returns the number of leading bars of node values computed for current input
+    /// - Parameter name: indicator node name
+    size_t GetValidBars(const std::string& name) const;
+    /// This function checks if node values are computed for all bars of current input
+    /// - Parameter name: indicator node name
+    bool IsCurrent(const std::string& name) const;
+
+    size_t m_size = 0;
+    std::unordered_map<std::string, std::vector<double>> m_values;
+    std::unordered_map<std::string, size_t> m_validBars;      //< Leading bars of node values that are computed for current input
+    std::unordered_map<std::string, Node> m_nodes;
+    IndicatorGraphStats m_stats;
+  };
+} // namespace KanVest
@@ -0,0 +1,67 @@
+//
+//  IndicatorPrecision.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+namespace KanVest
+{
+  /// This enum stores the storage precision of bulk indicator computation
+  enum class IndicatorPrecision : uint8_t
+  {
+    Float64, //< Double storage, reference
+    Float32, //< Float storage with double accumulators, half the memory traffic
+    Compact  //< 24 byte fixed point candles with int64 sums, read by screener only
+  };
+
+  /// This function returns the name of precision
+  /// - Parameter precision: storage precision
+  inline const char* GetPrecisionName(IndicatorPrecision precision)
+  {
+    switch (precision)
+    {
+      case IndicatorPrecision::Float32: return "float32";
+      case IndicatorPrecision::Compact: return "compact";
+      default:                          return "float64";
+    }
+  }
+
+  /// This structure stores the deviation of float32 indicators from double reference
+  struct PrecisionErrorStats
+  {
+    size_t series = 0;                //< Histories compared
+    size_t values = 0;                //< Indicator values compared
+    double maxRelativeError = 0.0;    //< SMA / EMA error relative to reference value
+    double maxRSIError = 0.0;         //< RSI error in points
+    std::string worstIndicator;       //< Indicator with largest relative error
+    double float64Ms = 0.0;           //< Kernel time with double storage
+    double float32Ms = 0.0;           //< Kernel time with float storage
+
+    /// This function returns the float32 speedup over double
+    double Speedup() const { return float32Ms > 0.0 ? float64Ms / float32Ms : 0.0; }
+  };
+
+  /// This class measures the accuracy of float32 indicator kernels against double reference on real histories.
+  /// It is run over the universe before switching bulk screening to float32
+  class IndicatorPrecisionHarness
+  {
+  public:
+    static constexpr double MaxRelativeError = 1e-5;  //< Accepted SMA / EMA relative error
+    static constexpr double MaxRSIError = 1e-3;       //< Accepted RSI error in points
+
+    /// This function computes SMA and EMA of all periods and RSI of closes in both precisions and accumulates the deviation
+    /// - Parameters:
+    ///   - closes: close prices
+    ///   - count: number of closes
+    ///   - periods: moving average periods
+    ///   - stats: statistics to accumulate
+    static void Compare(const double* closes, size_t count, const std::vector<int>& periods, PrecisionErrorStats& stats);
+
+    /// This function checks if deviation is within accepted bounds
+    /// - Parameter stats: accumulated statistics
+    static bool IsWithinBounds(const PrecisionErrorStats& stats);
+  };
+} // namespace KanVest
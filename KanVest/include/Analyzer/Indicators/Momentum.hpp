@@ -20,10 +20,14 @@ namespace KanVest
   class RSI
   {
   public:
-    // Computes the RSI series using Wilder's smoothing (the method brokers and TradingView/AngelOne use).
-    // - history: vector of StockPoint ordered oldest -> newest
-    // - period: typical default 14
-    // Returns full RSISeries where series[i] corresponds to history[i] (first period-1 entries will be NaN)
-    static RSISeries Compute(const StockData& data, size_t period = 14);
+    /// This function computes the RSI series of closes using Wilder's smoothing (the method brokers and TradingView/AngelOne use).
+    /// Average gain / loss are accumulated in double for any storage type
+    /// - Parameters:
+    ///   - closes: close prices
+    ///   - count: number of closes
+    ///   - period: rsi period
+    ///   - output: output (count values), NaN before period
+    template<typename T>
+    static void ComputeSeries(const T* closes, size_t count, size_t period, T* output);
   };
 } // namespace KanVest
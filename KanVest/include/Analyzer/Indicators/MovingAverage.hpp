@@ -13,6 +13,8 @@ namespace KanVest
 {
   static const std::vector<int> ValidMovingAveragePeriods = {5, 10, 20, 30, 50, 100, 150, 200};
 
+  /// This structure stores the moving averages of each period. Streaming indicator set keeps only last two values
+  /// (previous, current), chart evaluates visible window through MovingAverageCache
   struct MAResult
   {
     std::map<int, std::vector<double>> dmaValues;
@@ -22,12 +24,14 @@ namespace KanVest
   class MovingAverage
   {
   public:
-    [[nodiscard("Moving average is not used")]] static MAResult Compute(const StockData& data);
+    /// This function returns the moving average periods shown for chart range
+    /// - Parameter chartRange: chart range string
+    static std::vector<int> GetActivePeriods(const std::string& chartRange);
     
   private:
     static std::vector<double> ComputeDMA(const std::vector<double>& closes, int period);
     static std::vector<double> ComputeEMA(const std::vector<double>& closes, int period);
 
-    friend class MACD;
+    friend class IndicatorGraph;
   };
 } // namespace KanVest
@@ -0,0 +1,95 @@
+//
+//  MovingAverageCache.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/StockMetadata.hpp"
+
+namespace KanVest
+{
+  /// This enum stores the moving average types evaluated by cache
+  enum class MovingAverageType : uint8_t
+  {
+    Simple,       //< Same as MovingAverage::ComputeDMA
+    Exponential   //< Same as MovingAverage::ComputeEMA
+  };
+
+  /// This structure stores the moving average cache statistics
+  struct MovingAverageCacheStats
+  {
+    uint64_t requests = 0;
+    uint64_t computedChunks = 0;    //< Chunks evaluated
+    uint64_t cachedChunks = 0;      //< Chunks served from cache
+    uint64_t computedBars = 0;      //< Bars processed by evaluated chunks, including warm up
+    double computeMs = 0.0;         //< Time spent evaluating chunks
+  };
+
+  /// This class evaluates moving average series on demand. Only requested (type, period) series are computed and only
+  /// over requested window plus its warm up lookback, in chunks of ChunkSize candles that stay cached until their
+  /// candles change. Pan or zoom evaluates only chunks not yet cached, appended, forming or revised candles (last
+  /// RevisionWindow candles, as streaming indicators) invalidate chunks from first changed candle only.
+  /// - Note: SMA chunk needs period - 1 closes before it and matches batch DMA up to rounding. EMA chunk after a cached
+  ///         chunk continues from its last value, otherwise it is seeded GetWarmUp() closes before chunk, which leaves
+  ///         less than EMATolerance of seed error (none if warm up reaches first close)
+  class MovingAverageCache
+  {
+  public:
+    static constexpr size_t ChunkSize = 256;
+    static constexpr double EMATolerance = 1e-9;
+
+    /// This function sets the close input, keeping cached chunks before first changed close
+    /// - Parameter data: stock data
+    void SetInput(const StockData& data);
+
+    /// This function returns the average series of input size, evaluating the chunks of window not yet cached.
+    /// Values are valid in [begin, end), values of chunks never requested are NaN
+    /// - Parameters:
+    ///   - type: average type
+    ///   - period: average period
+    ///   - begin: first index of window
+    ///   - end: index after window, clamped to input size
+    const std::vector<double>& Get(MovingAverageType type, int period, size_t begin, size_t end);
+    /// This function removes the input and all cached series
+    void Clear();
+
+    /// This function returns the number of closes in input
+    size_t Size() const { return m_closes.size(); }
+    /// This function returns the cache statistics
+    const MovingAverageCacheStats& GetStats() const { return m_stats; }
+    /// This function returns the memory used in bytes
+    size_t GetMemoryUsage() const;
+
+    /// This function returns the closes evaluated before a chunk that is not continued from cached chunk
+    /// - Parameters:
+    ///   - type: average type
+    ///   - period: average period
+    static size_t GetWarmUp(MovingAverageType type, int period);
+
+  private:
+    // Candles at end of series that provider may revise, same as StreamingIndicatorSet
+    static constexpr size_t RevisionWindow = 16;
+
+    struct Series
+    {
+      std::vector<double> values;
+      std::vector<bool> cached;     //< Per chunk
+    };
+
+    /// This function evaluates one chunk of series
+    /// - Parameters:
+    ///   - type: average type
+    ///   - period: average period
+    ///   - series: series of type and period
+    ///   - chunk: chunk index
+    void Evaluate(MovingAverageType type, int period, Series& series, size_t chunk);
+
+    std::string m_symbol, m_range, m_granularity;
+    std::vector<double> m_closes;
+    std::unordered_map<int /* period * 2 + type */, Series> m_series;
+    MovingAverageCacheStats m_stats;
+  };
+} // namespace KanVest
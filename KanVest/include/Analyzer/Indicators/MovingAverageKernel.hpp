@@ -0,0 +1,77 @@
+//
+//  MovingAverageKernel.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+namespace KanVest
+{
+  /// This structure stores the indicator values as one contiguous row major matrix (row per period or symbol, column per bar)
+  /// - Template Parameter T: storage type, float halves memory traffic and doubles vector lanes
+  template<typename T>
+  struct BasicIndicatorMatrix
+  {
+    size_t rows = 0;
+    size_t columns = 0;
+    std::vector<T> values;
+
+    /// This function resizes the matrix, reusing the allocated memory
+    /// - Parameters:
+    ///   - rowCount: number of rows
+    ///   - columnCount: number of columns
+    void Resize(size_t rowCount, size_t columnCount)
+    {
+      rows = rowCount;
+      columns = columnCount;
+      values.resize(rowCount * columnCount);
+    }
+
+    T* Row(size_t row) { return values.data() + row * columns; }
+    const T* Row(size_t row) const { return values.data() + row * columns; }
+    T& At(size_t row, size_t column) { return values[row * columns + column]; }
+    T At(size_t row, size_t column) const { return values[row * columns + column]; }
+  };
+
+  using IndicatorMatrix = BasicIndicatorMatrix<double>;
+  using IndicatorMatrix32 = BasicIndicatorMatrix<float>;
+
+  /// This class provides the fused moving average kernels. Loops are written branch free over contiguous memory
+  /// so compiler vectorizes them for target (AVX2 / NEON). Kernels are instantiated for double and float storage,
+  /// sums that grow with history (SMA prefix) are always accumulated in double
+  class MovingAverageKernel
+  {
+  public:
+    /// This function computes SMA of all periods from one compensated prefix sum of closes.
+    /// Row k of output is period k, values before period - 1 are 0 (same as MovingAverage::ComputeDMA)
+    /// - Parameters:
+    ///   - closes: close prices
+    ///   - count: number of closes
+    ///   - periods: average periods
+    ///   - output: output matrix, resized to periods x count
+    template<typename T>
+    static void ComputeSMA(const T* closes, size_t count, const std::vector<int>& periods, BasicIndicatorMatrix<T>& output);
+
+    /// This function computes EMA of all periods in one pass over closes, all period states advance together
+    /// Row k of output is period k (same as MovingAverage::ComputeEMA)
+    /// - Parameters:
+    ///   - closes: close prices
+    ///   - count: number of closes
+    ///   - periods: average periods
+    ///   - output: output matrix, resized to periods x count
+    template<typename T>
+    static void ComputeEMA(const T* closes, size_t count, const std::vector<int>& periods, BasicIndicatorMatrix<T>& output);
+
+    /// This function computes EMA of one period for many symbols at once, symbol lanes advance together per bar.
+    /// All series must have same bar count (aligned universe). Row s of output is symbol s
+    /// - Parameters:
+    ///   - closes: close series of each symbol
+    ///   - count: number of bars in each series
+    ///   - period: average period
+    ///   - output: output matrix, resized to symbols x count
+    template<typename T>
+    static void ComputeEMAAcrossSymbols(const std::vector<const T*>& closes, size_t count, int period, BasicIndicatorMatrix<T>& output);
+  };
+} // namespace KanVest
@@ -0,0 +1,401 @@
+//
+//  RollingStatistics.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include <set>
+
+namespace KanVest
+{
+  /// This class stores the last window values in ring buffer. Base of rolling statistics
+  template<typename T>
+  class RollingWindow
+  {
+  public:
+    /// Constructor of window
+    /// - Parameter window: number of values in window
+    explicit RollingWindow(size_t window) : m_ring(std::max<size_t>(window, 1)) {}
+
+    /// This function returns the value, 0 is oldest
+    /// - Parameter index: index in window
+    T operator[](size_t index) const { return m_ring[(m_head + index) % m_ring.size()]; }
+
+    T Oldest() const { return m_ring[m_head]; }
+    T Newest() const { return (*this)[m_count - 1]; }
+    size_t Count() const { return m_count; }
+    size_t GetWindow() const { return m_ring.size(); }
+    bool IsFull() const { return m_count == m_ring.size(); }
+    bool IsEmpty() const { return m_count == 0; }
+
+  protected:
+    /// This function pushes the value, evicting oldest if window is full
+    /// - Parameter value: new value
+    void PushValue(T value)
+    {
+      if (IsFull())
+      {
+        m_ring[m_head] = value;
+        m_head = (m_head + 1) % m_ring.size();
+      }
+      else
+      {
+        m_ring[(m_head + m_count) % m_ring.size()] = value;
+        m_count++;
+      }
+    }
+    /// This function replaces the newest value
+    /// - Parameter value: new value
+    void ReplaceNewest(T value) { m_ring[(m_head + m_count - 1) % m_ring.size()] = value; }
+    void ClearValues() { m_head = 0; m_count = 0; }
+
+    std::vector<T> m_ring;
+    size_t m_head = 0;
+    size_t m_count = 0;
+  };
+
+  /// This class computes rolling mean and variance with Welford's update, O(1) per value. Evicted value is removed
+  /// with the inverse update, so there is no sum of squares cancellation of E[x^2] - E[x]^2 form. Removal still
+  /// accumulates rounding, so moments are recomputed from window once per window updates (amortized O(1))
+  template<typename T = double>
+  class RollingMeanVariance : public RollingWindow<T>
+  {
+  public:
+    static constexpr size_t MinResyncUpdates = 64;   //< Minimum updates between exact recomputes
+
+
+    /// Constructor of mean / variance
+    /// - Parameter window: number of values in window
+    explicit RollingMeanVariance(size_t window) : RollingWindow<T>(window) {}
+
+    /// This function appends a new value, O(1)
+    /// - Parameter value: new value
+    void Append(T value)
+    {
+      if (this->IsFull())
+      {
+        Replace(this->Oldest(), value);
+      }
+      else
+      {
+        const T delta = value - m_mean;
+        m_mean += delta / static_cast<T>(this->m_count + 1);
+        m_m2 += delta * (value - m_mean);
+      }
+      this->PushValue(value);
+      Resync();
+    }
+    /// This function replaces the newest value (forming candle), O(1)
+    /// - Parameter value: new value
+    void UpdateLast(T value)
+    {
+      if (this->IsEmpty())
+      {
+        Append(value);
+        return;
+      }
+      Replace(this->Newest(), value);
+      this->ReplaceNewest(value);
+      Resync();
+    }
+
+    T Mean() const { return m_mean; }
+    /// This function returns the variance of window
+    /// - Parameter sample: divide by count - 1 instead of count
+    T Variance(bool sample = false) const
+    {
+      const size_t divisor = sample ? this->m_count - 1 : this->m_count;
+      return this->m_count > (sample ? 1 : 0) ? std::max(T(0), m_m2 / static_cast<T>(divisor)) : T(0);
+    }
+    /// This function returns the standard deviation of window
+    /// - Parameter sample: divide by count - 1 instead of count
+    T StdDev(bool sample = false) const { return std::sqrt(Variance(sample)); }
+
+    void Reset() { this->ClearValues(); m_mean = T(0); m_m2 = T(0); m_updates = 0; }
+
+  private:
+    /// This function recomputes mean and squared deviations from window with two passes, once per window updates
+    void Resync()
+    {
+      if (++m_updates < std::max(this->GetWindow(), MinResyncUpdates))
+      {
+        return;
+      }
+      m_updates = 0;
+
+      T sum = T(0);
+      for (size_t i = 0; i < this->m_count; ++i)
+      {
+        sum += (*this)[i];
+      }
+      m_mean = sum / static_cast<T>(this->m_count);
+      m_m2 = T(0);
+      for (size_t i = 0; i < this->m_count; ++i)
+      {
+        const T deviation = (*this)[i] - m_mean;
+        m_m2 += deviation * deviation;
+      }
+    }
+
+    /// This function replaces one value of full window by another, count is unchanged
+    void Replace(T removed, T added)
+    {
+      const T delta = added - removed;
+      const T previousMean = m_mean;
+      m_mean += delta / static_cast<T>(this->m_count);
+      m_m2 += delta * (added - m_mean + removed - previousMean);
+    }
+
+    T m_mean = T(0);
+    T m_m2 = T(0);
+    size_t m_updates = 0;
+  };
+
+  /// This class computes rolling extreme with monotonic deque of candidate positions, amortized O(1) per value.
+  /// Compare is std::greater for maximum and std::less for minimum
+  template<typename T, typename Compare>
+  class RollingExtreme : public RollingWindow<T>
+  {
+  public:
+    /// Constructor of extreme
+    /// - Parameter window: number of values in window
+    explicit RollingExtreme(size_t window) : RollingWindow<T>(window), m_candidates(this->GetWindow() + 1) {}
+
+    /// This function appends a new value, amortized O(1)
+    /// - Parameter value: new value
+    void Append(T value)
+    {
+      this->PushValue(value);
+      Insert(m_position++, value);
+    }
+    /// This function replaces the newest value (forming candle). Candidates dropped by old value can not be restored,
+    /// so deque is rebuilt from window, O(window)
+    /// - Parameter value: new value
+    void UpdateLast(T value)
+    {
+      if (this->IsEmpty())
+      {
+        Append(value);
+        return;
+      }
+      this->ReplaceNewest(value);
+      m_front = m_size = 0;
+      const uint64_t first = m_position - this->m_count;
+      for (size_t i = 0; i < this->m_count; ++i)
+      {
+        Insert(first + i, (*this)[i]);
+      }
+    }
+
+    /// This function returns the extreme of window
+    T Value() const { return m_candidates[m_front].value; }
+
+    void Reset() { this->ClearValues(); m_front = m_size = 0; m_position = 0; }
+
+  private:
+    struct Candidate
+    {
+      uint64_t position = 0;
+      T value = T(0);
+    };
+
+    /// This function pushes the value at position, dropping candidates it dominates and candidate out of window
+    void Insert(uint64_t position, T value)
+    {
+      const size_t capacity = m_candidates.size();
+      while (m_size > 0 and !m_compare(m_candidates[(m_front + m_size - 1) % capacity].value, value))
+      {
+        m_size--;
+      }
+      m_candidates[(m_front + m_size) % capacity] = {position, value};
+      m_size++;
+      if (m_candidates[m_front].position + this->GetWindow() <= position)
+      {
+        m_front = (m_front + 1) % capacity;
+        m_size--;
+      }
+    }
+
+    // Candidates in ring, window + 1 entries before eviction. Values are strictly ordered by compare from front to back
+    std::vector<Candidate> m_candidates;
+    size_t m_front = 0;
+    size_t m_size = 0;
+    uint64_t m_position = 0;
+    Compare m_compare;
+  };
+
+  template<typename T = double> using RollingMaximum = RollingExtreme<T, std::greater<T>>;
+  template<typename T = double> using RollingMinimum = RollingExtreme<T, std::less<T>>;
+
+  /// This class computes rolling quantile with two ordered halves, lower holds the values up to quantile rank and upper
+  /// the rest. Insert, evict and rebalance are O(log window). Quantile is linearly interpolated between the closest
+  /// ranks (same as numpy default), so quantile 0.5 is the median
+  template<typename T = double>
+  class RollingQuantile : public RollingWindow<T>
+  {
+  public:
+    /// Constructor of quantile
+    /// - Parameters:
+    ///   - window: number of values in window
+    ///   - quantile: quantile in [0, 1]
+    RollingQuantile(size_t window, double quantile = 0.5) : RollingWindow<T>(window), m_quantile(std::clamp(quantile, 0.0, 1.0)) {}
+
+    /// This function appends a new value, O(log window)
+    /// - Parameter value: new value
+    void Append(T value)
+    {
+      if (this->IsFull())
+      {
+        Erase(this->Oldest());
+      }
+      this->PushValue(value);
+      Insert(value);
+      Rebalance();
+    }
+    /// This function replaces the newest value (forming candle), O(log window)
+    /// - Parameter value: new value
+    void UpdateLast(T value)
+    {
+      if (this->IsEmpty())
+      {
+        Append(value);
+        return;
+      }
+      Erase(this->Newest());
+      this->ReplaceNewest(value);
+      Insert(value);
+      Rebalance();
+    }
+
+    /// This function returns the quantile of values of window that are not NaN, 0 if there is none
+    T Value() const
+    {
+      if (m_lower.empty())
+      {
+        return T(0);
+      }
+      const double rank = m_quantile * static_cast<double>(m_lower.size() + m_upper.size() - 1);
+      const T fraction = static_cast<T>(rank - std::floor(rank));
+      const T below = *m_lower.rbegin();
+      return m_upper.empty() or fraction == T(0) ? below : below + fraction * (*m_upper.begin() - below);
+    }
+
+    double GetQuantile() const { return m_quantile; }
+
+    void Reset() { this->ClearValues(); m_lower.clear(); m_upper.clear(); }
+
+  private:
+    // NaN has no order in sets, window keeps it but quantile skips it
+    void Insert(T value)
+    {
+      if (std::isnan(value))
+      {
+        return;
+      }
+
+      // Lower may be empty after eviction, so split on upper minimum
+      if (!m_upper.empty() and !(value < *m_upper.begin()))
+      {
+        m_upper.insert(value);
+      }
+      else
+      {
+        m_lower.insert(value);
+      }
+    }
+    void Erase(T value)
+    {
+      if (std::isnan(value))
+      {
+        return;
+      }
+
+      // Every lower value is <= every upper value, so value not above lower maximum is in lower
+      auto& values = !m_lower.empty() and !(*m_lower.rbegin() < value) ? m_lower : m_upper;
+      if (auto it = values.find(value); it != values.end())
+      {
+        values.erase(it);
+      }
+    }
+    /// This function moves boundary values until lower holds floor(quantile * (count - 1)) + 1 of count values in sets
+    void Rebalance()
+    {
+      const size_t count = m_lower.size() + m_upper.size();
+      if (count == 0)
+      {
+        return;
+      }
+      const size_t target = static_cast<size_t>(std::floor(m_quantile * static_cast<double>(count - 1))) + 1;
+      while (m_lower.size() > target)
+      {
+        auto last = std::prev(m_lower.end());
+        m_upper.insert(*last);
+        m_lower.erase(last);
+      }
+      while (m_lower.size() < target and !m_upper.empty())
+      {
+        m_lower.insert(*m_upper.begin());
+        m_upper.erase(m_upper.begin());
+      }
+    }
+
+    double m_quantile;
+    std::multiset<T> m_lower;
+    std::multiset<T> m_upper;
+  };
+
+  /// This class computes rolling median, O(log window) per value
+  template<typename T = double>
+  class RollingMedian : public RollingQuantile<T>
+  {
+  public:
+    /// Constructor of median
+    /// - Parameter window: number of values in window
+    explicit RollingMedian(size_t window) : RollingQuantile<T>(window, 0.5) {}
+  };
+
+  /// This class provides the batch rolling statistics of whole columns. Output before window - 1 is NaN.
+  /// Mean / deviation and extremes are branch free loops over contiguous memory so compiler vectorizes them for
+  /// target (AVX2 / NEON); quantiles run the streaming O(log window) update over column
+  class RollingStatistics
+  {
+  public:
+    /// This function computes rolling mean and population standard deviation from compensated prefix sums of values
+    /// shifted by first value, so window sums do not lose precision to price level
+    /// - Parameters:
+    ///   - values: input values
+    ///   - count: number of values
+    ///   - window: window length
+    ///   - mean: mean output (count values), optional
+    ///   - deviation: standard deviation output (count values), optional
+    static void ComputeMeanDeviation(const double* values, size_t count, size_t window, double* mean, double* deviation);
+
+    /// This function computes rolling maximum with van Herk / Gil-Werman block prefix and suffix maxima,
+    /// three comparisons per value independent of window
+    /// - Parameters:
+    ///   - values: input values
+    ///   - count: number of values
+    ///   - window: window length
+    ///   - output: output (count values)
+    static void ComputeMaximum(const double* values, size_t count, size_t window, double* output);
+    /// This function computes rolling minimum, same as ComputeMaximum
+    /// - Parameters:
+    ///   - values: input values
+    ///   - count: number of values
+    ///   - window: window length
+    ///   - output: output (count values)
+    static void ComputeMinimum(const double* values, size_t count, size_t window, double* output);
+
+    /// This function computes rolling quantile
+    /// - Parameters:
+    ///   - values: input values
+    ///   - count: number of values
+    ///   - window: window length
+    ///   - quantile: quantile in [0, 1], 0.5 is median
+    ///   - output: output (count values)
+    static void ComputeQuantile(const double* values, size_t count, size_t window, double quantile, double* output);
+  };
+} // namespace KanVest
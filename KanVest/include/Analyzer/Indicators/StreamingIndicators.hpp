@@ -0,0 +1,205 @@
+//
+//  StreamingIndicators.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Analyzer/Indicators/MovingAverage.hpp"
+#include "Analyzer/Indicators/Momentum.hpp"
+
+namespace KanVest
+{
+  /// This class computes simple moving average incrementally with running sum over ring buffer.
+  /// Values match MovingAverage::ComputeDMA (0 until period closes are seen)
+  class StreamingSMA
+  {
+  public:
+    struct Checkpoint
+    {
+      size_t count = 0;
+      double sum = 0.0, prevSum = 0.0, evicted = 0.0;
+      std::vector<double> ring;
+    };
+
+    /// Constructor of SMA
+    /// - Parameter period: average period
+    explicit StreamingSMA(int period);
+
+    /// This function appends a new close and returns the average, O(1)
+    /// - Parameter close: close price
+    double Append(double close);
+    /// This function replaces the last close (forming candle) and returns the average, O(1)
+    /// - Parameter close: close price
+    double UpdateLast(double close);
+
+    /// This function returns the current average
+    double Value() const { return m_state.count >= m_period ? m_state.sum / static_cast<double>(m_period) : 0.0; }
+    /// This function returns the average before last close
+    double PreviousValue() const { return m_state.count > m_period ? m_state.prevSum / static_cast<double>(m_period) : 0.0; }
+    bool IsReady() const { return m_state.count >= m_period; }
+    int GetPeriod() const { return static_cast<int>(m_period); }
+
+    Checkpoint GetCheckpoint() const { return m_state; }
+    void Restore(const Checkpoint& checkpoint) { m_state = checkpoint; }
+    void Reset();
+
+  private:
+    size_t m_period;
+    Checkpoint m_state;
+  };
+
+  /// This class computes exponential moving average incrementally. Values match MovingAverage::ComputeEMA
+  class StreamingEMA
+  {
+  public:
+    struct State
+    {
+      size_t count = 0;
+      double value = 0.0;
+    };
+    struct Checkpoint
+    {
+      State state, prevState;
+    };
+
+    /// Constructor of EMA
+    /// - Parameter period: average period
+    explicit StreamingEMA(int period);
+
+    /// This function appends a new close and returns the average, O(1)
+    /// - Parameter close: close price
+    double Append(double close);
+    /// This function replaces the last close (forming candle) and returns the average, O(1)
+    /// - Parameter close: close price
+    double UpdateLast(double close);
+
+    double Value() const { return m_state.value; }
+    /// This function returns the average before last close
+    double PreviousValue() const { return m_prevState.value; }
+    int GetPeriod() const { return m_period; }
+
+    Checkpoint GetCheckpoint() const { return {m_state, m_prevState}; }
+    void Restore(const Checkpoint& checkpoint) { m_state = checkpoint.state; m_prevState = checkpoint.prevState; }
+    void Reset() { m_state = {}; m_prevState = {}; }
+
+  private:
+    State Step(const State& state, double close) const;
+
+    int m_period;
+    double m_multiplier;
+    State m_state, m_prevState;
+  };
+
+  /// This class computes RSI with Wilder's smoothing incrementally. Values match RSI::ComputeSeries (NaN until period + 1 closes)
+  class StreamingRSI
+  {
+  public:
+    struct State
+    {
+      size_t count = 0;
+      double lastClose = 0.0;
+      double gainSum = 0.0, lossSum = 0.0;
+      double avgGain = 0.0, avgLoss = 0.0;
+      double value = std::numeric_limits<double>::quiet_NaN();
+    };
+    struct Checkpoint
+    {
+      State state, prevState;
+    };
+
+    /// Constructor of RSI
+    /// - Parameter period: rsi period
+    explicit StreamingRSI(size_t period = 14);
+
+    /// This function appends a new close and returns the RSI, O(1)
+    /// - Parameter close: close price
+    double Append(double close);
+    /// This function replaces the last close (forming candle) and returns the RSI, O(1)
+    /// - Parameter close: close price
+    double UpdateLast(double close);
+
+    double Value() const { return m_state.value; }
+    size_t GetPeriod() const { return m_period; }
+
+    Checkpoint GetCheckpoint() const { return {m_state, m_prevState}; }
+    void Restore(const Checkpoint& checkpoint) { m_state = checkpoint.state; m_prevState = checkpoint.prevState; }
+    void Reset() { m_state = {}; m_prevState = {}; }
+
+  private:
+    State Step(const State& state, double close) const;
+
+    size_t m_period;
+    State m_state, m_prevState;
+  };
+
+  /// This class keeps the moving averages and RSI of one symbol in sync with its candle history.
+  /// Appended candles and forming candle updates cost O(1) per indicator, a revised tail is replayed from checkpoint.
+  /// Only last two values of each moving average are kept, full series are evaluated on demand by MovingAverageCache
+  class StreamingIndicatorSet
+  {
+  public:
+    struct Checkpoint
+    {
+      size_t count = 0;
+      std::vector<StreamingSMA::Checkpoint> sma;
+      std::vector<StreamingEMA::Checkpoint> ema;
+      StreamingRSI::Checkpoint rsi;
+    };
+
+    /// This function syncs the indicators with stock data, processing only what changed since last sync
+    /// - Parameter data: stock data
+    /// - Returns: number of candles processed (appended, updated or replayed)
+    size_t Sync(const StockData& data);
+
+    /// This function appends a close to all indicators and output series
+    /// - Parameters:
+    ///   - timestamp: candle time
+    ///   - close: close price
+    void Append(uint32_t timestamp, double close);
+    /// This function replaces the last close in all indicators and output series
+    /// - Parameter close: close price
+    void UpdateLast(double close);
+
+    /// This function returns the checkpoint of current state
+    Checkpoint GetCheckpoint() const;
+    /// This function restores the state and truncates output series to checkpoint
+    /// - Parameter checkpoint: checkpoint
+    void Restore(const Checkpoint& checkpoint);
+
+    /// This function returns the previous and current value of each moving average, last two values of
+    /// MovingAverage::ComputeDMA / ComputeEMA
+    const MAResult& GetMAResult() const;
+    /// This function returns the RSI series, same as RSI::ComputeSeries
+    const RSISeries& GetRSI() const;
+
+    size_t Size() const { return m_closes.size(); }
+    /// This function returns the memory used by indicator set in bytes
+    size_t GetMemoryUsage() const;
+
+  private:
+    void Reset(const StockData& data);
+    /// This function updates the last two moving average values from indicator states
+    void UpdateMovingAverageTail();
+
+    // Candles at end of series that provider may revise. Checkpoint is kept before them
+    static constexpr size_t RevisionWindow = 16;
+    static constexpr size_t MinMovingAverageCandles = 5;
+
+    std::string m_range, m_granularity;
+    std::vector<uint32_t> m_timestamps;
+    std::vector<double> m_closes;
+
+    std::vector<StreamingSMA> m_sma;
+    std::vector<StreamingEMA> m_ema;
+    StreamingRSI m_rsi;
+
+    MAResult m_maResult;
+    RSISeries m_rsiSeries;
+
+    Checkpoint m_revisionCheckpoint;
+    Checkpoint m_pendingCheckpoint;       //< Taken inside revision window, becomes revision checkpoint once it leaves it
+  };
+} // namespace KanVest
@@ -0,0 +1,119 @@
+//
+//  Volatility.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/StockMetadata.hpp"
+#include "Stock/CandleColumns.hpp"
+
+namespace KanVest
+{
+  /// This enum stores the volatility estimators
+  enum class VolatilityEstimator : uint8_t
+  {
+    CloseToClose,     //< Sample deviation of close to close log returns
+    Parkinson,        //< High - low range
+    GarmanKlass,      //< High - low range and open to close move
+    RogersSatchell,   //< High, low, open and close, unbiased under drift
+    YangZhang,        //< Overnight, open to close and Rogers-Satchell variances, handles opening gaps
+    Count
+  };
+
+  /// This structure stores the volatility series of one symbol. Volatility is annualized and in %, ATR is in price
+  struct VolatilitySeries
+  {
+    size_t window = 0;              //< Bars per estimate
+    size_t atrPeriod = 0;
+    double periodsPerYear = 0.0;    //< Bars per year used to annualize
+
+    std::vector<double> atr;        //< Wilder ATR, NaN before atrPeriod true ranges
+    std::array<std::vector<double>, static_cast<size_t>(VolatilityEstimator::Count)> values;   //< NaN before window bars
+
+    size_t Size() const { return atr.size(); }
+    /// This function returns the series of estimator
+    /// - Parameter estimator: volatility estimator
+    const std::vector<double>& Get(VolatilityEstimator estimator) const { return values[static_cast<size_t>(estimator)]; }
+    /// This function returns the last value of estimator, NaN if not available
+    /// - Parameter estimator: volatility estimator
+    double Latest(VolatilityEstimator estimator) const;
+    /// This function returns the last ATR, NaN if not available
+    double LatestATR() const { return atr.empty() ? std::numeric_limits<double>::quiet_NaN() : atr.back(); }
+    /// This function returns the percentile (0 - 100) of last value of estimator in its history, NaN if not available
+    /// - Parameter estimator: volatility estimator
+    double GetLatestPercentile(VolatilityEstimator estimator) const;
+
+    /// This function returns the memory used in bytes
+    size_t GetMemoryUsage() const;
+  };
+
+  /// This structure stores the fused kernel benchmark against separate estimator loops
+  struct VolatilityBenchmarkStats
+  {
+    size_t series = 0;                //< Histories compared
+    size_t bars = 0;
+    double maxDifference = 0.0;       //< Largest volatility difference in % points
+    double maxATRError = 0.0;         //< Largest ATR difference relative to reference
+    double fusedMs = 0.0;             //< Fused kernel time
+    double separateMs = 0.0;          //< Separate loops time
+
+    /// This function returns the fused kernel speedup over separate loops
+    double Speedup() const { return fusedMs > 0.0 ? separateMs / fusedMs : 0.0; }
+  };
+
+  /// This class computes ATR and the range based volatility estimators in one fused pass over OHLC columns. Each block
+  /// of bars takes four log ratios per bar (high / open, low / open, close / open, open / previous close) in a branch
+  /// free loop that compiler vectorizes for target (AVX2 / NEON), then one rolling loop derives every estimator from
+  /// them. Separate per estimator loops need fourteen logs per bar for same results. Changed tail is computed alone,
+  /// window before it is refilled from its bars.
+  /// - Note: Non positive or missing prices count as unchanged (log ratio 0)
+  class Volatility
+  {
+  public:
+    static constexpr size_t DefaultWindow = 20;
+    static constexpr size_t DefaultATRPeriod = 14;
+
+    /// This function computes all estimators and ATR in one fused pass
+    /// - Parameters:
+    ///   - opens, highs, lows, closes: price columns
+    ///   - count: number of bars
+    ///   - window: bars per estimate, at least 2
+    ///   - atrPeriod: ATR period
+    ///   - periodsPerYear: bars per year to annualize
+    ///   - output: output series
+    ///   - begin: first changed bar, values of output before it are kept if it has same parameters
+    static void Compute(const double* opens, const double* highs, const double* lows, const double* closes, size_t count, size_t window,
+                        size_t atrPeriod, double periodsPerYear, VolatilitySeries& output, size_t begin = 0);
+    /// This function computes all estimators and ATR of stock history, annualized for its interval
+    /// - Parameters:
+    ///   - data: stock data
+    ///   - columns: candle columns of data
+    ///   - output: output series
+    ///   - window: bars per estimate
+    ///   - atrPeriod: ATR period
+    ///   - begin: first changed candle, values of output before it are kept
+    static bool Compute(const StockData& data, const CandleColumns& columns, VolatilitySeries& output, size_t window = DefaultWindow,
+                        size_t atrPeriod = DefaultATRPeriod, size_t begin = 0);
+
+    /// This function computes same series with one loop per estimator and library log, reference of fused pass
+    /// - Parameters: same as Compute
+    static void ComputeSeparate(const double* opens, const double* highs, const double* lows, const double* closes, size_t count, size_t window,
+                                size_t atrPeriod, double periodsPerYear, VolatilitySeries& output);
+    /// This function runs fused pass and separate loops on history and accumulates their time and difference
+    /// - Parameters:
+    ///   - opens, highs, lows, closes: price columns
+    ///   - count: number of bars
+    ///   - stats: statistics to accumulate
+    static void Benchmark(const double* opens, const double* highs, const double* lows, const double* closes, size_t count, VolatilityBenchmarkStats& stats);
+
+    /// This function returns the bars per year of interval, NSE session of 375 minutes and 252 sessions a year
+    /// - Parameter dataGranularity: interval string
+    static double GetPeriodsPerYear(const std::string& dataGranularity);
+    /// This function returns the name of estimator
+    /// - Parameter estimator: volatility estimator
+    static std::string_view GetName(VolatilityEstimator estimator);
+  };
+} // namespace KanVest
@@ -0,0 +1,180 @@
+//
+//  VolumeProfile.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/StockMetadata.hpp"
+
+namespace KanVest
+{
+  /// This structure stores the levels of volume profile
+  struct VolumeProfileLevels
+  {
+    double pointOfControl = 0.0;    //< Center price of bin with highest volume
+    double valueAreaHigh = 0.0;     //< Upper edge of value area
+    double valueAreaLow = 0.0;      //< Lower edge of value area
+    double totalVolume = 0.0;
+  };
+
+  /// This class accumulates volume at price in fixed size bins of flat array. Bin size is whole number of ticks and bins
+  /// are aligned to multiples of it, so candle maps to bins with one division. Candle volume is spread uniformly over
+  /// bins between its low and high. Forming candle is replaced by removing its previous share, O(bins of candle)
+  class VolumeProfile
+  {
+  public:
+    static constexpr double ValueAreaFraction = 0.7;    //< Share of volume around point of control in value area
+    static constexpr double DefaultTickSize = 0.05;     //< NSE tick size
+    static constexpr double BinFraction = 0.0005;       //< Bin is about this fraction of price, in whole ticks
+
+    /// This function clears the profile
+    /// - Parameter binSize: price step of bin
+    void Reset(double binSize);
+
+    /// This function adds the candle volume, O(bins of candle)
+    /// - Parameter candle: new candle
+    void Append(const CandleData& candle);
+    /// This function replaces the last candle (forming candle), O(bins of old and new candle)
+    /// - Parameter candle: updated candle
+    void UpdateLast(const CandleData& candle);
+
+    /// This function computes point of control and value area, O(bins). Value area grows from point of control towards
+    /// the neighbour bin with more volume until it holds ValueAreaFraction of volume
+    VolumeProfileLevels ComputeLevels() const;
+
+    /// This function returns the volume of each bin, bin 0 is lowest price
+    const std::vector<double>& GetVolumes() const { return m_volumes; }
+    /// This function returns the lower price edge of bin
+    /// - Parameter bin: bin index
+    double GetBinLow(size_t bin) const { return static_cast<double>(m_baseBin + static_cast<int64_t>(bin)) * m_binSize; }
+    double GetBinSize() const { return m_binSize; }
+    size_t Size() const { return m_volumes.size(); }
+    bool IsEmpty() const { return !m_hasLast; }
+
+    /// This function returns the bin size for price, whole number of ticks close to BinFraction of price
+    /// - Parameters:
+    ///   - referencePrice: price level of stock
+    ///   - tickSize: exchange tick size
+    static double ChooseBinSize(double referencePrice, double tickSize = DefaultTickSize);
+
+  private:
+    /// This function adds (sign 1) or removes (sign -1) the candle volume
+    void Accumulate(const CandleData& candle, double sign);
+    /// This function grows the bin array to cover price range, with headroom so growth is amortized
+    void Cover(double low, double high);
+    /// This function returns the absolute bin of price, bin k covers [k * binSize, (k + 1) * binSize)
+    int64_t GetPriceBin(double price) const { return static_cast<int64_t>(std::floor(price / m_binSize)); }
+
+    double m_binSize = DefaultTickSize;
+    int64_t m_baseBin = 0;          //< Absolute bin of m_volumes[0], integer so growth at front never moves bin edges
+    std::vector<double> m_volumes;
+
+    CandleData m_last {};
+    bool m_hasLast = false;
+  };
+
+  /// This class computes volume weighted average price and volume weighted standard deviation incrementally.
+  /// Sums of closed candles and forming candle are kept apart, so forming candle update is exact, O(1).
+  /// Prices are shifted by anchor price so the second moment does not lose precision to price level
+  class StreamingVWAP
+  {
+  public:
+    /// This function restarts the average at anchor
+    /// - Parameter anchorPrice: price of anchor candle, used as shift
+    void Reset(double anchorPrice);
+
+    /// This function appends a new candle and returns the average
+    /// - Parameters:
+    ///   - price: typical price of candle
+    ///   - volume: volume of candle
+    double Append(double price, double volume);
+    /// This function replaces the last candle (forming candle) and returns the average
+    /// - Parameters:
+    ///   - price: typical price of candle
+    ///   - volume: volume of candle
+    double UpdateLast(double price, double volume);
+
+    /// This function returns the average, last price if no volume is traded since anchor
+    double Value() const;
+    /// This function returns the volume weighted standard deviation of price around average
+    double Deviation() const;
+
+  private:
+    struct Sums
+    {
+      double volume = 0.0, price = 0.0, square = 0.0;
+    };
+
+    double m_shift = 0.0;
+    double m_lastPrice = 0.0;
+    Sums m_closed, m_forming;
+  };
+
+  /// This enum stores the anchor where VWAP restarts
+  enum class VWAPAnchor : uint8_t
+  {
+    Session, Week, Month, Bar
+  };
+
+  /// This structure stores the VWAP series, bands are vwap +/- k * deviation
+  struct VWAPSeries
+  {
+    std::vector<double> vwap;
+    std::vector<double> deviation;
+  };
+
+  /// This class keeps the VWAP series and volume profile of one symbol in sync with its candle history.
+  /// Appended candles and forming candle updates are incremental, anchor change or revised history rebuilds
+  class VolumeAnalysis
+  {
+  public:
+    /// This function syncs with stock data, processing only what changed since last sync
+    /// - Parameter data: stock data
+    /// - Returns: number of candles processed
+    size_t Sync(const StockData& data);
+
+    /// This function sets where VWAP restarts. Series is rebuilt if anchor changed
+    /// - Parameters:
+    ///   - anchor: anchor type
+    ///   - bar: anchor candle index, used by Bar anchor
+    void SetAnchor(VWAPAnchor anchor, size_t bar = 0);
+
+    const VWAPSeries& GetVWAP() const { return m_series; }
+    const VolumeProfile& GetProfile() const { return m_profile; }
+    const VolumeProfileLevels& GetLevels() const { return m_levels; }
+    VWAPAnchor GetAnchor() const { return m_anchor; }
+    size_t GetAnchorBar() const { return m_anchorBar; }
+
+    /// This function returns the memory used in bytes
+    size_t GetMemoryUsage() const;
+
+    /// This function returns the default anchor of data interval, session for intraday and bar 0 otherwise
+    /// - Parameter dataGranularity: data interval string
+    static VWAPAnchor GetDefaultAnchor(const std::string& dataGranularity);
+    /// This function returns the name of anchor
+    /// - Parameter anchor: anchor
+    static std::string_view GetName(VWAPAnchor anchor);
+
+  private:
+    void Rebuild();
+    void Append(const CandleData& candle);
+    void UpdateLast(const CandleData& candle);
+    /// This function checks if candle starts new anchor period
+    bool IsAnchor(size_t index, uint32_t timestamp) const;
+
+    std::string m_symbol, m_range, m_granularity;
+    std::vector<CandleData> m_candles;
+
+    VWAPAnchor m_anchor = VWAPAnchor::Bar;
+    size_t m_anchorBar = 0;
+    bool m_anchorSet = false;     //< Anchor chosen by user, kept over series change
+
+    StreamingVWAP m_vwap;
+    VolumeProfile m_profile;
+    VWAPSeries m_series;
+    VolumeProfileLevels m_levels;
+  };
+} // namespace KanVest
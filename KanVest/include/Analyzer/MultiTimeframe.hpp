@@ -0,0 +1,122 @@
+//
+//  MultiTimeframe.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/StockMetadata.hpp"
+
+#include "Analyzer/Indicators/StreamingIndicators.hpp"
+
+namespace KanVest
+{
+  /// This enum stores the timeframe derived from base candles
+  enum class Timeframe : uint8_t
+  {
+    Minute5, Minute15, Hour1, Day1, Week1, Month1
+  };
+
+  /// This structure stores the analysis of one timeframe. Indicator columns are aligned to base candles: value at base
+  /// candle i is the indicator of derived bar containing i, formed only from base candles up to i (no lookahead)
+  struct TimeframeAnalysis
+  {
+    Timeframe timeframe = Timeframe::Day1;
+    std::vector<CandleData> bars;       //< Derived bars, last may be forming
+    std::vector<uint32_t> barIndex;     //< Derived bar of every base candle
+
+    std::vector<std::vector<double>> sma;   //< Per period, value per base candle. 0 until period bars are seen
+    std::vector<std::vector<double>> ema;   //< Per period, value per base candle
+    std::vector<double> rsi;            //< Per base candle, NaN until period + 1 bars are seen
+
+    int trend = 0;                      //< 1 bullish, -1 bearish, 0 mixed at last candle
+
+    /// This structure stores the bucket state of timeframe after last base candle. Averages of forming bar are derived
+    /// from state at last closed bar, lanes are periods so loops over them vectorize
+    struct State
+    {
+      int64_t bucket = std::numeric_limits<int64_t>::min();
+      double formingClose = 0.0;
+      std::vector<double> closedSums {0.0};   //< Prefix sums of closed bar closes, closedSums[k] is sum of first k closed bars
+      std::vector<double> emaClosed, emaForming;
+      StreamingRSI rsi;                   //< Of MultiTimeframeAnalyzer::RSIPeriod, set when state is reset
+
+      CandleData formingBase {};          //< Forming bar before last base candle was merged, to update that candle again
+      bool lastOpenedBar = false;         //< Last base candle opened the forming bar
+    } state;
+  };
+
+  /// This structure stores the multi timeframe analysis of stock, lowest timeframe first
+  struct MultiTimeframeReport
+  {
+    std::vector<int> periods;
+    std::vector<TimeframeAnalysis> timeframes;
+    int alignment = 0;                  //< Sum of timeframe trends, +/- timeframe count if all confirm
+    double elapsedMs = 0.0;
+    size_t updatedCandles = 0;          //< Base candles traversed by last analysis
+
+    // Analyzed series, next analysis of same series continues from its last candle
+    std::string symbol, range, granularity;
+    uint64_t revision = 0;
+    size_t analyzed = 0;                //< Base candles analyzed, last one may be forming
+    CandleData first {}, lastClosed {}, last {};
+
+    /// This function checks if every timeframe has same non neutral trend
+    bool IsConfirmed() const { return !timeframes.empty() and static_cast<size_t>(std::abs(alignment)) == timeframes.size(); }
+  };
+
+  /// This structure stores the single traversal benchmark against analyzing each timeframe in its own traversal
+  struct MultiTimeframeBenchmarkStats
+  {
+    size_t series = 0;                //< Histories analyzed
+    size_t bars = 0;                  //< Base candles
+    size_t timeframes = 0;            //< Timeframes of all histories
+    double singlePassMs = 0.0;        //< All timeframes in one traversal
+    double sequentialMs = 0.0;        //< One traversal per timeframe
+    double updateMs = 0.0;            //< Forming candle update of analyzed histories
+    double maxDifference = 0.0;       //< Largest indicator difference against sequential and against full analysis after update
+
+    /// This function returns the single traversal speedup over sequential timeframes
+    double Speedup() const { return singlePassMs > 0.0 ? sequentialMs / singlePassMs : 0.0; }
+  };
+
+  /// This class derives higher timeframe bars from base candles and evaluates SMA / EMA of all periods and RSI on all
+  /// timeframes in one traversal. Each base candle either opens a new bar of timeframe (indicators append) or updates its
+  /// forming bar (indicators update last), so every timeframe costs O(1) per base candle per indicator. Bucket state of
+  /// every timeframe is kept in report, so analysis of same series traverses only appended candles and forming candle
+  class MultiTimeframeAnalyzer
+  {
+  public:
+    static constexpr uint32_t SessionOpenSeconds = 13500;   //< 09:15 IST as UTC seconds of day, intraday bars start at session open
+    static constexpr size_t RSIPeriod = 14;
+
+    /// This function analyzes the stock on base and derived timeframes. Report of same series (symbol, revision, first
+    /// and closed candles unchanged) is advanced from its last candle, otherwise it is analyzed from start of history
+    /// - Parameters:
+    ///   - stockData: stock data, base timeframe is its interval
+    ///   - timeframes: timeframes, each must be same or higher than base interval
+    ///   - periods: moving average periods
+    ///   - report: output report, its memory and bucket state are reused
+    static void Analyze(const StockData& stockData, const std::vector<Timeframe>& timeframes, const std::vector<int>& periods, MultiTimeframeReport& report);
+    /// This function analyzes the stock in one traversal and with one traversal per timeframe, then updates its forming
+    /// candle, and accumulates times and differences
+    /// - Parameters:
+    ///   - stockData: stock data
+    ///   - stats: statistics to accumulate
+    static void Benchmark(const StockData& stockData, MultiTimeframeBenchmarkStats& stats);
+
+    /// This function returns the timeframes derivable from data interval, lowest first (e.g. 1d -> 1D, 1W, 1M and 5m -> 5m, 15m, 1H, 1D)
+    /// - Parameter dataGranularity: data interval string
+    static std::vector<Timeframe> GetTimeframes(const std::string& dataGranularity);
+    /// This function returns the bucket of timestamp, candles with same bucket form one bar
+    /// - Parameters:
+    ///   - timeframe: timeframe
+    ///   - timestamp: unix timestamp
+    static int64_t GetBucket(Timeframe timeframe, uint32_t timestamp);
+    /// This function returns the short name of timeframe
+    /// - Parameter timeframe: timeframe
+    static std::string_view GetName(Timeframe timeframe);
+  };
+} // namespace KanVest
@@ -0,0 +1,132 @@
+//
+//  PatternScanner.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/StockMetadata.hpp"
+
+#include "Analyzer/Screener.hpp"
+
+namespace KanVest
+{
+  /// This enum stores the candlestick and chart patterns detected by scanner. Pattern is reported at its last bar
+  enum class CandlePattern : uint8_t
+  {
+    Doji, Hammer, HangingMan, InvertedHammer, ShootingStar, BullishMarubozu, BearishMarubozu,
+    BullishEngulfing, BearishEngulfing, BullishHarami, BearishHarami,
+    MorningStar, EveningStar, ThreeWhiteSoldiers, ThreeBlackCrows,
+    BreakoutHigh, BreakdownLow, DoubleTop, DoubleBottom,
+    Count
+  };
+
+  static constexpr size_t CandlePatternCount = static_cast<size_t>(CandlePattern::Count);
+
+  /// Bit per CandlePattern
+  using PatternMask = uint32_t;
+
+  /// This structure stores the patterns of all bars of universe as bit columns, bit i of pattern column is set if
+  /// pattern ends at bar i. Symbol s owns bars [offsets[s], offsets[s + 1]) same as universe
+  struct PatternScanResult
+  {
+    std::array<std::vector<uint64_t>, CandlePatternCount> columns;
+    std::vector<size_t> offsets {0};
+
+    double elapsedMs = 0.0;
+    size_t rescannedBars = 0;           //< Bars whose patterns were evaluated again by last stock scan
+
+    // Scanned stock history, next scan of same series rescans only from its first changed bar
+    std::string symbol;
+    uint64_t revision = 0;
+    CandleData first {}, lastClosed {}, last {};
+
+    /// This function checks if pattern ends at bar
+    /// - Parameters:
+    ///   - pattern: pattern
+    ///   - bar: bar index in universe
+    bool Has(CandlePattern pattern, size_t bar) const { return (columns[static_cast<size_t>(pattern)][bar / 64] >> (bar % 64)) & 1; }
+    /// This function returns the patterns ending at bar
+    /// - Parameter bar: bar index in universe
+    PatternMask GetMask(size_t bar) const;
+    /// This function returns the patterns ending at last bar of symbol, 0 if symbol has no bar
+    /// - Parameter symbol: symbol index in universe
+    PatternMask GetLatestMask(size_t symbol) const { return offsets[symbol + 1] > offsets[symbol] ? GetMask(offsets[symbol + 1] - 1) : 0; }
+    /// This function returns the number of bars where pattern ends
+    /// - Parameter pattern: pattern
+    size_t Count(CandlePattern pattern) const;
+
+    size_t Symbols() const { return offsets.size() - 1; }
+    size_t Bars() const { return offsets.back(); }
+    /// This function returns the scanned bars per second
+    double BarsPerSecond() const { return elapsedMs > 0.0 ? static_cast<double>(Bars()) * 1000.0 / elapsedMs : 0.0; }
+  };
+
+  /// This class scans candlestick and swing chart patterns over bars of universe.
+  ///
+  /// Each bar is encoded once into feature bits (body / shadow shape, relation to previous bars, trend, N bar breakout,
+  /// confirmed swing pivot), stored as bit columns, 64 bars per word, over the bars of all symbols concatenated.
+  /// Multi bar pattern is matched with word shifts and ANDs of feature columns, so one word operation tests a pattern
+  /// on 64 bars (of many symbols). Age features mask out matches whose bars cross symbol boundary. Double top / bottom
+  /// walk the sparse swing pivot bits
+  class PatternScanner
+  {
+  public:
+    static constexpr double DojiBody = 0.1;           //< Body at most this fraction of range
+    static constexpr double SmallBody = 0.3;
+    static constexpr double LongBody = 0.6;
+    static constexpr double MarubozuBody = 0.95;
+    static constexpr double ShadowToBody = 2.0;       //< Hammer / inverted hammer shadow at least this times body
+    static constexpr double LongShadow = 0.6;         //< Hammer / inverted hammer shadow at least this fraction of range
+    static constexpr double ShortShadow = 0.1;        //< Hammer / inverted hammer opposite shadow at most this fraction of range
+
+    static constexpr size_t TrendBars = 5;            //< Rising / falling close over these bars, gives context of reversal
+    static constexpr size_t BreakoutBars = 20;        //< Close beyond highest high / lowest low of these previous bars
+    static constexpr size_t SwingBars = 5;            //< Pivot is extreme of this many bars on both sides, confirmed after them
+
+    static constexpr size_t MinTopSeparation = 10;    //< Bars between pivots of double top / bottom
+    static constexpr size_t MaxTopSeparation = 60;
+    static constexpr double TopTolerance = 0.02;      //< Pivots of double top / bottom within this fraction of each other
+    static constexpr double MinTopDepth = 0.03;       //< Extreme between pivots at least this fraction away from pivots
+
+    /// Bars before a bar that its patterns can read: previous pivot and confirmation of double top / bottom, which
+    /// covers breakout lookback and three bar patterns
+    static constexpr size_t MaxLookback = MaxTopSeparation + 2 * SwingBars;
+
+    /// This function scans the patterns of universe with bit parallel matcher
+    /// - Parameters:
+    ///   - universe: universe columns
+    ///   - result: output result, its memory is reused
+    static void Scan(const ScreenerUniverse& universe, PatternScanResult& result);
+    /// This function scans the patterns of stock history. Result of same series (symbol, revision, first and closed
+    /// candles unchanged) keeps masks before first changed bar, only bars from it and MaxLookback bars before are encoded
+    /// - Parameters:
+    ///   - stockData: stock data
+    ///   - result: output result, its memory and masks are reused
+    static void Scan(const StockData& stockData, PatternScanResult& result);
+
+    /// This function scans the patterns of universe bar by bar, evaluating each pattern with scalar conditions.
+    /// Reference of bit parallel matcher
+    /// - Parameters:
+    ///   - universe: universe columns
+    ///   - result: output result, its memory is reused
+    static void ScanReference(const ScreenerUniverse& universe, PatternScanResult& result);
+    /// This function returns the number of bars whose patterns differ
+    /// - Parameters:
+    ///   - result: scan result
+    ///   - reference: reference result
+    static size_t CountMismatches(const PatternScanResult& result, const PatternScanResult& reference);
+
+    /// This function returns the name of pattern
+    /// - Parameter pattern: pattern
+    static std::string_view GetName(CandlePattern pattern);
+    /// This function returns 1 for bullish, -1 for bearish and 0 for neutral pattern
+    /// - Parameter pattern: pattern
+    static int GetBias(CandlePattern pattern);
+    /// This function returns the comma separated names of patterns in mask
+    /// - Parameter mask: pattern mask
+    static std::string FormatMask(PatternMask mask);
+  };
+} // namespace KanVest
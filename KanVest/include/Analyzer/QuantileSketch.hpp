@@ -0,0 +1,127 @@
+//
+//  QuantileSketch.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/StockMetadata.hpp"
+
+namespace KanVest
+{
+  /// This class approximates the distribution of a stream with KLL sketch. Values are kept in levels (compactors), value
+  /// at level h stands for 2^h inserted values. Full level is sorted and every other value is promoted to next level, so
+  /// memory stays about 3 * K values whatever the stream length. Rank error is about 1.7 / K (1% for K = 200).
+  /// Sketches with same K merge by appending levels and compacting, so per symbol sketches combine to universe sketch
+  class QuantileSketch
+  {
+  public:
+    static constexpr uint32_t DefaultK = 200;
+
+    /// Constructor
+    /// - Parameter k: accuracy parameter, capacity of top level
+    explicit QuantileSketch(uint32_t k = DefaultK);
+
+    /// This function inserts the value, amortized O(log K). NaN is ignored
+    /// - Parameter value: value
+    void Update(double value);
+    /// This function merges the other sketch into this one
+    /// - Parameter other: sketch with same K
+    void Merge(const QuantileSketch& other);
+    /// This function removes all the values
+    void Clear();
+
+    /// This function returns the approximate value at rank fraction, O(retained log retained). NaN if empty
+    /// - Parameter fraction: rank fraction, 0 is minimum and 1 is maximum
+    double GetQuantile(double fraction) const;
+    /// This function returns the approximate values at many rank fractions, sorting retained values once
+    /// - Parameters:
+    ///   - fractions: rank fractions
+    ///   - values: output values, in order of fractions
+    void GetQuantiles(const std::vector<double>& fractions, std::vector<double>& values) const;
+    /// This function returns the approximate fraction of values less than or equal to value, O(retained)
+    /// - Parameter value: value
+    double GetRank(double value) const;
+
+    uint64_t Count() const { return m_count; }
+    bool IsEmpty() const { return m_count == 0; }
+    double Min() const { return m_min; }
+    double Max() const { return m_max; }
+    uint32_t GetK() const { return m_k; }
+    /// This function returns the number of values kept
+    size_t Retained() const { return m_retained; }
+    /// This function returns the memory used in bytes
+    size_t GetMemoryUsage() const;
+
+  private:
+    /// This function returns the capacity of level, shrinking geometrically below top level
+    size_t GetCapacity(size_t level) const;
+    /// This function compacts the lowest full level into next level
+    void Compact();
+
+    uint32_t m_k = DefaultK;
+    uint64_t m_count = 0;
+    size_t m_retained = 0;
+    size_t m_totalCapacity = 0;                     //< Capacity of all levels, updated when level is added
+    uint64_t m_random = 0x9E3779B97F4A7C15ull;    //< Coin of compaction offset, deterministic so results are reproducible
+    double m_min = std::numeric_limits<double>::quiet_NaN();
+    double m_max = std::numeric_limits<double>::quiet_NaN();
+    std::vector<std::vector<float>> m_levels;       //< Float values, sketch error is far above float rounding
+  };
+
+  /// This enum stores the candle metrics whose distribution is kept
+  enum class DistributionMetric : uint8_t
+  {
+    Return,     //< Close to close return, %
+    Volume,     //< Candle volume
+    Range,      //< High - low as % of close
+    Count
+  };
+
+  /// This class keeps the quantile sketch of each metric of one symbol in sync with its candle history. Closed candles
+  /// are inserted once, last (forming) candle is only ranked against them, revised history rebuilds
+  class DistributionAnalysis
+  {
+  public:
+    /// This function syncs with stock data, inserting only candles closed since last sync
+    /// - Parameter data: stock data
+    /// - Returns: number of candles inserted
+    size_t Sync(const StockData& data);
+
+    /// This function returns the sketch of metric
+    /// - Parameter metric: candle metric
+    const QuantileSketch& GetSketch(DistributionMetric metric) const { return m_sketches[static_cast<size_t>(metric)]; }
+    /// This function returns the metric value of last candle, NaN if not available
+    /// - Parameter metric: candle metric
+    double GetLatestValue(DistributionMetric metric) const { return m_latest[static_cast<size_t>(metric)]; }
+    /// This function returns the percentile (0 - 100) of last candle value in closed history, NaN if not available
+    /// - Parameter metric: candle metric
+    double GetLatestPercentile(DistributionMetric metric) const;
+
+    /// This function returns the memory used in bytes
+    size_t GetMemoryUsage() const;
+
+    /// This function returns the metric value of candle
+    /// - Parameters:
+    ///   - metric: candle metric
+    ///   - candle: candle
+    ///   - previous: previous candle, nullptr for first candle
+    static double GetValue(DistributionMetric metric, const CandleData& candle, const CandleData* previous);
+    /// This function returns the name of metric
+    /// - Parameter metric: candle metric
+    static std::string_view GetName(DistributionMetric metric);
+
+  private:
+    void Insert(const std::vector<CandleData>& history, size_t index);
+
+    std::string m_symbol, m_range, m_granularity;
+    uint32_t m_firstTimestamp = 0;
+    size_t m_inserted = 0;                  //< Closed candles inserted
+    CandleData m_lastInserted {};           //< Detects revision of closed candles
+
+    std::array<QuantileSketch, static_cast<size_t>(DistributionMetric::Count)> m_sketches;
+    std::array<double, static_cast<size_t>(DistributionMetric::Count)> m_latest {};
+  };
+} // namespace KanVest
@@ -0,0 +1,156 @@
+//
+//  RelativeStrength.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/StockMetadata.hpp"
+#include "Stock/StockUtils.hpp"
+#include "Stock/CandleColumns.hpp"
+
+#include "Analyzer/Screener.hpp"
+#include "Analyzer/MultiTimeframe.hpp"
+
+namespace KanVest
+{
+  /// This structure stores the closes of benchmark index as sorted columns, shared by every stock compared with it
+  struct BenchmarkSeries
+  {
+    std::string symbol;
+    std::string dataGranularity;
+    uint64_t version = 0;           //< Changes on every rebuild of series
+    std::vector<int64_t> keys;      //< Join key of each bar, ascending
+    std::vector<double> closes;
+
+    size_t Size() const { return closes.size(); }
+  };
+
+  /// This class caches the benchmark series by symbol. Series is rebuilt only when benchmark candles change, and is
+  /// shared read only by all the stocks (and threads) compared with it
+  class BenchmarkCache
+  {
+  public:
+    /// This function updates the cached series of benchmark from its stock data
+    /// - Parameter stockData: benchmark stock data
+    /// - Returns: true if series changed
+    static bool Update(const StockData& stockData);
+    /// This function returns the cached series of benchmark, nullptr if not cached
+    /// - Parameter symbol: benchmark symbol
+    static std::shared_ptr<const BenchmarkSeries> Get(const std::string& symbol);
+    /// This function removes all the cached series
+    static void Clear();
+
+  private:
+    struct Entry
+    {
+      size_t size = 0;
+      uint32_t firstTimestamp = 0;
+      uint32_t lastTimestamp = 0;
+      double lastClose = 0.0;
+      std::shared_ptr<const BenchmarkSeries> series;
+    };
+
+    inline static std::unordered_map<std::string, Entry> s_cache;
+    inline static uint64_t s_version = 0;
+    inline static std::mutex s_mutex;
+  };
+
+  /// This structure stores the relative strength of stock against benchmark, aligned to stock bars
+  struct RelativeStrengthSeries
+  {
+    std::string benchmark;
+    std::vector<double> ratio;        //< Stock close / benchmark close, 1 at first aligned bar. NaN before it
+    std::vector<double> mansfield;    //< Mansfield RS, (ratio / SMA(ratio) - 1) * 100
+    size_t alignedBars = 0;           //< Bars with benchmark close at or before them
+
+    uint64_t benchmarkVersion = 0;    //< Version of benchmark series compared, tail is extended only while it is same
+    size_t firstAligned = 0;
+    double base = 0.0;                //< Raw ratio at first aligned bar
+
+    double LastRatio() const { return ratio.empty() ? std::numeric_limits<double>::quiet_NaN() : ratio.back(); }
+    double LastMansfield() const { return mansfield.empty() ? std::numeric_limits<double>::quiet_NaN() : mansfield.back(); }
+  };
+
+  /// This structure stores the relative strength of one symbol of universe
+  struct RelativeStrengthEntry
+  {
+    std::string symbol;
+    std::string sector;                                                       //< Sector index, empty if not mapped
+    double ratio = std::numeric_limits<double>::quiet_NaN();                  //< Last ratio to benchmark
+    double mansfield = std::numeric_limits<double>::quiet_NaN();              //< Last Mansfield RS to benchmark
+    double sectorMansfield = std::numeric_limits<double>::quiet_NaN();        //< Last Mansfield RS to sector index
+    int percentile = 0;                                                       //< Rank of Mansfield RS in universe, 1 - 99
+    int sectorPercentile = 0;                                                 //< Rank of Mansfield RS among sector peers, 1 - 99
+  };
+
+  /// This structure stores the relative strength ranking of universe, strongest first
+  struct RelativeStrengthRanking
+  {
+    std::string benchmark;
+    std::vector<RelativeStrengthEntry> entries;
+    size_t bars = 0;
+    double elapsedMs = 0.0;
+  };
+
+  /// This class computes the relative strength of stocks against benchmark and sector indices.
+  ///
+  /// Stock and benchmark bars are aligned with one merge join over their sorted join keys (as of join, benchmark bar at
+  /// or before stock bar), O(stock bars + benchmark bars) without per bar lookup. Mansfield RS is ratio over its moving
+  /// average, expanding until period bars are seen so short histories still rank. Changed tail of stock is joined
+  /// alone, from benchmark bar found by binary search and average window summed from its bars
+  class RelativeStrength
+  {
+  public:
+    static constexpr std::string_view DefaultBenchmark = Utils::BenchmarkSymbol;
+
+    /// This function computes the relative strength of stock data against benchmark
+    /// - Parameters:
+    ///   - stockData: stock data
+    ///   - columns: candle columns of data
+    ///   - benchmark: benchmark series, must have same interval
+    ///   - output: output series, its memory is reused
+    ///   - begin: first changed candle, values of output before it are kept
+    /// - Returns: false if intervals differ or nothing aligns
+    static bool Compute(const StockData& stockData, const CandleColumns& columns, const BenchmarkSeries& benchmark, RelativeStrengthSeries& output,
+                        size_t begin = 0);
+    /// This function computes the relative strength of close column against benchmark
+    /// - Parameters:
+    ///   - timestamps: bar timestamps, ascending
+    ///   - closes: bar closes
+    ///   - count: number of bars
+    ///   - dataGranularity: interval of bars
+    ///   - benchmark: benchmark series, must have same interval
+    ///   - output: output series, its memory is reused
+    ///   - begin: first changed bar, values of output before it are kept if it was computed against same benchmark version
+    template<typename T>
+    static bool Compute(const uint32_t* timestamps, const T* closes, size_t count, const std::string& dataGranularity, const BenchmarkSeries& benchmark,
+                        RelativeStrengthSeries& output, size_t begin = 0);
+
+    /// This function ranks the universe by Mansfield RS against benchmark, and among sector peers
+    /// - Parameters:
+    ///   - universe: universe columns
+    ///   - dataGranularity: interval of universe bars
+    ///   - sectors: sector index of each universe symbol, empty if not mapped
+    ///   - benchmark: benchmark symbol
+    ///   - ranking: output ranking, its memory is reused
+    static void Rank(const ScreenerUniverse& universe, const std::string& dataGranularity, const std::vector<std::string>& sectors,
+                     const std::string& benchmark, RelativeStrengthRanking& ranking);
+
+    /// This function returns the join key of timestamp. Daily and higher intervals join on calendar bucket, so index and
+    /// stock bars of same day match even if provider stamps them at different time of day
+    /// - Parameters:
+    ///   - timestamp: unix timestamp
+    ///   - dataGranularity: data interval string
+    static int64_t GetJoinKey(uint32_t timestamp, const std::string& dataGranularity);
+    /// This function returns the Mansfield moving average period of interval (52 weeks of bars, 200 bars intraday)
+    /// - Parameter dataGranularity: data interval string
+    static size_t GetMansfieldPeriod(const std::string& dataGranularity);
+
+  private:
+    /// This function returns the calendar timeframe joined on, nullopt if bars join on raw timestamp
+    static std::optional<Timeframe> GetJoinTimeframe(const std::string& dataGranularity);
+  };
+} // namespace KanVest
@@ -0,0 +1,28 @@
+//
+//  ScoreColors.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+namespace KanVest::ScoreColor
+{
+  /// This function packs RGBA components the same way as IM_COL32, so analyzer reports can carry colors without
+  /// depending on ImGui and the UI can draw them directly
+  /// - Parameters:
+  ///   - r: red component
+  ///   - g: green component
+  ///   - b: blue component
+  ///   - a: alpha component
+  constexpr uint32_t Pack(uint32_t r, uint32_t g, uint32_t b, uint32_t a = 255)
+  {
+    return (a << 24) | (b << 16) | (g << 8) | r;
+  }
+
+  inline constexpr uint32_t Profit = Pack(68, 149, 128);    //< Same as KanVasX::Color::Green
+  inline constexpr uint32_t Loss = Pack(215, 55, 25);       //< Same as KanVasX::Color::Red
+  inline constexpr uint32_t Moderate = Pack(250, 190, 12);  //< Same as KanVasX::Color::Yellow
+  inline constexpr uint32_t Neutral = Pack(255, 255, 255);  //< Same as KanVasX::Color::White
+} // namespace KanVest::ScoreColor
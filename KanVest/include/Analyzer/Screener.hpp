@@ -0,0 +1,234 @@
+//
+//  Screener.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/StockMetadata.hpp"
+#include "Stock/FetchWorkerPool.hpp"
+#include "Stock/CompactCandle.hpp"
+
+#include "Analyzer/Indicators/IndicatorPrecision.hpp"
+
+namespace KanVest
+{
+  /// This structure stores the operand (market value or indicator) used by screener filter
+  struct ScreenerOperand
+  {
+    enum class Type : uint8_t
+    {
+      Price, Change, Open, High, Low, Close, Volume,
+      SMA, EMA, RSI, ATR, HighestHigh, LowestLow, AverageVolume
+    };
+
+    Type type = Type::Close;
+    int period = 0;
+    std::string name;
+
+    bool operator==(const ScreenerOperand& other) const { return type == other.type and period == other.period; }
+  };
+
+  /// This class compiles the screener filter expression to postfix program, evaluated without allocation
+  ///
+  /// Syntax:
+  /// - Logical             : and, or, not (&&, ||, ! also accepted)
+  /// - Comparison          : <, <=, >, >=, ==, !=
+  /// - Arithmetic          : +, -, *, / and parenthesis
+  /// - Values              : price (live), change (%), open, high, low, close, volume of last candle
+  /// - Indicators          : DMA<p> / SMA<p>, EMA<p>, RSI<p>, ATR<p>, HHV<p> (highest high), LLV<p> (lowest low), AVGVOL<p>
+  /// - Note: Names are case insensitive. Comparison with value that is not available (warm up) is false
+  ///
+  /// e.g. "close > DMA200 and RSI14 < 30", "price > 1.05 * EMA50 or change >= 4"
+  class ScreenerFilter
+  {
+  public:
+    static constexpr size_t MaxOperands = 16;
+    static constexpr size_t MaxStackDepth = 32;
+
+    /// This function compiles the filter expression
+    /// - Parameter expression: filter expression
+    [[nodiscard("Filter is not used")]] static ScreenerFilter Compile(const std::string& expression);
+
+    /// This function evaluates the filter for operand values
+    /// - Parameter values: value of each operand, in order of GetOperands
+    bool Evaluate(const double* values) const;
+
+    /// This function checks if expression compiled
+    bool IsValid() const { return m_error.empty() and !m_program.empty(); }
+    /// This function returns the compile error
+    const std::string& GetError() const { return m_error; }
+    /// This function returns the filter expression
+    const std::string& GetExpression() const { return m_expression; }
+    /// This function returns the operands used by filter
+    const std::vector<ScreenerOperand>& GetOperands() const { return m_operands; }
+
+  private:
+    enum class OpCode : uint8_t
+    {
+      Constant, Operand,
+      Add, Subtract, Multiply, Divide, Negate,
+      Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual,
+      And, Or, Not
+    };
+
+    struct Instruction
+    {
+      OpCode code;
+      uint32_t operand = 0;
+      double constant = 0.0;
+    };
+
+    friend class ScreenerParser;
+
+    std::string m_expression;
+    std::string m_error;
+    std::vector<Instruction> m_program;
+    std::vector<ScreenerOperand> m_operands;
+  };
+
+  /// This structure stores the candle columns of universe in storage type
+  template<typename T>
+  struct ScreenerColumns
+  {
+    std::vector<T> opens, highs, lows, closes, volumes;
+
+    /// This function appends the candle
+    void Append(double open, double high, double low, double close, double volume)
+    {
+      opens.push_back(static_cast<T>(open));
+      highs.push_back(static_cast<T>(high));
+      lows.push_back(static_cast<T>(low));
+      closes.push_back(static_cast<T>(close));
+      volumes.push_back(static_cast<T>(volume));
+    }
+    /// This function reserves the memory
+    /// - Parameter barCount: total bars of all symbols
+    void Reserve(size_t barCount)
+    {
+      opens.reserve(barCount);
+      highs.reserve(barCount);
+      lows.reserve(barCount);
+      closes.reserve(barCount);
+      volumes.reserve(barCount);
+    }
+    /// This function clears the columns
+    void Clear()
+    {
+      opens.clear();
+      highs.clear();
+      lows.clear();
+      closes.clear();
+      volumes.clear();
+    }
+  };
+
+  /// This structure stores the candle columns of all symbols of universe in shared contiguous buffers.
+  /// Symbol s owns bars [offsets[s], offsets[s + 1]). Bars are stored in columns of universe precision only.
+  /// Compact universe stores one fixed point series per symbol instead of columns, it is read by screener kernels only
+  struct ScreenerUniverse
+  {
+    std::vector<std::string> symbols;
+    std::vector<double> livePrices, changePercents;
+    std::vector<size_t> offsets {0};
+    std::vector<uint32_t> timestamps;                            //< Bar timestamps, ascending within symbol
+
+    IndicatorPrecision precision = IndicatorPrecision::Float64; //< Storage of bars, set before adding stocks
+    ScreenerColumns<double> columns;                             //< Float64 bars
+    ScreenerColumns<float> columns32;                            //< Float32 bars
+    std::vector<CompactCandleSeries> compact;                    //< Compact bars, one series per symbol
+
+    /// This function appends the stock to universe. Split / bonus adjusted history is used if symbol has actions
+    /// - Parameter stockData: stock data
+    /// - Returns: false if history can not be stored in compact universe, stock is not added then
+    bool Add(const StockData& stockData);
+    /// This function reserves the memory
+    /// - Parameters:
+    ///   - symbolCount: number of symbols
+    ///   - barCount: total bars of all symbols
+    void Reserve(size_t symbolCount, size_t barCount);
+    /// This function clears the universe
+    void Clear();
+
+    size_t Size() const { return symbols.size(); }
+    size_t Bars(size_t symbol) const { return offsets[symbol + 1] - offsets[symbol]; }
+    size_t TotalBars() const { return offsets.back(); }
+    /// This function checks if bars are stored in columns (float precision), as read by pattern, factor and RS scans
+    bool HasColumns() const { return precision != IndicatorPrecision::Compact; }
+
+    /// This function returns the memory used by bars of universe in bytes
+    size_t GetBarMemoryUsage() const;
+  };
+
+  /// This structure stores the symbol that passed the filter
+  struct ScreenerMatch
+  {
+    std::string symbol;
+    std::vector<double> values; //< Operand values, in order of filter operands
+  };
+
+  /// This structure stores the screener run statistics
+  struct ScreenerStats
+  {
+    size_t symbols = 0;
+    size_t bars = 0;
+    size_t matches = 0;
+    size_t barBytes = 0;        //< Memory of universe bars, compares storage precisions
+    uint32_t threads = 0;
+    double elapsedMs = 0.0;
+
+    /// This function returns the screened symbols per second
+    double SymbolsPerSecond() const { return elapsedMs > 0.0 ? symbols * 1000.0 / elapsedMs : 0.0; }
+  };
+
+  /// This structure stores the screener result
+  struct ScreenerResult
+  {
+    std::vector<ScreenerMatch> matches;
+    ScreenerStats stats;
+  };
+
+  /// This class evaluates the filter over universe in parallel. Symbols are split into blocks, each block is evaluated
+  /// by worker thread with last value kernels that read the universe columns and write to preallocated output.
+  /// Kernels read columns of universe precision and accumulate in double, except EMA of column universe which is computed
+  /// for whole block by MovingAverageKernel::ComputeEMAAcrossSymbols in storage type. Compact universe is read with int64
+  /// sums and decoded one price at a time
+  class Screener
+  {
+  public:
+    /// This function starts the worker threads
+    /// - Parameter threadCount: number of threads. 0 selects hardware concurrency
+    static void Initialize(uint32_t threadCount = 0);
+    /// This function stops the worker threads
+    static void Shutdown();
+
+    /// This function screens the universe. Runs on caller thread if screener is not initialized
+    /// - Parameters:
+    ///   - filter: compiled filter
+    ///   - universe: universe columns
+    [[nodiscard("Screener result is not used")]] static ScreenerResult Run(const ScreenerFilter& filter, const ScreenerUniverse& universe);
+
+    /// This function computes the last value of operand for symbol of universe
+    /// - Parameters:
+    ///   - operand: screener operand
+    ///   - universe: universe columns
+    ///   - symbol: symbol index
+    static double ComputeOperand(const ScreenerOperand& operand, const ScreenerUniverse& universe, size_t symbol);
+
+    /// This function runs the task over blocks of items on worker threads and caller thread, and returns when all blocks
+    /// are done. Runs on caller thread if screener is not initialized
+    /// - Parameters:
+    ///   - count: number of items
+    ///   - task: task for items [begin, end), blocks are disjoint
+    /// - Returns: number of threads used
+    static uint32_t ParallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& task);
+
+  private:
+    static constexpr size_t BlockSize = 64; //< Items per task
+
+    inline static FetchWorkerPool s_workerPool;
+    inline static uint32_t s_threads = 0;
+  };
+} // namespace KanVest
@@ -0,0 +1,173 @@
+//
+//  Seasonality.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/StockMetadata.hpp"
+#include "Stock/CandleColumns.hpp"
+
+namespace KanVest
+{
+  /// This structure stores the log returns aggregated in one calendar bucket
+  struct SeasonalityBucket
+  {
+    uint32_t count = 0;
+    uint32_t positives = 0;
+    double sum = 0.0;           //< Sum of log returns
+    double sumSquares = 0.0;
+
+    /// This function adds the log return
+    /// - Parameter value: log return
+    void Add(double value);
+
+    /// This function returns the average return in %, compounded from mean log return. NaN if empty
+    double AverageReturn() const;
+    /// This function returns the total return in %, compounded from sum of log returns. NaN if empty
+    double TotalReturn() const;
+    /// This function returns the share of positive returns in %. NaN if empty
+    double WinRate() const;
+    /// This function returns the standard deviation of log returns in %. NaN if less than two returns
+    double Deviation() const;
+  };
+
+  /// This enum stores the calendar groups of seasonality
+  enum class SeasonalityGroup : uint8_t
+  {
+    Month,        //< Daily returns by month of year, January first
+    Weekday,      //< Daily returns by weekday, Monday first
+    DayOfMonth,   //< Daily returns by day of month, 1st first
+    Holiday,      //< Daily returns of normal, pre-holiday and post-holiday sessions
+    TimeOfDay,    //< Intraday candle returns by 5 minute slot from session open, intraday data only
+    Count
+  };
+
+  /// This class aggregates the calendar effects of one symbol in one pass over its closed candles. Candles are bucketed
+  /// into trading days; a day return is added when next trading day starts, so the gap to it tells whether the day was
+  /// before a holiday (weekday without session). Closed candles are inserted once and whole state can be saved to file
+  /// and loaded back, so heatmap and profiles are served from aggregates without rescanning history
+  class SeasonalityAggregates
+  {
+  public:
+    static constexpr uint32_t SlotSeconds = 300;
+    static constexpr size_t SlotCount = 75;       //< 09:15 to 15:30 IST in 5 minute slots
+
+    /// This function syncs with stock data, inserting only candles closed since last sync. Weekly and monthly data
+    /// is not aggregated
+    /// - Parameters:
+    ///   - data: stock data, identifies series
+    ///   - columns: candle columns of data
+    /// - Returns: number of candles inserted
+    size_t Sync(const StockData& data, const CandleColumns& columns);
+    /// This function removes all the aggregates
+    void Clear();
+
+    /// This function returns the buckets of group
+    /// - Parameter group: calendar group
+    std::span<const SeasonalityBucket> GetBuckets(SeasonalityGroup group) const;
+    /// This function returns the month bucket of year and month, nullptr if year is not in history
+    /// - Parameters:
+    ///   - year: calendar year
+    ///   - month: month 0 (January) to 11
+    const SeasonalityBucket* GetYearMonth(int year, size_t month) const;
+    int FirstYear() const { return m_firstYear; }
+    /// This function returns the number of years from first year, 0 if empty
+    size_t Years() const { return m_yearMonth.size() / 12; }
+    /// This function returns the number of trading days aggregated
+    uint32_t Days() const { return m_days; }
+    /// This function returns true if no candle is inserted
+    bool IsEmpty() const { return m_inserted == 0; }
+
+    /// This function saves the aggregates and sync state in yaml file
+    /// - Parameter filePath: file path
+    bool Save(const std::filesystem::path& filePath) const;
+    /// This function loads the aggregates and sync state from yaml file saved by Save
+    /// - Parameter filePath: file path
+    bool Load(const std::filesystem::path& filePath);
+
+    /// This function returns the memory used in bytes
+    size_t GetMemoryUsage() const { return sizeof(*this) + m_yearMonth.capacity() * sizeof(SeasonalityBucket); }
+
+    /// This function returns the number of buckets of group
+    /// - Parameter group: calendar group
+    static size_t GetBucketCount(SeasonalityGroup group);
+    /// This function returns the name of group
+    /// - Parameter group: calendar group
+    static std::string_view GetName(SeasonalityGroup group);
+    /// This function returns the label of bucket, e.g. "Jan", "Mon", "15", "Pre-Holiday", "09:15"
+    /// - Parameters:
+    ///   - group: calendar group
+    ///   - index: bucket index
+    static std::string GetLabel(SeasonalityGroup group, size_t index);
+
+  private:
+    void Insert(uint32_t timestamp, double open, double close, bool intraday);
+    /// This function adds the return of current day to day groups
+    /// - Parameter nextDay: day of next trading day
+    void CloseDay(int64_t nextDay);
+    SeasonalityBucket& Bucket(SeasonalityGroup group, size_t index);
+
+    std::string m_symbol, m_range, m_granularity;
+    uint32_t m_firstTimestamp = 0;
+    size_t m_inserted = 0;                  //< Closed candles inserted
+    CandleData m_lastInserted {};           //< Detects revision of closed candles
+
+    // Trading day in progress
+    int64_t m_day = -1;                     //< Day index since 1970-01-01, -1 before first candle
+    double m_dayClose = 0.0;
+    double m_previousDayClose = 0.0;        //< Close of trading day before current one, 0 if not known
+    bool m_postHoliday = false;             //< Current day follows a holiday
+    double m_lastClose = 0.0;
+
+    uint32_t m_days = 0;
+    int m_firstYear = 0;
+    std::array<SeasonalityBucket, 12 + 5 + 31 + 3 + SlotCount> m_buckets {};
+    std::vector<SeasonalityBucket> m_yearMonth;   //< 12 months per year from first year
+  };
+
+  /// This class persists the seasonality aggregates in one yaml file per series (symbol, range, interval), so heatmap
+  /// of series can be shown from its file before its history is fetched. Files are written by a writer thread, saves
+  /// of same series within save delay are coalesced into one write of latest aggregates
+  class SeasonalityStore
+  {
+  public:
+    static constexpr std::chrono::seconds SaveDelay {5};
+
+    /// This function sets the directory of aggregate files, creating it, and starts the writer thread. Aggregates are
+    /// not persisted until it is set
+    /// - Parameter directory: directory path
+    static void SetDirectory(const std::filesystem::path& directory);
+    /// This function writes the pending aggregates and stops the writer thread
+    static void Shutdown();
+
+    /// This function queues the aggregates of series for saving in its file. Aggregates are copied, caller does not wait
+    /// for file write. Files are of base symbols, aggregates of tagged series are not saved
+    /// - Parameters:
+    ///   - data: stock data aggregates are synced with
+    ///   - aggregates: aggregates
+    /// - Returns: true if queued
+    static bool Save(const StockData& data, const SeasonalityAggregates& aggregates);
+    /// This function loads the aggregates of series from its file
+    /// - Parameters:
+    ///   - symbol: stock symbol
+    ///   - range: range
+    ///   - interval: interval
+    ///   - aggregates: output aggregates, unchanged if file is not available
+    static bool Load(const std::string& symbol, const std::string& range, const std::string& interval, SeasonalityAggregates& aggregates);
+
+  private:
+    static std::filesystem::path GetFilePath(const std::string& symbol, const std::string& range, const std::string& interval);
+    /// This is writer loop
+    static void WriterLoop();
+
+    inline static std::filesystem::path s_directory;
+    inline static std::unordered_map<std::string, SeasonalityAggregates> s_pending;   //< File path to latest aggregates
+    inline static bool s_running = false;
+    inline static std::mutex s_mutex;
+    inline static std::condition_variable s_condition;
+    inline static std::thread s_writer;
+  };
+} // namespace KanVest
@@ -11,17 +11,182 @@
 
 #include "Analyzer/Indicators/MovingAverage.hpp"
 #include "Analyzer/Indicators/Momentum.hpp"
+#include "Analyzer/Indicators/StreamingIndicators.hpp"
+#include "Analyzer/Indicators/MovingAverageCache.hpp"
+#include "Analyzer/Indicators/IndicatorGraph.hpp"
+#include "Analyzer/Indicators/VolumeProfile.hpp"
+#include "Analyzer/Indicators/Volatility.hpp"
+
+#include "Analyzer/MultiTimeframe.hpp"
+#include "Analyzer/PatternScanner.hpp"
+#include "Analyzer/RelativeStrength.hpp"
+#include "Analyzer/QuantileSketch.hpp"
+#include "Analyzer/Seasonality.hpp"
+
+#include <list>
 
 namespace KanVest
 {
-  enum class TechnicalIndicators {DMA, EMA, RSI};
+  enum class TechnicalIndicators {DMA, EMA, RSI, Volatility};
 
   struct StockReport
   {
     double score = 50.0;
-    std::unordered_map<TechnicalIndicators, std::vector<std::pair<ImU32, std::string>>> summary;
+    std::unordered_map<TechnicalIndicators, std::vector<std::pair<uint32_t, std::string>>> summary;
+  };
+
+  /// This class stores the analysis state and results of one symbol. Contexts share no state, so different symbols can
+  /// be analyzed on different threads at same time, as long as each context is used by one thread at a time
+  class AnalysisContext
+  {
+  public:
+    /// This function analyze stock from data. Indicators advance only by candles changed since last analysis
+    /// - Parameter stockData: stock data
+    void Analyze(const StockData& stockData);
+
+    const StockReport& GetReport() const { return m_report; }
+
+    /// This function returns the DMA tail of active periods. Values of each period are two elements, average before last
+    /// close and current average (0 while warming up). Empty if stock has too few candles. Use GetMovingAverage for series
+    const std::map<int, std::vector<double>>& GetDMAValues() const { return m_indicators.GetMAResult().dmaValues; }
+    /// This function returns the EMA tail of active periods, same layout as GetDMAValues
+    const std::map<int, std::vector<double>>& GetEMAValues() const { return m_indicators.GetMAResult().emaValues; }
+
+    /// This function returns the moving average series of analyzed stock, evaluated only over window and its warm up
+    /// - Parameters:
+    ///   - type: average type
+    ///   - period: average period
+    ///   - begin: first candle index of window
+    ///   - end: candle index after window
+    const std::vector<double>& GetMovingAverage(MovingAverageType type, int period, size_t begin, size_t end) { return m_movingAverages.Get(type, period, begin, end); }
+    /// This function returns the moving average cache statistics
+    const MovingAverageCacheStats& GetMovingAverageStats() const { return m_movingAverages.GetStats(); }
+
+    const RSISeries& GetRSI() const { return m_indicators.GetRSI(); }
+
+    /// This function returns the indicator values of analyzed stock, evaluated on first request
+    /// - Parameter name: indicator node name (e.g. "MACD(12,26)", "BollingerUpper(20,2)", "ATR(14)")
+    const std::vector<double>& GetIndicator(const std::string& name) { return m_indicatorGraph.Get(name); }
+    /// This function returns the indicator graph statistics
+    const IndicatorGraphStats& GetIndicatorGraphStats() const { return m_indicatorGraph.GetStats(); }
+
+    /// This function returns the analysis of stock on its interval and higher timeframes derived from it
+    const MultiTimeframeReport& GetMultiTimeframeReport() const { return m_multiTimeframe; }
+    /// This function returns the candlestick and chart patterns of stock history
+    const PatternScanResult& GetPatterns() const { return m_patterns; }
+    /// This function returns the patterns ending at last candle
+    PatternMask GetLatestPatterns() const { return m_patterns.Symbols() ? m_patterns.GetLatestMask(0) : 0; }
+
+    /// This function returns the VWAP, volume profile and anchor of stock
+    const VolumeAnalysis& GetVolumeAnalysis() const { return m_volume; }
+    /// This function sets where VWAP restarts, series is rebuilt only if anchor changed
+    /// - Parameters:
+    ///   - anchor: anchor type
+    ///   - bar: anchor candle index, used by Bar anchor
+    void SetVWAPAnchor(VWAPAnchor anchor, size_t bar) { m_volume.SetAnchor(anchor, bar); }
+
+    /// This function returns the relative strength of stock against cached benchmark, empty if benchmark is not cached
+    const RelativeStrengthSeries& GetRelativeStrength() const { return m_relativeStrength; }
+    /// This function returns the quantile sketches of candle metrics, last candle is ranked against closed candles
+    const DistributionAnalysis& GetDistribution() const { return m_distribution; }
+    /// This function returns the calendar and time of day return aggregates of stock
+    const SeasonalityAggregates& GetSeasonality() const { return m_seasonality; }
+    /// This function returns the ATR and volatility estimator series of stock
+    const VolatilitySeries& GetVolatility() const { return m_volatility; }
+
+    /// This function returns the memory used by context in bytes
+    size_t GetMemoryUsage() const;
+
+  private:
+    // Analyzed series. Candles before last analyzed one are final while revision and corporate actions are same
+    std::string m_symbol, m_range, m_granularity;
+    uint64_t m_revision = 0;
+    uint64_t m_actionVersion = 0;
+    size_t m_analyzed = 0;
+    CandleData m_first, m_lastClosed, m_last;
+
+    StockData m_adjustedData;     //< Split / bonus adjusted copy of analyzed stock, empty if it has no actions
+    CandleColumns m_columns;      //< Columns of analyzed candles, shared by column based analyses
+    StockReport m_report;
+    StreamingIndicatorSet m_indicators;
+    MovingAverageCache m_movingAverages;
+    IndicatorGraph m_indicatorGraph;
+    MultiTimeframeReport m_multiTimeframe;
+    PatternScanResult m_patterns;
+    VolumeAnalysis m_volume;
+    RelativeStrengthSeries m_relativeStrength;
+    DistributionAnalysis m_distribution;
+    SeasonalityAggregates m_seasonality;
+    VolatilitySeries m_volatility;
+  };
+
+  /// This structure stores the analysis cache statistics
+  struct AnalysisCacheStats
+  {
+    uint64_t hits = 0;            //< Series unchanged, cached result is reused
+    uint64_t updates = 0;         //< Series changed, cached context advanced by changed candles
+    uint64_t misses = 0;          //< Context built from scratch
+    uint64_t evictions = 0;
+
+    size_t entries = 0;
+    size_t bytesUsed = 0;
+    size_t budgetBytes = 0;
+
+    double lastLatencyUs = 0.0;   //< Latency of last analysis request
+    double hitLatencyUs = 0.0;    //< Average latency of hits
+    double missLatencyUs = 0.0;   //< Average latency of updates and misses
+
+    /// This function returns the percentage of requests served without analysis
+    double HitRate() const { return hits + updates + misses ? 100.0 * static_cast<double>(hits) / static_cast<double>(hits + updates + misses) : 0.0; }
   };
 
+  /// This class caches the analysis contexts keyed by series (symbol, range, interval) and indicator parameters.
+  /// Context is reused as is if series hash is unchanged. Least recently used contexts are evicted above memory budget
+  class AnalysisCache
+  {
+  public:
+    static constexpr size_t DefaultBudgetBytes = 64 * 1024 * 1024;
+
+    /// This function returns the analyzed context of stock. Returned context is most recent and stays valid until
+    /// another stock is analyzed
+    /// - Parameter stockData: stock data
+    AnalysisContext& Analyze(const StockData& stockData);
+
+    /// This function sets the memory budget, evicting contexts above it
+    /// - Parameter bytes: budget in bytes
+    void SetBudget(size_t bytes);
+    /// This function removes all the contexts
+    void Clear();
+
+    /// This function returns the cache statistics
+    const AnalysisCacheStats& GetStats() const { return m_stats; }
+
+    /// This function returns the hash of series analyzed by context, built from revision, candle count, first and last
+    /// candles and benchmark version in constant time
+    /// - Parameter stockData: stock data
+    static uint64_t HashSeries(const StockData& stockData);
+
+  private:
+    struct Entry
+    {
+      std::string key;
+      uint64_t seriesHash = 0;
+      size_t bytes = 0;
+      AnalysisContext context;
+    };
+
+    /// This function evicts least recently used entries until cache fits budget. Most recent entry is never evicted
+    void Evict();
+
+    // Front is most recently used, list nodes keep contexts at stable address
+    std::list<Entry> m_entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+    size_t m_budget = DefaultBudgetBytes;
+    AnalysisCacheStats m_stats;
+  };
+
+  /// This class analyze the stock shown by UI. Contexts are kept in analysis cache, last analyzed one is active and
+  /// served by getters. Use AnalysisContext directly to analyze from other threads
   class Analyzer
   {
   public:
@@ -31,15 +196,57 @@ namespace KanVest
 
     static const StockReport& GetReport();
     
+    /// This function returns the DMA tail of analyzed stock, (previous, current) average of each active period
     static const std::map<int, std::vector<double>>& GetDMAValues();
+    /// This function returns the EMA tail of analyzed stock, (previous, current) average of each active period
     static const std::map<int, std::vector<double>>& GetEMAValues();
+    /// This function returns the moving average series of analyzed stock. Only chunks of window not yet cached are
+    /// evaluated, values outside requested windows are NaN
+    /// - Parameters:
+    ///   - type: average type
+    ///   - period: average period
+    ///   - begin: first candle index of window
+    ///   - end: candle index after window
+    static const std::vector<double>& GetMovingAverage(MovingAverageType type, int period, size_t begin, size_t end);
+    /// This function returns the moving average cache statistics of analyzed stock
+    static const MovingAverageCacheStats& GetMovingAverageStats();
 
     static const RSISeries& GetRSI();
 
-  private:
-    inline static StockReport s_stockReport;
+    /// This function returns the indicator values of analyzed stock. Indicator and its inputs are evaluated on first
+    /// request and shared with other indicators until stock is analyzed again
+    /// - Parameter name: indicator node name (e.g. "MACD(12,26)", "BollingerUpper(20,2)", "ATR(14)")
+    static const std::vector<double>& GetIndicator(const std::string& name);
+    /// This function returns the indicator graph statistics
+    static const IndicatorGraphStats& GetIndicatorGraphStats();
+    /// This function returns the multi timeframe analysis of analyzed stock
+    static const MultiTimeframeReport& GetMultiTimeframeReport();
+    /// This function returns the patterns ending at last candle of analyzed stock
+    static PatternMask GetLatestPatterns();
+    /// This function returns the VWAP series and volume profile of analyzed stock
+    static const VolumeAnalysis& GetVolumeAnalysis();
+    /// This function sets where VWAP of analyzed stock restarts
+    /// - Parameters:
+    ///   - anchor: anchor type
+    ///   - bar: anchor candle index, used by Bar anchor
+    static void SetVWAPAnchor(VWAPAnchor anchor, size_t bar = 0);
+    /// This function returns the relative strength of analyzed stock against NIFTY 50
+    static const RelativeStrengthSeries& GetRelativeStrength();
+    /// This function returns the distribution of candle metrics of analyzed stock
+    static const DistributionAnalysis& GetDistribution();
+    /// This function returns the seasonality aggregates of analyzed stock
+    static const SeasonalityAggregates& GetSeasonality();
+    /// This function returns the ATR and volatility estimators of analyzed stock
+    static const VolatilitySeries& GetVolatility();
 
-    inline static MAResult s_maResults;
-    inline static RSISeries s_rsiSeries;
+    /// This function sets the memory budget of analysis cache
+    /// - Parameter bytes: budget in bytes
+    static void SetCacheBudget(size_t bytes);
+    /// This function returns the analysis cache statistics
+    static const AnalysisCacheStats& GetCacheStats();
+
+  private:
+    inline static AnalysisCache s_cache;
+    inline static AnalysisContext* s_activeContext = nullptr;
   };
 } // namespace KanVest
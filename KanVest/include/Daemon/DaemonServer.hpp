@@ -0,0 +1,50 @@
+//
+//  DaemonServer.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+namespace KanVest
+{
+  /// This class exposes the daemon results over a local (unix domain) socket.
+  /// Protocol is line based, one request per connection:
+  ///   LIST            -> one line per symbol
+  ///   GET <SYMBOL>    -> report of symbol
+  ///   SCREEN <EXPR>   -> symbols passing filter expression (e.g. SCREEN close > DMA200 and RSI14 < 30)
+  ///   BACKTEST <SYMBOL> <ENTRY> ; <EXIT> -> strategy metrics over symbol history (e.g. BACKTEST TCS close > SMA50 ; close < SMA50)
+  ///   SWEEP <SYMBOL> <NAME>=<FIRST>:<LAST>:<STEP>[,...] <ENTRY> ; <EXIT> -> best parameter combinations and sweep rate
+  ///                   (e.g. SWEEP TCS fast=5:20:5,slow=50:200:50 EMA{fast} > EMA{slow} ; EMA{fast} < EMA{slow})
+  ///   PRECISION [FLOAT32 | FLOAT64 | COMPACT] -> float32 indicator deviation over universe, optionally switching screener precision
+  ///                   (compact stores 24 byte fixed point candles, SCREEN reports bar_bytes of each storage)
+  ///   VOLATILITY      -> fused volatility pass against separate estimator loops over universe, time and largest difference
+  ///   TIMEFRAMES      -> multi timeframe analysis in one traversal against one traversal per timeframe, and forming candle update time
+  ///   PATTERNS [VERIFY] -> symbols with candlestick / chart pattern at last candle and scan rate, optionally checked with scalar reference
+  ///   FACTORS [N]     -> top N symbols by composite of winsorized factor z-scores (momentum, volatility, distance from MA)
+  ///   QUANTILES [RETURN | VOLUME | RANGE] -> universe quantiles merged from symbol sketches, and percentile of last candle of each symbol
+  ///   RS              -> relative strength ranking of universe against benchmark, with sector percentile
+  ///   STATS           -> daemon statistics
+  class DaemonServer
+  {
+  public:
+    /// This function opens the socket and starts the accept thread
+    /// - Parameter socketPath: socket file path
+    static bool Start(const std::string& socketPath);
+    /// This function closes the socket and joins the accept thread
+    static void Stop();
+
+  private:
+    /// This is accept loop
+    static void AcceptLoop();
+    /// This function returns the response for request line
+    /// - Parameter request: request line
+    static std::string HandleRequest(const std::string& request);
+
+    inline static int s_socket = -1;
+    inline static std::string s_socketPath;
+    inline static std::atomic<bool> s_running = false;
+    inline static std::thread s_acceptThread;
+  };
+} // namespace KanVest
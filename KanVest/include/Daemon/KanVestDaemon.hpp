@@ -0,0 +1,206 @@
+//
+//  KanVestDaemon.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/StockMetadata.hpp"
+
+#include "URL_API/API_Provider.hpp"
+
+#include "Analyzer/StockAnalyzer.hpp"
+#include "Analyzer/Screener.hpp"
+#include "Analyzer/Backtester.hpp"
+#include "Analyzer/PatternScanner.hpp"
+#include "Analyzer/RelativeStrength.hpp"
+#include "Analyzer/FactorPipeline.hpp"
+
+namespace KanVest
+{
+  /// This structure stores the daemon configuration loaded from universe file
+  struct DaemonSpecification
+  {
+    std::vector<std::string> symbols;
+    Range range = Range::_1Y;
+    Interval interval = Interval::_1D;
+
+    int fetchDelayMs = 1000;
+    int pollDelayMs = 1000;
+    int statsIntervalSec = 60;
+
+    std::string socketPath = "/tmp/kanvest.sock";
+    std::string corporateActionsPath;
+
+    IndicatorPrecision screenerPrecision = IndicatorPrecision::Float64;
+
+    std::string benchmark = std::string(Utils::BenchmarkSymbol);  //< Index relative strength is ranked against
+    std::unordered_map<std::string, std::string> sectors;         //< Normalized symbol to its sector index
+
+    FactorSettings factors;                                       //< Factors and weights of leaderboard
+  };
+
+  /// This structure stores the analyzed result of a symbol, served over the socket
+  struct DaemonSymbolReport
+  {
+    std::string symbol;
+    std::string shortName;
+
+    double livePrice = -1;
+    double changePercent = -1;
+    double score = 50.0;
+    double rsi = std::numeric_limits<double>::quiet_NaN();
+    double volatility = std::numeric_limits<double>::quiet_NaN();   //< Annualized Yang-Zhang volatility in %
+    double atrPercent = std::numeric_limits<double>::quiet_NaN();   //< ATR in % of live price
+
+    size_t candles = 0;
+    uint32_t lastCandleTimestamp = 0;
+    std::chrono::steady_clock::time_point analyzedAt;
+  };
+
+  /// This structure stores the pattern scan of universe, served over the socket
+  struct DaemonPatternReport
+  {
+    std::vector<std::pair<std::string, PatternMask>> latest;  //< Symbols with patterns at last candle
+    size_t symbols = 0;
+    size_t bars = 0;
+    double elapsedMs = 0.0;
+    double barsPerSecond = 0.0;
+
+    bool verified = false;              //< Compared with scalar reference scan
+    size_t mismatches = 0;              //< Bars whose patterns differ from reference
+    double referenceMs = 0.0;
+  };
+
+  /// This structure stores the universe distribution of candle metric, merged from sketches of symbols
+  struct DaemonDistributionReport
+  {
+    DistributionMetric metric = DistributionMetric::Return;
+    std::vector<double> fractions = {0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99};
+    std::vector<double> quantiles;                                //< Universe value at each fraction
+    std::vector<std::tuple<std::string, double, double>> latest;  //< Symbol, last candle value and its percentile in own history
+
+    size_t symbols = 0;
+    uint64_t values = 0;                //< Candles summarized
+    size_t retained = 0;                //< Values kept by merged sketch
+    size_t sketchBytes = 0;             //< Memory of sketches of all symbols
+    double mergeMs = 0.0;
+  };
+
+  /// This structure stores the daemon process statistics
+  struct DaemonStats
+  {
+    double startupMs = 0.0;             //< Time from launch until every symbol of universe was analyzed once
+    bool warm = false;                  //< All symbols have valid cached data
+    size_t symbols = 0;
+    size_t readySymbols = 0;
+
+    double residentMemoryMB = 0.0;      //< Current resident set size of the process
+    double cpuPercent = 0.0;            //< Process CPU usage over last stats window
+    double cpuPercentPer100 = 0.0;      //< Process CPU usage normalized per 100 symbols
+
+    uint64_t analysisCount = 0;
+  };
+
+  /// This class runs the KanVest fetch / analyze pipeline headless, without any window or renderer
+  class Daemon
+  {
+  public:
+    /// This function loads the daemon specification from yaml file
+    /// - Parameter universeFilePath: universe file path
+    static DaemonSpecification LoadSpecification(const std::filesystem::path& universeFilePath);
+
+    /// This function intializes the stock manager and socket server for universe
+    /// - Parameter specification: daemon specification
+    static bool Initialize(const DaemonSpecification& specification);
+    /// This function runs the polling loop until stop is requested
+    static void Run();
+    /// This function requests the polling loop to stop. Safe to call from signal handler
+    static void Stop();
+    /// This function shuts down the daemon
+    static void Shutdown();
+
+    /// This function returns the report of symbol
+    /// - Parameter symbol: stock symbol
+    static std::optional<DaemonSymbolReport> GetReport(const std::string& symbol);
+    /// This function returns the reports of all the symbols
+    static std::vector<DaemonSymbolReport> GetReports();
+    /// This function screens the latest data of universe with filter
+    /// - Parameter filter: compiled screener filter
+    static ScreenerResult Screen(const ScreenerFilter& filter);
+    /// This function backtests the strategy over latest data of symbol
+    /// - Parameters:
+    ///   - symbol: stock symbol
+    ///   - entry: entry expression
+    ///   - exit: exit expression
+    static BacktestResult Backtest(const std::string& symbol, const std::string& entry, const std::string& exit);
+    /// This function backtests every parameter combination of strategy over latest data of symbol
+    /// - Parameters:
+    ///   - symbol: stock symbol
+    ///   - entry: entry expression template
+    ///   - exit: exit expression template
+    ///   - parameters: swept parameters
+    static BacktestSweepResult Sweep(const std::string& symbol, const std::string& entry, const std::string& exit,
+                                     const std::vector<BacktestParameter>& parameters);
+    /// This function scans candlestick and chart patterns over latest data of universe
+    /// - Parameter verify: compare with scalar reference scan
+    static DaemonPatternReport ScanPatterns(bool verify);
+    /// This function returns the relative strength ranking of universe, ranked again after each daily close of benchmark
+    static RelativeStrengthRanking GetRelativeStrength();
+    /// This function scores the latest data of universe on factors and returns the leaderboard
+    /// - Parameter topN: symbols in leaderboard, 0 for specification default
+    static FactorResult ScoreFactors(size_t topN);
+    /// This function merges the sketches of symbols into universe distribution of metric
+    /// - Parameter metric: candle metric
+    static DaemonDistributionReport GetDistribution(DistributionMetric metric);
+    /// This function measures the float32 indicator deviation from double over latest data of universe
+    static PrecisionErrorStats CheckPrecision();
+    /// This function runs fused volatility pass and separate estimator loops over latest data of universe
+    static VolatilityBenchmarkStats BenchmarkVolatility();
+    /// This function runs single traversal multi timeframe analysis against one traversal per timeframe over latest data of universe
+    static MultiTimeframeBenchmarkStats BenchmarkTimeframes();
+    /// This function sets the precision of screener universe, used by next screen
+    /// - Parameter precision: storage precision
+    static void SetScreenerPrecision(IndicatorPrecision precision);
+    static IndicatorPrecision GetScreenerPrecision() { return s_screenerPrecision; }
+    /// This function returns the daemon statistics
+    static DaemonStats GetStats();
+
+  private:
+    /// This function fills universe columns with latest data of symbols in screener precision
+    /// - Parameters:
+    ///   - universe: output universe
+    ///   - screener: universe is read by screener only, compact precision is kept. Otherwise float64 is used instead of compact
+    static void BuildUniverse(ScreenerUniverse& universe, bool screener = false);
+    /// This function polls stock manager cache and analyze the changed symbols
+    static void Poll();
+    /// This function updates the shared benchmark and sector series
+    /// - Returns: true if benchmark has a new candle (daily close)
+    static bool UpdateBenchmarks();
+    /// This function ranks the relative strength of universe against benchmark and sector indices
+    static void RankRelativeStrength();
+    /// This function updates the process statistics
+    static void UpdateStats();
+
+    inline static DaemonSpecification s_specification;
+    inline static std::unordered_map<std::string, DaemonSymbolReport> s_reports;
+    inline static DaemonStats s_stats;
+    inline static RelativeStrengthRanking s_relativeStrength;
+    inline static std::unordered_map<std::string, DistributionAnalysis> s_distributions;   //< Snapshot of context sketches, read by server thread
+    inline static uint32_t s_benchmarkTimestamp = 0;    //< Last benchmark candle seen, used by polling thread
+    inline static bool s_rankPending = false;           //< Benchmark closed a candle, rank once universe is warm
+
+    // Analysis contexts, used only by polling thread
+    inline static std::unordered_map<std::string, AnalysisContext> s_contexts;
+
+    inline static std::mutex s_mutex;
+    inline static std::atomic<bool> s_running = false;
+    inline static std::atomic<IndicatorPrecision> s_screenerPrecision = IndicatorPrecision::Float64;
+
+    inline static KanViz::Timer s_launchTimer;
+    inline static std::chrono::steady_clock::time_point s_statsWindowStart;
+    inline static double s_statsWindowCpuSec = 0.0;
+  };
+} // namespace KanVest
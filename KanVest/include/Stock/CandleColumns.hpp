@@ -0,0 +1,30 @@
+//
+//  CandleColumns.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/StockMetadata.hpp"
+
+namespace KanVest
+{
+  /// This structure stores the candle data as columns (one vector per field)
+  struct CandleColumns
+  {
+    std::vector<uint32_t> timestamps;
+    std::vector<double> opens, highs, lows, closes;
+    std::vector<uint64_t> volumes;
+
+    size_t Size() const { return closes.size(); }
+    void Reserve(size_t size);
+    void Clear();
+    /// This function writes candles from begin into columns, columns before begin are kept and capacity is reused
+    /// - Parameters:
+    ///   - candles: candle rows
+    ///   - begin: first changed candle, 0 fills whole columns
+    void Append(const std::vector<CandleData>& candles, size_t begin);
+  };
+} // namespace KanVest
@@ -0,0 +1,119 @@
+//
+//  CompactCandle.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/StockMetadata.hpp"
+#include "Stock/CandleColumns.hpp"
+
+namespace KanVest
+{
+  /// This structure stores the candle in fixed point. 24 bytes per bar instead of 48 for CandleData
+  /// - Note: Prices are scaled by series price scale, timestamp is delta from series base timestamp
+  struct CompactCandle
+  {
+    int32_t open, high, low, close;
+    uint32_t timeDelta;
+    uint32_t volume;    //< CompactCandleSeries::VolumeEscape if volume is stored in overflow table
+  };
+  static_assert(sizeof(CompactCandle) == 24, "Compact candle must be 24 bytes");
+
+  /// This class stores the candle history in compact fixed point format
+  class CompactCandleSeries
+  {
+  public:
+    static constexpr uint32_t VolumeEscape = std::numeric_limits<uint32_t>::max();
+
+    /// This function builds the compact series from candle history. Price scale is selected per symbol
+    /// - Parameters:
+    ///   - history: candle history
+    ///   - series: output series
+    /// - Returns: false if a candle can not be stored (older than first candle, or price not finite / out of range)
+    [[nodiscard("Rejected history must be handled")]] static bool Build(const std::vector<CandleData>& history, CompactCandleSeries& series);
+    /// This function builds the compact series from candle columns (e.g. split adjusted history)
+    /// - Parameters:
+    ///   - columns: candle columns
+    ///   - series: output series
+    /// - Returns: false if a candle can not be stored (older than first candle, or price not finite / out of range)
+    [[nodiscard("Rejected history must be handled")]] static bool Build(const CandleColumns& columns, CompactCandleSeries& series);
+
+    /// This function appends a candle at end of series. Series is not changed if candle is rejected
+    /// - Parameters:
+    ///   - timestamp: candle time
+    ///   - open, high, low, close: candle prices
+    ///   - volume: candle volume
+    /// - Returns: false if candle is older than base timestamp or a price does not fit the price scale
+    [[nodiscard("Rejected candle must be handled")]] bool Append(uint32_t timestamp, double open, double high, double low, double close, uint64_t volume);
+
+    /// This function decodes the candle at index
+    /// - Parameter index: candle index
+    CandleData Decode(size_t index) const;
+
+    /// This function converts price to fixed point
+    /// - Parameters:
+    ///   - price: price
+    ///   - fixed: output fixed point price
+    /// - Returns: false if price is not finite or scaled price does not fit in int32
+    bool ToFixed(double price, int32_t& fixed) const;
+    /// This function converts fixed point to price
+    /// - Parameter fixed: fixed price
+    double ToPrice(int64_t fixed) const { return static_cast<double>(fixed) * m_inversePriceScale; }
+
+    /// This function returns the timestamp of candle
+    /// - Parameter index: candle index
+    uint32_t GetTimestamp(size_t index) const { return m_baseTimestamp + m_candles[index].timeDelta; }
+    /// This function returns the volume of candle, resolving the overflow escape
+    /// - Parameter index: candle index
+    uint64_t GetVolume(size_t index) const;
+
+    const std::vector<CompactCandle>& GetCandles() const { return m_candles; }
+    const CompactCandle& operator[](size_t index) const { return m_candles[index]; }
+
+    size_t Size() const { return m_candles.size(); }
+    bool Empty() const { return m_candles.empty(); }
+    int32_t GetPriceScale() const { return m_priceScale; }
+    uint32_t GetBaseTimestamp() const { return m_baseTimestamp; }
+
+    /// This function returns the memory used by series in bytes
+    size_t GetMemoryUsage() const;
+
+  private:
+    /// This function sets the price scale and base timestamp of empty series
+    /// - Parameters:
+    ///   - priceScale: fixed point scale
+    ///   - baseTimestamp: timestamp of first candle
+    void Reset(int32_t priceScale, uint32_t baseTimestamp);
+
+    int32_t m_priceScale = 100;
+    double m_inversePriceScale = 0.01;
+    uint32_t m_baseTimestamp = 0;
+
+    std::vector<CompactCandle> m_candles;
+    std::vector<std::pair<uint32_t /* Index */, uint64_t /* Volume */>> m_volumeOverflow;
+  };
+
+  /// This class provides random access decoded view over compact series, without decoding whole series
+  class CompactCandleView
+  {
+  public:
+    /// Constructor of view
+    /// - Parameter series: compact series
+    explicit CompactCandleView(const CompactCandleSeries& series) : m_series(series) {}
+
+    CandleData operator[](size_t index) const { return m_series.Decode(index); }
+    double Close(size_t index) const { return m_series.ToPrice(m_series[index].close); }
+    double Open(size_t index) const { return m_series.ToPrice(m_series[index].open); }
+    double High(size_t index) const { return m_series.ToPrice(m_series[index].high); }
+    double Low(size_t index) const { return m_series.ToPrice(m_series[index].low); }
+    double Volume(size_t index) const { return static_cast<double>(m_series.GetVolume(index)); }
+
+    size_t Size() const { return m_series.Size(); }
+
+  private:
+    const CompactCandleSeries& m_series;
+  };
+} // namespace KanVest
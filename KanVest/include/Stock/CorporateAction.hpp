@@ -0,0 +1,109 @@
+//
+//  CorporateAction.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/CandleColumns.hpp"
+
+namespace KanVest
+{
+  enum class CorporateActionType
+  {
+    Split, Bonus
+  };
+
+  /// This structure stores a corporate action of symbol
+  /// - Split  : `from` old shares become `to` new shares (1:5 split -> from = 1, to = 5)
+  /// - Bonus  : `to` bonus shares for every `from` held (1:1 bonus -> from = 1, to = 1)
+  struct CorporateAction
+  {
+    CorporateActionType type = CorporateActionType::Split;
+    uint32_t exDate = 0;
+    double from = 1.0;
+    double to = 1.0;
+
+    /// This function returns the multiplicative factor to be applied on prices before ex date
+    double GetPriceFactor() const;
+  };
+
+  /// This structure stores the adjustment statistics
+  struct AdjustmentStats
+  {
+    uint64_t adjustedSeries = 0;
+    uint64_t adjustedBars = 0;
+    uint64_t cacheHits = 0;
+    double adjustMicroseconds = 0.0;
+
+    /// This function returns the adjustment throughput
+    double BarsPerSecond() const { return adjustMicroseconds > 0.0 ? adjustedBars * 1e6 / adjustMicroseconds : 0.0; }
+  };
+
+  /// This class stores the corporate actions per symbol and lazily produces split / bonus adjusted candle columns.
+  /// Adjusted columns are cached and versioned per symbol, so adding an action only invalidates that symbol
+  class AdjustmentEngine
+  {
+  public:
+    /// This function loads the corporate actions from yaml file
+    /// - Parameter filePath: corporate action file path
+    static void Load(const std::filesystem::path& filePath);
+
+    /// This function adds corporate action for symbol
+    /// - Parameters:
+    ///   - symbol: stock symbol
+    ///   - action: corporate action
+    static void AddAction(const std::string& symbol, const CorporateAction& action);
+    /// This function adds batch of corporate actions. Each touched symbol is invalidated once
+    /// - Parameter actions: symbol and action pairs
+    static void AddActions(const std::vector<std::pair<std::string, CorporateAction>>& actions);
+
+    /// This function checks if symbol has any corporate action
+    /// - Parameter symbol: stock symbol
+    static bool HasActions(const std::string& symbol);
+    /// This function returns the action version of symbol. Changes whenever an action is added
+    /// - Parameter symbol: stock symbol
+    static uint64_t GetVersion(const std::string& symbol);
+
+    /// This function returns the adjusted columns for stock data, computed once per action version and series revision.
+    /// Candles appended under same revision are adjusted alone
+    /// - Parameter stockData: stock data
+    [[nodiscard("Adjusted data is not used")]] static std::shared_ptr<const CandleColumns> GetAdjustedColumns(const StockData& stockData);
+    /// This function writes the stock data with split / bonus adjusted candles in output, reusing its memory
+    /// - Parameters:
+    ///   - stockData: stock data
+    ///   - adjustedData: output stock data, not changed if symbol has no actions
+    ///   - begin: first changed candle, adjusted candles before it are kept in output
+    /// - Returns: false if symbol has no actions
+    static bool GetAdjustedStockData(const StockData& stockData, StockData& adjustedData, size_t begin = 0);
+
+    /// This function adjusts columns in place for actions
+    /// - Parameters:
+    ///   - columns: candle columns (timestamps must be sorted)
+    ///   - actions: actions sorted by ex date
+    ///   - begin: first bar to adjust, bars before it are already adjusted
+    static void Adjust(CandleColumns& columns, const std::vector<CorporateAction>& actions, size_t begin = 0);
+
+    /// This function returns the adjustment statistics
+    static AdjustmentStats GetStats();
+
+  private:
+    struct CacheEntry
+    {
+      uint64_t version = 0;         //< Action version of symbol
+      uint64_t revision = 0;        //< Revision of series, candles before last one are same while it is unchanged
+      uint32_t lastTimestamp = 0;
+      double lastClose = 0.0;
+      std::shared_ptr<const CandleColumns> columns;
+    };
+
+    inline static std::unordered_map<std::string, std::vector<CorporateAction>> s_actions;
+    inline static std::unordered_map<std::string, uint64_t> s_versions;
+    inline static std::unordered_map<std::string, CacheEntry> s_cache;
+    inline static AdjustmentStats s_stats;
+
+    inline static std::mutex s_mutex;
+  };
+} // namespace KanVest
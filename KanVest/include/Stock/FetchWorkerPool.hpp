@@ -0,0 +1,99 @@
+//
+//  FetchWorkerPool.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+namespace KanVest
+{
+  enum class FetchPriority : uint8_t
+  {
+    Background, Refresh, Interactive
+  };
+
+  /// This structure stores the worker pool metrics
+  struct WorkerPoolMetrics
+  {
+    static constexpr size_t LatencyBuckets = 16; //< Bucket i holds latency in (2^(i-1), 2^i] ms
+
+    uint32_t threads = 0;
+    uint64_t threadsCreated = 0;
+    uint64_t tasksSubmitted = 0;
+    uint64_t tasksCompleted = 0;
+    size_t queueDepth = 0;
+
+    double uptimeSeconds = 0.0;
+    double busySeconds = 0.0;   //< Wall time spent in tasks summed over threads
+    std::array<uint64_t, LatencyBuckets> latencyHistogram {};
+
+    /// This function returns the thread creations per minute since pool start
+    double ThreadCreationsPerMinute() const { return uptimeSeconds > 0.0 ? threadsCreated * 60.0 / uptimeSeconds : 0.0; }
+    /// This function returns the average thread utilization in percent
+    double Utilization() const { return uptimeSeconds > 0.0 and threads ? 100.0 * busySeconds / (uptimeSeconds * threads) : 0.0; }
+    /// This function returns the upper bound of latency percentile in milliseconds (submit to completion)
+    /// - Parameter percentile: percentile in [0, 100]
+    double LatencyPercentileMs(double percentile) const;
+  };
+
+  /// This class runs the fetch / parse tasks on fixed number of threads. Tasks are picked by priority,
+  /// first come first served within same priority. Threads are created once in Start
+  class FetchWorkerPool
+  {
+  public:
+    using Task = std::function<void()>;
+
+    /// Destructor of pool, stops the threads
+    ~FetchWorkerPool();
+
+    /// This function starts the worker threads
+    /// - Parameter threadCount: number of threads. 0 selects from hardware concurrency
+    void Start(uint32_t threadCount = 0);
+    /// This function stops the worker threads. Queued tasks are discarded, running tasks are finished
+    void Stop();
+
+    /// This function submits the task to pool
+    /// - Parameters:
+    ///   - priority: task priority
+    ///   - task: task to run on worker thread
+    ///   - onComplete: callback invoked on worker thread after task
+    /// - Returns: false if pool is not running and task is dropped
+    bool Submit(FetchPriority priority, Task task, Task onComplete = {});
+
+    /// This function returns the pool metrics
+    WorkerPoolMetrics GetMetrics() const;
+    /// This function checks if pool is running
+    bool IsRunning() const { return m_running; }
+
+  private:
+    struct QueuedTask
+    {
+      FetchPriority priority;
+      uint64_t sequence;
+      std::chrono::steady_clock::time_point submitTime;
+      Task task;
+      Task onComplete;
+
+      bool operator<(const QueuedTask& other) const
+      {
+        // Max heap on priority, then older sequence first
+        return priority != other.priority ? priority < other.priority : sequence > other.sequence;
+      }
+    };
+
+    void WorkerThread();
+
+    std::vector<std::thread> m_threads;
+    std::priority_queue<QueuedTask> m_queue;
+    uint64_t m_sequence = 0;
+    std::atomic<bool> m_running = false;
+
+    WorkerPoolMetrics m_metrics;
+    std::chrono::steady_clock::time_point m_startTime;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+  };
+} // namespace KanVest
@@ -9,6 +9,8 @@
 
 #include "Stock/StockMetadata.hpp"
 
+#include "Stock/FetchWorkerPool.hpp"
+
 #include "URL_API/API_Provider.hpp"
 
 namespace KanVest
@@ -22,6 +24,21 @@ namespace KanVest
     
     StockData cachedData;
     std::chrono::steady_clock::time_point lastUpdated;
+
+    bool pending = false;      //< Fetch is queued or running in worker pool
+    bool replay = false;       //< Data is served by bar replay, symbol is not fetched
+    uint64_t generation = 0;   //< Changes when request is replaced, stale fetch results are dropped
+  };
+
+  /// This structure stores the fetch deduplication statistics
+  struct FetchStats
+  {
+    uint64_t requests = 0;        //< Fetch requests from all callers
+    uint64_t networkFetches = 0;  //< Fetches actually sent to URL
+    uint64_t coalesced = 0;       //< Requests served by an in flight fetch of same or superset key
+
+    /// This function returns the percentage of requests that were duplicate fetches without single flight
+    double DuplicateRate() const { return requests ? 100.0 * static_cast<double>(coalesced) / static_cast<double>(requests) : 0.0; }
   };
 
   /// This class managers stocks data
@@ -29,11 +46,14 @@ namespace KanVest
   {
   public:
     /// This function intializes the stock manager data
-    static void Initialize(int milliseconds = 10);
+    /// - Parameters:
+    ///   - milliseconds: refresh delay of each symbol after its last fetch
+    ///   - workerThreads: fetch worker threads. 0 selects from hardware concurrency
+    static void Initialize(int milliseconds = 10, uint32_t workerThreads = 0);
     /// This function shuts down the stock manager data
     static void Shutdown();
     
-    /// This function adds the request for stock
+    /// This function adds the request for stock. Requests are keyed by normalized symbol, lookups normalize too
     /// - Parameters:
     ///   - symbol: stock symbpl
     ///   - range: range of stock fetch
@@ -45,9 +65,48 @@ namespace KanVest
     ///   - symbol: stock symbpl
     [[nodiscard("Stock Data can not be discarded")]] static StockData GetLatestStockData(const std::string& symbol);
 
+    /// This function returns the normalized symbols requested so far (watchlist)
+    static std::vector<std::string> GetRequestedSymbols();
+
+    /// This function fetches the stock data with single flight. Concurrent callers for same symbol and interval share
+    /// one in flight fetch, a smaller range waits on in flight superset range and gets trimmed copy
+    /// - Parameters:
+    ///   - symbol: stock symbpl
+    ///   - range: range of stock fetch
+    ///   - interval: interval of stock fetch
+    [[nodiscard("Stock Data can not be discarded")]] static StockData FetchShared(const std::string& symbol, Range range, Interval interval);
+
+    /// This function serves the symbol from replayed data instead of fetches until replay ends. Request of symbol with
+    /// AddStockDataRequest also ends replay
+    /// - Parameters:
+    ///   - symbol: stock symbol
+    ///   - stockData: data with candles replayed so far
+    /// - Returns: revision of replayed data
+    static uint64_t BeginReplay(const std::string& symbol, StockData stockData);
+    /// This function appends the replayed candles to data of symbol and updates its live price
+    /// - Parameters:
+    ///   - symbol: stock symbol
+    ///   - candles: candles to append, in time order
+    ///   - prevClose: close of previous session
+    /// - Returns: false if symbol is not replayed
+    static bool AppendReplayCandles(const std::string& symbol, std::span<const CandleData> candles, double prevClose);
+    /// This function ends the replay of symbol and fetches its live data
+    /// - Parameter symbol: stock symbol
+    static void EndReplay(const std::string& symbol);
+
+    /// This function returns the fetch deduplication statistics
+    static FetchStats GetFetchStats();
+    /// This function returns the fetch worker pool metrics
+    static WorkerPoolMetrics GetWorkerPoolMetrics();
+
   private:
-    /// This is worker loop
+    /// This is worker loop. Schedules due symbols on worker pool
     static void WorkerLoop();
+    /// This function submits the fetch of symbol to worker pool
+    /// - Parameters:
+    ///   - request: stock request. Must be called with s_mutex locked
+    ///   - priority: fetch priority
+    static void ScheduleFetch(StockRequest& request, FetchPriority priority);
 
     /// This function fetch data for stock as fallback, search for .BS if not available in .NS
     /// This function fetch data for stock as fallback, search for .BS if not available in .NS
@@ -60,11 +119,40 @@ namespace KanVest
     ///   - keys: keys
     static std::string FetchStockFallbackData(const std::string& symbol, Range range, Interval interval, const APIKeys& keys);
 
+    /// This function checks if data of superset range contains data of subset range
+    /// - Parameters:
+    ///   - superset: in flight range
+    ///   - subset: requested range
+    static bool RangeCovers(Range superset, Range subset);
+    /// This function returns copy of stock data with candles outside range removed
+    /// - Parameters:
+    ///   - stockData: stock data of superset range
+    ///   - symbol: requested symbol
+    ///   - range: requested range
+    static StockData TrimToRange(const StockData& stockData, const std::string& symbol, Range range);
+    /// This function checks if candles of data extend candles of previous data. Last previous candle may be revised
+    /// - Parameters:
+    ///   - previous: previous data
+    ///   - data: new data
+    static bool ExtendsHistory(const StockData& previous, const StockData& data);
+
+    struct InFlightFetch
+    {
+      Range range;
+      Interval interval;
+      std::shared_future<StockData> result;
+    };
+
     inline static std::unordered_map<std::string, StockRequest> s_stockDataRequests;
+    inline static std::unordered_map<std::string, std::vector<InFlightFetch>> s_inFlightFetches;
+    inline static FetchStats s_fetchStats;
+    inline static std::mutex s_inFlightMutex;
 
     inline static std::mutex s_mutex;
     inline static std::atomic<bool> s_running = false;
     inline static std::thread s_worker;
+    inline static FetchWorkerPool s_workerPool;
     inline static std::atomic<int> s_updateDelayMs = 10;
+    inline static uint64_t s_revision = 0;    //< Last revision given to cached data, guarded by s_mutex
   };
 } // namespace KanVest
@@ -52,6 +52,7 @@ namespace KanVest
     
     // --- Historical Candles ---
     std::vector <CandleData> candleHistory;
+    uint64_t revision = 0;    //< Changes when candles are replaced by ones not extending previous history
 
     bool IsValid() const { return !shortName.empty(); }
   };
@@ -5,15 +5,39 @@
 //  Created by Ashish . on 10/01/26.
 //
 
+#pragma once
+
 #include "Stock/StockMetadata.hpp"
 
 namespace KanVest::Utils
 {
-  /// This function normalize the stock symbol. Adds .NS in stock also convert Nifty as its original symbol
+  /// Benchmark index, fetched with stocks and used for relative strength
+  inline constexpr std::string_view BenchmarkSymbol = "%5ENSEI";   //< NIFTY 50
+
+  /// Separator of series tag in symbol (e.g. TCS|Heikin Ashi), tagged series are derived from candles of base symbol
+  inline constexpr char SeriesTagSeparator = '|';
+
+  /// This function normalize the stock symbol. Adds .NS in stock also convert Nifty as its original symbol. Series tag
+  /// is kept as is after normalized base symbol
   /// - Parameter input: symbol data
   std::string NormalizeSymbol(const std::string& input);
+  /// This function returns the symbol without series tag
+  /// - Parameter symbol: stock symbol
+  std::string GetBaseSymbol(const std::string& symbol);
+  /// This function checks if symbol has series tag
+  /// - Parameter symbol: stock symbol
+  bool HasSeriesTag(const std::string& symbol);
+
+  /// This function copies the stock fields except candle history, so history of destination is not reallocated
+  /// - Parameters:
+  ///   - source: source stock data
+  ///   - destination: destination stock data
+  void CopyStockInfo(const StockData& source, StockData& destination);
   
   /// This function returns the Trading days data only for weekdays
   /// - Parameter history: candle history
   std::vector<CandleData> FilterTradingDays(const std::vector<CandleData>& history);
+  /// This function checks if timestamp falls on weekday (local time)
+  /// - Parameter timestamp: candle timestamp
+  bool IsTradingDay(uint32_t timestamp);
 } // namespace KanVest
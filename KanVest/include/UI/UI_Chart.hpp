@@ -9,8 +9,28 @@
 
 #include "Stock/StockManager.hpp"
 
+#include "Analyzer/BarTransform.hpp"
+#include "Analyzer/Indicators/MovingAverageCache.hpp"
+
 namespace KanVest
 {
+  /// This structure stores the plot columns of shown series. Candles closed since last frame are appended and only
+  /// last (forming) candle is rewritten, columns are rebuilt when series changes
+  struct ChartSeries
+  {
+    std::string symbol, range, interval;
+    uint32_t firstTimestamp = 0;
+    size_t consumed = 0;                //< Closed candles of history processed
+    size_t closedRows = 0;              //< Rows of weekday candles among processed ones
+    CandleData lastConsumed {};         //< Detects revision of closed candles
+
+    double closedLow = DBL_MAX, closedHigh = -DBL_MAX, closedMaxVolume = 1.0;
+    double ymin = DBL_MAX, ymax = -DBL_MAX, maxVolume = 1.0;
+
+    std::vector<CandleData> candles;    //< Weekday candles
+    std::vector<double> xs, opens, highs, lows, closes, volumes;
+  };
+
   class Chart
   {
   public:
@@ -27,7 +47,12 @@ namespace KanVest
       glm::vec4 color = {0.8, 0.4, 0.1, 1.0};
     };
 
+    /// This function syncs the plot columns with stock data
+    /// - Parameter stockData: shown stock data
+    static void SyncSeries(const StockData& stockData);
+
     static void ShowController(const StockData& stockData);
+    static void ShowReplayController();
     
     static void PLotChart(const StockData& stockData);
     static void ComputeCandleWidth(const std::vector<double>& xs);
@@ -36,8 +61,7 @@ namespace KanVest
     static void ShowCandlePlot(const StockData& stockData, const std::vector<double>& xs, const std::vector<double>& closes,
                                const std::vector<double>& opens, const std::vector<double>& highs, const std::vector<double>& lows);
 
-    static void ShowVolumes(const std::vector<double>& xs, const std::vector<double>& volumeY, const std::vector<double>& opens,
-                            const std::vector<double>& closes, double volBottom);
+    static void ShowVolumes(const ChartSeries& series, double volBottom, double volTop);
 
     static void ShowCrossHair(const std::vector<double>& xs, double ymin, double ymax);
     
@@ -48,7 +72,13 @@ namespace KanVest
     static void ShowTooltip(const StockData& stockData, const std::vector<CandleData>& filteredDaysCandles);
 
     static void ShowMAControler(const std::string& title, std::unordered_map<int /* Period */, MovingAverage_UI_Data>& MA_UI_data, int period);
-    static void ShowMAPlot(const MovingAverage_UI_Data& MA_UI_Data, const std::map<int, std::vector<double>>& MA_Data, const std::vector<double> &xs);
+    static void ShowMAPlot(const MovingAverage_UI_Data& MA_UI_Data, MovingAverageType type, const std::vector<double> &xs);
+    static void ShowBollingerControler();
+    static void ShowBollingerPlot(const std::vector<double> &xs);
+    static void ShowVWAPControler();
+    static void ShowVWAPPlot(const std::vector<double> &xs);
+    static void ShowVolumeProfileControler();
+    static void ShowVolumeProfile();
 
     // Stock change cache
     inline static bool s_stockChanged = true;
@@ -59,14 +89,28 @@ namespace KanVest
     // Plot Type
     enum class PlotType {Line, Candle};
     inline static PlotType s_plotType = PlotType::Candle;
+
+    // Bar Type, alternative bars are transformed from time candles and analyzed in their place
+    inline static BarTransformSettings s_barSettings;
+    inline static BarTransformer s_barTransformer;
+    inline static StockData s_barStockData;
+    inline static BarType s_analyzedBarType = BarType::Time;
     
     // Candle Data
     inline static float s_candleWidth = 4.0f;
+    inline static ChartSeries s_series;
+
+    // Visible candles of last frame, replay keeps this width and follows last candle
+    inline static size_t s_visibleBegin = 0, s_visibleEnd = 0;
+    inline static double s_visibleWidth = 0.0;
     
     // Indicator UI Data
-    enum class Indicator {None, DMA, EMA};
+    enum class Indicator {None, DMA, EMA, Bollinger, VWAP, VolumeProfile};
     inline static Indicator s_selectedIndicator = Indicator::None;
     inline static std::unordered_map<int /* Period */, MovingAverage_UI_Data> s_DMA_UI_Data;
     inline static std::unordered_map<int /* Period */, MovingAverage_UI_Data> s_EMA_UI_Data;
+    inline static bool s_showBollinger = false;
+    inline static bool s_showVWAP = false;
+    inline static bool s_showVolumeProfile = false;
   };
 } // namespace KanVest
@@ -0,0 +1,32 @@
+//
+//  UI_Correlation.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/StockMetadata.hpp"
+
+#include "Analyzer/CorrelationEngine.hpp"
+
+namespace KanVest
+{
+  class UI_Correlation
+  {
+  public:
+    /// This function shows the correlation heatmap of watchlist symbols with same interval as stock
+    /// - Parameter stockData: selected stock data
+    static void ShowHeatmap(const StockData& stockData);
+
+  private:
+    inline static CorrelationEngine s_engine;
+    inline static KanViz::Timer s_syncTimer;
+    inline static bool s_syncRequired = true;
+
+    // Axis labels of last synchronized symbols
+    inline static std::vector<std::string> s_labels;
+    inline static std::vector<const char*> s_labelPointers;
+  };
+} // namespace KanVest
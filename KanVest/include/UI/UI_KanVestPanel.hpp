@@ -48,6 +48,9 @@ namespace KanVest::UI
     inline static std::string s_lastRange;
     inline static std::string s_lastInterval;
 
+    // Column heatmap, watchlist correlation or seasonality of selected stock
+    inline static bool s_showSeasonality = false;
+
     // Texture data
     inline static ImTextureID s_shadowTextureID = 0;
   };
@@ -0,0 +1,41 @@
+//
+//  UI_Seasonality.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/StockMetadata.hpp"
+
+#include "Analyzer/Seasonality.hpp"
+
+namespace KanVest
+{
+  class UI_Seasonality
+  {
+  public:
+    /// This function shows the year by month return heatmap and calendar profiles of stock. Only aggregates are read,
+    /// from analyzed stock or from saved file while its history is not fetched
+    /// - Parameter stockData: selected stock data
+    static void ShowHeatmap(const StockData& stockData);
+
+  private:
+    /// This function shows the year by month heatmap
+    /// - Parameter aggregates: seasonality aggregates
+    static void ShowYearMonth(const SeasonalityAggregates& aggregates);
+    /// This function shows the average return of each bucket of group
+    /// - Parameters:
+    ///   - aggregates: seasonality aggregates
+    ///   - group: calendar group
+    static void ShowProfile(const SeasonalityAggregates& aggregates, SeasonalityGroup group);
+
+    // Selected view, Count shows year by month heatmap
+    inline static SeasonalityGroup s_view = SeasonalityGroup::Count;
+
+    // Aggregates loaded from file, reloaded only when series changes
+    inline static SeasonalityAggregates s_stored;
+    inline static std::string s_storedKey;
+  };
+} // namespace KanVest
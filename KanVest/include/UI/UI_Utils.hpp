@@ -7,11 +7,13 @@
 
 #pragma once
 
+#include "Analyzer/ScoreColors.hpp"
+
 namespace KanVest::UI::Utils
 {
-  static ImU32 StockProfitColor = KanVasX::Color::Green;
-  static ImU32 StockLossColor = KanVasX::Color::Red;
-  static ImU32 StockModerateColor = KanVasX::Color::Yellow;
+  static ImU32 StockProfitColor = ScoreColor::Profit;
+  static ImU32 StockLossColor = ScoreColor::Loss;
+  static ImU32 StockModerateColor = ScoreColor::Moderate;
 
   std::string FormatDoubleToString(double value);
   std::string FormatLargeNumber(double value);
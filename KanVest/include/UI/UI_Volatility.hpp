@@ -0,0 +1,21 @@
+//
+//  UI_Volatility.hpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#pragma once
+
+#include "Stock/StockMetadata.hpp"
+
+namespace KanVest
+{
+  class UI_Volatility
+  {
+  public:
+    /// This function shows the ATR, latest value of each volatility estimator and their history
+    /// - Parameter stockData: selected stock data
+    static void ShowVolatility(const StockData& stockData);
+  };
+} // namespace KanVest
@@ -0,0 +1,542 @@
+//
+//  Backtester.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "Backtester.hpp"
+
+#include "Stock/CorporateAction.hpp"
+
+#include "Analyzer/Indicators/StreamingIndicators.hpp"
+#include "Analyzer/Indicators/RollingStatistics.hpp"
+
+#include <latch>
+
+namespace KanVest
+{
+  static constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+  static CandleColumns GetColumns(const StockData& stockData)
+  {
+    if (AdjustmentEngine::HasActions(stockData.symbol))
+    {
+      if (auto adjusted = AdjustmentEngine::GetAdjustedColumns(stockData))
+      {
+        return *adjusted;
+      }
+    }
+
+    CandleColumns columns;
+    columns.Reserve(stockData.candleHistory.size());
+    for (const auto& candle : stockData.candleHistory)
+    {
+      columns.timestamps.push_back(candle.timestamp);
+      columns.opens.push_back(candle.open);
+      columns.highs.push_back(candle.high);
+      columns.lows.push_back(candle.low);
+      columns.closes.push_back(candle.close);
+      columns.volumes.push_back(candle.volume);
+    }
+    return columns;
+  }
+
+  /// This function returns the index of each filter operand in shared operand list, adding missing ones
+  static std::vector<uint32_t> MapOperands(const ScreenerFilter& filter, std::vector<ScreenerOperand>& operands)
+  {
+    std::vector<uint32_t> rows;
+    rows.reserve(filter.GetOperands().size());
+    for (const auto& operand : filter.GetOperands())
+    {
+      auto it = std::find(operands.begin(), operands.end(), operand);
+      if (it == operands.end())
+      {
+        it = operands.insert(operands.end(), operand);
+      }
+      rows.push_back(static_cast<uint32_t>(it - operands.begin()));
+    }
+    return rows;
+  }
+
+  static std::string FormatParameter(double value)
+  {
+    if (value == std::round(value))
+    {
+      return std::to_string(std::llround(value));
+    }
+    std::ostringstream oss;
+    oss << value;
+    return oss.str();
+  }
+
+  // BacktestCostModel -----------------------------------------------------------------------------------------------
+  double BacktestCostModel::GetCharges(double turnover, bool buy) const
+  {
+    const double brokerage = std::min(turnover * brokeragePercent / 100.0, brokerageCap);
+    const double exchange = turnover * exchangePercent / 100.0;
+    const double gst = (brokerage + exchange) * gstPercent / 100.0;
+    const double stt = turnover * sttPercent / 100.0;
+    const double stampDuty = buy ? turnover * stampDutyPercent / 100.0 : 0.0;
+    return brokerage + exchange + gst + stt + stampDuty;
+  }
+
+  // Backtester ------------------------------------------------------------------------------------------------------
+  void Backtester::Initialize(uint32_t threadCount)
+  {
+    IK_PROFILE();
+    s_threads = threadCount ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+    s_workerPool.Start(s_threads);
+  }
+
+  void Backtester::Shutdown()
+  {
+    IK_PROFILE();
+    s_workerPool.Stop();
+  }
+
+  void Backtester::ComputeOperandSeries(const CandleColumns& columns, const std::vector<ScreenerOperand>& operands, IndicatorMatrix& output)
+  {
+    IK_PERFORMANCE_FUNC("Backtester::ComputeOperandSeries");
+    using Type = ScreenerOperand::Type;
+
+    const size_t count = columns.Size();
+    output.Resize(operands.size(), count);
+    std::fill(output.values.begin(), output.values.end(), NaN);
+
+    const double* opens = columns.opens.data();
+    const double* highs = columns.highs.data();
+    const double* lows = columns.lows.data();
+    const double* closes = columns.closes.data();
+
+    // Averages of all periods share one kernel call each
+    std::vector<int> smaPeriods, emaPeriods;
+    std::vector<size_t> smaRows, emaRows;
+    bool needsTrueRange = false;
+    for (size_t row = 0; row < operands.size(); ++row)
+    {
+      if (operands[row].type == Type::SMA)
+      {
+        smaPeriods.push_back(operands[row].period);
+        smaRows.push_back(row);
+      }
+      else if (operands[row].type == Type::EMA)
+      {
+        emaPeriods.push_back(operands[row].period);
+        emaRows.push_back(row);
+      }
+      needsTrueRange |= operands[row].type == Type::ATR;
+    }
+
+    thread_local IndicatorMatrix averages;
+    auto CopyAverages = [&](const std::vector<int>& periods, const std::vector<size_t>& rows) {
+      for (size_t k = 0; k < periods.size(); ++k)
+      {
+        const size_t first = static_cast<size_t>(periods[k]) - 1;
+        if (first < count)
+        {
+          std::copy(averages.Row(k) + first, averages.Row(k) + count, output.Row(rows[k]) + first);
+        }
+      }
+    };
+    if (!smaPeriods.empty())
+    {
+      MovingAverageKernel::ComputeSMA(closes, count, smaPeriods, averages);
+      CopyAverages(smaPeriods, smaRows);
+    }
+    if (!emaPeriods.empty())
+    {
+      MovingAverageKernel::ComputeEMA(closes, count, emaPeriods, averages);
+      CopyAverages(emaPeriods, emaRows);
+    }
+
+    thread_local std::vector<double> trueRange;
+    if (needsTrueRange)
+    {
+      trueRange.resize(count);
+      for (size_t i = 0; i < count; ++i)
+      {
+        trueRange[i] = i == 0 ? highs[i] - lows[i] :
+        std::max({highs[i] - lows[i], std::abs(highs[i] - closes[i - 1]), std::abs(lows[i] - closes[i - 1])});
+      }
+    }
+
+    for (size_t row = 0; row < operands.size(); ++row)
+    {
+      const ScreenerOperand& operand = operands[row];
+      const size_t period = static_cast<size_t>(operand.period);
+      double* out = output.Row(row);
+
+      switch (operand.type)
+      {
+        case Type::Price:
+        case Type::Close:  std::copy(closes, closes + count, out); break;
+        case Type::Open:   std::copy(opens, opens + count, out); break;
+        case Type::High:   std::copy(highs, highs + count, out); break;
+        case Type::Low:    std::copy(lows, lows + count, out); break;
+        case Type::Volume:
+          std::transform(columns.volumes.begin(), columns.volumes.end(), out, [](uint64_t volume) { return static_cast<double>(volume); });
+          break;
+        case Type::Change:
+          for (size_t i = 1; i < count; ++i)
+          {
+            out[i] = closes[i - 1] != 0.0 ? (closes[i] / closes[i - 1] - 1.0) * 100.0 : NaN;
+          }
+          break;
+        case Type::RSI:
+        {
+          StreamingRSI rsi(period);
+          for (size_t i = 0; i < count; ++i)
+          {
+            out[i] = rsi.Append(closes[i]);
+          }
+          break;
+        }
+        case Type::ATR:
+        {
+          // Wilder smoothing seeded with average of first period true ranges, same as screener
+          if (count < period)
+          {
+            break;
+          }
+          double atr = std::accumulate(trueRange.begin(), trueRange.begin() + static_cast<std::ptrdiff_t>(period), 0.0) / period;
+          out[period - 1] = atr;
+          for (size_t i = period; i < count; ++i)
+          {
+            atr = (atr * (period - 1) + trueRange[i]) / period;
+            out[i] = atr;
+          }
+          break;
+        }
+        case Type::HighestHigh:
+        case Type::LowestLow:
+        {
+          if (operand.type == Type::HighestHigh)
+          {
+            RollingStatistics::ComputeMaximum(highs, count, period, out);
+          }
+          else
+          {
+            RollingStatistics::ComputeMinimum(lows, count, period, out);
+          }
+          break;
+        }
+        case Type::AverageVolume:
+        {
+          double sum = 0.0;
+          for (size_t i = 0; i < count; ++i)
+          {
+            sum += static_cast<double>(columns.volumes[i]);
+            if (i >= period)
+            {
+              sum -= static_cast<double>(columns.volumes[i - period]);
+            }
+            if (i + 1 >= period)
+            {
+              out[i] = sum / static_cast<double>(period);
+            }
+          }
+          break;
+        }
+        case Type::SMA:
+        case Type::EMA:
+          break;
+      }
+    }
+  }
+
+  BacktestMetrics Backtester::Simulate(const CandleColumns& columns, const IndicatorMatrix& series, const ScreenerFilter& entry, const ScreenerFilter& exit,
+                                       const std::vector<uint32_t>& entryRows, const std::vector<uint32_t>& exitRows, const BacktestSettings& settings,
+                                       std::vector<double>* equity, std::vector<BacktestTrade>* trades)
+  {
+    enum class Order {None, Buy, Sell};
+
+    const size_t count = columns.Size();
+    const double slippage = settings.costs.slippageBps / 10000.0;
+
+    BacktestMetrics metrics;
+    metrics.finalEquity = settings.initialCapital;
+    if (equity)
+    {
+      equity->clear();
+      equity->reserve(count);
+    }
+
+    double cash = settings.initialCapital;
+    uint64_t quantity = 0;
+    Order order = Order::None;
+    BacktestTrade openTrade;
+    double openCharges = 0.0;
+    size_t wins = 0;
+
+    // Drawdown and return statistics are accumulated per bar, so sweep needs no equity curve
+    double peak = settings.initialCapital, previousEquity = settings.initialCapital;
+    double meanReturn = 0.0, returnM2 = 0.0;
+    size_t returns = 0;
+
+    double values[ScreenerFilter::MaxOperands];
+    for (size_t i = 0; i < count; ++i)
+    {
+      // Order of previous close is filled at open
+      if (order == Order::Buy)
+      {
+        const double price = columns.opens[i] * (1.0 + slippage);
+        const double budget = cash * settings.positionFraction;
+        const double chargeRate = budget > 0.0 ? settings.costs.GetCharges(budget, true) / budget : 0.0;
+
+        auto shares = static_cast<uint64_t>(std::max(0.0, std::floor(budget / (price * (1.0 + chargeRate)))));
+        double charges = settings.costs.GetCharges(shares * price, true);
+        while (shares > 0 and shares * price + charges > cash)
+        {
+          shares--;
+          charges = settings.costs.GetCharges(shares * price, true);
+        }
+
+        if (shares > 0)
+        {
+          cash -= shares * price + charges;
+          quantity = shares;
+          openTrade = {columns.timestamps[i], 0, price, 0.0, shares, 0.0};
+          openCharges = charges;
+          metrics.charges += charges;
+        }
+      }
+      else if (order == Order::Sell)
+      {
+        const double price = columns.opens[i] * (1.0 - slippage);
+        const double turnover = quantity * price;
+        const double charges = settings.costs.GetCharges(turnover, false);
+        cash += turnover - charges;
+        metrics.charges += charges;
+
+        openTrade.exitTimestamp = columns.timestamps[i];
+        openTrade.exitPrice = price;
+        openTrade.pnl = turnover - charges - (openTrade.entryPrice * quantity + openCharges);
+        wins += openTrade.pnl > 0.0;
+        metrics.trades++;
+        if (trades)
+        {
+          trades->push_back(openTrade);
+        }
+        quantity = 0;
+      }
+      order = Order::None;
+
+      const double currentEquity = cash + quantity * columns.closes[i];
+      if (equity)
+      {
+        equity->push_back(currentEquity);
+      }
+
+      peak = std::max(peak, currentEquity);
+      metrics.maxDrawdownPercent = std::max(metrics.maxDrawdownPercent, peak > 0.0 ? 100.0 * (peak - currentEquity) / peak : 0.0);
+
+      const double barReturn = previousEquity > 0.0 ? currentEquity / previousEquity - 1.0 : 0.0;
+      returns++;
+      const double delta = barReturn - meanReturn;
+      meanReturn += delta / returns;
+      returnM2 += delta * (barReturn - meanReturn);
+      previousEquity = currentEquity;
+      metrics.finalEquity = currentEquity;
+
+      // Signal at close, last bar has no next open to fill
+      if (i + 1 == count)
+      {
+        break;
+      }
+      const ScreenerFilter& filter = quantity ? exit : entry;
+      const std::vector<uint32_t>& rows = quantity ? exitRows : entryRows;
+      for (size_t k = 0; k < rows.size(); ++k)
+      {
+        values[k] = series.At(rows[k], i);
+      }
+      if (filter.Evaluate(values))
+      {
+        order = quantity ? Order::Sell : Order::Buy;
+      }
+    }
+
+    metrics.totalReturnPercent = settings.initialCapital > 0.0 ? 100.0 * (metrics.finalEquity / settings.initialCapital - 1.0) : 0.0;
+    metrics.winRatePercent = metrics.trades ? 100.0 * wins / metrics.trades : 0.0;
+
+    // Bars per year from calendar span, so intraday and daily intervals annualize alike
+    if (count > 2 and returnM2 > 0.0)
+    {
+      const double years = (columns.timestamps.back() - columns.timestamps.front()) / (365.25 * 86400.0);
+      const double barsPerYear = years > 0.0 ? (count - 1) / years : 0.0;
+      metrics.sharpe = meanReturn / std::sqrt(returnM2 / (returns - 1)) * std::sqrt(barsPerYear);
+    }
+    return metrics;
+  }
+
+  BacktestResult Backtester::Run(const StockData& stockData, const std::string& entry, const std::string& exit, const BacktestSettings& settings)
+  {
+    IK_PERFORMANCE_FUNC("Backtester::Run");
+
+    BacktestResult result;
+    const ScreenerFilter entryFilter = ScreenerFilter::Compile(entry);
+    const ScreenerFilter exitFilter = ScreenerFilter::Compile(exit);
+    if (!entryFilter.IsValid() or !exitFilter.IsValid())
+    {
+      result.error = !entryFilter.IsValid() ? "Entry : " + entryFilter.GetError() : "Exit : " + exitFilter.GetError();
+      return result;
+    }
+
+    KanViz::Timer timer;
+    const CandleColumns columns = GetColumns(stockData);
+
+    std::vector<ScreenerOperand> operands;
+    const std::vector<uint32_t> entryRows = MapOperands(entryFilter, operands);
+    const std::vector<uint32_t> exitRows = MapOperands(exitFilter, operands);
+
+    IndicatorMatrix series;
+    ComputeOperandSeries(columns, operands, series);
+    result.stats.indicatorMs = timer.ElapsedMilliseconds();
+
+    result.metrics = Simulate(columns, series, entryFilter, exitFilter, entryRows, exitRows, settings, &result.equity, &result.trades);
+
+    result.stats.simulatedBars = columns.Size();
+    result.stats.threads = 1;
+    result.stats.elapsedMs = timer.ElapsedMilliseconds();
+    return result;
+  }
+
+  BacktestSweepResult Backtester::Sweep(const StockData& stockData, const std::string& entry, const std::string& exit,
+                                        const std::vector<BacktestParameter>& parameters, const BacktestSettings& settings)
+  {
+    IK_PERFORMANCE_FUNC("Backtester::Sweep");
+
+    BacktestSweepResult result;
+    KanViz::Timer timer;
+
+    // Values of each parameter
+    std::vector<std::vector<double>> parameterValues;
+    size_t combinationCount = 1;
+    for (const auto& parameter : parameters)
+    {
+      if (parameter.step <= 0.0 or parameter.last < parameter.first)
+      {
+        result.error = "Invalid range of parameter " + parameter.name;
+        return result;
+      }
+
+      auto& values = parameterValues.emplace_back();
+      for (double value = parameter.first; value <= parameter.last + parameter.step * 1e-9; value += parameter.step)
+      {
+        values.push_back(value);
+      }
+      combinationCount *= values.size();
+      if (combinationCount > MaxCombinations)
+      {
+        result.error = "Too many parameter combinations";
+        return result;
+      }
+    }
+
+    // Compile every combination, operands of all combinations are collected in one shared list
+    struct Strategy
+    {
+      std::vector<double> parameters;
+      ScreenerFilter entry, exit;
+      std::vector<uint32_t> entryRows, exitRows;
+    };
+    std::vector<Strategy> strategies(combinationCount);
+    std::vector<ScreenerOperand> operands;
+
+    for (size_t index = 0; index < combinationCount; ++index)
+    {
+      Strategy& strategy = strategies[index];
+      std::string entryText = entry, exitText = exit;
+
+      // Mixed radix decode of combination index, last parameter changes fastest
+      size_t remainder = index;
+      strategy.parameters.resize(parameters.size());
+      for (size_t p = parameters.size(); p-- > 0;)
+      {
+        const double value = parameterValues[p][remainder % parameterValues[p].size()];
+        remainder /= parameterValues[p].size();
+        strategy.parameters[p] = value;
+
+        const std::string placeholder = "{" + parameters[p].name + "}";
+        const std::string text = FormatParameter(value);
+        for (std::string* expression : {&entryText, &exitText})
+        {
+          for (size_t position = expression->find(placeholder); position != std::string::npos; position = expression->find(placeholder, position + text.size()))
+          {
+            expression->replace(position, placeholder.size(), text);
+          }
+        }
+      }
+
+      strategy.entry = ScreenerFilter::Compile(entryText);
+      strategy.exit = ScreenerFilter::Compile(exitText);
+      if (!strategy.entry.IsValid() or !strategy.exit.IsValid())
+      {
+        result.error = !strategy.entry.IsValid() ? "Entry '" + entryText + "' : " + strategy.entry.GetError() :
+        "Exit '" + exitText + "' : " + strategy.exit.GetError();
+        return result;
+      }
+      strategy.entryRows = MapOperands(strategy.entry, operands);
+      strategy.exitRows = MapOperands(strategy.exit, operands);
+    }
+
+    // Shared intermediates : every distinct operand series is computed once for all combinations
+    const CandleColumns columns = GetColumns(stockData);
+    IndicatorMatrix series;
+    ComputeOperandSeries(columns, operands, series);
+    result.stats.indicatorMs = timer.ElapsedMilliseconds();
+
+    result.combinations.resize(combinationCount);
+    static constexpr size_t BlockSize = 16;
+    const size_t blockCount = (combinationCount + BlockSize - 1) / BlockSize;
+
+    auto SimulateBlock = [&](size_t block) {
+      const size_t last = std::min(combinationCount, (block + 1) * BlockSize);
+      for (size_t index = block * BlockSize; index < last; ++index)
+      {
+        const Strategy& strategy = strategies[index];
+        result.combinations[index].parameters = strategy.parameters;
+        result.combinations[index].metrics = Simulate(columns, series, strategy.entry, strategy.exit, strategy.entryRows, strategy.exitRows,
+                                                      settings, nullptr, nullptr);
+      }
+    };
+
+    // Same scheduling as screener : blocks are claimed from shared counter, late helper finds nothing to do
+    struct SharedState
+    {
+      std::atomic<size_t> nextBlock = 0;
+      std::latch done;
+      explicit SharedState(size_t count) : done(static_cast<std::ptrdiff_t>(count)) {}
+    };
+    auto state = std::make_shared<SharedState>(blockCount);
+
+    std::function<void()> ClaimBlocks = [state, blockCount, &SimulateBlock]() {
+      for (size_t block = state->nextBlock++; block < blockCount; block = state->nextBlock++)
+      {
+        SimulateBlock(block);
+        state->done.count_down();
+      }
+    };
+
+    uint32_t helpers = 0;
+    if (s_workerPool.IsRunning() and blockCount > 1)
+    {
+      const size_t helperCount = std::min<size_t>(s_threads, blockCount - 1);
+      for (size_t i = 0; i < helperCount; ++i)
+      {
+        helpers += s_workerPool.Submit(FetchPriority::Background, ClaimBlocks) ? 1 : 0;
+      }
+    }
+    ClaimBlocks();
+    state->done.wait();
+
+    std::stable_sort(result.combinations.begin(), result.combinations.end(), [](const auto& a, const auto& b) {
+      return a.metrics.totalReturnPercent > b.metrics.totalReturnPercent;
+    });
+
+    result.stats.simulatedBars = static_cast<uint64_t>(combinationCount) * columns.Size();
+    result.stats.threads = helpers + 1;
+    result.stats.elapsedMs = timer.ElapsedMilliseconds();
+    return result;
+  }
+} // namespace KanVest
@@ -0,0 +1,195 @@
+//
+//  BarReplay.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "BarReplay.hpp"
+
+#include "Stock/StockManager.hpp"
+#include "Stock/StockUtils.hpp"
+
+#include "Analyzer/StockAnalyzer.hpp"
+#include "Analyzer/MultiTimeframe.hpp"
+
+namespace KanVest
+{
+  // Frame after a stall (e.g. window drag) does not flush the series at once
+  static constexpr double MaxFrameSeconds = 0.25;
+
+  /// This function returns the close of session before candle, 0 if candle is in first session
+  static double GetPrevClose(const std::vector<CandleData>& history, size_t index)
+  {
+    const int64_t day = MultiTimeframeAnalyzer::GetBucket(Timeframe::Day1, history[index].timestamp);
+    for (size_t i = index; i > 0; --i)
+    {
+      if (MultiTimeframeAnalyzer::GetBucket(Timeframe::Day1, history[i - 1].timestamp) != day)
+      {
+        return history[i - 1].close;
+      }
+    }
+    return 0.0;
+  }
+
+  /// This function sets the live price of replayed data from its last candle, same as stock manager does on append
+  static void SetQuote(StockData& data, double prevClose)
+  {
+    const CandleData& last = data.candleHistory.back();
+    data.prevClose = prevClose;
+    data.livePrice = last.close;
+    data.change = data.livePrice - data.prevClose;
+    data.changePercent = data.prevClose > 0.0 ? data.change / data.prevClose * 100.0 : 0.0;
+    data.volume = last.volume;
+  }
+
+  bool BarReplay::Start(const StockData& source, size_t start)
+  {
+    IK_PERFORMANCE_FUNC("BarReplay::Start");
+
+    if (s_active)
+    {
+      Stop();
+    }
+    if (!source.IsValid() or source.candleHistory.size() < 2)
+    {
+      return false;
+    }
+
+    s_source = source;
+    const auto& history = s_source.candleHistory;
+    start = std::clamp<size_t>(start, 1, history.size() - 1);
+
+    // Replayed data starts as stored data cut at start. Replay keeps its own copy in step with stock manager, so
+    // frames analyze it in place instead of copying whole data out of manager
+    Utils::CopyStockInfo(s_source, s_replayData);
+    s_replayData.candleHistory.assign(history.begin(), history.begin() + static_cast<std::ptrdiff_t>(start));
+    s_replayData.candleHistory.reserve(history.size());
+
+    s_prevClose = GetPrevClose(history, start - 1);
+    SetQuote(s_replayData, s_prevClose);
+
+    s_replayData.revision = StockManager::BeginReplay(s_source.symbol, s_replayData);
+    Analyzer::AnalzeStock(s_replayData);
+
+    s_active = true;
+    s_playing = false;
+    s_pendingBars = 0.0;
+    s_stats = {};
+    s_stats.position = start;
+    s_stats.total = history.size();
+    s_windowFrames = s_windowBars = 0;
+    s_windowFrameMs = s_windowMaxFrameMs = s_totalUpdateMs = 0.0;
+    s_frameTimer.Reset();
+    s_windowTimer.Reset();
+
+    IK_LOG_INFO("BarReplay", "Replay {0} ({1}) from candle {2} of {3}", s_source.symbol, s_source.dataGranularity, start, history.size());
+    return true;
+  }
+
+  void BarReplay::Stop()
+  {
+    if (!s_active)
+    {
+      return;
+    }
+
+    IK_LOG_INFO("BarReplay", "Replayed {0} candles of {1} | {2:.2f} us per candle | frame {3:.2f} ms (max {4:.2f} ms)", s_stats.barsReplayed,
+                s_source.symbol, s_stats.updateUsPerBar, s_stats.frameMs, s_stats.maxFrameMs);
+
+    StockManager::EndReplay(s_source.symbol);
+    s_active = false;
+    s_playing = false;
+    s_replayData = {};
+  }
+
+  size_t BarReplay::Update()
+  {
+    if (!s_active)
+    {
+      return 0;
+    }
+
+    // Frame time statistics over one second windows
+    const double frameMs = s_frameTimer.ElapsedMilliseconds();
+    s_frameTimer.Reset();
+    s_windowFrames++;
+    s_windowFrameMs += frameMs;
+    s_windowMaxFrameMs = std::max(s_windowMaxFrameMs, frameMs);
+    if (const double windowSeconds = s_windowTimer.ElapsedSeconds(); windowSeconds >= 1.0)
+    {
+      s_stats.frameMs = s_windowFrameMs / static_cast<double>(s_windowFrames);
+      s_stats.maxFrameMs = s_windowMaxFrameMs;
+      s_stats.barsPerSecond = static_cast<double>(s_windowBars) / windowSeconds;
+      s_windowFrames = s_windowBars = 0;
+      s_windowFrameMs = s_windowMaxFrameMs = 0.0;
+      s_windowTimer.Reset();
+    }
+
+    if (!s_playing)
+    {
+      return 0;
+    }
+
+    // Candles due in this frame, fraction carried to next one
+    s_pendingBars += std::min(frameMs / 1000.0, MaxFrameSeconds) * s_speed;
+    const size_t bars = static_cast<size_t>(s_pendingBars);
+    s_pendingBars -= static_cast<double>(bars);
+    return Advance(bars);
+  }
+
+  size_t BarReplay::Step(size_t bars)
+  {
+    return s_active ? Advance(bars) : 0;
+  }
+
+  size_t BarReplay::Advance(size_t bars)
+  {
+    const auto& history = s_source.candleHistory;
+    bars = std::min(bars, history.size() - s_stats.position);
+    if (bars == 0)
+    {
+      // End of series, last candle stays shown
+      s_playing = false;
+      return 0;
+    }
+
+    IK_PERFORMANCE_FUNC("BarReplay::Advance");
+    KanViz::Timer timer;
+
+    // New session moves previous close
+    const size_t begin = s_stats.position, end = begin + bars;
+    for (size_t i = std::max<size_t>(begin, 1); i < end; ++i)
+    {
+      if (MultiTimeframeAnalyzer::GetBucket(Timeframe::Day1, history[i].timestamp) != MultiTimeframeAnalyzer::GetBucket(Timeframe::Day1, history[i - 1].timestamp))
+      {
+        s_prevClose = history[i - 1].close;
+      }
+    }
+
+    // Request of symbol replaced replay (e.g. range changed)
+    if (!StockManager::AppendReplayCandles(s_source.symbol, {history.data() + begin, bars}, s_prevClose))
+    {
+      s_active = false;
+      s_playing = false;
+      s_replayData = {};
+      return 0;
+    }
+    s_stats.position = end;
+
+    s_replayData.candleHistory.insert(s_replayData.candleHistory.end(), history.begin() + static_cast<std::ptrdiff_t>(begin),
+                                      history.begin() + static_cast<std::ptrdiff_t>(end));
+    SetQuote(s_replayData, s_prevClose);
+
+    // All candles of frame analyzed at once by reference, analysis advances by them only
+    Analyzer::AnalzeStock(s_replayData);
+
+    s_stats.lastUpdateMs = timer.ElapsedMilliseconds();
+    s_totalUpdateMs += s_stats.lastUpdateMs;
+    s_stats.barsReplayed += bars;
+    s_stats.updates++;
+    s_stats.updateUsPerBar = s_totalUpdateMs * 1000.0 / static_cast<double>(s_stats.barsReplayed);
+    s_windowBars += bars;
+    return bars;
+  }
+} // namespace KanVest
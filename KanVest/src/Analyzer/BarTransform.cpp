@@ -0,0 +1,390 @@
+//
+//  BarTransform.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "BarTransform.hpp"
+
+#include "Stock/StockUtils.hpp"
+
+namespace KanVest
+{
+  // Tolerance of Renko level comparison in boxes, so close exactly at brick edge is not lost to rounding
+  static constexpr double LevelEpsilon = 1e-9;
+
+  static CandleData MakeBar(uint32_t timestamp, double open, double high, double low, double close, uint64_t volume)
+  {
+    CandleData bar {};
+    bar.open = open;
+    bar.high = high;
+    bar.low = low;
+    bar.close = close;
+    bar.range = high - low;
+    bar.volume = static_cast<uint32_t>(std::min<uint64_t>(volume, std::numeric_limits<uint32_t>::max()));
+    bar.timestamp = timestamp;
+    return bar;
+  }
+
+  static bool IsSameCandle(const CandleData& a, const CandleData& b)
+  {
+    return a.timestamp == b.timestamp and a.open == b.open and a.high == b.high and a.low == b.low and a.close == b.close and a.volume == b.volume;
+  }
+
+  void BarTransformer::SetSettings(const BarTransformSettings& settings)
+  {
+    if (settings == m_settings)
+    {
+      return;
+    }
+    m_settings = settings;
+    m_settings.candlesPerBar = std::max<size_t>(1, m_settings.candlesPerBar);
+    m_dirty = true;
+  }
+
+  size_t BarTransformer::Sync(const StockData& data)
+  {
+    IK_PERFORMANCE_FUNC("BarTransformer::Sync");
+    KanViz::Timer timer;
+
+    const auto& history = data.candleHistory;
+    const size_t n = history.size(), m = m_inputs;
+
+    // Candles before forming one are final, revision of them rebuilds
+    const bool sameSeries = !m_dirty and m > 0 and n >= m and m_symbol == data.symbol and m_range == data.range and m_granularity == data.dataGranularity
+    and data.revision == m_baseRevision and history.front().timestamp == m_firstTimestamp and history[m - 1].timestamp == m_lastInput.timestamp
+    and (m < 2 or IsSameCandle(history[m - 2], m_previousInput));
+
+    if (!sameSeries)
+    {
+      m_symbol = data.symbol;
+      m_range = data.range;
+      m_granularity = data.dataGranularity;
+      m_baseRevision = data.revision;
+      m_revision++;
+      Rebuild(history);
+      return n;
+    }
+
+    size_t processed = 0;
+    if (!IsSameCandle(history[m - 1], m_lastInput))
+    {
+      UpdateLast(history[m - 1]);
+      processed++;
+    }
+    for (size_t i = m; i < n; ++i)
+    {
+      Append(history[i]);
+      processed++;
+    }
+
+    m_stats.inputBars = m_inputs;
+    m_stats.outputBars = m_bars.Size();
+    m_stats.lastUpdateUs = timer.ElapsedMicroseconds();
+    return processed;
+  }
+
+  void BarTransformer::Rebuild(const std::vector<CandleData>& history)
+  {
+    IK_PERFORMANCE_FUNC("BarTransformer::Rebuild");
+    KanViz::Timer timer;
+
+    m_dirty = false;
+    m_inputs = 0;
+    m_firstTimestamp = history.empty() ? 0 : history.front().timestamp;
+    m_previousInput = {};
+    m_lastInput = {};
+    m_state = {};
+    m_checkpoint = {};
+    m_bars.Clear();
+    m_firstChangedBar = 0;
+    m_bars.Reserve(history.size());
+
+    // Box size is fixed for whole series, so appended candles never move earlier bricks
+    const bool usesBox = m_settings.type == BarType::Renko or m_settings.type == BarType::Range;
+    m_boxSize = !usesBox ? TickSize : m_settings.boxSize > 0.0 ? m_settings.boxSize : ComputeBoxSize(history, m_settings.atrPeriod, m_settings.atrMultiple);
+
+    for (const auto& candle : history)
+    {
+      Append(candle);
+    }
+
+    m_stats.inputBars = m_inputs;
+    m_stats.outputBars = m_bars.Size();
+    m_stats.rebuildMs = timer.ElapsedMilliseconds();
+    IK_LOG_DEBUG("BarTransform", "{0} {1} : {2} candles -> {3} bars in {4:.3f} ms", m_symbol, GetName(m_settings.type), m_stats.inputBars,
+                 m_stats.outputBars, m_stats.rebuildMs);
+  }
+
+  void BarTransformer::Append(const CandleData& candle)
+  {
+    if (m_inputs == 0)
+    {
+      m_firstTimestamp = candle.timestamp;
+    }
+
+    // State before the candle, forming candle update restarts from here
+    m_checkpoint = m_state;
+    m_checkpoint.bars = m_bars.Size();
+    m_checkpoint.lastBar = GetLastBar();
+
+    Process(candle);
+    m_previousInput = m_lastInput;
+    m_lastInput = candle;
+    m_inputs++;
+  }
+
+  void BarTransformer::UpdateLast(const CandleData& candle)
+  {
+    if (m_inputs == 0)
+    {
+      Append(candle);
+      return;
+    }
+    Restore(m_checkpoint);
+    Process(candle);
+    m_lastInput = candle;
+  }
+
+  void BarTransformer::Restore(const State& state)
+  {
+    // Bars after checkpoint are dropped, last bar is changed only if candle updated it in place
+    m_firstChangedBar = std::min(m_firstChangedBar, state.bars);
+    m_bars.timestamps.resize(state.bars);
+    m_bars.opens.resize(state.bars);
+    m_bars.highs.resize(state.bars);
+    m_bars.lows.resize(state.bars);
+    m_bars.closes.resize(state.bars);
+    m_bars.volumes.resize(state.bars);
+    if (state.bars > 0 and !IsSameCandle(GetLastBar(), state.lastBar))
+    {
+      SetLastBar(state.lastBar);
+    }
+    m_state = state;
+  }
+
+  void BarTransformer::Process(const CandleData& candle)
+  {
+    switch (m_settings.type)
+    {
+      case BarType::Time:
+        PushBar(candle);
+        break;
+
+      case BarType::HeikinAshi:
+      {
+        const double haClose = (candle.open + candle.high + candle.low + candle.close) / 4.0;
+        const double haOpen = m_state.started ? (m_state.haOpen + m_state.haClose) / 2.0 : (candle.open + candle.close) / 2.0;
+        PushBar(MakeBar(candle.timestamp, haOpen, std::max({candle.high, haOpen, haClose}), std::min({candle.low, haOpen, haClose}), haClose, candle.volume));
+        m_state.haOpen = haOpen;
+        m_state.haClose = haClose;
+        m_state.started = true;
+        break;
+      }
+
+      case BarType::Renko:
+        ProcessRenko(candle);
+        break;
+
+      case BarType::Range:
+        ProcessRange(candle);
+        break;
+
+      case BarType::CandleCount:
+        if (m_state.formingCandles == 0 or m_state.formingCandles >= m_settings.candlesPerBar)
+        {
+          PushBar(candle);
+          m_state.formingCandles = 1;
+        }
+        else
+        {
+          CandleData bar = GetLastBar();
+          bar = MakeBar(bar.timestamp, bar.open, std::max(bar.high, candle.high), std::min(bar.low, candle.low), candle.close,
+                        static_cast<uint64_t>(m_bars.volumes.back()) + candle.volume);
+          SetLastBar(bar);
+          m_state.formingCandles++;
+        }
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  void BarTransformer::ProcessRenko(const CandleData& candle)
+  {
+    // Levels are whole boxes, so brick edges never drift with repeated additions
+    const double level = candle.close / m_boxSize;
+    if (!m_state.started)
+    {
+      m_state.brickTop = m_state.brickBottom = std::llround(level);
+      m_state.started = true;
+    }
+
+    // Volume since last brick goes to next brick
+    m_state.pendingVolume += candle.volume;
+    auto PushBrick = [this, &candle](int64_t from, int64_t to) {
+      const double open = static_cast<double>(from) * m_boxSize, close = static_cast<double>(to) * m_boxSize;
+      PushBar(MakeBar(candle.timestamp, open, std::max(open, close), std::min(open, close), close, m_state.pendingVolume));
+      m_state.pendingVolume = 0;
+    };
+
+    while (level >= static_cast<double>(m_state.brickTop + 1) - LevelEpsilon)
+    {
+      PushBrick(m_state.brickTop, m_state.brickTop + 1);
+      m_state.brickBottom = m_state.brickTop++;
+    }
+    while (level <= static_cast<double>(m_state.brickBottom - 1) + LevelEpsilon)
+    {
+      PushBrick(m_state.brickBottom, m_state.brickBottom - 1);
+      m_state.brickTop = m_state.brickBottom--;
+    }
+  }
+
+  void BarTransformer::ProcessRange(const CandleData& candle)
+  {
+    const size_t firstBar = m_bars.Size() > 0 ? m_bars.Size() - 1 : 0;
+
+    // Path inside candle visits the extreme nearer to open first
+    const bool rising = candle.close >= candle.open;
+    const double path[] = {candle.open, rising ? candle.low : candle.high, rising ? candle.high : candle.low, candle.close};
+    for (double price : path)
+    {
+      if (!m_state.started)
+      {
+        PushBar(MakeBar(candle.timestamp, price, price, price, price, 0));
+        m_state.started = true;
+        continue;
+      }
+
+      // Close bar at range edge, next bar opens at its close
+      CandleData bar = GetLastBar();
+      while (price > bar.low + m_boxSize)
+      {
+        bar.high = bar.close = bar.low + m_boxSize;
+        SetLastBar(bar);
+        bar = MakeBar(candle.timestamp, bar.close, bar.close, bar.close, bar.close, 0);
+        PushBar(bar);
+      }
+      while (price < bar.high - m_boxSize)
+      {
+        bar.low = bar.close = bar.high - m_boxSize;
+        SetLastBar(bar);
+        bar = MakeBar(candle.timestamp, bar.close, bar.close, bar.close, bar.close, 0);
+        PushBar(bar);
+      }
+      bar.high = std::max(bar.high, price);
+      bar.low = std::min(bar.low, price);
+      bar.close = price;
+      SetLastBar(bar);
+    }
+
+    // Candle volume is shared by bars it touched, remainder to last
+    m_firstChangedBar = std::min(m_firstChangedBar, firstBar);
+    const uint64_t touched = m_bars.Size() - firstBar;
+    for (size_t i = firstBar; i < m_bars.Size(); ++i)
+    {
+      m_bars.volumes[i] += candle.volume / touched;
+    }
+    m_bars.volumes.back() += candle.volume % touched;
+  }
+
+  void BarTransformer::PushBar(const CandleData& bar)
+  {
+    m_firstChangedBar = std::min(m_firstChangedBar, m_bars.Size());
+    m_bars.timestamps.push_back(bar.timestamp);
+    m_bars.opens.push_back(bar.open);
+    m_bars.highs.push_back(bar.high);
+    m_bars.lows.push_back(bar.low);
+    m_bars.closes.push_back(bar.close);
+    m_bars.volumes.push_back(bar.volume);
+  }
+
+  void BarTransformer::SetLastBar(const CandleData& bar)
+  {
+    m_firstChangedBar = std::min(m_firstChangedBar, m_bars.Size() - 1);
+    m_bars.timestamps.back() = bar.timestamp;
+    m_bars.opens.back() = bar.open;
+    m_bars.highs.back() = bar.high;
+    m_bars.lows.back() = bar.low;
+    m_bars.closes.back() = bar.close;
+    m_bars.volumes.back() = bar.volume;
+  }
+
+  CandleData BarTransformer::GetLastBar() const
+  {
+    if (m_bars.Size() == 0)
+    {
+      return {};
+    }
+    return MakeBar(m_bars.timestamps.back(), m_bars.opens.back(), m_bars.highs.back(), m_bars.lows.back(), m_bars.closes.back(), m_bars.volumes.back());
+  }
+
+  size_t BarTransformer::ToStockData(const StockData& base, StockData& output)
+  {
+    IK_PERFORMANCE_FUNC("BarTransformer::ToStockData");
+
+    std::string symbol = base.symbol;
+    if (m_settings.type != BarType::Time)
+    {
+      symbol += Utils::SeriesTagSeparator + std::string(GetName(m_settings.type));
+    }
+
+    // Bars before first changed one are same as given out by previous call, if output is that series
+    const size_t count = m_bars.Size();
+    const size_t given = output.candleHistory.size();
+    const bool sameOutput = output.symbol == symbol and output.revision == m_revision and m_firstChangedBar <= given;
+    const size_t first = sameOutput ? m_firstChangedBar : 0;
+
+    // Bar before last one given out changed, so history does not only extend previous one
+    if (sameOutput and (first + 1 < given or count < given))
+    {
+      m_revision++;
+    }
+
+    Utils::CopyStockInfo(base, output);
+    output.symbol = std::move(symbol);
+    output.revision = m_revision;
+
+    output.candleHistory.resize(count);
+    for (size_t i = first; i < count; ++i)
+    {
+      output.candleHistory[i] = MakeBar(m_bars.timestamps[i], m_bars.opens[i], m_bars.highs[i], m_bars.lows[i], m_bars.closes[i], m_bars.volumes[i]);
+    }
+    m_firstChangedBar = count;
+    return count - first;
+  }
+
+  double BarTransformer::ComputeBoxSize(const std::vector<CandleData>& history, size_t period, double multiple)
+  {
+    if (history.empty())
+    {
+      return TickSize;
+    }
+
+    // Wilder ATR seeded with average of first period true ranges, same as indicator graph
+    period = std::max<size_t>(1, period);
+    double atr = 0.0;
+    for (size_t i = 0; i < history.size(); ++i)
+    {
+      const double trueRange = i == 0 ? history[i].high - history[i].low :
+      std::max({history[i].high - history[i].low, std::abs(history[i].high - history[i - 1].close), std::abs(history[i].low - history[i - 1].close)});
+      atr = i < period ? atr + (trueRange - atr) / static_cast<double>(i + 1) : (atr * static_cast<double>(period - 1) + trueRange) / static_cast<double>(period);
+    }
+    return std::max(TickSize, std::round(atr * multiple / TickSize) * TickSize);
+  }
+
+  std::string_view BarTransformer::GetName(BarType type)
+  {
+    switch (type)
+    {
+      case BarType::Time:        return "Time";
+      case BarType::HeikinAshi:  return "Heikin Ashi";
+      case BarType::Renko:       return "Renko";
+      case BarType::Range:       return "Range";
+      case BarType::CandleCount: return "Candle Count";
+      default: return "";
+    }
+  }
+} // namespace KanVest
@@ -0,0 +1,360 @@
+//
+//  CorrelationEngine.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "CorrelationEngine.hpp"
+
+namespace KanVest
+{
+  static double LogReturn(double previousClose, double close)
+  {
+    return previousClose > 0.0 and close > 0.0 ? std::log(close / previousClose) : 0.0;
+  }
+
+  void CorrelationEngine::SetWindow(size_t window)
+  {
+    m_window = std::max<size_t>(window, 2);
+    Reset({}, {});
+  }
+
+  bool CorrelationEngine::Sync(const std::vector<StockData>& stocks)
+  {
+    IK_PERFORMANCE_FUNC("CorrelationEngine::Sync");
+
+    std::vector<const StockData*> valid;
+    std::vector<std::string> symbols;
+    for (const auto& stock : stocks)
+    {
+      if (stock.IsValid() and stock.candleHistory.size() >= 2)
+      {
+        valid.push_back(&stock);
+        symbols.push_back(stock.symbol);
+      }
+    }
+
+    // Timestamps common to all symbols, candle history is ascending
+    std::vector<uint32_t> common, timestamps, intersection;
+    if (!valid.empty())
+    {
+      for (const auto& candle : valid.front()->candleHistory)
+      {
+        common.push_back(candle.timestamp);
+      }
+    }
+    for (size_t s = 1; s < valid.size() and !common.empty(); ++s)
+    {
+      timestamps.clear();
+      for (const auto& candle : valid[s]->candleHistory)
+      {
+        timestamps.push_back(candle.timestamp);
+      }
+      intersection.clear();
+      std::set_intersection(common.begin(), common.end(), timestamps.begin(), timestamps.end(), std::back_inserter(intersection));
+      common.swap(intersection);
+    }
+
+    if (valid.size() < 2 or common.size() < 2)
+    {
+      const bool changed = !m_symbols.empty();
+      Reset({}, {});
+      return changed;
+    }
+
+    // Aligned closes of last window + 1 common bars, row per bar
+    const size_t symbolCount = valid.size();
+    const size_t barCount = std::min(common.size(), m_window + 1);
+    const size_t firstBar = common.size() - barCount;
+
+    std::vector<double> closes(barCount * symbolCount);
+    for (size_t s = 0; s < symbolCount; ++s)
+    {
+      const auto& history = valid[s]->candleHistory;
+      auto candle = std::lower_bound(history.begin(), history.end(), common[firstBar], [](const CandleData& data, uint32_t timestamp) {
+        return data.timestamp < timestamp;
+      });
+      for (size_t bar = 0; bar < barCount; ++bar)
+      {
+        while (candle->timestamp < common[firstBar + bar])
+        {
+          ++candle;
+        }
+        closes[bar * symbolCount + s] = candle->close;
+      }
+    }
+
+    std::vector<double> row(symbolCount);
+    auto ReturnRow = [&](size_t bar) {
+      for (size_t s = 0; s < symbolCount; ++s)
+      {
+        row[s] = LogReturn(closes[(bar - 1) * symbolCount + s], closes[bar * symbolCount + s]);
+      }
+      return row.data();
+    };
+    auto StoreLastBar = [&]() {
+      m_lastTimestamp = common.back();
+      m_lastCloses.assign(closes.end() - static_cast<std::ptrdiff_t>(symbolCount), closes.end());
+    };
+
+    // Incremental when symbols are same and last synchronized bar (with its previous bar) is still in aligned bars
+    size_t lastBar = 0;
+    if (symbols == m_symbols and m_filled > 0)
+    {
+      auto it = std::lower_bound(common.begin() + static_cast<std::ptrdiff_t>(firstBar), common.end(), m_lastTimestamp);
+      if (it != common.end() and *it == m_lastTimestamp)
+      {
+        lastBar = static_cast<size_t>(it - common.begin()) - firstBar;
+      }
+    }
+
+    if (lastBar >= 1)
+    {
+      bool changed = false;
+      if (!std::equal(m_lastCloses.begin(), m_lastCloses.end(), closes.begin() + static_cast<std::ptrdiff_t>(lastBar * symbolCount)))
+      {
+        ReplaceLast(ReturnRow(lastBar));
+        changed = true;
+      }
+      for (size_t bar = lastBar + 1; bar < barCount; ++bar)
+      {
+        Append(ReturnRow(bar));
+        changed = true;
+      }
+      if (changed)
+      {
+        StoreLastBar();
+      }
+      return changed;
+    }
+
+    std::vector<std::vector<double>> returns;
+    returns.reserve(barCount - 1);
+    for (size_t bar = 1; bar < barCount; ++bar)
+    {
+      const double* values = ReturnRow(bar);
+      returns.emplace_back(values, values + symbolCount);
+    }
+    Reset(symbols, returns);
+    StoreLastBar();
+    return true;
+  }
+
+  void CorrelationEngine::Reset(const std::vector<std::string>& symbols, const std::vector<std::vector<double>>& returns)
+  {
+    m_symbols = symbols;
+    const size_t symbolCount = m_symbols.size();
+
+    m_returns.assign(m_window * symbolCount, 0.0);
+    m_head = 0;
+    m_filled = std::min(returns.size(), m_window);
+
+    // Keep newest rows when more than window
+    const size_t first = returns.size() - m_filled;
+    for (size_t bar = 0; bar < m_filled; ++bar)
+    {
+      IK_ASSERT(returns[first + bar].size() == symbolCount, "Return row must have one value per symbol");
+      std::copy(returns[first + bar].begin(), returns[first + bar].end(), m_returns.begin() + static_cast<std::ptrdiff_t>(bar * symbolCount));
+    }
+
+    m_lastTimestamp = 0;
+    m_lastCloses.clear();
+    Recompute();
+  }
+
+  void CorrelationEngine::Recompute()
+  {
+    IK_PERFORMANCE_FUNC("CorrelationEngine::Recompute");
+    KanViz::Timer timer;
+
+    const size_t symbolCount = m_symbols.size();
+    m_sums.assign(symbolCount, 0.0);
+    m_cross.assign(symbolCount * symbolCount, 0.0);
+
+    for (size_t bar = 0; bar < m_filled; ++bar)
+    {
+      const double* returns = Row(bar);
+      for (size_t i = 0; i < symbolCount; ++i)
+      {
+        m_sums[i] += returns[i];
+      }
+    }
+
+    // Upper triangle in BlockSize x BlockSize tiles. Tile of cross products stays in cache while all bars stream
+    // through it, inner loop is contiguous over symbols and vectorizes
+    for (size_t iBlock = 0; iBlock < symbolCount; iBlock += BlockSize)
+    {
+      const size_t iEnd = std::min(iBlock + BlockSize, symbolCount);
+      for (size_t jBlock = iBlock; jBlock < symbolCount; jBlock += BlockSize)
+      {
+        const size_t jEnd = std::min(jBlock + BlockSize, symbolCount);
+        for (size_t bar = 0; bar < m_filled; ++bar)
+        {
+          const double* returns = Row(bar);
+          for (size_t i = iBlock; i < iEnd; ++i)
+          {
+            const double a = returns[i];
+            double* cross = m_cross.data() + i * symbolCount;
+            for (size_t j = std::max(jBlock, i); j < jEnd; ++j)
+            {
+              cross[j] += a * returns[j];
+            }
+          }
+        }
+      }
+    }
+
+    m_updatesSinceRecompute = 0;
+    m_dirty = true;
+    m_stats.fullRecomputes++;
+    m_stats.lastRecomputeMs = timer.ElapsedMilliseconds();
+  }
+
+  void CorrelationEngine::RankUpdate(const double* add, const double* remove)
+  {
+    const size_t symbolCount = m_symbols.size();
+    for (size_t i = 0; i < symbolCount; ++i)
+    {
+      const double a = add[i];
+      double* cross = m_cross.data() + i * symbolCount;
+      if (remove)
+      {
+        const double b = remove[i];
+        for (size_t j = i; j < symbolCount; ++j)
+        {
+          cross[j] += a * add[j] - b * remove[j];
+        }
+      }
+      else
+      {
+        for (size_t j = i; j < symbolCount; ++j)
+        {
+          cross[j] += a * add[j];
+        }
+      }
+    }
+  }
+
+  void CorrelationEngine::Append(const double* returns)
+  {
+    IK_PERFORMANCE_FUNC("CorrelationEngine::Append");
+    KanViz::Timer timer;
+
+    const size_t symbolCount = m_symbols.size();
+    double* slot = nullptr;
+    if (m_filled == m_window)
+    {
+      // Oldest row leaves the window and its slot takes new row
+      slot = m_returns.data() + m_head * symbolCount;
+      RankUpdate(returns, slot);
+      for (size_t i = 0; i < symbolCount; ++i)
+      {
+        m_sums[i] += returns[i] - slot[i];
+      }
+      m_head = (m_head + 1) % m_window;
+    }
+    else
+    {
+      slot = m_returns.data() + ((m_head + m_filled) % m_window) * symbolCount;
+      RankUpdate(returns, nullptr);
+      for (size_t i = 0; i < symbolCount; ++i)
+      {
+        m_sums[i] += returns[i];
+      }
+      m_filled++;
+    }
+    std::copy(returns, returns + symbolCount, slot);
+
+    m_dirty = true;
+    m_stats.incrementalUpdates++;
+    if (++m_updatesSinceRecompute >= ResyncUpdates)
+    {
+      Recompute();
+    }
+    m_stats.lastUpdateMs = timer.ElapsedMilliseconds();
+  }
+
+  void CorrelationEngine::ReplaceLast(const double* returns)
+  {
+    if (m_filled == 0)
+    {
+      Append(returns);
+      return;
+    }
+
+    IK_PERFORMANCE_FUNC("CorrelationEngine::ReplaceLast");
+    KanViz::Timer timer;
+
+    const size_t symbolCount = m_symbols.size();
+    double* slot = m_returns.data() + ((m_head + m_filled - 1) % m_window) * symbolCount;
+    RankUpdate(returns, slot);
+    for (size_t i = 0; i < symbolCount; ++i)
+    {
+      m_sums[i] += returns[i] - slot[i];
+    }
+    std::copy(returns, returns + symbolCount, slot);
+
+    m_dirty = true;
+    m_stats.incrementalUpdates++;
+    if (++m_updatesSinceRecompute >= ResyncUpdates)
+    {
+      Recompute();
+    }
+    m_stats.lastUpdateMs = timer.ElapsedMilliseconds();
+  }
+
+  void CorrelationEngine::UpdateMatrices()
+  {
+    if (!m_dirty)
+    {
+      return;
+    }
+    m_dirty = false;
+
+    static constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+    const size_t symbolCount = m_symbols.size();
+    m_covariance.assign(symbolCount * symbolCount, NaN);
+    m_correlation.assign(symbolCount * symbolCount, NaN);
+    if (m_filled < 2)
+    {
+      return;
+    }
+
+    const double bars = static_cast<double>(m_filled);
+    for (size_t i = 0; i < symbolCount; ++i)
+    {
+      for (size_t j = i; j < symbolCount; ++j)
+      {
+        const double covariance = (m_cross[i * symbolCount + j] - m_sums[i] * m_sums[j] / bars) / (bars - 1.0);
+        m_covariance[i * symbolCount + j] = m_covariance[j * symbolCount + i] = covariance;
+      }
+    }
+
+    for (size_t i = 0; i < symbolCount; ++i)
+    {
+      const double varianceI = m_covariance[i * symbolCount + i];
+      for (size_t j = i; j < symbolCount; ++j)
+      {
+        const double varianceJ = m_covariance[j * symbolCount + j];
+        if (varianceI > 0.0 and varianceJ > 0.0)
+        {
+          const double correlation = i == j ? 1.0 : std::clamp(m_covariance[i * symbolCount + j] / std::sqrt(varianceI * varianceJ), -1.0, 1.0);
+          m_correlation[i * symbolCount + j] = m_correlation[j * symbolCount + i] = correlation;
+        }
+      }
+    }
+  }
+
+  const std::vector<double>& CorrelationEngine::GetCorrelation()
+  {
+    UpdateMatrices();
+    return m_correlation;
+  }
+
+  const std::vector<double>& CorrelationEngine::GetCovariance()
+  {
+    UpdateMatrices();
+    return m_covariance;
+  }
+} // namespace KanVest
@@ -0,0 +1,280 @@
+//
+//  FactorPipeline.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "FactorPipeline.hpp"
+
+namespace KanVest
+{
+  static constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+  /// This function computes the price factor of symbol from columns of storage type, sums are accumulated in double
+  template<typename T>
+  static double ComputePriceFactor(FactorType type, size_t period, const ScreenerUniverse& universe, const ScreenerColumns<T>& columns, size_t symbol)
+  {
+    const size_t count = universe.Bars(symbol);
+    if (period == 0 or count <= period)
+    {
+      return NaN;
+    }
+
+    const T* closes = columns.closes.data() + universe.offsets[symbol];
+    if (type == FactorType::Momentum)
+    {
+      const double first = static_cast<double>(closes[count - 1 - period]);
+      return first > 0.0 ? (static_cast<double>(closes[count - 1]) / first - 1.0) * 100.0 : NaN;
+    }
+
+    // Volatility, sample deviation of last period log returns
+    double mean = 0.0, squares = 0.0;
+    for (size_t i = count - period; i < count; ++i)
+    {
+      const double previous = static_cast<double>(closes[i - 1]), close = static_cast<double>(closes[i]);
+      if (!(previous > 0.0) or !(close > 0.0))
+      {
+        return NaN;
+      }
+
+      // Welford update
+      const double value = std::log(close / previous);
+      const double delta = value - mean;
+      const size_t n = i - (count - period) + 1;
+      mean += delta / static_cast<double>(n);
+      squares += delta * (value - mean);
+    }
+    return period > 1 ? std::sqrt(squares / static_cast<double>(period - 1)) * 100.0 : 0.0;
+  }
+
+  std::string FactorDefinition::GetName() const
+  {
+    return std::string(FactorPipeline::GetPrefix(type)) + std::to_string(period);
+  }
+
+  size_t FactorResult::GetRank(size_t symbol) const
+  {
+    if (symbol >= composite.size() or std::isnan(composite[symbol]))
+    {
+      return 0;
+    }
+
+    const double score = composite[symbol];
+    return 1 + static_cast<size_t>(std::count_if(composite.begin(), composite.end(), [score](double value) { return value > score; }));
+  }
+
+  double FactorPipeline::ComputeFactor(const FactorDefinition& factor, const ScreenerUniverse& universe, size_t symbol)
+  {
+    using Type = ScreenerOperand::Type;
+
+    const size_t period = static_cast<size_t>(std::max(factor.period, 0));
+    auto Operand = [&](Type type, int operandPeriod) { return Screener::ComputeOperand({type, operandPeriod, {}}, universe, symbol); };
+    switch (factor.type)
+    {
+      case FactorType::Momentum:
+      case FactorType::Volatility:
+        return universe.precision == IndicatorPrecision::Float32 ? ComputePriceFactor(factor.type, period, universe, universe.columns32, symbol)
+        : ComputePriceFactor(factor.type, period, universe, universe.columns, symbol);
+      case FactorType::DistanceFromMA:
+      {
+        const double average = Operand(Type::SMA, factor.period);
+        const double close = Operand(Type::Close, 0);
+        return average > 0.0 ? (close / average - 1.0) * 100.0 : NaN;
+      }
+      case FactorType::RSI:
+        return Operand(Type::RSI, factor.period);
+      case FactorType::RelativeVolume:
+      {
+        const double average = Operand(Type::AverageVolume, factor.period);
+        const double volume = Operand(Type::Volume, 0);
+        return average > 0.0 ? volume / average : NaN;
+      }
+      default:
+        return NaN;
+    }
+  }
+
+  void FactorPipeline::Standardize(double* values, size_t count, double fraction, std::vector<double>& scratch)
+  {
+    scratch.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (!std::isnan(values[i]))
+      {
+        scratch.push_back(values[i]);
+      }
+    }
+    const size_t n = scratch.size();
+    if (n == 0)
+    {
+      return;
+    }
+
+    // Tail quantiles by selection, no full sort. Second selection runs only over values above lower quantile
+    double low = -std::numeric_limits<double>::infinity(), high = std::numeric_limits<double>::infinity();
+    if (fraction > 0.0 and n > 2)
+    {
+      const size_t lowIndex = static_cast<size_t>(std::floor(std::min(fraction, 0.5) * static_cast<double>(n - 1)));
+      const size_t highIndex = n - 1 - lowIndex;
+      std::nth_element(scratch.begin(), scratch.begin() + static_cast<std::ptrdiff_t>(lowIndex), scratch.end());
+      low = scratch[lowIndex];
+      std::nth_element(scratch.begin() + static_cast<std::ptrdiff_t>(lowIndex), scratch.begin() + static_cast<std::ptrdiff_t>(highIndex), scratch.end());
+      high = scratch[highIndex];
+    }
+
+    // Mean and deviation of winsorized values
+    double mean = 0.0, squares = 0.0;
+    for (size_t i = 0; i < n; ++i)
+    {
+      const double value = std::clamp(scratch[i], low, high);
+      const double delta = value - mean;
+      mean += delta / static_cast<double>(i + 1);
+      squares += delta * (value - mean);
+    }
+    const double deviation = std::sqrt(squares / static_cast<double>(n));
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (!std::isnan(values[i]))
+      {
+        values[i] = deviation > 0.0 ? (std::clamp(values[i], low, high) - mean) / deviation : 0.0;
+      }
+    }
+  }
+
+  void FactorPipeline::Run(const ScreenerUniverse& universe, const FactorSettings& settings, FactorResult& result)
+  {
+    IK_PERFORMANCE_FUNC("FactorPipeline::Run");
+    KanViz::Timer timer;
+
+    const auto& factors = settings.factors;
+    const size_t factorCount = factors.size();
+    const size_t symbolCount = universe.Size();
+
+    result.factorNames.clear();
+    for (const auto& factor : factors)
+    {
+      result.factorNames.push_back(factor.GetName());
+    }
+    result.values.assign(factorCount * symbolCount, NaN);
+    result.composite.assign(symbolCount, NaN);
+    result.leaderboard.clear();
+    result.stats = {};
+    result.stats.symbols = symbolCount;
+    result.stats.factors = factorCount;
+
+    if (!universe.HasColumns())
+    {
+      IK_LOG_ERROR("FactorPipeline", "Compact universe has no bar columns, build universe with float precision");
+      return;
+    }
+
+    // Factor values, blocks of symbols write disjoint entries of each factor column
+    result.stats.threads = Screener::ParallelFor(symbolCount, [&](size_t begin, size_t end) {
+      for (size_t factor = 0; factor < factorCount; ++factor)
+      {
+        double* column = result.values.data() + factor * symbolCount;
+        for (size_t symbol = begin; symbol < end; ++symbol)
+        {
+          column[symbol] = ComputeFactor(factors[factor], universe, symbol);
+        }
+      }
+    });
+    result.stats.computeMs = timer.ElapsedMilliseconds();
+
+    // Cross sectional normalization, one column at a time
+    std::vector<double> scratch;
+    scratch.reserve(symbolCount);
+    result.zScores = result.values;
+    for (size_t factor = 0; factor < factorCount; ++factor)
+    {
+      Standardize(result.zScores.data() + factor * symbolCount, symbolCount, settings.winsorizeFraction, scratch);
+    }
+    result.stats.normalizeMs = timer.ElapsedMilliseconds() - result.stats.computeMs;
+
+    // Composite over factors available for symbol, so short history is not penalized by missing factor
+    std::vector<size_t> order;
+    order.reserve(symbolCount);
+    for (size_t symbol = 0; symbol < symbolCount; ++symbol)
+    {
+      double sum = 0.0, weights = 0.0;
+      for (size_t factor = 0; factor < factorCount; ++factor)
+      {
+        if (const double z = result.zScores[factor * symbolCount + symbol]; !std::isnan(z))
+        {
+          sum += factors[factor].weight * z;
+          weights += std::abs(factors[factor].weight);
+        }
+      }
+      if (weights > 0.0)
+      {
+        result.composite[symbol] = sum / weights;
+        order.push_back(symbol);
+      }
+    }
+    result.stats.scored = order.size();
+
+    // Only top N are ordered
+    const size_t leaders = std::min(settings.topN, order.size());
+    std::partial_sort(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(leaders), order.end(), [&](size_t a, size_t b) {
+      return result.composite[a] != result.composite[b] ? result.composite[a] > result.composite[b] : a < b;
+    });
+
+    result.leaderboard.resize(leaders);
+    for (size_t rank = 0; rank < leaders; ++rank)
+    {
+      FactorLeader& leader = result.leaderboard[rank];
+      leader.rank = rank + 1;
+      leader.symbol = order[rank];
+      leader.name = universe.symbols[leader.symbol];
+      leader.composite = result.composite[leader.symbol];
+      leader.zScores.resize(factorCount);
+      for (size_t factor = 0; factor < factorCount; ++factor)
+      {
+        leader.zScores[factor] = result.zScores[factor * symbolCount + leader.symbol];
+      }
+    }
+    result.stats.elapsedMs = timer.ElapsedMilliseconds();
+    result.stats.rankMs = result.stats.elapsedMs - result.stats.computeMs - result.stats.normalizeMs;
+
+    IK_LOG_DEBUG("FactorPipeline", "Scored {0} of {1} symbols on {2} factors in {3:.3f} ms ({4} threads)", result.stats.scored, symbolCount, factorCount,
+                 result.stats.elapsedMs, result.stats.threads);
+  }
+
+  std::optional<FactorDefinition> FactorPipeline::ParseFactor(const std::string& name, double weight)
+  {
+    std::string upper = name;
+    std::transform(upper.begin(), upper.end(), upper.begin(), [](unsigned char ch) { return std::toupper(ch); });
+    for (size_t index = 0; index < static_cast<size_t>(FactorType::Count); ++index)
+    {
+      const FactorType type = static_cast<FactorType>(index);
+      const std::string_view prefix = GetPrefix(type);
+      const std::string_view view(upper);
+      if (view.size() > prefix.size() and view.starts_with(prefix) and
+          std::all_of(view.begin() + static_cast<std::ptrdiff_t>(prefix.size()), view.end(), [](unsigned char c) { return std::isdigit(c); }))
+      {
+        const int period = std::atoi(upper.c_str() + prefix.size());
+        if (period < 1 or period > 5000)
+        {
+          return std::nullopt;
+        }
+        return FactorDefinition{type, period, weight};
+      }
+    }
+    return std::nullopt;
+  }
+
+  std::string_view FactorPipeline::GetPrefix(FactorType type)
+  {
+    switch (type)
+    {
+      case FactorType::Momentum:        return "MOM";
+      case FactorType::Volatility:      return "VOL";
+      case FactorType::DistanceFromMA:  return "DIST";
+      case FactorType::RSI:             return "RSI";
+      case FactorType::RelativeVolume:  return "RVOL";
+      default: return "";
+    }
+  }
+} // namespace KanVest
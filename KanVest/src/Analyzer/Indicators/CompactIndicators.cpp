@@ -0,0 +1,53 @@
+//
+//  CompactIndicators.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "CompactIndicators.hpp"
+
+namespace KanVest
+{
+  int64_t CompactIndicators::LastCloseSum(const CompactCandleSeries& series, size_t period)
+  {
+    const auto& candles = series.GetCandles();
+    if (period == 0 or candles.size() < period)
+    {
+      return -1;
+    }
+
+    int64_t sum = 0;
+    for (size_t i = candles.size() - period; i < candles.size(); ++i)
+    {
+      sum += candles[i].close;
+    }
+    return sum;
+  }
+
+  int32_t CompactIndicators::HighestHigh(const CompactCandleSeries& series, size_t period)
+  {
+    const auto& candles = series.GetCandles();
+    const size_t begin = candles.size() > period ? candles.size() - period : 0;
+
+    int32_t highest = std::numeric_limits<int32_t>::min();
+    for (size_t i = begin; i < candles.size(); ++i)
+    {
+      highest = std::max(highest, candles[i].high);
+    }
+    return highest;
+  }
+
+  int32_t CompactIndicators::LowestLow(const CompactCandleSeries& series, size_t period)
+  {
+    const auto& candles = series.GetCandles();
+    const size_t begin = candles.size() > period ? candles.size() - period : 0;
+
+    int32_t lowest = std::numeric_limits<int32_t>::max();
+    for (size_t i = begin; i < candles.size(); ++i)
+    {
+      lowest = std::min(lowest, candles[i].low);
+    }
+    return lowest;
+  }
+} // namespace KanVest
@@ -0,0 +1,573 @@
+//
+//  IndicatorGraph.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "IndicatorGraph.hpp"
+
+#include "Analyzer/Indicators/MovingAverage.hpp"
+#include "Analyzer/Indicators/StreamingIndicators.hpp"
+#include "Analyzer/Indicators/RollingStatistics.hpp"
+
+namespace KanVest
+{
+  static constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+  static const std::vector<std::string> SourceNodes = {"Close", "Open", "High", "Low", "Volume"};
+
+  /// This function splits the node name "Type(a,b)" into type and arguments
+  static bool ParseNodeName(const std::string& name, std::string& type, std::vector<double>& args)
+  {
+    args.clear();
+    const size_t open = name.find('(');
+    if (open == std::string::npos)
+    {
+      type = name;
+      return !type.empty();
+    }
+    if (name.back() != ')')
+    {
+      return false;
+    }
+
+    type = name.substr(0, open);
+    std::stringstream stream(name.substr(open + 1, name.size() - open - 2));
+    std::string token;
+    while (std::getline(stream, token, ','))
+    {
+      try
+      {
+        args.push_back(std::stod(token));
+      }
+      catch (...)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// This function formats the node name from type and integer arguments
+  static std::string NodeName(const std::string& type, std::initializer_list<int> args)
+  {
+    std::string name = type + "(";
+    for (int arg : args)
+    {
+      name += std::to_string(arg) + ",";
+    }
+    name.back() = ')';
+    return name;
+  }
+
+  /// This function computes EMA seeded with first valid value from begin, NaN inputs before it are kept NaN
+  /// - Parameters:
+  ///   - input: input values
+  ///   - period: EMA period
+  ///   - begin: first changed value, output before it is kept
+  ///   - output: output values, sized as input
+  static void ComputeSeededEMA(const std::vector<double>& input, int period, size_t begin, std::vector<double>& output)
+  {
+    const double multiplier = 2.0 / (period + 1.0);
+
+    // Continue from last average, or seed with first valid value if there is none yet
+    size_t i = begin;
+    if (i == 0 or std::isnan(output[i - 1]))
+    {
+      while (i < input.size() and std::isnan(input[i]))
+      {
+        output[i++] = NaN;
+      }
+      if (i == input.size())
+      {
+        return;
+      }
+      output[i] = input[i];
+      i++;
+    }
+
+    for (; i < input.size(); ++i)
+    {
+      output[i] = (input[i] - output[i - 1]) * multiplier + output[i - 1];
+    }
+  }
+
+  /// This function evaluates rolling window kernel from begin, window - 1 values before begin are read again
+  /// - Parameters:
+  ///   - input: input values
+  ///   - window: window length
+  ///   - begin: first changed value, output before it is kept
+  ///   - output: output values, sized as input
+  ///   - kernel: batch kernel (values, count, output), NaN before window - 1
+  template<typename Kernel>
+  static void ComputeWindowTail(const std::vector<double>& input, size_t window, size_t begin, std::vector<double>& output, Kernel&& kernel)
+  {
+    if (begin == 0)
+    {
+      kernel(input.data(), input.size(), output.data());
+      return;
+    }
+
+    const size_t start = begin + 1 > window ? begin + 1 - window : 0;
+    thread_local std::vector<double> scratch;
+    scratch.resize(input.size() - start);
+    kernel(input.data() + start, scratch.size(), scratch.data());
+    std::copy(scratch.begin() + static_cast<std::ptrdiff_t>(begin - start), scratch.end(), output.begin() + static_cast<std::ptrdiff_t>(begin));
+  }
+
+  void IndicatorGraph::SetInput(const CandleColumns& columns, size_t begin)
+  {
+    IK_PERFORMANCE_FUNC("IndicatorGraph::SetInput");
+
+    // Values before first changed candle stay computed, nodes continue from it on next request
+    begin = std::min({begin, m_size, columns.Size()});
+    m_size = columns.Size();
+    for (auto& [name, validBars] : m_validBars)
+    {
+      validBars = std::min(validBars, begin);
+    }
+
+    auto CopyTail = [this, begin](const std::string& name, const auto& column) {
+      auto& values = m_values[name];
+      values.resize(m_size);
+      for (size_t i = begin; i < m_size; ++i)
+      {
+        values[i] = static_cast<double>(column[i]);
+      }
+    };
+    CopyTail("Close", columns.closes);
+    CopyTail("Open", columns.opens);
+    CopyTail("High", columns.highs);
+    CopyTail("Low", columns.lows);
+    CopyTail("Volume", columns.volumes);
+  }
+
+  const std::vector<double>& IndicatorGraph::Get(const std::string& name)
+  {
+    static const std::vector<double> EmptyValues;
+
+    Evaluate({name});
+    auto it = m_values.find(name);
+    return it != m_values.end() ? it->second : EmptyValues;
+  }
+
+  void IndicatorGraph::Evaluate(const std::vector<std::string>& names)
+  {
+    // No input set
+    if (m_values.empty())
+    {
+      return;
+    }
+
+    // Cost if every requested indicator not yet evaluated computed its own dependency closure
+    for (const auto& name : names)
+    {
+      if (IsCurrent(name))
+      {
+        continue;
+      }
+
+      std::vector<std::string> closure;
+      std::unordered_set<std::string> scheduled;
+      Schedule(name, closure, scheduled, false);
+      m_stats.independentNodes += closure.size();
+      for (const auto& node : closure)
+      {
+        m_stats.independentBars += m_size - GetValidBars(node);
+      }
+    }
+
+    // Shared schedule, skipping nodes already current for this input
+    std::vector<std::string> order;
+    std::unordered_set<std::string> scheduled;
+    for (const auto& name : names)
+    {
+      Schedule(name, order, scheduled, true);
+    }
+    if (order.empty())
+    {
+      return;
+    }
+
+    IK_PERFORMANCE_FUNC("IndicatorGraph::Evaluate");
+    for (const auto& name : order)
+    {
+      const Node& node = GetNode(name);
+
+      std::vector<const std::vector<double>*> inputs;
+      inputs.reserve(node.inputs.size());
+      for (const auto& input : node.inputs)
+      {
+        inputs.push_back(&m_values.at(input));
+      }
+
+      // Values before first stale bar are kept, node evaluates changed tail only
+      auto& output = m_values[name];
+      size_t& validBars = m_validBars[name];
+      const size_t begin = std::min(validBars, m_size);
+      output.resize(m_size, NaN);
+      node.compute(inputs, node.args, begin, output);
+      output.resize(m_size, NaN);
+      validBars = m_size;
+
+      m_stats.computedNodes++;
+      m_stats.computedBars += m_size - begin;
+    }
+  }
+
+  void IndicatorGraph::Schedule(const std::string& name, std::vector<std::string>& order, std::unordered_set<std::string>& scheduled, bool skipComputed)
+  {
+    // Iterative post order DFS, inputs are placed before the node using them
+    std::vector<std::pair<std::string, bool /* Expanded */>> stack = {{name, false}};
+    while (!stack.empty())
+    {
+      auto [current, expanded] = std::move(stack.back());
+      stack.pop_back();
+
+      if (expanded)
+      {
+        order.push_back(current);
+        continue;
+      }
+
+      const bool isSource = std::find(SourceNodes.begin(), SourceNodes.end(), current) != SourceNodes.end();
+      if (isSource or scheduled.contains(current) or (skipComputed and IsCurrent(current)))
+      {
+        continue;
+      }
+
+      const Node& node = GetNode(current);
+      if (!node.valid)
+      {
+        IK_LOG_WARN("IndicatorGraph", "Invalid indicator node {0}", current);
+        continue;
+      }
+
+      scheduled.insert(current);
+      stack.emplace_back(current, true);
+      for (const auto& input : node.inputs)
+      {
+        stack.emplace_back(input, false);
+      }
+    }
+  }
+
+  bool IndicatorGraph::IsValidNode(const std::string& name)
+  {
+    return std::find(SourceNodes.begin(), SourceNodes.end(), name) != SourceNodes.end() or MakeNode(name).valid;
+  }
+
+  size_t IndicatorGraph::GetMemoryUsage() const
+  {
+    size_t bytes = sizeof(*this);
+    for (const auto& [name, values] : m_values)
+    {
+      bytes += sizeof(name) + name.capacity() + sizeof(values) + values.capacity() * sizeof(double);
+    }
+    bytes += m_validBars.size() * (sizeof(std::string) + sizeof(size_t));
+    return bytes + m_nodes.size() * sizeof(Node);
+  }
+
+  size_t IndicatorGraph::GetValidBars(const std::string& name) const
+  {
+    auto it = m_validBars.find(name);
+    return it != m_validBars.end() ? std::min(it->second, m_size) : 0;
+  }
+
+  bool IndicatorGraph::IsCurrent(const std::string& name) const
+  {
+    auto it = m_validBars.find(name);
+    return it != m_validBars.end() and it->second == m_size;
+  }
+
+  const IndicatorGraph::Node& IndicatorGraph::GetNode(const std::string& name)
+  {
+    auto it = m_nodes.find(name);
+    if (it == m_nodes.end())
+    {
+      it = m_nodes.emplace(name, MakeNode(name)).first;
+    }
+    return it->second;
+  }
+
+  IndicatorGraph::Node IndicatorGraph::MakeNode(const std::string& name)
+  {
+    Node node;
+
+    std::string type;
+    std::vector<double> args;
+    if (!ParseNodeName(name, type, args))
+    {
+      return node;
+    }
+
+    auto Arg = [&args](size_t index) { return static_cast<int>(args[index]); };
+    auto HasArgs = [&args](size_t count) {
+      return args.size() == count and std::all_of(args.begin(), args.end(), [](double arg) { return arg > 0.0; });
+    };
+
+    if (type == "SMA" and HasArgs(1))
+    {
+      // Window sum restarts at first changed average, values before period - 1 are 0 as in MovingAverage
+      node.inputs = {"Close"};
+      node.compute = [](const auto& in, const auto& a, size_t begin, auto& out) {
+        const auto& closes = *in[0];
+        const size_t period = static_cast<size_t>(a[0]);
+        if (begin == 0)
+        {
+          out = MovingAverage::ComputeDMA(closes, static_cast<int>(period));
+          return;
+        }
+
+        const size_t start = std::max(begin, period - 1);
+        std::fill(out.begin() + static_cast<std::ptrdiff_t>(begin), out.begin() + static_cast<std::ptrdiff_t>(std::min(start, closes.size())), 0.0);
+        if (start >= closes.size())
+        {
+          return;
+        }
+
+        double sum = std::accumulate(closes.begin() + static_cast<std::ptrdiff_t>(start + 1 - period), closes.begin() + static_cast<std::ptrdiff_t>(start + 1), 0.0);
+        out[start] = sum / period;
+        for (size_t i = start + 1; i < closes.size(); ++i)
+        {
+          sum += closes[i];
+          sum -= closes[i - period];
+          out[i] = sum / period;
+        }
+      };
+    }
+    else if (type == "EMA" and HasArgs(1))
+    {
+      node.inputs = {"Close"};
+      node.compute = [](const auto& in, const auto& a, size_t begin, auto& out) {
+        const auto& closes = *in[0];
+        if (begin == 0)
+        {
+          out = MovingAverage::ComputeEMA(closes, static_cast<int>(a[0]));
+          return;
+        }
+
+        const double multiplier = 2.0 / (static_cast<int>(a[0]) + 1.0);
+        for (size_t i = begin; i < closes.size(); ++i)
+        {
+          out[i] = (closes[i] - out[i - 1]) * multiplier + out[i - 1];
+        }
+      };
+    }
+    else if (type == "StdDev" and HasArgs(1))
+    {
+      // Population standard deviation, shifted compensated window sums keep precision at any price level
+      node.inputs = {"Close"};
+      node.compute = [](const auto& in, const auto& a, size_t begin, auto& out) {
+        const size_t window = static_cast<size_t>(a[0]);
+        ComputeWindowTail(*in[0], window, begin, out, [window](const double* values, size_t count, double* output) {
+          RollingStatistics::ComputeMeanDeviation(values, count, window, nullptr, output);
+        });
+      };
+    }
+    else if ((type == "BollingerUpper" or type == "BollingerLower") and HasArgs(2))
+    {
+      node.inputs = {NodeName("SMA", {Arg(0)}), NodeName("StdDev", {Arg(0)})};
+      const double sign = type == "BollingerUpper" ? 1.0 : -1.0;
+      node.compute = [sign](const auto& in, const auto& a, size_t begin, auto& out) {
+        const auto& mean = *in[0];
+        const auto& deviation = *in[1];
+        for (size_t i = begin; i < mean.size(); ++i)
+        {
+          out[i] = mean[i] + sign * a[1] * deviation[i];
+        }
+      };
+    }
+    else if (type == "MACD" and HasArgs(2))
+    {
+      node.inputs = {NodeName("EMA", {Arg(0)}), NodeName("EMA", {Arg(1)})};
+      node.compute = [](const auto& in, const auto&, size_t begin, auto& out) {
+        const auto& fast = *in[0];
+        const auto& slow = *in[1];
+        for (size_t i = begin; i < fast.size(); ++i)
+        {
+          out[i] = fast[i] - slow[i];
+        }
+      };
+    }
+    else if (type == "MACDSignal" and HasArgs(3))
+    {
+      node.inputs = {NodeName("MACD", {Arg(0), Arg(1)})};
+      node.compute = [](const auto& in, const auto& a, size_t begin, auto& out) { ComputeSeededEMA(*in[0], static_cast<int>(a[2]), begin, out); };
+    }
+    else if (type == "MACDHistogram" and HasArgs(3))
+    {
+      node.inputs = {NodeName("MACD", {Arg(0), Arg(1)}), NodeName("MACDSignal", {Arg(0), Arg(1), Arg(2)})};
+      node.compute = [](const auto& in, const auto&, size_t begin, auto& out) {
+        const auto& macd = *in[0];
+        const auto& signal = *in[1];
+        for (size_t i = begin; i < macd.size(); ++i)
+        {
+          out[i] = macd[i] - signal[i];
+        }
+      };
+    }
+    else if (type == "TrueRange" and args.empty())
+    {
+      node.inputs = {"High", "Low", "Close"};
+      node.compute = [](const auto& in, const auto&, size_t begin, auto& out) {
+        const auto& highs = *in[0];
+        const auto& lows = *in[1];
+        const auto& closes = *in[2];
+        for (size_t i = begin; i < highs.size(); ++i)
+        {
+          out[i] = i == 0 ? highs[i] - lows[i] :
+          std::max({highs[i] - lows[i], std::abs(highs[i] - closes[i - 1]), std::abs(lows[i] - closes[i - 1])});
+        }
+      };
+    }
+    else if (type == "ATR" and HasArgs(1))
+    {
+      // Wilder smoothing seeded with average of first period true ranges, changed tail continues from last ATR
+      node.inputs = {"TrueRange"};
+      node.compute = [](const auto& in, const auto& a, size_t begin, auto& out) {
+        const auto& trueRange = *in[0];
+        const size_t period = static_cast<size_t>(a[0]);
+
+        double atr = 0.0;
+        if (begin < period)
+        {
+          std::fill(out.begin(), out.end(), NaN);
+          if (trueRange.size() < period)
+          {
+            return;
+          }
+          atr = std::accumulate(trueRange.begin(), trueRange.begin() + static_cast<std::ptrdiff_t>(period), 0.0) / period;
+          out[period - 1] = atr;
+          begin = period;
+        }
+        else
+        {
+          atr = out[begin - 1];
+        }
+
+        for (size_t i = begin; i < trueRange.size(); ++i)
+        {
+          atr = (atr * (period - 1) + trueRange[i]) / period;
+          out[i] = atr;
+        }
+      };
+    }
+    else if (type == "HighestHigh" and HasArgs(1))
+    {
+      node.inputs = {"High"};
+      node.compute = [](const auto& in, const auto& a, size_t begin, auto& out) {
+        const size_t window = static_cast<size_t>(a[0]);
+        ComputeWindowTail(*in[0], window, begin, out, [window](const double* values, size_t count, double* output) {
+          RollingStatistics::ComputeMaximum(values, count, window, output);
+        });
+      };
+    }
+    else if (type == "LowestLow" and HasArgs(1))
+    {
+      node.inputs = {"Low"};
+      node.compute = [](const auto& in, const auto& a, size_t begin, auto& out) {
+        const size_t window = static_cast<size_t>(a[0]);
+        ComputeWindowTail(*in[0], window, begin, out, [window](const double* values, size_t count, double* output) {
+          RollingStatistics::ComputeMinimum(values, count, window, output);
+        });
+      };
+    }
+    else if (type == "StochasticK" and HasArgs(1))
+    {
+      node.inputs = {"Close", NodeName("HighestHigh", {Arg(0)}), NodeName("LowestLow", {Arg(0)})};
+      node.compute = [](const auto& in, const auto&, size_t begin, auto& out) {
+        const auto& closes = *in[0];
+        const auto& highest = *in[1];
+        const auto& lowest = *in[2];
+        for (size_t i = begin; i < closes.size(); ++i)
+        {
+          const double range = highest[i] - lowest[i];
+          out[i] = range > 0.0 ? 100.0 * (closes[i] - lowest[i]) / range : (std::isnan(range) ? NaN : 50.0);
+        }
+      };
+    }
+    else if (type == "StochasticD" and HasArgs(2))
+    {
+      // Average of last d %K values, NaN while window reaches into %K warm up
+      node.inputs = {NodeName("StochasticK", {Arg(0)})};
+      node.compute = [](const auto& in, const auto& a, size_t begin, auto& out) {
+        const auto& k = *in[0];
+        const size_t period = static_cast<size_t>(a[1]);
+        for (size_t i = begin; i < k.size(); ++i)
+        {
+          if (i + 1 < period)
+          {
+            out[i] = NaN;
+            continue;
+          }
+
+          double sum = 0.0;
+          for (size_t j = i + 1 - period; j <= i; ++j)
+          {
+            sum += k[j];
+          }
+          out[i] = sum / period;
+        }
+      };
+    }
+    else if ((type == "AverageGain" or type == "AverageLoss") and HasArgs(1))
+    {
+      // Wilder smoothing of close changes seeded with average of first period changes, same as StreamingRSI
+      node.inputs = {"Close"};
+      const double sign = type == "AverageGain" ? 1.0 : -1.0;
+      node.compute = [sign](const auto& in, const auto& a, size_t begin, auto& out) {
+        const auto& closes = *in[0];
+        const size_t period = static_cast<size_t>(a[0]);
+
+        // Seed needs first period changes, changed tail after it continues from last average
+        if (begin <= period)
+        {
+          begin = 0;
+        }
+        double sum = 0.0, average = begin > 0 ? out[begin - 1] : 0.0;
+        for (size_t i = begin; i < closes.size(); ++i)
+        {
+          if (i == 0)
+          {
+            out[i] = NaN;
+            continue;
+          }
+
+          const double change = sign * (closes[i] - closes[i - 1]);
+          const double move = change > 0.0 ? change : 0.0;
+          if (i < period)
+          {
+            sum += move;
+            out[i] = NaN;
+            continue;
+          }
+          average = i == period ? (sum + move) / period : (average * (period - 1) + move) / period;
+          out[i] = average;
+        }
+      };
+    }
+    else if (type == "RSI" and HasArgs(1))
+    {
+      node.inputs = {NodeName("AverageGain", {Arg(0)}), NodeName("AverageLoss", {Arg(0)})};
+      node.compute = [](const auto& in, const auto&, size_t begin, auto& out) {
+        const auto& gains = *in[0];
+        const auto& losses = *in[1];
+        for (size_t i = begin; i < gains.size(); ++i)
+        {
+          const double gain = gains[i], loss = losses[i];
+          out[i] = std::isnan(gain) or std::isnan(loss) ? NaN : loss == 0.0 ? 100.0 : gain == 0.0 ? 0.0 : 100.0 - (100.0 / (1.0 + (gain / loss)));
+        }
+      };
+    }
+    else
+    {
+      return node;
+    }
+
+    node.args = std::move(args);
+    node.valid = true;
+    return node;
+  }
+} // namespace KanVest
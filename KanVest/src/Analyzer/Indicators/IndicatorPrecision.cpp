@@ -0,0 +1,89 @@
+//
+//  IndicatorPrecision.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "IndicatorPrecision.hpp"
+
+#include "Analyzer/Indicators/Momentum.hpp"
+#include "Analyzer/Indicators/MovingAverageKernel.hpp"
+
+namespace KanVest
+{
+  /// This function accumulates the relative deviation of float rows from double rows
+  static void CompareRows(const IndicatorMatrix& reference, const IndicatorMatrix32& values, const std::vector<int>& periods,
+                          const char* name, PrecisionErrorStats& stats)
+  {
+    for (size_t row = 0; row < reference.rows; ++row)
+    {
+      const double* expected = reference.Row(row);
+      const float* actual = values.Row(row);
+      for (size_t i = 0; i < reference.columns; ++i)
+      {
+        if (expected[i] == 0.0)
+        {
+          continue;
+        }
+        const double error = std::abs(static_cast<double>(actual[i]) - expected[i]) / std::abs(expected[i]);
+        if (error > stats.maxRelativeError)
+        {
+          stats.maxRelativeError = error;
+          stats.worstIndicator = name + std::to_string(periods[row]);
+        }
+        stats.values++;
+      }
+    }
+  }
+
+  void IndicatorPrecisionHarness::Compare(const double* closes, size_t count, const std::vector<int>& periods, PrecisionErrorStats& stats)
+  {
+    IK_PERFORMANCE_FUNC("IndicatorPrecisionHarness::Compare");
+
+    if (count == 0)
+    {
+      return;
+    }
+
+    static constexpr size_t RSIPeriod = 14;
+
+    thread_local IndicatorMatrix sma, ema;
+    thread_local IndicatorMatrix32 sma32, ema32;
+    thread_local std::vector<double> rsi;
+    thread_local std::vector<float> closes32, rsi32;
+
+    closes32.assign(closes, closes + count);
+    rsi.resize(count);
+    rsi32.resize(count);
+
+    KanViz::Timer timer;
+    MovingAverageKernel::ComputeSMA(closes, count, periods, sma);
+    MovingAverageKernel::ComputeEMA(closes, count, periods, ema);
+    RSI::ComputeSeries(closes, count, RSIPeriod, rsi.data());
+    stats.float64Ms += timer.ElapsedMilliseconds();
+
+    timer.Reset();
+    MovingAverageKernel::ComputeSMA(closes32.data(), count, periods, sma32);
+    MovingAverageKernel::ComputeEMA(closes32.data(), count, periods, ema32);
+    RSI::ComputeSeries(closes32.data(), count, RSIPeriod, rsi32.data());
+    stats.float32Ms += timer.ElapsedMilliseconds();
+
+    CompareRows(sma, sma32, periods, "SMA", stats);
+    CompareRows(ema, ema32, periods, "EMA", stats);
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (!std::isnan(rsi[i]))
+      {
+        stats.maxRSIError = std::max(stats.maxRSIError, std::abs(static_cast<double>(rsi32[i]) - rsi[i]));
+        stats.values++;
+      }
+    }
+    stats.series++;
+  }
+
+  bool IndicatorPrecisionHarness::IsWithinBounds(const PrecisionErrorStats& stats)
+  {
+    return stats.maxRelativeError <= MaxRelativeError and stats.maxRSIError <= MaxRSIError;
+  }
+} // namespace KanVest
@@ -12,29 +12,13 @@ namespace KanVest
   // Helper: safe NaN
   static constexpr double NaN() { return std::numeric_limits<double>::quiet_NaN(); }
   
-  RSISeries RSI::Compute(const StockData& data, size_t period)
+  template<typename T>
+  void RSI::ComputeSeries(const T* closes, size_t count, size_t period, T* output)
   {
-    RSISeries out;
-
-    // Get candle history data
-    const auto& history = data.candleHistory;
-    const size_t n = history.size();
-
-    // Validate data
-    if (!data.IsValid() or n < 2)
+    std::fill(output, output + count, static_cast<T>(NaN()));
+    if (period == 0 or count <= period)
     {
-      out.last = NaN();
-      return out;
-    }
-    
-    // Reserve rsi data size and assign all as NAN
-    out.series.assign(n, NaN());
-    
-    // Validate if chart have enough candle as period If we do not have period size candles
-    if (n <= period)
-    {
-      out.last = NaN();
-      return out;
+      return;
     }
     
     // --- Step 1: initial avg gain/loss for first `period` candles ---
@@ -43,7 +27,7 @@ namespace KanVest
     
     for (size_t i = 1; i <= period; ++i)
     {
-      double diff = history[i].close - history[i - 1].close;
+      double diff = static_cast<double>(closes[i]) - static_cast<double>(closes[i - 1]);
       if (diff > 0)
         gainSum += diff;
       else
@@ -60,12 +44,12 @@ namespace KanVest
     else
       rsi = 100.0 - (100.0 / (1.0 + (avgGain / avgLoss)));
     
-    out.series[period] = rsi;
+    output[period] = static_cast<T>(rsi);
     
     // --- Step 2: Wilder smoothing for remaining candles ---
-    for (size_t i = period + 1; i < n; ++i)
+    for (size_t i = period + 1; i < count; ++i)
     {
-      double diff = history[i].close - history[i - 1].close;
+      double diff = static_cast<double>(closes[i]) - static_cast<double>(closes[i - 1]);
       double gain = diff > 0 ? diff : 0.0;
       double loss = diff < 0 ? -diff : 0.0;
       
@@ -79,11 +63,10 @@ namespace KanVest
       else
         rsi = 100.0 - (100.0 / (1.0 + (avgGain / avgLoss)));
       
-      out.series[i] = rsi;
+      output[i] = static_cast<T>(rsi);
     }
-    
-    out.last = out.series[n - 1];
-    
-    return out;
   }
+
+  template void RSI::ComputeSeries<double>(const double*, size_t, size_t, double*);
+  template void RSI::ComputeSeries<float>(const float*, size_t, size_t, float*);
 } // namespace KanVest
@@ -7,47 +7,15 @@
 
 #include "MovingAverage.hpp"
 
-#include "Analyzer/Indicators/IndicatorUtils.hpp"
-
 namespace KanVest
 {
-  static std::vector<int> GetActivePeriods(const std::string& chartRange)
+  std::vector<int> MovingAverage::GetActivePeriods(const std::string& chartRange)
   {
     if (chartRange == "1mo") return {5, 10, 20};
     if (chartRange == "3mo") return {5, 10, 20, 30, 50};
     return ValidMovingAveragePeriods;
   }
   
-  MAResult MovingAverage::Compute(const StockData& data)
-  {
-    MAResult result;
-    
-    if (!data.IsValid())
-    {
-      return result;
-    }
-    
-    // convert ANY raw history (1W,1D,1h..)-> daily
-#if UseDailyCandle
-    auto closesCandle = Indicator::Utils::BuildDailyCloses(data);
-#else
-    auto closesCandle = Indicator::Utils::GetCandleCloses(data);
-#endif
-    if (closesCandle.size() < 5)
-    {
-      return result;
-    }
-    
-    auto periods = GetActivePeriods(data.range);
-    
-    for (int p : periods)
-    {
-      result.dmaValues[p] = ComputeDMA(closesCandle, p);
-      result.emaValues[p] = ComputeEMA(closesCandle, p);
-    }
-    return result;
-  }
-
   std::vector<double> MovingAverage::ComputeDMA(const std::vector<double>& closes, int period)
   {
     std::vector<double> dma(closes.size(), 0.0);
@@ -0,0 +1,197 @@
+//
+//  MovingAverageCache.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "MovingAverageCache.hpp"
+
+namespace KanVest
+{
+  static constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+  void MovingAverageCache::SetInput(const StockData& data)
+  {
+    const auto& history = data.candleHistory;
+    const size_t n = history.size();
+
+    // First changed close, cached chunks before it stay valid
+    size_t changed = 0;
+    if (m_symbol == data.symbol and m_range == data.range and m_granularity == data.dataGranularity)
+    {
+      // Candles before revision window are final, adjusted history changes first close too
+      if (n >= m_closes.size() and !m_closes.empty() and history.front().close == m_closes.front())
+      {
+        changed = m_closes.size() > RevisionWindow ? m_closes.size() - RevisionWindow : 0;
+        while (changed < m_closes.size() and history[changed].close == m_closes[changed])
+        {
+          changed++;
+        }
+      }
+    }
+    else
+    {
+      m_symbol = data.symbol;
+      m_range = data.range;
+      m_granularity = data.dataGranularity;
+      m_series.clear();
+    }
+
+    if (changed == n and n == m_closes.size())
+    {
+      return;
+    }
+
+    m_closes.resize(n);
+    for (size_t i = changed; i < n; ++i)
+    {
+      m_closes[i] = history[i].close;
+    }
+
+    // Partial last chunk is invalidated by appended candles as well
+    const size_t chunks = (n + ChunkSize - 1) / ChunkSize;
+    for (auto& [key, series] : m_series)
+    {
+      series.values.resize(n, NaN);
+      series.cached.resize(chunks, false);
+      std::fill(series.cached.begin() + static_cast<std::ptrdiff_t>(std::min(changed / ChunkSize, chunks)), series.cached.end(), false);
+    }
+  }
+
+  const std::vector<double>& MovingAverageCache::Get(MovingAverageType type, int period, size_t begin, size_t end)
+  {
+    period = std::max(period, 1);
+    m_stats.requests++;
+
+    Series& series = m_series[period * 2 + static_cast<int>(type)];
+    const size_t n = m_closes.size();
+    if (series.values.size() != n)
+    {
+      series.values.assign(n, NaN);
+      series.cached.assign((n + ChunkSize - 1) / ChunkSize, false);
+    }
+
+    end = std::min(end, n);
+    if (begin >= end)
+    {
+      return series.values;
+    }
+
+    // Ascending order, so chunks after first missing one continue from it
+    for (size_t chunk = begin / ChunkSize; chunk <= (end - 1) / ChunkSize; ++chunk)
+    {
+      if (series.cached[chunk])
+      {
+        m_stats.cachedChunks++;
+        continue;
+      }
+      Evaluate(type, period, series, chunk);
+    }
+    return series.values;
+  }
+
+  void MovingAverageCache::Evaluate(MovingAverageType type, int period, Series& series, size_t chunk)
+  {
+    IK_PERFORMANCE_FUNC("MovingAverageCache::Evaluate");
+    KanViz::Timer timer;
+
+    const double* closes = m_closes.data();
+    double* values = series.values.data();
+    const size_t chunkBegin = chunk * ChunkSize;
+    const size_t chunkEnd = std::min(chunkBegin + ChunkSize, m_closes.size());
+    size_t first = chunkBegin;
+
+    if (type == MovingAverageType::Simple)
+    {
+      // Running sum over window of period closes, 0 until period closes are seen
+      const size_t length = static_cast<size_t>(period);
+      first = chunkBegin >= length - 1 ? chunkBegin - (length - 1) : 0;
+
+      double sum = 0.0;
+      for (size_t i = first; i < chunkEnd; ++i)
+      {
+        sum += closes[i];
+        if (i >= first + length)
+        {
+          sum -= closes[i - length];
+        }
+        if (i >= chunkBegin)
+        {
+          values[i] = i + 1 >= length ? sum / static_cast<double>(length) : 0.0;
+        }
+      }
+    }
+    else
+    {
+      const double multiplier = 2.0 / (period + 1.0);
+      double value = 0.0;
+      size_t i = chunkBegin;
+
+      if (chunkBegin == 0)
+      {
+        // Seeded with first close, same as batch EMA
+        value = values[0] = closes[0];
+        i = 1;
+      }
+      else if (series.cached[chunk - 1])
+      {
+        value = values[chunkBegin - 1];
+      }
+      else
+      {
+        // Seed error decays below tolerance over warm up
+        const size_t warmUp = GetWarmUp(type, period);
+        first = chunkBegin > warmUp ? chunkBegin - warmUp : 0;
+        value = closes[first];
+        for (size_t j = first + 1; j < chunkBegin; ++j)
+        {
+          value = (closes[j] - value) * multiplier + value;
+        }
+      }
+
+      for (; i < chunkEnd; ++i)
+      {
+        value = (closes[i] - value) * multiplier + value;
+        values[i] = value;
+      }
+    }
+
+    series.cached[chunk] = true;
+    m_stats.computedChunks++;
+    m_stats.computedBars += chunkEnd - first;
+    m_stats.computeMs += timer.ElapsedMilliseconds();
+  }
+
+  void MovingAverageCache::Clear()
+  {
+    m_symbol.clear();
+    m_range.clear();
+    m_granularity.clear();
+    m_closes.clear();
+    m_series.clear();
+  }
+
+  size_t MovingAverageCache::GetMemoryUsage() const
+  {
+    size_t bytes = sizeof(*this) + m_closes.capacity() * sizeof(double);
+    for (const auto& [key, series] : m_series)
+    {
+      bytes += sizeof(series) + series.values.capacity() * sizeof(double) + series.cached.capacity() / 8;
+    }
+    return bytes;
+  }
+
+  size_t MovingAverageCache::GetWarmUp(MovingAverageType type, int period)
+  {
+    period = std::max(period, 1);
+    if (type == MovingAverageType::Simple)
+    {
+      return static_cast<size_t>(period - 1);
+    }
+
+    // Seed weight after w steps is (1 - alpha)^w
+    const double decay = 1.0 - 2.0 / (period + 1.0);
+    return decay > 0.0 ? static_cast<size_t>(std::ceil(std::log(EMATolerance) / std::log(decay))) : 0;
+  }
+} // namespace KanVest
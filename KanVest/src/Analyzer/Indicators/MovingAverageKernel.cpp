@@ -0,0 +1,155 @@
+//
+//  MovingAverageKernel.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "MovingAverageKernel.hpp"
+
+namespace KanVest
+{
+  // Lanes processed together, fits AVX2 as 2 x 4 doubles or 8 floats and NEON as 4 x 2 doubles or 2 x 4 floats
+  static constexpr size_t LaneWidth = 8;
+
+  template<typename T>
+  void MovingAverageKernel::ComputeSMA(const T* closes, size_t count, const std::vector<int>& periods, BasicIndicatorMatrix<T>& output)
+  {
+    IK_PERFORMANCE_FUNC("MovingAverageKernel::ComputeSMA");
+
+    output.Resize(periods.size(), count);
+    std::fill(output.values.begin(), output.values.end(), T(0));
+    if (count == 0)
+    {
+      return;
+    }
+
+    // Prefix sum as double-double (Neumaier), high and low parts are separate columns.
+    // prefix[i] is sum of first i closes, so window sum is prefix[i + 1] - prefix[i + 1 - period]
+    thread_local std::vector<double> prefixHigh, prefixLow;
+    prefixHigh.resize(count + 1);
+    prefixLow.resize(count + 1);
+
+    double sum = 0.0, compensation = 0.0;
+    prefixHigh[0] = prefixLow[0] = 0.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      const double value = static_cast<double>(closes[i]);
+      const double total = sum + value;
+      compensation += std::abs(sum) >= std::abs(value) ? (sum - total) + value : (value - total) + sum;
+      sum = total;
+
+      prefixHigh[i + 1] = sum;
+      prefixLow[i + 1] = compensation;
+    }
+
+    // One branch free difference loop per period over shared prefix columns
+    const double* high = prefixHigh.data();
+    const double* low = prefixLow.data();
+    for (size_t row = 0; row < periods.size(); ++row)
+    {
+      const size_t period = static_cast<size_t>(periods[row]);
+      if (period == 0 or period > count)
+      {
+        continue;
+      }
+
+      const double inversePeriod = 1.0 / static_cast<double>(period);
+      T* out = output.Row(row);
+      for (size_t i = period - 1; i < count; ++i)
+      {
+        out[i] = static_cast<T>(((high[i + 1] - high[i + 1 - period]) + (low[i + 1] - low[i + 1 - period])) * inversePeriod);
+      }
+    }
+  }
+
+  template<typename T>
+  void MovingAverageKernel::ComputeEMA(const T* closes, size_t count, const std::vector<int>& periods, BasicIndicatorMatrix<T>& output)
+  {
+    IK_PERFORMANCE_FUNC("MovingAverageKernel::ComputeEMA");
+
+    const size_t periodCount = periods.size();
+    output.Resize(periodCount, count);
+    if (count == 0 or periodCount == 0)
+    {
+      return;
+    }
+
+    // EMA is recurrent in time, so vectorize over periods: every bar advances all period lanes.
+    // Error of each step decays by (1 - multiplier), so state is kept in storage type
+    std::vector<T> multipliers(periodCount), state(periodCount, closes[0]);
+    for (size_t row = 0; row < periodCount; ++row)
+    {
+      multipliers[row] = static_cast<T>(2.0 / (periods[row] + 1.0));
+      output.At(row, 0) = closes[0];
+    }
+
+    for (size_t i = 1; i < count; ++i)
+    {
+      const T close = closes[i];
+      for (size_t row = 0; row < periodCount; ++row)
+      {
+        state[row] = (close - state[row]) * multipliers[row] + state[row];
+      }
+      for (size_t row = 0; row < periodCount; ++row)
+      {
+        output.values[row * count + i] = state[row];
+      }
+    }
+  }
+
+  template<typename T>
+  void MovingAverageKernel::ComputeEMAAcrossSymbols(const std::vector<const T*>& closes, size_t count, int period, BasicIndicatorMatrix<T>& output)
+  {
+    IK_PERFORMANCE_FUNC("MovingAverageKernel::ComputeEMAAcrossSymbols");
+
+    const size_t symbolCount = closes.size();
+    output.Resize(symbolCount, count);
+    if (count == 0 or symbolCount == 0)
+    {
+      return;
+    }
+
+    const T multiplier = static_cast<T>(2.0 / (period + 1.0));
+
+    // Symbols are processed in blocks of lanes. Missing lanes of last block read first symbol and write to scratch row,
+    // so every lane loop has constant trip count and vectorizes
+    thread_local std::vector<T> scratchRow;
+    scratchRow.resize(count);
+
+    for (size_t first = 0; first < symbolCount; first += LaneWidth)
+    {
+      const T* input[LaneWidth];
+      T* out[LaneWidth];
+      for (size_t lane = 0; lane < LaneWidth; ++lane)
+      {
+        const bool valid = first + lane < symbolCount;
+        input[lane] = valid ? closes[first + lane] : closes[first];
+        out[lane] = valid ? output.Row(first + lane) : scratchRow.data();
+      }
+
+      T state[LaneWidth];
+      for (size_t lane = 0; lane < LaneWidth; ++lane)
+      {
+        state[lane] = input[lane][0];
+        out[lane][0] = state[lane];
+      }
+
+      for (size_t i = 1; i < count; ++i)
+      {
+        for (size_t lane = 0; lane < LaneWidth; ++lane)
+        {
+          state[lane] = (input[lane][i] - state[lane]) * multiplier + state[lane];
+          out[lane][i] = state[lane];
+        }
+      }
+    }
+  }
+
+  template void MovingAverageKernel::ComputeSMA<double>(const double*, size_t, const std::vector<int>&, IndicatorMatrix&);
+  template void MovingAverageKernel::ComputeSMA<float>(const float*, size_t, const std::vector<int>&, IndicatorMatrix32&);
+  template void MovingAverageKernel::ComputeEMA<double>(const double*, size_t, const std::vector<int>&, IndicatorMatrix&);
+  template void MovingAverageKernel::ComputeEMA<float>(const float*, size_t, const std::vector<int>&, IndicatorMatrix32&);
+  template void MovingAverageKernel::ComputeEMAAcrossSymbols<double>(const std::vector<const double*>&, size_t, int, IndicatorMatrix&);
+  template void MovingAverageKernel::ComputeEMAAcrossSymbols<float>(const std::vector<const float*>&, size_t, int, IndicatorMatrix32&);
+} // namespace KanVest
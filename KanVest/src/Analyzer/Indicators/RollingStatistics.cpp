@@ -0,0 +1,153 @@
+//
+//  RollingStatistics.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "RollingStatistics.hpp"
+
+namespace KanVest
+{
+  static constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+  /// This function computes rolling extreme with van Herk / Gil-Werman algorithm. Values are split in blocks of window,
+  /// prefix holds extreme from block start and suffix extreme to block end. Window ending at i spans at most two blocks,
+  /// so its extreme is select(suffix[i - window + 1], prefix[i])
+  template<typename Select>
+  static void ComputeExtreme(const double* values, size_t count, size_t window, double* output, Select select)
+  {
+    std::fill(output, output + count, NaN);
+    if (window == 0 or window > count)
+    {
+      return;
+    }
+
+    thread_local std::vector<double> prefix, suffix;
+    prefix.resize(count);
+    suffix.resize(count);
+
+    for (size_t start = 0; start < count; start += window)
+    {
+      const size_t end = std::min(start + window, count);
+      prefix[start] = values[start];
+      for (size_t i = start + 1; i < end; ++i)
+      {
+        prefix[i] = select(prefix[i - 1], values[i]);
+      }
+      suffix[end - 1] = values[end - 1];
+      for (size_t i = end - 1; i > start; --i)
+      {
+        suffix[i - 1] = select(suffix[i], values[i - 1]);
+      }
+    }
+
+    // Branch free combine loop, vectorizes to max / min instructions
+    const double* head = suffix.data();
+    const double* tail = prefix.data() + window - 1;
+    double* out = output + window - 1;
+    const size_t outputs = count - window + 1;
+    for (size_t i = 0; i < outputs; ++i)
+    {
+      out[i] = select(head[i], tail[i]);
+    }
+  }
+
+  void RollingStatistics::ComputeMeanDeviation(const double* values, size_t count, size_t window, double* mean, double* deviation)
+  {
+    IK_PERFORMANCE_FUNC("RollingStatistics::ComputeMeanDeviation");
+
+    if (mean)
+    {
+      std::fill(mean, mean + count, NaN);
+    }
+    if (deviation)
+    {
+      std::fill(deviation, deviation + count, NaN);
+    }
+    if (window == 0 or window > count)
+    {
+      return;
+    }
+
+    // Compensated (Neumaier) prefix sums of shifted values and their squares, high and low parts are separate columns.
+    // prefix[i] is sum of first i values, so window sum is prefix[i + 1] - prefix[i + 1 - window]
+    thread_local std::vector<double> sumHigh, sumLow, squareHigh, squareLow;
+    sumHigh.resize(count + 1);
+    sumLow.resize(count + 1);
+    squareHigh.resize(count + 1);
+    squareLow.resize(count + 1);
+
+    auto Accumulate = [](double& sum, double& compensation, double value) {
+      const double total = sum + value;
+      compensation += std::abs(sum) >= std::abs(value) ? (sum - total) + value : (value - total) + sum;
+      sum = total;
+    };
+
+    const double shift = values[0];
+    double sum = 0.0, sumCompensation = 0.0, squares = 0.0, squareCompensation = 0.0;
+    sumHigh[0] = sumLow[0] = squareHigh[0] = squareLow[0] = 0.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      const double value = values[i] - shift;
+      Accumulate(sum, sumCompensation, value);
+      Accumulate(squares, squareCompensation, value * value);
+
+      sumHigh[i + 1] = sum;
+      sumLow[i + 1] = sumCompensation;
+      squareHigh[i + 1] = squares;
+      squareLow[i + 1] = squareCompensation;
+    }
+
+    // Branch free difference loop over prefix columns
+    const double inverseWindow = 1.0 / static_cast<double>(window);
+    for (size_t i = window - 1; i < count; ++i)
+    {
+      const size_t first = i + 1 - window;
+      const double windowSum = (sumHigh[i + 1] - sumHigh[first]) + (sumLow[i + 1] - sumLow[first]);
+      const double windowSquares = (squareHigh[i + 1] - squareHigh[first]) + (squareLow[i + 1] - squareLow[first]);
+      const double shiftedMean = windowSum * inverseWindow;
+      if (mean)
+      {
+        mean[i] = shiftedMean + shift;
+      }
+      if (deviation)
+      {
+        deviation[i] = std::sqrt(std::max(0.0, windowSquares * inverseWindow - shiftedMean * shiftedMean));
+      }
+    }
+  }
+
+  void RollingStatistics::ComputeMaximum(const double* values, size_t count, size_t window, double* output)
+  {
+    IK_PERFORMANCE_FUNC("RollingStatistics::ComputeMaximum");
+    ComputeExtreme(values, count, window, output, [](double a, double b) { return a > b ? a : b; });
+  }
+
+  void RollingStatistics::ComputeMinimum(const double* values, size_t count, size_t window, double* output)
+  {
+    IK_PERFORMANCE_FUNC("RollingStatistics::ComputeMinimum");
+    ComputeExtreme(values, count, window, output, [](double a, double b) { return a < b ? a : b; });
+  }
+
+  void RollingStatistics::ComputeQuantile(const double* values, size_t count, size_t window, double quantile, double* output)
+  {
+    IK_PERFORMANCE_FUNC("RollingStatistics::ComputeQuantile");
+
+    std::fill(output, output + count, NaN);
+    if (window == 0 or window > count)
+    {
+      return;
+    }
+
+    RollingQuantile<double> rolling(window, quantile);
+    for (size_t i = 0; i < count; ++i)
+    {
+      rolling.Append(values[i]);
+      if (i + 1 >= window)
+      {
+        output[i] = rolling.Value();
+      }
+    }
+  }
+} // namespace KanVest
@@ -0,0 +1,399 @@
+//
+//  StreamingIndicators.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "StreamingIndicators.hpp"
+
+namespace KanVest
+{
+  // StreamingSMA ----------------------------------------------------------------------------------------------------
+  StreamingSMA::StreamingSMA(int period)
+  : m_period(static_cast<size_t>(std::max(period, 1)))
+  {
+    Reset();
+  }
+
+  void StreamingSMA::Reset()
+  {
+    m_state = {};
+    m_state.ring.assign(m_period, 0.0);
+  }
+
+  double StreamingSMA::Append(double close)
+  {
+    const size_t slot = m_state.count % m_period;
+    m_state.count++;
+
+    // Same operation order as batch DMA, so values are bit identical
+    m_state.prevSum = m_state.sum;
+    m_state.evicted = m_state.ring[slot];
+    m_state.sum += close;
+    if (m_state.count > m_period)
+    {
+      m_state.sum -= m_state.evicted;
+    }
+    m_state.ring[slot] = close;
+    return Value();
+  }
+
+  double StreamingSMA::UpdateLast(double close)
+  {
+    if (m_state.count == 0)
+    {
+      return Append(close);
+    }
+
+    const size_t slot = (m_state.count - 1) % m_period;
+    m_state.sum = m_state.prevSum + close;
+    if (m_state.count > m_period)
+    {
+      m_state.sum -= m_state.evicted;
+    }
+    m_state.ring[slot] = close;
+    return Value();
+  }
+
+  // StreamingEMA ----------------------------------------------------------------------------------------------------
+  StreamingEMA::StreamingEMA(int period)
+  : m_period(period), m_multiplier(2.0 / (period + 1.0))
+  {
+  }
+
+  StreamingEMA::State StreamingEMA::Step(const State& state, double close) const
+  {
+    State next;
+    next.count = state.count + 1;
+    next.value = state.count == 0 ? close : (close - state.value) * m_multiplier + state.value;
+    return next;
+  }
+
+  double StreamingEMA::Append(double close)
+  {
+    m_prevState = m_state;
+    m_state = Step(m_prevState, close);
+    return m_state.value;
+  }
+
+  double StreamingEMA::UpdateLast(double close)
+  {
+    if (m_state.count == 0)
+    {
+      return Append(close);
+    }
+    m_state = Step(m_prevState, close);
+    return m_state.value;
+  }
+
+  // StreamingRSI ----------------------------------------------------------------------------------------------------
+  StreamingRSI::StreamingRSI(size_t period)
+  : m_period(std::max<size_t>(period, 1))
+  {
+  }
+
+  StreamingRSI::State StreamingRSI::Step(const State& state, double close) const
+  {
+    State next = state;
+    next.count = state.count + 1;
+    next.lastClose = close;
+    next.value = std::numeric_limits<double>::quiet_NaN();
+
+    if (state.count == 0)
+    {
+      return next;
+    }
+
+    // Index of this close in series
+    const size_t index = state.count;
+    const double diff = close - state.lastClose;
+
+    // Seed with simple average of first `period` changes
+    if (index <= m_period)
+    {
+      if (diff > 0)
+        next.gainSum += diff;
+      else
+        next.lossSum += -diff;
+
+      if (index == m_period)
+      {
+        next.avgGain = next.gainSum / m_period;
+        next.avgLoss = next.lossSum / m_period;
+        next.value = next.avgLoss == 0.0 ? 100.0 : 100.0 - (100.0 / (1.0 + (next.avgGain / next.avgLoss)));
+      }
+      return next;
+    }
+
+    // Wilder smoothing
+    const double gain = diff > 0 ? diff : 0.0;
+    const double loss = diff < 0 ? -diff : 0.0;
+    next.avgGain = (state.avgGain * (m_period - 1) + gain) / m_period;
+    next.avgLoss = (state.avgLoss * (m_period - 1) + loss) / m_period;
+
+    if (next.avgLoss == 0.0)
+      next.value = 100.0;
+    else if (next.avgGain == 0.0)
+      next.value = 0.0;
+    else
+      next.value = 100.0 - (100.0 / (1.0 + (next.avgGain / next.avgLoss)));
+    return next;
+  }
+
+  double StreamingRSI::Append(double close)
+  {
+    m_prevState = m_state;
+    m_state = Step(m_prevState, close);
+    return m_state.value;
+  }
+
+  double StreamingRSI::UpdateLast(double close)
+  {
+    if (m_state.count == 0)
+    {
+      return Append(close);
+    }
+    m_state = Step(m_prevState, close);
+    return m_state.value;
+  }
+
+  // StreamingIndicatorSet -------------------------------------------------------------------------------------------
+  void StreamingIndicatorSet::Reset(const StockData& data)
+  {
+    m_range = data.range;
+    m_granularity = data.dataGranularity;
+    m_timestamps.clear();
+    m_closes.clear();
+
+    m_sma.clear();
+    m_ema.clear();
+    m_rsi.Reset();
+
+    m_maResult = {};
+    m_rsiSeries = {};
+
+    const size_t size = data.candleHistory.size();
+    m_timestamps.reserve(size);
+    m_closes.reserve(size);
+    m_rsiSeries.series.reserve(size);
+    for (int period : MovingAverage::GetActivePeriods(data.range))
+    {
+      m_sma.emplace_back(period);
+      m_ema.emplace_back(period);
+      m_maResult.dmaValues[period];
+      m_maResult.emaValues[period];
+    }
+
+    m_revisionCheckpoint = GetCheckpoint();
+    m_pendingCheckpoint = {};
+  }
+
+  size_t StreamingIndicatorSet::Sync(const StockData& data)
+  {
+    const auto& history = data.candleHistory;
+    if (!data.IsValid() or history.empty())
+    {
+      Reset(data);
+      UpdateMovingAverageTail();
+      return 0;
+    }
+
+    const size_t n = history.size();
+    const bool sameSeries = !m_closes.empty() and m_range == data.range and m_granularity == data.dataGranularity and
+    n >= m_closes.size() and history.front().timestamp == m_timestamps.front() and history.front().close == m_closes.front();
+
+    size_t replayFrom = 0;
+    size_t processed = 0;
+    if (sameSeries)
+    {
+      // Candles before checkpoint are final. Look for revision between checkpoint and forming candle
+      if (m_pendingCheckpoint.count > m_revisionCheckpoint.count and m_pendingCheckpoint.count + RevisionWindow <= n)
+      {
+        m_revisionCheckpoint = std::move(m_pendingCheckpoint);
+        m_pendingCheckpoint = {};
+      }
+
+      const size_t last = m_closes.size() - 1;
+      replayFrom = m_closes.size();
+      for (size_t i = m_revisionCheckpoint.count; i < last; ++i)
+      {
+        if (history[i].timestamp != m_timestamps[i] or history[i].close != m_closes[i])
+        {
+          Restore(m_revisionCheckpoint);
+          replayFrom = m_revisionCheckpoint.count;
+          m_pendingCheckpoint = {};
+          break;
+        }
+      }
+
+      // Forming candle update
+      if (replayFrom > last and (history[last].timestamp != m_timestamps[last] or history[last].close != m_closes[last]))
+      {
+        m_timestamps[last] = history[last].timestamp;
+        UpdateLast(history[last].close);
+        processed++;
+      }
+    }
+    else
+    {
+      Reset(data);
+    }
+
+    for (size_t i = replayFrom; i < n; ++i)
+    {
+      // Keep a checkpoint before the candles that can still be revised. Candles appended few at a time never pass
+      // n - RevisionWindow, so a pending checkpoint is taken inside the window instead
+      if (i + RevisionWindow == n)
+      {
+        m_revisionCheckpoint = GetCheckpoint();
+        m_pendingCheckpoint = {};
+      }
+      else if (i + RevisionWindow > n and i >= std::max(m_revisionCheckpoint.count, m_pendingCheckpoint.count) + RevisionWindow)
+      {
+        m_pendingCheckpoint = GetCheckpoint();
+      }
+      Append(history[i].timestamp, history[i].close);
+      processed++;
+    }
+
+    UpdateMovingAverageTail();
+    return processed;
+  }
+
+  void StreamingIndicatorSet::Append(uint32_t timestamp, double close)
+  {
+    m_timestamps.push_back(timestamp);
+    m_closes.push_back(close);
+
+    for (auto& sma : m_sma)
+    {
+      sma.Append(close);
+    }
+    for (auto& ema : m_ema)
+    {
+      ema.Append(close);
+    }
+
+    m_rsiSeries.last = m_rsi.Append(close);
+    m_rsiSeries.series.push_back(m_rsiSeries.last);
+  }
+
+  void StreamingIndicatorSet::UpdateLast(double close)
+  {
+    if (m_closes.empty())
+    {
+      return;
+    }
+    m_closes.back() = close;
+
+    for (auto& sma : m_sma)
+    {
+      sma.UpdateLast(close);
+    }
+    for (auto& ema : m_ema)
+    {
+      ema.UpdateLast(close);
+    }
+
+    m_rsiSeries.last = m_rsi.UpdateLast(close);
+    m_rsiSeries.series.back() = m_rsiSeries.last;
+  }
+
+  StreamingIndicatorSet::Checkpoint StreamingIndicatorSet::GetCheckpoint() const
+  {
+    Checkpoint checkpoint;
+    checkpoint.count = m_closes.size();
+    checkpoint.rsi = m_rsi.GetCheckpoint();
+
+    checkpoint.sma.reserve(m_sma.size());
+    for (const auto& sma : m_sma)
+    {
+      checkpoint.sma.push_back(sma.GetCheckpoint());
+    }
+    checkpoint.ema.reserve(m_ema.size());
+    for (const auto& ema : m_ema)
+    {
+      checkpoint.ema.push_back(ema.GetCheckpoint());
+    }
+    return checkpoint;
+  }
+
+  void StreamingIndicatorSet::Restore(const Checkpoint& checkpoint)
+  {
+    IK_ASSERT(checkpoint.sma.size() == m_sma.size() and checkpoint.ema.size() == m_ema.size(), "Checkpoint is of different period set");
+
+    for (size_t i = 0; i < m_sma.size(); ++i)
+    {
+      m_sma[i].Restore(checkpoint.sma[i]);
+      m_ema[i].Restore(checkpoint.ema[i]);
+    }
+    m_rsi.Restore(checkpoint.rsi);
+
+    const size_t count = std::min(checkpoint.count, m_closes.size());
+    m_timestamps.resize(count);
+    m_closes.resize(count);
+    UpdateMovingAverageTail();
+    m_rsiSeries.series.resize(count);
+    m_rsiSeries.last = count ? m_rsiSeries.series.back() : std::numeric_limits<double>::quiet_NaN();
+  }
+
+  void StreamingIndicatorSet::UpdateMovingAverageTail()
+  {
+    // Map iteration is ascending, same order as active periods. Trend score needs value and its slope only
+    size_t index = 0;
+    for (auto& [period, values] : m_maResult.dmaValues)
+    {
+      const StreamingSMA& sma = m_sma[index++];
+      values.assign({sma.PreviousValue(), sma.Value()});
+    }
+    index = 0;
+    for (auto& [period, values] : m_maResult.emaValues)
+    {
+      const StreamingEMA& ema = m_ema[index++];
+      values.assign({ema.PreviousValue(), ema.Value()});
+    }
+  }
+
+  const MAResult& StreamingIndicatorSet::GetMAResult() const
+  {
+    // Batch version needs minimum candles to compute any average
+    static const MAResult EmptyResult;
+    return m_closes.size() >= MinMovingAverageCandles ? m_maResult : EmptyResult;
+  }
+
+  size_t StreamingIndicatorSet::GetMemoryUsage() const
+  {
+    size_t bytes = sizeof(*this) + m_timestamps.capacity() * sizeof(uint32_t) + m_closes.capacity() * sizeof(double);
+    bytes += m_ema.capacity() * sizeof(StreamingEMA) + m_rsiSeries.series.capacity() * sizeof(double);
+    for (const auto& sma : m_sma)
+    {
+      bytes += sizeof(StreamingSMA) + static_cast<size_t>(sma.GetPeriod()) * sizeof(double);
+    }
+    for (const auto& [period, values] : m_maResult.dmaValues)
+    {
+      bytes += values.capacity() * sizeof(double);
+    }
+    for (const auto& [period, values] : m_maResult.emaValues)
+    {
+      bytes += values.capacity() * sizeof(double);
+    }
+
+    // Checkpoints keep their own copy of SMA rings
+    for (const Checkpoint* checkpoint : {&m_revisionCheckpoint, &m_pendingCheckpoint})
+    {
+      for (const auto& sma : checkpoint->sma)
+      {
+        bytes += sizeof(sma) + sma.ring.capacity() * sizeof(double);
+      }
+      bytes += checkpoint->ema.capacity() * sizeof(StreamingEMA::Checkpoint);
+    }
+    return bytes;
+  }
+
+  const RSISeries& StreamingIndicatorSet::GetRSI() const
+  {
+    static const RSISeries EmptySeries;
+    return m_closes.size() >= 2 ? m_rsiSeries : EmptySeries;
+  }
+} // namespace KanVest
@@ -0,0 +1,500 @@
+//
+//  Volatility.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "Volatility.hpp"
+
+namespace KanVest
+{
+  static constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+  static constexpr double Ln2 = 0.693147180559945309417232121458;
+  static constexpr double GarmanKlassFactor = 2.0 * Ln2 - 1.0;
+
+  // Log columns of one block stay in L1 between log and rolling loops
+  static constexpr size_t BlockSize = 256;
+
+  // Per bar terms summed over window
+  enum Term : size_t
+  {
+    Return, ReturnSquare,               //< Close to close
+    RangeSquare,                        //< Parkinson
+    GarmanKlassTerm,
+    RogersSatchellTerm,
+    Overnight, OvernightSquare,         //< Yang-Zhang open jump
+    Intraday, IntradaySquare,           //< Yang-Zhang open to close
+    TermCount
+  };
+
+  /// This function returns natural log without branches. Mantissa is reduced to [sqrt(0.5), sqrt(2)) with integer
+  /// operations and its log is odd atanh series, so loops over columns vectorize without vector math library.
+  /// Relative error is below 1e-15 for positive normal input
+  static inline double FastLog(double x)
+  {
+    constexpr uint64_t SqrtHalfBits = 0x3FE6A09E667F3BCDull;
+    constexpr uint64_t ExponentMask = 0xFFF0000000000000ull;
+    constexpr uint64_t ExponentBias = 1024ull << 52;
+    constexpr uint64_t MagicBits = 0x4330000000000000ull;   // 2^52, integer below it in mantissa bits converts exactly
+    constexpr double Magic = 4503599627370496.0;
+
+    const uint64_t bits = std::bit_cast<uint64_t>(x);
+    const uint64_t offset = bits - SqrtHalfBits;
+    const double mantissa = std::bit_cast<double>(bits - (offset & ExponentMask));
+
+    // Signed exponent on top 12 bits of offset, biased so it converts without 64 bit signed shift
+    const double exponent = std::bit_cast<double>(((offset + ExponentBias) >> 52) | MagicBits) - Magic - 1024.0;
+
+    const double f = mantissa - 1.0;
+    const double s = f / (2.0 + f);
+    const double z = s * s;
+    const double series = 1.0 + z * (1.0 / 3.0 + z * (1.0 / 5.0 + z * (1.0 / 7.0 + z * (1.0 / 9.0 + z * (1.0 / 11.0 + z * (1.0 / 13.0 + z * (1.0 / 15.0
+                        + z * (1.0 / 17.0 + z * (1.0 / 19.0 + z * (1.0 / 21.0))))))))));
+    return exponent * Ln2 + 2.0 * s * series;
+  }
+
+  /// This function returns the price ratio, 1 if either price is missing or not positive
+  static inline double Ratio(double numerator, double denominator)
+  {
+    const double ratio = numerator / denominator;
+    return (ratio > 1e-300) & (ratio < 1e300) ? ratio : 1.0;
+  }
+
+  /// This function returns the true range, 0 if prices are missing
+  static inline double TrueRange(double high, double low, double previousClose)
+  {
+    const double range = std::max(high, previousClose) - std::min(low, previousClose);
+    return range >= 0.0 ? range : 0.0;
+  }
+
+  /// This function returns the window terms of bar from its log ratios
+  /// - Parameters:
+  ///   - ho, lo, co: log of high, low and close over open
+  ///   - oc: log of open over previous close
+  static inline std::array<double, TermCount> GetTerms(double ho, double lo, double co, double oc)
+  {
+    const double hl = ho - lo;
+    const double cc = oc + co;
+    return {
+      cc, cc * cc,
+      hl * hl,
+      0.5 * hl * hl - GarmanKlassFactor * co * co,
+      ho * (ho - co) + lo * (lo - co),
+      oc, oc * oc,
+      co, co * co
+    };
+  }
+
+  /// This function converts variance per bar to annualized volatility in %
+  static inline double Annualize(double variance, double periodsPerYear)
+  {
+    return std::sqrt(std::max(variance, 0.0) * periodsPerYear) * 100.0;
+  }
+
+  // Volatility Series -----------------------------------------------------------------------------------------------
+  double VolatilitySeries::Latest(VolatilityEstimator estimator) const
+  {
+    const auto& series = Get(estimator);
+    return series.empty() ? NaN : series.back();
+  }
+
+  double VolatilitySeries::GetLatestPercentile(VolatilityEstimator estimator) const
+  {
+    const double latest = Latest(estimator);
+    if (std::isnan(latest))
+    {
+      return NaN;
+    }
+
+    size_t valid = 0, below = 0;
+    for (double value : Get(estimator))
+    {
+      valid += !std::isnan(value);
+      below += value <= latest;
+    }
+    return valid ? 100.0 * static_cast<double>(below) / static_cast<double>(valid) : NaN;
+  }
+
+  size_t VolatilitySeries::GetMemoryUsage() const
+  {
+    size_t bytes = sizeof(*this) + atr.capacity() * sizeof(double);
+    for (const auto& series : values)
+    {
+      bytes += series.capacity() * sizeof(double);
+    }
+    return bytes;
+  }
+
+  // Volatility ------------------------------------------------------------------------------------------------------
+  void Volatility::Compute(const double* opens, const double* highs, const double* lows, const double* closes, size_t count, size_t window,
+                           size_t atrPeriod, double periodsPerYear, VolatilitySeries& output, size_t begin)
+  {
+    IK_PERFORMANCE_FUNC("Volatility::Compute");
+
+    window = std::max<size_t>(window, 2);
+    atrPeriod = std::max<size_t>(atrPeriod, 1);
+
+    // Values before begin are kept only if they were computed with same parameters
+    if (output.window != window or output.atrPeriod != atrPeriod or output.periodsPerYear != periodsPerYear)
+    {
+      begin = 0;
+    }
+    begin = std::min({begin, count, output.Size()});
+
+    output.window = window;
+    output.atrPeriod = atrPeriod;
+    output.periodsPerYear = periodsPerYear;
+    output.atr.resize(count);
+    for (auto& series : output.values)
+    {
+      series.resize(count);
+    }
+    if (begin == count)
+    {
+      return;
+    }
+
+    std::array<double, BlockSize> highOpen, lowOpen, closeOpen, openJump, trueRange;
+
+    // Terms of last window bars, one bar updates all sums together
+    thread_local std::vector<std::array<double, TermCount>> ring;
+    ring.assign(window, {});
+    std::array<double, TermCount>* slots = ring.data();
+    size_t slotIndex = 0;
+    std::array<double, TermCount> sums {};
+
+    const double n = static_cast<double>(window);
+    const double inverseN = 1.0 / n, inverseSample = 1.0 / (n - 1.0);
+    const double yangZhangK = 0.34 / (1.34 + (n + 1.0) / (n - 1.0));
+    double atr = 0.0, trueRangeSum = 0.0;
+
+    // Resumed pass refills window with bars before begin, oldest at slot 0, and continues ATR from its last value
+    if (begin > 0)
+    {
+      const size_t start = begin > window ? begin - window : 0;
+      for (size_t i = start; i < begin; ++i)
+      {
+        const double previousClose = i > 0 ? closes[i - 1] : opens[0];
+        const double oc = i > 0 ? FastLog(Ratio(opens[i], previousClose)) : 0.0;
+        const auto terms = GetTerms(FastLog(Ratio(highs[i], opens[i])), FastLog(Ratio(lows[i], opens[i])), FastLog(Ratio(closes[i], opens[i])), oc);
+
+        slots[window - (begin - i)] = terms;
+        for (size_t k = 0; k < TermCount; ++k)
+        {
+          sums[k] += terms[k];
+        }
+      }
+
+      if (begin < atrPeriod)
+      {
+        for (size_t i = 0; i < begin; ++i)
+        {
+          trueRangeSum += TrueRange(highs[i], lows[i], i > 0 ? closes[i - 1] : opens[0]);
+        }
+      }
+      else
+      {
+        atr = output.atr[begin - 1];
+      }
+    }
+
+    double* atrValues = output.atr.data();
+
+    double* closeToClose = output.values[static_cast<size_t>(VolatilityEstimator::CloseToClose)].data();
+    double* parkinson = output.values[static_cast<size_t>(VolatilityEstimator::Parkinson)].data();
+    double* garmanKlass = output.values[static_cast<size_t>(VolatilityEstimator::GarmanKlass)].data();
+    double* rogersSatchell = output.values[static_cast<size_t>(VolatilityEstimator::RogersSatchell)].data();
+    double* yangZhang = output.values[static_cast<size_t>(VolatilityEstimator::YangZhang)].data();
+
+    for (size_t blockBegin = begin; blockBegin < count; blockBegin += BlockSize)
+    {
+      const size_t size = std::min(BlockSize, count - blockBegin);
+      const double* o = opens + blockBegin;
+      const double* h = highs + blockBegin;
+      const double* l = lows + blockBegin;
+      const double* c = closes + blockBegin;
+
+      // First bar has no previous close, it opens at its own open
+      size_t first = 0;
+      if (blockBegin == 0)
+      {
+        highOpen[0] = FastLog(Ratio(h[0], o[0]));
+        lowOpen[0] = FastLog(Ratio(l[0], o[0]));
+        closeOpen[0] = FastLog(Ratio(c[0], o[0]));
+        openJump[0] = 0.0;
+        trueRange[0] = TrueRange(h[0], l[0], o[0]);
+        first = 1;
+      }
+
+      // Only log ratios shared by all estimators, branch free over contiguous columns
+      for (size_t j = first; j < size; ++j)
+      {
+        const double previousClose = c[j - 1];
+        highOpen[j] = FastLog(Ratio(h[j], o[j]));
+        lowOpen[j] = FastLog(Ratio(l[j], o[j]));
+        closeOpen[j] = FastLog(Ratio(c[j], o[j]));
+        openJump[j] = FastLog(Ratio(o[j], previousClose));
+        trueRange[j] = TrueRange(h[j], l[j], previousClose);
+      }
+
+      // All estimators from same log ratios, one rolling update per bar
+      for (size_t j = 0; j < size; ++j)
+      {
+        const size_t i = blockBegin + j;
+        const auto terms = GetTerms(highOpen[j], lowOpen[j], closeOpen[j], openJump[j]);
+
+        auto& slot = slots[slotIndex];
+        slotIndex = slotIndex + 1 == window ? 0 : slotIndex + 1;
+        for (size_t k = 0; k < TermCount; ++k)
+        {
+          sums[k] += terms[k] - slot[k];
+          slot[k] = terms[k];
+        }
+
+        // Every bar of window needs previous close
+        if (i >= window)
+        {
+          const double returnVariance = (sums[ReturnSquare] - sums[Return] * sums[Return] * inverseN) * inverseSample;
+          const double overnightVariance = (sums[OvernightSquare] - sums[Overnight] * sums[Overnight] * inverseN) * inverseSample;
+          const double intradayVariance = (sums[IntradaySquare] - sums[Intraday] * sums[Intraday] * inverseN) * inverseSample;
+          const double rogersSatchellVariance = sums[RogersSatchellTerm] * inverseN;
+
+          closeToClose[i] = returnVariance;
+          parkinson[i] = sums[RangeSquare] * inverseN / (4.0 * Ln2);
+          garmanKlass[i] = sums[GarmanKlassTerm] * inverseN;
+          rogersSatchell[i] = rogersSatchellVariance;
+          yangZhang[i] = overnightVariance + yangZhangK * intradayVariance + (1.0 - yangZhangK) * rogersSatchellVariance;
+        }
+        else
+        {
+          closeToClose[i] = parkinson[i] = garmanKlass[i] = rogersSatchell[i] = yangZhang[i] = NaN;
+        }
+
+        // Wilder smoothing seeded with average of first period true ranges, same as ATR node of indicator graph
+        const double range = trueRange[j];
+        if (i + 1 < atrPeriod)
+        {
+          trueRangeSum += range;
+          atrValues[i] = NaN;
+        }
+        else
+        {
+          atr = i + 1 == atrPeriod ? (trueRangeSum + range) / static_cast<double>(atrPeriod)
+          : (atr * static_cast<double>(atrPeriod - 1) + range) / static_cast<double>(atrPeriod);
+          atrValues[i] = atr;
+        }
+      }
+
+      for (auto& series : output.values)
+      {
+        double* values = series.data() + blockBegin;
+        for (size_t j = 0; j < size; ++j)
+        {
+          values[j] = Annualize(values[j], periodsPerYear);
+        }
+      }
+    }
+  }
+
+  bool Volatility::Compute(const StockData& data, const CandleColumns& columns, VolatilitySeries& output, size_t window, size_t atrPeriod, size_t begin)
+  {
+    if (!data.IsValid() or columns.Size() == 0)
+    {
+      output = {};
+      return false;
+    }
+
+    Compute(columns.opens.data(), columns.highs.data(), columns.lows.data(), columns.closes.data(), columns.Size(), window, atrPeriod,
+            GetPeriodsPerYear(data.dataGranularity), output, begin);
+    return true;
+  }
+
+  void Volatility::ComputeSeparate(const double* opens, const double* highs, const double* lows, const double* closes, size_t count, size_t window,
+                                   size_t atrPeriod, double periodsPerYear, VolatilitySeries& output)
+  {
+    IK_PERFORMANCE_FUNC("Volatility::ComputeSeparate");
+
+    window = std::max<size_t>(window, 2);
+    atrPeriod = std::max<size_t>(atrPeriod, 1);
+    output.window = window;
+    output.atrPeriod = atrPeriod;
+    output.periodsPerYear = periodsPerYear;
+    output.atr.assign(count, NaN);
+    for (auto& series : output.values)
+    {
+      series.assign(count, NaN);
+    }
+
+    const double n = static_cast<double>(window);
+    auto PreviousClose = [&](size_t i) { return i > 0 ? closes[i - 1] : opens[0]; };
+
+    // Rolling sum over window of term(i), value(sums) written once all bars of window have previous close
+    auto Rolling = [&](VolatilityEstimator estimator, size_t terms, auto&& term, auto&& variance) {
+      std::vector<std::array<double, 3>> ring(window, std::array<double, 3> {});
+      std::array<double, 3> sums {};
+      auto& series = output.values[static_cast<size_t>(estimator)];
+      for (size_t i = 0; i < count; ++i)
+      {
+        const std::array<double, 3> values = term(i);
+        auto& slot = ring[i % window];
+        for (size_t k = 0; k < terms; ++k)
+        {
+          sums[k] += values[k] - slot[k];
+          slot[k] = values[k];
+        }
+        if (i >= window)
+        {
+          series[i] = Annualize(variance(sums), periodsPerYear);
+        }
+      }
+    };
+
+    Rolling(VolatilityEstimator::CloseToClose, 2, [&](size_t i) {
+      const double r = std::log(Ratio(closes[i], PreviousClose(i)));
+      return std::array<double, 3> {r, r * r, 0.0};
+    }, [&](const auto& s) { return (s[1] - s[0] * s[0] / n) / (n - 1.0); });
+
+    Rolling(VolatilityEstimator::Parkinson, 1, [&](size_t i) {
+      const double hl = std::log(Ratio(highs[i], lows[i]));
+      return std::array<double, 3> {hl * hl, 0.0, 0.0};
+    }, [&](const auto& s) { return s[0] / (4.0 * Ln2 * n); });
+
+    Rolling(VolatilityEstimator::GarmanKlass, 1, [&](size_t i) {
+      const double hl = std::log(Ratio(highs[i], lows[i]));
+      const double co = std::log(Ratio(closes[i], opens[i]));
+      return std::array<double, 3> {0.5 * hl * hl - GarmanKlassFactor * co * co, 0.0, 0.0};
+    }, [&](const auto& s) { return s[0] / n; });
+
+    auto RogersSatchellTerm = [&](size_t i) {
+      return std::log(Ratio(highs[i], closes[i])) * std::log(Ratio(highs[i], opens[i])) + std::log(Ratio(lows[i], closes[i])) * std::log(Ratio(lows[i], opens[i]));
+    };
+    Rolling(VolatilityEstimator::RogersSatchell, 1, [&](size_t i) {
+      return std::array<double, 3> {RogersSatchellTerm(i), 0.0, 0.0};
+    }, [&](const auto& s) { return s[0] / n; });
+
+    // Yang-Zhang keeps its own sums of overnight and open to close moves
+    {
+      const double k = 0.34 / (1.34 + (n + 1.0) / (n - 1.0));
+      std::vector<std::array<double, 5>> ring(window, std::array<double, 5> {});
+      std::array<double, 5> sums {};
+      auto& series = output.values[static_cast<size_t>(VolatilityEstimator::YangZhang)];
+      for (size_t i = 0; i < count; ++i)
+      {
+        const double oc = i > 0 ? std::log(Ratio(opens[i], closes[i - 1])) : 0.0;
+        const double co = std::log(Ratio(closes[i], opens[i]));
+        const std::array<double, 5> values = {oc, oc * oc, co, co * co, RogersSatchellTerm(i)};
+        auto& slot = ring[i % window];
+        for (size_t j = 0; j < values.size(); ++j)
+        {
+          sums[j] += values[j] - slot[j];
+          slot[j] = values[j];
+        }
+        if (i >= window)
+        {
+          const double overnight = (sums[1] - sums[0] * sums[0] / n) / (n - 1.0);
+          const double intraday = (sums[3] - sums[2] * sums[2] / n) / (n - 1.0);
+          series[i] = Annualize(overnight + k * intraday + (1.0 - k) * sums[4] / n, periodsPerYear);
+        }
+      }
+    }
+
+    // ATR
+    double atr = 0.0, trueRangeSum = 0.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      const double range = TrueRange(highs[i], lows[i], PreviousClose(i));
+      if (i + 1 < atrPeriod)
+      {
+        trueRangeSum += range;
+        continue;
+      }
+      atr = i + 1 == atrPeriod ? (trueRangeSum + range) / static_cast<double>(atrPeriod)
+      : (atr * static_cast<double>(atrPeriod - 1) + range) / static_cast<double>(atrPeriod);
+      output.atr[i] = atr;
+    }
+  }
+
+  void Volatility::Benchmark(const double* opens, const double* highs, const double* lows, const double* closes, size_t count, VolatilityBenchmarkStats& stats)
+  {
+    thread_local VolatilitySeries fused, separate;
+
+    KanViz::Timer timer;
+    Compute(opens, highs, lows, closes, count, DefaultWindow, DefaultATRPeriod, GetPeriodsPerYear("1d"), fused);
+    stats.fusedMs += timer.ElapsedMilliseconds();
+
+    timer.Reset();
+    ComputeSeparate(opens, highs, lows, closes, count, DefaultWindow, DefaultATRPeriod, GetPeriodsPerYear("1d"), separate);
+    stats.separateMs += timer.ElapsedMilliseconds();
+
+    // Bad price zeroes different log ratios in two formulations, windows containing one are not compared
+    thread_local std::vector<uint32_t> invalidBars;
+    invalidBars.assign(count + 1, 0);
+    for (size_t i = 0; i < count; ++i)
+    {
+      const bool valid = opens[i] > 0.0 and highs[i] > 0.0 and lows[i] > 0.0 and closes[i] > 0.0 and std::isfinite(opens[i] + highs[i] + lows[i] + closes[i]);
+      invalidBars[i + 1] = invalidBars[i] + !valid;
+    }
+
+    // Value on one side only is a mismatch
+    for (size_t estimator = 0; estimator < fused.values.size(); ++estimator)
+    {
+      for (size_t i = 0; i < count; ++i)
+      {
+        // Window bars and close before them
+        const size_t first = i >= DefaultWindow ? i - DefaultWindow : 0;
+        if (invalidBars[i + 1] != invalidBars[first])
+        {
+          continue;
+        }
+        const double a = fused.values[estimator][i], b = separate.values[estimator][i];
+        const double difference = std::isnan(a) != std::isnan(b) ? std::numeric_limits<double>::infinity() : std::isnan(a) ? 0.0 : std::abs(a - b);
+        stats.maxDifference = std::max(stats.maxDifference, difference);
+      }
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+      const double a = fused.atr[i], b = separate.atr[i];
+      const double error = std::isnan(a) != std::isnan(b) ? std::numeric_limits<double>::infinity() : std::isnan(a) or b == 0.0 ? 0.0 : std::abs(a - b) / std::abs(b);
+      stats.maxATRError = std::max(stats.maxATRError, error);
+    }
+
+    stats.series++;
+    stats.bars += count;
+  }
+
+  double Volatility::GetPeriodsPerYear(const std::string& dataGranularity)
+  {
+    static constexpr double SessionsPerYear = 252.0;
+    static constexpr double SessionMinutes = 375.0;
+
+    size_t digits = 0;
+    while (digits < dataGranularity.size() and std::isdigit(static_cast<unsigned char>(dataGranularity[digits])))
+    {
+      digits++;
+    }
+    const double value = digits ? std::max(std::atof(dataGranularity.substr(0, digits).c_str()), 1.0) : 1.0;
+    const std::string unit = dataGranularity.substr(digits);
+
+    // Intraday bars per session include last partial bar
+    if (unit == "m")  return SessionsPerYear * std::ceil(SessionMinutes / value);
+    if (unit == "h")  return SessionsPerYear * std::ceil(SessionMinutes / (60.0 * value));
+    if (unit == "d")  return SessionsPerYear / value;
+    if (unit == "wk") return 52.0 / value;
+    if (unit == "mo") return 12.0 / value;
+    return SessionsPerYear;
+  }
+
+  std::string_view Volatility::GetName(VolatilityEstimator estimator)
+  {
+    switch (estimator)
+    {
+      case VolatilityEstimator::CloseToClose:   return "Close-Close";
+      case VolatilityEstimator::Parkinson:      return "Parkinson";
+      case VolatilityEstimator::GarmanKlass:    return "Garman-Klass";
+      case VolatilityEstimator::RogersSatchell: return "Rogers-Satchell";
+      case VolatilityEstimator::YangZhang:      return "Yang-Zhang";
+      default: return "";
+    }
+  }
+} // namespace KanVest
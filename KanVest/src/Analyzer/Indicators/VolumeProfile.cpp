@@ -0,0 +1,353 @@
+//
+//  VolumeProfile.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "VolumeProfile.hpp"
+
+#include "Analyzer/MultiTimeframe.hpp"
+
+namespace KanVest
+{
+  static constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+  static double TypicalPrice(const CandleData& candle)
+  {
+    return (candle.high + candle.low + candle.close) / 3.0;
+  }
+
+  static bool IsSameCandle(const CandleData& a, const CandleData& b)
+  {
+    return a.timestamp == b.timestamp and a.open == b.open and a.high == b.high and a.low == b.low and a.close == b.close and a.volume == b.volume;
+  }
+
+  // Volume Profile --------------------------------------------------------------------------------------------------
+  void VolumeProfile::Reset(double binSize)
+  {
+    m_binSize = binSize > 0.0 ? binSize : DefaultTickSize;
+    m_baseBin = 0;
+    m_volumes.clear();
+    m_last = {};
+    m_hasLast = false;
+  }
+
+  void VolumeProfile::Append(const CandleData& candle)
+  {
+    Accumulate(candle, 1.0);
+    m_last = candle;
+    m_hasLast = true;
+  }
+
+  void VolumeProfile::UpdateLast(const CandleData& candle)
+  {
+    if (!m_hasLast)
+    {
+      Append(candle);
+      return;
+    }
+    Accumulate(m_last, -1.0);
+    Accumulate(candle, 1.0);
+    m_last = candle;
+  }
+
+  void VolumeProfile::Cover(double low, double high)
+  {
+    if (m_volumes.empty())
+    {
+      m_baseBin = GetPriceBin(low);
+      m_volumes.assign(static_cast<size_t>(GetPriceBin(high) - m_baseBin + 1), 0.0);
+      return;
+    }
+
+    // Bins are addressed by integer price bin, so growing at front only shifts base bin
+    if (const int64_t lowBin = GetPriceBin(low) - m_baseBin; lowBin < 0)
+    {
+      const size_t grow = std::max(static_cast<size_t>(-lowBin), m_volumes.size() / 2);
+      m_volumes.insert(m_volumes.begin(), grow, 0.0);
+      m_baseBin -= static_cast<int64_t>(grow);
+    }
+    if (const int64_t highBin = GetPriceBin(high) - m_baseBin; highBin >= static_cast<int64_t>(m_volumes.size()))
+    {
+      m_volumes.resize(std::max(static_cast<size_t>(highBin) + 1, m_volumes.size() + m_volumes.size() / 2), 0.0);
+    }
+  }
+
+  void VolumeProfile::Accumulate(const CandleData& candle, double sign)
+  {
+    const double low = candle.low, high = candle.high;
+    if (!(high >= low) or low <= 0.0 or candle.volume == 0)
+    {
+      return;
+    }
+    if (sign > 0.0)
+    {
+      Cover(low, high);
+    }
+
+    const double volume = sign * static_cast<double>(candle.volume);
+    const size_t first = static_cast<size_t>(GetPriceBin(low) - m_baseBin);
+    const size_t last = static_cast<size_t>(GetPriceBin(high) - m_baseBin);
+    if (first == last)
+    {
+      m_volumes[first] += volume;
+      return;
+    }
+
+    // Uniform density over candle range, partial first and last bins
+    const double density = volume / (high - low);
+    m_volumes[first] += density * (GetBinLow(first + 1) - low);
+    for (size_t bin = first + 1; bin < last; ++bin)
+    {
+      m_volumes[bin] += density * m_binSize;
+    }
+    m_volumes[last] += density * (high - GetBinLow(last));
+  }
+
+  VolumeProfileLevels VolumeProfile::ComputeLevels() const
+  {
+    VolumeProfileLevels levels;
+    if (m_volumes.empty())
+    {
+      return levels;
+    }
+
+    size_t pointOfControl = 0;
+    for (size_t bin = 0; bin < m_volumes.size(); ++bin)
+    {
+      levels.totalVolume += std::max(0.0, m_volumes[bin]);
+      pointOfControl = m_volumes[bin] > m_volumes[pointOfControl] ? bin : pointOfControl;
+    }
+    if (levels.totalVolume <= 0.0)
+    {
+      return levels;
+    }
+
+    const double target = ValueAreaFraction * levels.totalVolume;
+    size_t low = pointOfControl, high = pointOfControl;
+    double area = m_volumes[pointOfControl];
+    while (area < target and (low > 0 or high + 1 < m_volumes.size()))
+    {
+      const double below = low > 0 ? m_volumes[low - 1] : -1.0;
+      const double above = high + 1 < m_volumes.size() ? m_volumes[high + 1] : -1.0;
+      area += above >= below ? m_volumes[++high] : m_volumes[--low];
+    }
+
+    levels.pointOfControl = GetBinLow(pointOfControl) + 0.5 * m_binSize;
+    levels.valueAreaLow = GetBinLow(low);
+    levels.valueAreaHigh = GetBinLow(high + 1);
+    return levels;
+  }
+
+  double VolumeProfile::ChooseBinSize(double referencePrice, double tickSize)
+  {
+    const double ticks = std::max(1.0, std::round(referencePrice * BinFraction / tickSize));
+    return ticks * tickSize;
+  }
+
+  // Streaming VWAP --------------------------------------------------------------------------------------------------
+  void StreamingVWAP::Reset(double anchorPrice)
+  {
+    m_shift = anchorPrice;
+    m_lastPrice = anchorPrice;
+    m_closed = {};
+    m_forming = {};
+  }
+
+  double StreamingVWAP::Append(double price, double volume)
+  {
+    m_closed.volume += m_forming.volume;
+    m_closed.price += m_forming.price;
+    m_closed.square += m_forming.square;
+    return UpdateLast(price, volume);
+  }
+
+  double StreamingVWAP::UpdateLast(double price, double volume)
+  {
+    const double shifted = price - m_shift;
+    m_forming = {volume, volume * shifted, volume * shifted * shifted};
+    m_lastPrice = price;
+    return Value();
+  }
+
+  double StreamingVWAP::Value() const
+  {
+    const double volume = m_closed.volume + m_forming.volume;
+    return volume > 0.0 ? m_shift + (m_closed.price + m_forming.price) / volume : m_lastPrice;
+  }
+
+  double StreamingVWAP::Deviation() const
+  {
+    const double volume = m_closed.volume + m_forming.volume;
+    if (volume <= 0.0)
+    {
+      return 0.0;
+    }
+    const double mean = (m_closed.price + m_forming.price) / volume;
+    return std::sqrt(std::max(0.0, (m_closed.square + m_forming.square) / volume - mean * mean));
+  }
+
+  // Volume Analysis -------------------------------------------------------------------------------------------------
+  size_t VolumeAnalysis::Sync(const StockData& data)
+  {
+    IK_PERFORMANCE_FUNC("VolumeAnalysis::Sync");
+
+    const auto& history = data.candleHistory;
+    const size_t n = history.size(), m = m_candles.size();
+
+    // Candles before forming one are final, revision of them rebuilds
+    const bool sameSeries = m > 0 and n >= m and m_symbol == data.symbol and m_range == data.range and m_granularity == data.dataGranularity
+    and history.front().timestamp == m_candles.front().timestamp and history[m - 1].timestamp == m_candles[m - 1].timestamp
+    and (m < 2 or IsSameCandle(history[m - 2], m_candles[m - 2]));
+
+    if (!sameSeries)
+    {
+      m_symbol = data.symbol;
+      m_range = data.range;
+      m_granularity = data.dataGranularity;
+      if (!m_anchorSet)
+      {
+        m_anchor = GetDefaultAnchor(data.dataGranularity);
+        m_anchorBar = 0;
+      }
+      m_candles = history;
+      Rebuild();
+      return n;
+    }
+
+    size_t processed = 0;
+    if (!IsSameCandle(history[m - 1], m_candles[m - 1]))
+    {
+      UpdateLast(history[m - 1]);
+      processed++;
+    }
+    for (size_t i = m; i < n; ++i)
+    {
+      Append(history[i]);
+      processed++;
+    }
+    if (processed > 0)
+    {
+      m_levels = m_profile.ComputeLevels();
+    }
+    return processed;
+  }
+
+  void VolumeAnalysis::SetAnchor(VWAPAnchor anchor, size_t bar)
+  {
+    m_anchorSet = true;
+    if (anchor == m_anchor and (anchor != VWAPAnchor::Bar or bar == m_anchorBar))
+    {
+      return;
+    }
+    m_anchor = anchor;
+    m_anchorBar = bar;
+    Rebuild();
+  }
+
+  void VolumeAnalysis::Rebuild()
+  {
+    IK_PERFORMANCE_FUNC("VolumeAnalysis::Rebuild");
+
+    std::vector<CandleData> candles = std::move(m_candles);
+    m_candles.clear();
+    m_candles.reserve(candles.size());
+    m_series.vwap.clear();
+    m_series.deviation.clear();
+    m_series.vwap.reserve(candles.size());
+    m_series.deviation.reserve(candles.size());
+    m_profile.Reset(VolumeProfile::ChooseBinSize(candles.empty() ? 0.0 : candles.back().close));
+
+    for (const auto& candle : candles)
+    {
+      Append(candle);
+    }
+    m_levels = m_profile.ComputeLevels();
+  }
+
+  void VolumeAnalysis::Append(const CandleData& candle)
+  {
+    const size_t index = m_candles.size();
+    m_candles.push_back(candle);
+    m_profile.Append(candle);
+
+    // Bars before anchor bar have no average
+    if (m_anchor == VWAPAnchor::Bar and index < m_anchorBar)
+    {
+      m_series.vwap.push_back(NaN);
+      m_series.deviation.push_back(NaN);
+      return;
+    }
+
+    const double price = TypicalPrice(candle);
+    if (IsAnchor(index, candle.timestamp))
+    {
+      m_vwap.Reset(price);
+    }
+    m_series.vwap.push_back(m_vwap.Append(price, static_cast<double>(candle.volume)));
+    m_series.deviation.push_back(m_vwap.Deviation());
+  }
+
+  void VolumeAnalysis::UpdateLast(const CandleData& candle)
+  {
+    const size_t index = m_candles.size() - 1;
+    m_candles.back() = candle;
+    m_profile.UpdateLast(candle);
+
+    if (m_anchor == VWAPAnchor::Bar and index < m_anchorBar)
+    {
+      return;
+    }
+    m_series.vwap.back() = m_vwap.UpdateLast(TypicalPrice(candle), static_cast<double>(candle.volume));
+    m_series.deviation.back() = m_vwap.Deviation();
+  }
+
+  bool VolumeAnalysis::IsAnchor(size_t index, uint32_t timestamp) const
+  {
+    if (index == 0)
+    {
+      return true;
+    }
+
+    const uint32_t previous = m_candles[index - 1].timestamp;
+    switch (m_anchor)
+    {
+      case VWAPAnchor::Session:
+        return MultiTimeframeAnalyzer::GetBucket(Timeframe::Day1, timestamp) != MultiTimeframeAnalyzer::GetBucket(Timeframe::Day1, previous);
+      case VWAPAnchor::Week:
+        return MultiTimeframeAnalyzer::GetBucket(Timeframe::Week1, timestamp) != MultiTimeframeAnalyzer::GetBucket(Timeframe::Week1, previous);
+      case VWAPAnchor::Month:
+        return MultiTimeframeAnalyzer::GetBucket(Timeframe::Month1, timestamp) != MultiTimeframeAnalyzer::GetBucket(Timeframe::Month1, previous);
+      case VWAPAnchor::Bar:
+        return index == m_anchorBar;
+      default:
+        return false;
+    }
+  }
+
+  size_t VolumeAnalysis::GetMemoryUsage() const
+  {
+    return sizeof(*this) + m_symbol.capacity() + m_range.capacity() + m_granularity.capacity() + m_candles.capacity() * sizeof(CandleData)
+    + (m_series.vwap.capacity() + m_series.deviation.capacity() + m_profile.GetVolumes().capacity()) * sizeof(double);
+  }
+
+  VWAPAnchor VolumeAnalysis::GetDefaultAnchor(const std::string& dataGranularity)
+  {
+    // Intraday intervals end with m (minutes) or h (hours), month interval is "1mo"
+    const bool intraday = !dataGranularity.empty() and (dataGranularity.back() == 'm' or dataGranularity.back() == 'h');
+    return intraday ? VWAPAnchor::Session : VWAPAnchor::Bar;
+  }
+
+  std::string_view VolumeAnalysis::GetName(VWAPAnchor anchor)
+  {
+    switch (anchor)
+    {
+      case VWAPAnchor::Session: return "Session";
+      case VWAPAnchor::Week:    return "Week";
+      case VWAPAnchor::Month:   return "Month";
+      case VWAPAnchor::Bar:     return "Bar";
+      default: return "";
+    }
+  }
+} // namespace KanVest
@@ -0,0 +1,413 @@
+//
+//  MultiTimeframe.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "MultiTimeframe.hpp"
+
+#include "Analyzer/Indicators/MovingAverage.hpp"
+
+namespace KanVest
+{
+  static constexpr int64_t SecondsPerDay = 86400;
+
+  static bool IsSameCandle(const CandleData& a, const CandleData& b)
+  {
+    return a.timestamp == b.timestamp and a.open == b.open and a.high == b.high and a.low == b.low and a.close == b.close and a.volume == b.volume;
+  }
+
+  /// This function merges the base candle into forming bar
+  /// - Parameters:
+  ///   - bar: forming bar
+  ///   - candle: base candle of same bucket
+  static void Merge(CandleData& bar, const CandleData& candle)
+  {
+    bar.high = std::max(bar.high, candle.high);
+    bar.low = std::min(bar.low, candle.low);
+    bar.close = candle.close;
+    bar.volume = static_cast<uint32_t>(std::min<uint64_t>(static_cast<uint64_t>(bar.volume) + candle.volume, std::numeric_limits<uint32_t>::max()));
+    bar.range = bar.high - bar.low;
+  }
+
+  /// This structure stores the per period constants of analysis
+  struct PeriodLanes
+  {
+    std::vector<size_t> windows;
+    std::vector<double> inversePeriods, multipliers;
+    std::vector<double> smaColumn;
+
+    explicit PeriodLanes(const std::vector<int>& periods)
+    : windows(periods.size()), inversePeriods(periods.size()), multipliers(periods.size()), smaColumn(periods.size())
+    {
+      for (size_t p = 0; p < periods.size(); ++p)
+      {
+        windows[p] = static_cast<size_t>(std::max(periods[p], 1));
+        inversePeriods[p] = 1.0 / static_cast<double>(windows[p]);
+        multipliers[p] = 2.0 / (periods[p] + 1.0);
+      }
+    }
+  };
+
+  /// This function advances the timeframe by base candle
+  /// - Parameters:
+  ///   - analysis: timeframe analysis
+  ///   - lanes: period constants
+  ///   - candle: base candle
+  ///   - index: base candle index, columns are already sized past it
+  ///   - update: candle replaces last analyzed base candle (same bucket) instead of following it
+  static void Step(TimeframeAnalysis& analysis, PeriodLanes& lanes, const CandleData& candle, size_t index, bool update)
+  {
+    TimeframeAnalysis::State& state = analysis.state;
+    const double close = candle.close;
+    const size_t periodCount = lanes.windows.size();
+
+    bool newBar = false;
+    if (update)
+    {
+      // Same bucket as before, forming bar is rebuilt from its state before the candle
+      newBar = state.lastOpenedBar;
+      analysis.bars.back() = newBar ? candle : state.formingBase;
+      if (!newBar)
+      {
+        Merge(analysis.bars.back(), candle);
+      }
+    }
+    else
+    {
+      const int64_t bucket = MultiTimeframeAnalyzer::GetBucket(analysis.timeframe, candle.timestamp);
+      newBar = bucket != state.bucket;
+      if (newBar)
+      {
+        // Forming bar is closed, its close and averages become state of new bar
+        if (!analysis.bars.empty())
+        {
+          state.closedSums.push_back(state.closedSums.back() + state.formingClose);
+          state.emaClosed.swap(state.emaForming);
+        }
+        state.bucket = bucket;
+        analysis.bars.push_back(candle);
+      }
+      else
+      {
+        state.formingBase = analysis.bars.back();
+        Merge(analysis.bars.back(), candle);
+      }
+      state.lastOpenedBar = newBar;
+    }
+    state.formingClose = close;
+    analysis.barIndex[index] = static_cast<uint32_t>(analysis.bars.size() - 1);
+
+    // SMA over last period bars including forming one, 0 until period bars (same as StreamingSMA)
+    const size_t closed = state.closedSums.size() - 1;
+    const double* sums = state.closedSums.data();
+    double* smaColumn = lanes.smaColumn.data();
+    for (size_t p = 0; p < periodCount; ++p)
+    {
+      const size_t window = lanes.windows[p];
+      smaColumn[p] = closed + 1 >= window ? (sums[closed] - sums[closed + 1 - window] + close) * lanes.inversePeriods[p] : 0.0;
+    }
+
+    // EMA seeded with first close (same as StreamingEMA)
+    const double* emaClosed = state.emaClosed.data();
+    double* emaForming = state.emaForming.data();
+    if (closed == 0)
+    {
+      std::fill(emaForming, emaForming + periodCount, close);
+    }
+    else
+    {
+      for (size_t p = 0; p < periodCount; ++p)
+      {
+        emaForming[p] = (close - emaClosed[p]) * lanes.multipliers[p] + emaClosed[p];
+      }
+    }
+
+    for (size_t p = 0; p < periodCount; ++p)
+    {
+      analysis.sma[p][index] = smaColumn[p];
+      analysis.ema[p][index] = emaForming[p];
+    }
+    analysis.rsi[index] = (newBar and !update) ? state.rsi.Append(close) : state.rsi.UpdateLast(close);
+  }
+
+  void MultiTimeframeAnalyzer::Analyze(const StockData& stockData, const std::vector<Timeframe>& timeframes, const std::vector<int>& periods,
+                                       MultiTimeframeReport& report)
+  {
+    IK_PERFORMANCE_FUNC("MultiTimeframeAnalyzer::Analyze");
+    KanViz::Timer timer;
+
+    const auto& history = stockData.candleHistory;
+    const size_t count = history.size();
+    const size_t periodCount = periods.size();
+    const size_t analyzed = report.analyzed;
+
+    // Closed candles are final, revision of them or change of analysis setup starts from first candle. Forming candle
+    // is updated in place while it stays in bucket of every timeframe, otherwise it is analyzed from first candle too
+    bool sameSeries = analyzed > 0 and count >= analyzed and report.symbol == stockData.symbol and report.revision == stockData.revision
+    and report.range == stockData.range and report.granularity == stockData.dataGranularity and report.periods == periods
+    and report.timeframes.size() == timeframes.size() and IsSameCandle(history.front(), report.first)
+    and (analyzed < 2 or IsSameCandle(history[analyzed - 2], report.lastClosed));
+    for (size_t t = 0; sameSeries and t < timeframes.size(); ++t)
+    {
+      const TimeframeAnalysis& analysis = report.timeframes[t];
+      sameSeries = analysis.timeframe == timeframes[t] and GetBucket(timeframes[t], history[analyzed - 1].timestamp) == analysis.state.bucket;
+    }
+
+    size_t begin = 0;
+    if (sameSeries)
+    {
+      // Forming candle unchanged, continue after it
+      begin = IsSameCandle(history[analyzed - 1], report.last) ? analyzed : analyzed - 1;
+    }
+    else
+    {
+      report.periods = periods;
+      report.symbol = stockData.symbol;
+      report.range = stockData.range;
+      report.granularity = stockData.dataGranularity;
+      report.revision = stockData.revision;
+
+      report.timeframes.resize(timeframes.size());
+      for (size_t t = 0; t < timeframes.size(); ++t)
+      {
+        TimeframeAnalysis& analysis = report.timeframes[t];
+        analysis.timeframe = timeframes[t];
+        analysis.bars.clear();
+        analysis.barIndex.clear();
+        analysis.sma.resize(periodCount);
+        analysis.ema.resize(periodCount);
+        for (size_t p = 0; p < periodCount; ++p)
+        {
+          analysis.sma[p].clear();
+          analysis.ema[p].clear();
+        }
+        analysis.rsi.clear();
+
+        TimeframeAnalysis::State& state = analysis.state;
+        state.bucket = std::numeric_limits<int64_t>::min();
+        state.formingClose = 0.0;
+        state.closedSums.assign(1, 0.0);
+        state.emaClosed.assign(periodCount, 0.0);
+        state.emaForming.assign(periodCount, 0.0);
+        state.rsi = StreamingRSI(RSIPeriod);
+        state.lastOpenedBar = false;
+      }
+    }
+
+    report.alignment = 0;
+    report.updatedCandles = count - begin;
+
+    // Columns grow by appended candles only, earlier values are kept
+    PeriodLanes lanes(periods);
+    for (auto& analysis : report.timeframes)
+    {
+      analysis.trend = 0;
+      analysis.barIndex.resize(count);
+      for (size_t p = 0; p < periodCount; ++p)
+      {
+        analysis.sma[p].resize(count);
+        analysis.ema[p].resize(count);
+      }
+      analysis.rsi.resize(count);
+    }
+
+    // One traversal of changed base candles, every timeframe advances together
+    for (size_t i = begin; i < count; ++i)
+    {
+      const bool update = sameSeries and i + 1 == analyzed;
+      for (auto& analysis : report.timeframes)
+      {
+        Step(analysis, lanes, history[i], i, update);
+      }
+    }
+
+    report.analyzed = count;
+    if (count > 0)
+    {
+      report.first = history.front();
+      report.last = history.back();
+      report.lastClosed = count > 1 ? history[count - 2] : CandleData {};
+    }
+
+    // Trend at last candle: close above / below majority of ready averages, confirmed by RSI side of 50
+    for (auto& analysis : report.timeframes)
+    {
+      if (count == 0)
+      {
+        break;
+      }
+
+      const double close = history.back().close;
+      int above = 0, below = 0;
+      for (size_t p = 0; p < periodCount; ++p)
+      {
+        for (double average : {analysis.sma[p][count - 1], analysis.ema[p][count - 1]})
+        {
+          if (average > 0.0 and analysis.bars.size() >= static_cast<size_t>(periods[p]))
+          {
+            above += close > average ? 1 : 0;
+            below += close < average ? 1 : 0;
+          }
+        }
+      }
+
+      const double rsi = analysis.rsi.back();
+      if (above > below and (std::isnan(rsi) or rsi >= 50.0))
+      {
+        analysis.trend = 1;
+      }
+      else if (below > above and (std::isnan(rsi) or rsi < 50.0))
+      {
+        analysis.trend = -1;
+      }
+      report.alignment += analysis.trend;
+    }
+
+    report.elapsedMs = timer.ElapsedMilliseconds();
+  }
+
+  /// This function returns the largest difference of indicator columns of two reports, infinity if shapes or NaN differ
+  static double GetMaxDifference(const MultiTimeframeReport& a, const MultiTimeframeReport& b)
+  {
+    if (a.timeframes.size() != b.timeframes.size())
+    {
+      return std::numeric_limits<double>::infinity();
+    }
+
+    double maxDifference = 0.0;
+    auto compare = [&maxDifference](const std::vector<double>& x, const std::vector<double>& y) {
+      if (x.size() != y.size())
+      {
+        maxDifference = std::numeric_limits<double>::infinity();
+        return;
+      }
+      for (size_t i = 0; i < x.size(); ++i)
+      {
+        const double difference = std::isnan(x[i]) != std::isnan(y[i]) ? std::numeric_limits<double>::infinity() : std::isnan(x[i]) ? 0.0 : std::abs(x[i] - y[i]);
+        maxDifference = std::max(maxDifference, difference);
+      }
+    };
+
+    for (size_t t = 0; t < a.timeframes.size(); ++t)
+    {
+      const TimeframeAnalysis& x = a.timeframes[t];
+      const TimeframeAnalysis& y = b.timeframes[t];
+      if (x.bars.size() != y.bars.size() or x.barIndex != y.barIndex or x.sma.size() != y.sma.size() or x.trend != y.trend)
+      {
+        return std::numeric_limits<double>::infinity();
+      }
+      for (size_t p = 0; p < x.sma.size(); ++p)
+      {
+        compare(x.sma[p], y.sma[p]);
+        compare(x.ema[p], y.ema[p]);
+      }
+      compare(x.rsi, y.rsi);
+    }
+    return maxDifference;
+  }
+
+  void MultiTimeframeAnalyzer::Benchmark(const StockData& stockData, MultiTimeframeBenchmarkStats& stats)
+  {
+    thread_local MultiTimeframeReport singlePass, reference;
+    thread_local std::vector<MultiTimeframeReport> sequential;
+    thread_local StockData updated;
+
+    const std::vector<Timeframe> timeframes = GetTimeframes(stockData.dataGranularity);
+    const std::vector<int> periods = MovingAverage::GetActivePeriods(stockData.range);
+
+    // Fresh reports, so both sides traverse whole history
+    singlePass.analyzed = 0;
+    KanViz::Timer timer;
+    Analyze(stockData, timeframes, periods, singlePass);
+    stats.singlePassMs += timer.ElapsedMilliseconds();
+
+    sequential.resize(timeframes.size());
+    timer.Reset();
+    for (size_t t = 0; t < timeframes.size(); ++t)
+    {
+      sequential[t].analyzed = 0;
+      Analyze(stockData, {timeframes[t]}, periods, sequential[t]);
+    }
+    stats.sequentialMs += timer.ElapsedMilliseconds();
+
+    for (size_t t = 0; t < timeframes.size(); ++t)
+    {
+      MultiTimeframeReport single;
+      single.timeframes.push_back(singlePass.timeframes[t]);
+      stats.maxDifference = std::max(stats.maxDifference, GetMaxDifference(single, sequential[t]));
+    }
+
+    // Forming candle moves, analyzed report advances by it only and must match analysis from start
+    if (!stockData.candleHistory.empty())
+    {
+      updated = stockData;
+      CandleData& last = updated.candleHistory.back();
+      last.close = last.close * 1.01;
+      last.high = std::max(last.high, last.close);
+      last.range = last.high - last.low;
+
+      timer.Reset();
+      Analyze(updated, timeframes, periods, singlePass);
+      stats.updateMs += timer.ElapsedMilliseconds();
+
+      reference.analyzed = 0;
+      Analyze(updated, timeframes, periods, reference);
+      stats.maxDifference = std::max(stats.maxDifference, GetMaxDifference(singlePass, reference));
+    }
+
+    stats.series++;
+    stats.bars += stockData.candleHistory.size();
+    stats.timeframes += timeframes.size();
+  }
+
+  std::vector<Timeframe> MultiTimeframeAnalyzer::GetTimeframes(const std::string& dataGranularity)
+  {
+    if (dataGranularity == "1m" or dataGranularity == "2m" or dataGranularity == "5m")
+      return {Timeframe::Minute5, Timeframe::Minute15, Timeframe::Hour1, Timeframe::Day1};
+    if (dataGranularity == "15m")
+      return {Timeframe::Minute15, Timeframe::Hour1, Timeframe::Day1};
+    if (dataGranularity == "30m" or dataGranularity == "60m" or dataGranularity == "1h")
+      return {Timeframe::Hour1, Timeframe::Day1, Timeframe::Week1};
+    if (dataGranularity == "5d" or dataGranularity == "1wk")
+      return {Timeframe::Week1, Timeframe::Month1};
+    if (dataGranularity == "1mo" or dataGranularity == "3mo")
+      return {Timeframe::Month1};
+    return {Timeframe::Day1, Timeframe::Week1, Timeframe::Month1};
+  }
+
+  int64_t MultiTimeframeAnalyzer::GetBucket(Timeframe timeframe, uint32_t timestamp)
+  {
+    const int64_t seconds = static_cast<int64_t>(timestamp);
+    switch (timeframe)
+    {
+      case Timeframe::Minute5:  return (seconds - SessionOpenSeconds) / 300;
+      case Timeframe::Minute15: return (seconds - SessionOpenSeconds) / 900;
+      case Timeframe::Hour1:    return (seconds - SessionOpenSeconds) / 3600;
+      case Timeframe::Day1:     return seconds / SecondsPerDay;
+      // Day 0 (1970-01-01) is Thursday, weeks start on Monday
+      case Timeframe::Week1:    return (seconds / SecondsPerDay + 3) / 7;
+      case Timeframe::Month1:
+      {
+        const std::chrono::year_month_day date {std::chrono::sys_days {std::chrono::days {seconds / SecondsPerDay}}};
+        return static_cast<int64_t>(static_cast<int>(date.year())) * 12 + static_cast<unsigned>(date.month()) - 1;
+      }
+      default: return seconds;
+    }
+  }
+
+  std::string_view MultiTimeframeAnalyzer::GetName(Timeframe timeframe)
+  {
+    switch (timeframe)
+    {
+      case Timeframe::Minute5:  return "5m";
+      case Timeframe::Minute15: return "15m";
+      case Timeframe::Hour1:    return "1H";
+      case Timeframe::Day1:     return "1D";
+      case Timeframe::Week1:    return "1W";
+      case Timeframe::Month1:   return "1M";
+      default: return "";
+    }
+  }
+} // namespace KanVest
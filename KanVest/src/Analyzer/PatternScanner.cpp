@@ -0,0 +1,752 @@
+//
+//  PatternScanner.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "PatternScanner.hpp"
+
+#include <bit>
+
+namespace KanVest
+{
+  static_assert(PatternScanner::MaxLookback >= PatternScanner::BreakoutBars + 2 and PatternScanner::MaxLookback >= PatternScanner::TrendBars + 1,
+                "Lookback must cover every feature read by patterns");
+
+  static bool IsSameCandle(const CandleData& a, const CandleData& b)
+  {
+    return a.timestamp == b.timestamp and a.open == b.open and a.high == b.high and a.low == b.low and a.close == b.close and a.volume == b.volume;
+  }
+
+  /// Feature bits of one bar, relation features are set only if bar has the previous bars of same symbol
+  enum class Feature : uint8_t
+  {
+    Bullish, Bearish, Doji, SmallBody, LongBody, HammerShape, InvertedShape, Marubozu,
+    Rising, Falling,                                                  //< Age >= TrendBars
+    Engulfs, Inside, GapUp, GapDown, HigherClose, LowerClose, OpensInBody, //< Body relation to previous bar, age >= 1
+    AboveMidpoint, BelowMidpoint,                                     //< Close relation to body midpoint of bar i - 2, age >= 2
+    NewHigh, NewLow,                                                  //< Age >= BreakoutBars
+    SwingHigh, SwingLow,                                              //< Pivot at i - SwingBars confirmed, age >= 2 * SwingBars
+    Age1, Age2,
+    Count
+  };
+
+  static constexpr size_t FeatureCount = static_cast<size_t>(Feature::Count);
+
+  static constexpr uint32_t Bit(Feature feature) { return 1u << static_cast<uint32_t>(feature); }
+  static constexpr PatternMask Bit(CandlePattern pattern) { return 1u << static_cast<uint32_t>(pattern); }
+
+  /// Candle columns of scanned bars
+  template<typename T>
+  struct BarColumns
+  {
+    const T* opens;
+    const T* highs;
+    const T* lows;
+    const T* closes;
+  };
+
+  /// This function computes the feature bits of bar. Shared by bit parallel and reference scan, so both match same definitions
+  /// - Parameters:
+  ///   - bars: bar columns
+  ///   - i: bar index
+  ///   - age: number of previous bars of same symbol
+  ///   - priorHigh: highest high of previous BreakoutBars bars, used if age >= BreakoutBars
+  ///   - priorLow: lowest low of previous BreakoutBars bars, used if age >= BreakoutBars
+  template<typename T>
+  static uint32_t ComputeFeatures(const BarColumns<T>& bars, size_t i, size_t age, double priorHigh, double priorLow)
+  {
+    const double open = bars.opens[i], high = bars.highs[i], low = bars.lows[i], close = bars.closes[i];
+    const double range = high - low;
+    const double top = std::max(open, close), bottom = std::min(open, close);
+    const double body = top - bottom, upper = high - top, lower = bottom - low;
+
+    // Conditions combine with bitwise operators, so bar shape does not cause branches. Age checks are predictable
+    uint32_t features = 0;
+    auto Set = [&features](Feature feature, bool condition) { features |= static_cast<uint32_t>(condition) << static_cast<uint32_t>(feature); };
+
+    Set(Feature::Bullish, close > open);
+    Set(Feature::Bearish, close < open);
+    Set(Feature::Doji, body <= PatternScanner::DojiBody * range);
+    Set(Feature::SmallBody, body <= PatternScanner::SmallBody * range);
+    Set(Feature::LongBody, (body > 0.0) & (body >= PatternScanner::LongBody * range));
+    Set(Feature::HammerShape, (range > 0.0) & (lower >= PatternScanner::ShadowToBody * body) & (lower >= PatternScanner::LongShadow * range)
+        & (upper <= PatternScanner::ShortShadow * range));
+    Set(Feature::InvertedShape, (range > 0.0) & (upper >= PatternScanner::ShadowToBody * body) & (upper >= PatternScanner::LongShadow * range)
+        & (lower <= PatternScanner::ShortShadow * range));
+    Set(Feature::Marubozu, (body > 0.0) & (body >= PatternScanner::MarubozuBody * range));
+
+    if (age >= 1)
+    {
+      const double previousTop = std::max<double>(bars.opens[i - 1], bars.closes[i - 1]);
+      const double previousBottom = std::min<double>(bars.opens[i - 1], bars.closes[i - 1]);
+      const double previousBody = previousTop - previousBottom;
+
+      Set(Feature::Engulfs, (top >= previousTop) & (bottom <= previousBottom) & (body > previousBody));
+      Set(Feature::Inside, (top <= previousTop) & (bottom >= previousBottom) & (body < previousBody));
+      Set(Feature::GapUp, bottom > previousTop);
+      Set(Feature::GapDown, top < previousBottom);
+      Set(Feature::HigherClose, close > bars.closes[i - 1]);
+      Set(Feature::LowerClose, close < bars.closes[i - 1]);
+      Set(Feature::OpensInBody, (open >= previousBottom) & (open <= previousTop));
+      Set(Feature::Age1, true);
+    }
+    if (age >= 2)
+    {
+      const double midpoint = 0.5 * (static_cast<double>(bars.opens[i - 2]) + static_cast<double>(bars.closes[i - 2]));
+      Set(Feature::AboveMidpoint, close > midpoint);
+      Set(Feature::BelowMidpoint, close < midpoint);
+      Set(Feature::Age2, true);
+    }
+    if (age >= PatternScanner::TrendBars)
+    {
+      Set(Feature::Rising, close > bars.closes[i - PatternScanner::TrendBars]);
+      Set(Feature::Falling, close < bars.closes[i - PatternScanner::TrendBars]);
+    }
+    if (age >= PatternScanner::BreakoutBars)
+    {
+      Set(Feature::NewHigh, close > priorHigh);
+      Set(Feature::NewLow, close < priorLow);
+    }
+    if (age >= 2 * PatternScanner::SwingBars)
+    {
+      // Pivot is strictly above the bars before it and not below the bars after it, so flat top gives one pivot
+      const size_t pivot = i - PatternScanner::SwingBars;
+      bool swingHigh = true, swingLow = true;
+      for (size_t k = 1; k <= PatternScanner::SwingBars; ++k)
+      {
+        swingHigh &= (bars.highs[pivot] > bars.highs[pivot - k]) & (bars.highs[pivot] >= bars.highs[pivot + k]);
+        swingLow &= (bars.lows[pivot] < bars.lows[pivot - k]) & (bars.lows[pivot] <= bars.lows[pivot + k]);
+      }
+      Set(Feature::SwingHigh, swingHigh);
+      Set(Feature::SwingLow, swingLow);
+    }
+    return features;
+  }
+
+  /// This function checks if two pivots of same symbol form double top (or bottom)
+  /// - Parameters:
+  ///   - bars: bar columns
+  ///   - first: first pivot bar
+  ///   - second: second pivot bar
+  ///   - top: double top if true, double bottom otherwise
+  template<typename T>
+  static bool IsDoubleExtreme(const BarColumns<T>& bars, size_t first, size_t second, bool top)
+  {
+    const size_t separation = second - first;
+    if (separation < PatternScanner::MinTopSeparation or separation > PatternScanner::MaxTopSeparation)
+    {
+      return false;
+    }
+
+    const double a = top ? bars.highs[first] : bars.lows[first];
+    const double b = top ? bars.highs[second] : bars.lows[second];
+    if (std::abs(a - b) > PatternScanner::TopTolerance * std::max(a, b))
+    {
+      return false;
+    }
+
+    // Trough between tops (peak between bottoms) must be deep enough to be a pattern
+    if (top)
+    {
+      const double trough = *std::min_element(bars.lows + first + 1, bars.lows + second);
+      return trough <= (1.0 - PatternScanner::MinTopDepth) * std::min(a, b);
+    }
+    const double peak = *std::max_element(bars.highs + first + 1, bars.highs + second);
+    return peak >= (1.0 + PatternScanner::MinTopDepth) * std::max(a, b);
+  }
+
+  /// This function returns the column word with bar i holding bit of bar i - shift
+  static inline uint64_t ShiftWord(const std::vector<uint64_t>& column, size_t word, uint32_t shift)
+  {
+    return shift == 0 ? column[word] : (column[word] << shift) | (word > 0 ? column[word - 1] >> (64 - shift) : 0);
+  }
+
+  static void ResetColumns(PatternScanResult& result, const std::vector<size_t>& offsets)
+  {
+    const size_t words = (offsets.back() + 63) / 64;
+    for (auto& column : result.columns)
+    {
+      column.assign(words, 0);
+    }
+    result.offsets = offsets;
+  }
+
+  /// This function packs 64 flag bytes (0 or 1) into word, bit j is flag j. Multiply gathers the low bit of eight bytes
+  /// into the top byte without carries
+  static inline uint64_t PackFlags(const uint8_t* flags)
+  {
+    uint64_t word = 0;
+    for (size_t byte = 0; byte < 8; ++byte)
+    {
+      uint64_t eight;
+      std::memcpy(&eight, flags + byte * 8, sizeof(eight));
+      word |= ((eight * 0x0102040810204080ull) >> 56) << (byte * 8);
+    }
+    return word;
+  }
+
+  /// This function encodes the features of all bars into bit columns, 64 bars per word. Same definitions as
+  /// ComputeFeatures, but evaluated feature major over block of bars: each loop is branch free over contiguous columns,
+  /// so compiler vectorizes it for target (SSE / AVX2 / NEON). Flags of block are then packed to column words
+  template<typename T>
+  static void EncodeFeatures(const BarColumns<T>& bars, const std::vector<size_t>& offsets, std::array<std::vector<uint64_t>, FeatureCount>& features)
+  {
+    static constexpr size_t BlockBars = 256;
+    static constexpr size_t SwingBars = PatternScanner::SwingBars;
+
+    const size_t count = offsets.back();
+    const size_t words = (count + 63) / 64;
+    for (auto& column : features)
+    {
+      column.resize(words);
+    }
+
+    alignas(64) uint8_t flags[FeatureCount][BlockBars];
+    alignas(64) double priorHigh[BlockBars], priorLow[BlockBars];
+    alignas(64) uint8_t ages[BlockBars];
+    auto Flags = [&flags](Feature feature) { return flags[static_cast<size_t>(feature)]; };
+
+    size_t symbol = 0;
+    for (size_t start = 0; start < count; start += BlockBars)
+    {
+      const size_t size = std::min(BlockBars, count - start);
+      std::memset(flags, 0, sizeof(flags));
+
+      // Age saturates, largest lookback is below 255
+      for (size_t j = 0; j < size; ++j)
+      {
+        while (start + j >= offsets[symbol + 1])
+        {
+          symbol++;
+        }
+        ages[j] = static_cast<uint8_t>(std::min<size_t>(start + j - offsets[symbol], 255));
+      }
+
+      const T* opens = bars.opens + start;
+      const T* highs = bars.highs + start;
+      const T* lows = bars.lows + start;
+      const T* closes = bars.closes + start;
+
+      uint8_t* bullish = Flags(Feature::Bullish);
+      uint8_t* bearish = Flags(Feature::Bearish);
+      uint8_t* doji = Flags(Feature::Doji);
+      uint8_t* smallBody = Flags(Feature::SmallBody);
+      uint8_t* longBody = Flags(Feature::LongBody);
+      uint8_t* hammer = Flags(Feature::HammerShape);
+      uint8_t* inverted = Flags(Feature::InvertedShape);
+      uint8_t* marubozu = Flags(Feature::Marubozu);
+      for (size_t j = 0; j < size; ++j)
+      {
+        const double open = opens[j], high = highs[j], low = lows[j], close = closes[j];
+        const double range = high - low;
+        const double top = std::max(open, close), bottom = std::min(open, close);
+        const double body = top - bottom, upper = high - top, lower = bottom - low;
+
+        bullish[j] = close > open;
+        bearish[j] = close < open;
+        doji[j] = body <= PatternScanner::DojiBody * range;
+        smallBody[j] = body <= PatternScanner::SmallBody * range;
+        longBody[j] = (body > 0.0) & (body >= PatternScanner::LongBody * range);
+        hammer[j] = (range > 0.0) & (lower >= PatternScanner::ShadowToBody * body) & (lower >= PatternScanner::LongShadow * range)
+        & (upper <= PatternScanner::ShortShadow * range);
+        inverted[j] = (range > 0.0) & (upper >= PatternScanner::ShadowToBody * body) & (upper >= PatternScanner::LongShadow * range)
+        & (lower <= PatternScanner::ShortShadow * range);
+        marubozu[j] = (body > 0.0) & (body >= PatternScanner::MarubozuBody * range);
+      }
+
+      // History loops start where previous bars exist in memory, bars of other symbol are cleared by age
+      uint8_t* engulfs = Flags(Feature::Engulfs);
+      uint8_t* inside = Flags(Feature::Inside);
+      uint8_t* gapUp = Flags(Feature::GapUp);
+      uint8_t* gapDown = Flags(Feature::GapDown);
+      uint8_t* higherClose = Flags(Feature::HigherClose);
+      uint8_t* lowerClose = Flags(Feature::LowerClose);
+      uint8_t* opensInBody = Flags(Feature::OpensInBody);
+      uint8_t* age1 = Flags(Feature::Age1);
+      for (size_t j = start < 1 ? 1 : 0; j < size; ++j)
+      {
+        const double open = opens[j], close = closes[j];
+        const double top = std::max(open, close), bottom = std::min(open, close), body = top - bottom;
+        const double previousTop = std::max<double>(opens[j - 1], closes[j - 1]);
+        const double previousBottom = std::min<double>(opens[j - 1], closes[j - 1]);
+        const double previousBody = previousTop - previousBottom;
+        const bool valid = ages[j] >= 1;
+
+        engulfs[j] = valid & (top >= previousTop) & (bottom <= previousBottom) & (body > previousBody);
+        inside[j] = valid & (top <= previousTop) & (bottom >= previousBottom) & (body < previousBody);
+        gapUp[j] = valid & (bottom > previousTop);
+        gapDown[j] = valid & (top < previousBottom);
+        higherClose[j] = valid & (close > closes[j - 1]);
+        lowerClose[j] = valid & (close < closes[j - 1]);
+        opensInBody[j] = valid & (open >= previousBottom) & (open <= previousTop);
+        age1[j] = valid;
+      }
+
+      uint8_t* aboveMidpoint = Flags(Feature::AboveMidpoint);
+      uint8_t* belowMidpoint = Flags(Feature::BelowMidpoint);
+      uint8_t* age2 = Flags(Feature::Age2);
+      for (size_t j = start < 2 ? 2 - start : 0; j < size; ++j)
+      {
+        const double close = closes[j];
+        const double midpoint = 0.5 * (static_cast<double>(opens[j - 2]) + static_cast<double>(closes[j - 2]));
+        const bool valid = ages[j] >= 2;
+
+        aboveMidpoint[j] = valid & (close > midpoint);
+        belowMidpoint[j] = valid & (close < midpoint);
+        age2[j] = valid;
+      }
+
+      uint8_t* rising = Flags(Feature::Rising);
+      uint8_t* falling = Flags(Feature::Falling);
+      for (size_t j = start < PatternScanner::TrendBars ? PatternScanner::TrendBars - start : 0; j < size; ++j)
+      {
+        const bool valid = ages[j] >= PatternScanner::TrendBars;
+        rising[j] = valid & (closes[j] > closes[j - PatternScanner::TrendBars]);
+        falling[j] = valid & (closes[j] < closes[j - PatternScanner::TrendBars]);
+      }
+
+      // Highest high / lowest low of previous bars, one vector max per lookback over block stays in cache
+      uint8_t* newHigh = Flags(Feature::NewHigh);
+      uint8_t* newLow = Flags(Feature::NewLow);
+      const size_t firstBreakout = start < PatternScanner::BreakoutBars ? PatternScanner::BreakoutBars - start : 0;
+      for (size_t j = firstBreakout; j < size; ++j)
+      {
+        priorHigh[j] = highs[j - 1];
+        priorLow[j] = lows[j - 1];
+      }
+      for (size_t k = 2; k <= PatternScanner::BreakoutBars; ++k)
+      {
+        for (size_t j = firstBreakout; j < size; ++j)
+        {
+          priorHigh[j] = std::max<double>(priorHigh[j], highs[j - k]);
+          priorLow[j] = std::min<double>(priorLow[j], lows[j - k]);
+        }
+      }
+      for (size_t j = firstBreakout; j < size; ++j)
+      {
+        const bool valid = ages[j] >= PatternScanner::BreakoutBars;
+        newHigh[j] = valid & (closes[j] > priorHigh[j]);
+        newLow[j] = valid & (closes[j] < priorLow[j]);
+      }
+
+      uint8_t* swingHigh = Flags(Feature::SwingHigh);
+      uint8_t* swingLow = Flags(Feature::SwingLow);
+      for (size_t j = start < 2 * SwingBars ? 2 * SwingBars - start : 0; j < size; ++j)
+      {
+        const T* pivotHigh = highs + j - SwingBars;
+        const T* pivotLow = lows + j - SwingBars;
+        bool isHigh = ages[j] >= 2 * SwingBars, isLow = isHigh;
+        for (size_t k = 1; k <= SwingBars; ++k)
+        {
+          isHigh &= (pivotHigh[0] > pivotHigh[-static_cast<ptrdiff_t>(k)]) & (pivotHigh[0] >= pivotHigh[k]);
+          isLow &= (pivotLow[0] < pivotLow[-static_cast<ptrdiff_t>(k)]) & (pivotLow[0] <= pivotLow[k]);
+        }
+        swingHigh[j] = isHigh;
+        swingLow[j] = isLow;
+      }
+
+      // Flags past count are zero, so partial last word packs cleanly
+      for (size_t feature = 0; feature < FeatureCount; ++feature)
+      {
+        for (size_t word = 0; word * 64 < size; ++word)
+        {
+          features[feature][start / 64 + word] = PackFlags(flags[feature] + word * 64);
+        }
+      }
+    }
+  }
+
+  /// This function matches the double tops (or bottoms) by walking set bits of swing column. Pivot is compared with
+  /// previous pivot of same symbol
+  template<typename T>
+  static void MatchDoubleExtremes(const BarColumns<T>& bars, const std::vector<size_t>& offsets, const std::vector<uint64_t>& swings, bool top,
+                                  std::vector<uint64_t>& output)
+  {
+    static constexpr size_t None = std::numeric_limits<size_t>::max();
+
+    size_t symbol = 0, lastPivot = None;
+    for (size_t word = 0; word < swings.size(); ++word)
+    {
+      for (uint64_t bits = swings[word]; bits; bits &= bits - 1)
+      {
+        const size_t confirm = word * 64 + static_cast<size_t>(std::countr_zero(bits));
+        while (confirm >= offsets[symbol + 1])
+        {
+          symbol++;
+          lastPivot = None;
+        }
+
+        const size_t pivot = confirm - PatternScanner::SwingBars;
+        if (lastPivot != None and IsDoubleExtreme(bars, lastPivot, pivot, top))
+        {
+          output[word] |= uint64_t(1) << (confirm % 64);
+        }
+        lastPivot = pivot;
+      }
+    }
+  }
+
+  template<typename T>
+  static void ScanColumns(const BarColumns<T>& bars, const std::vector<size_t>& offsets, PatternScanResult& result)
+  {
+    KanViz::Timer timer;
+
+    thread_local std::array<std::vector<uint64_t>, FeatureCount> features;
+    EncodeFeatures(bars, offsets, features);
+    ResetColumns(result, offsets);
+
+    auto Column = [](Feature feature) -> const std::vector<uint64_t>& { return features[static_cast<size_t>(feature)]; };
+    auto Output = [&result](CandlePattern pattern) -> std::vector<uint64_t>& { return result.columns[static_cast<size_t>(pattern)]; };
+
+    const size_t words = features[0].size();
+    for (size_t word = 0; word < words; ++word)
+    {
+      // Feature of bar i - shift at bit of bar i
+      auto F = [&](Feature feature, uint32_t shift = 0) { return ShiftWord(Column(feature), word, shift); };
+
+      const uint64_t bullish = F(Feature::Bullish), bearish = F(Feature::Bearish);
+      const uint64_t longBody = F(Feature::LongBody), age1 = F(Feature::Age1), age2 = F(Feature::Age2);
+      const uint64_t hammer = F(Feature::HammerShape) & age1, inverted = F(Feature::InvertedShape) & age1;
+      const uint64_t rising1 = F(Feature::Rising, 1), falling1 = F(Feature::Falling, 1);
+      const uint64_t bullish1 = F(Feature::Bullish, 1), bearish1 = F(Feature::Bearish, 1), longBody1 = F(Feature::LongBody, 1);
+      const uint64_t opensInBody = F(Feature::OpensInBody), opensInBody1 = F(Feature::OpensInBody, 1);
+
+      Output(CandlePattern::Doji)[word] = F(Feature::Doji);
+      Output(CandlePattern::Hammer)[word] = hammer & falling1;
+      Output(CandlePattern::HangingMan)[word] = hammer & rising1;
+      Output(CandlePattern::InvertedHammer)[word] = inverted & falling1;
+      Output(CandlePattern::ShootingStar)[word] = inverted & rising1;
+      Output(CandlePattern::BullishMarubozu)[word] = F(Feature::Marubozu) & bullish;
+      Output(CandlePattern::BearishMarubozu)[word] = F(Feature::Marubozu) & bearish;
+
+      Output(CandlePattern::BullishEngulfing)[word] = bullish & F(Feature::Engulfs) & bearish1;
+      Output(CandlePattern::BearishEngulfing)[word] = bearish & F(Feature::Engulfs) & bullish1;
+      Output(CandlePattern::BullishHarami)[word] = bullish & F(Feature::Inside) & bearish1 & longBody1;
+      Output(CandlePattern::BearishHarami)[word] = bearish & F(Feature::Inside) & bullish1 & longBody1;
+
+      const uint64_t star = F(Feature::SmallBody, 1) & F(Feature::LongBody, 2);
+      Output(CandlePattern::MorningStar)[word] = bullish & F(Feature::AboveMidpoint) & star & F(Feature::GapDown, 1) & F(Feature::Bearish, 2);
+      Output(CandlePattern::EveningStar)[word] = bearish & F(Feature::BelowMidpoint) & star & F(Feature::GapUp, 1) & F(Feature::Bullish, 2);
+
+      const uint64_t soldiers = longBody & longBody1 & F(Feature::LongBody, 2) & opensInBody & opensInBody1 & age2;
+      Output(CandlePattern::ThreeWhiteSoldiers)[word] = soldiers & bullish & bullish1 & F(Feature::Bullish, 2)
+      & F(Feature::HigherClose) & F(Feature::HigherClose, 1);
+      Output(CandlePattern::ThreeBlackCrows)[word] = soldiers & bearish & bearish1 & F(Feature::Bearish, 2)
+      & F(Feature::LowerClose) & F(Feature::LowerClose, 1);
+
+      Output(CandlePattern::BreakoutHigh)[word] = F(Feature::NewHigh);
+      Output(CandlePattern::BreakdownLow)[word] = F(Feature::NewLow);
+    }
+
+    MatchDoubleExtremes(bars, offsets, Column(Feature::SwingHigh), true, Output(CandlePattern::DoubleTop));
+    MatchDoubleExtremes(bars, offsets, Column(Feature::SwingLow), false, Output(CandlePattern::DoubleBottom));
+
+    result.elapsedMs = timer.ElapsedMilliseconds();
+  }
+
+  template<typename T>
+  static void ScanColumnsReference(const BarColumns<T>& bars, const std::vector<size_t>& offsets, PatternScanResult& result)
+  {
+    KanViz::Timer timer;
+
+    ResetColumns(result, offsets);
+    auto SetPattern = [&result](CandlePattern pattern, size_t bar, bool condition) {
+      result.columns[static_cast<size_t>(pattern)][bar / 64] |= static_cast<uint64_t>(condition) << (bar % 64);
+    };
+
+    std::vector<uint32_t> features;
+    for (size_t symbol = 0; symbol + 1 < offsets.size(); ++symbol)
+    {
+      const size_t first = offsets[symbol], last = offsets[symbol + 1];
+
+      features.assign(last - first, 0);
+      for (size_t i = first; i < last; ++i)
+      {
+        const size_t age = i - first;
+        double priorHigh = 0.0, priorLow = 0.0;
+        if (age >= PatternScanner::BreakoutBars)
+        {
+          priorHigh = *std::max_element(bars.highs + i - PatternScanner::BreakoutBars, bars.highs + i);
+          priorLow = *std::min_element(bars.lows + i - PatternScanner::BreakoutBars, bars.lows + i);
+        }
+        features[age] = ComputeFeatures(bars, i, age, priorHigh, priorLow);
+      }
+
+      static constexpr size_t None = std::numeric_limits<size_t>::max();
+      size_t lastSwingHigh = None, lastSwingLow = None;
+      for (size_t age = 0; age < last - first; ++age)
+      {
+        const size_t i = first + age;
+        auto Has = [&features, age](Feature feature, size_t back = 0) { return back <= age and (features[age - back] & Bit(feature)) != 0; };
+
+        const bool hasPrevious = age >= 1, hasTwoPrevious = age >= 2;
+        SetPattern(CandlePattern::Doji, i, Has(Feature::Doji));
+        SetPattern(CandlePattern::Hammer, i, hasPrevious and Has(Feature::HammerShape) and Has(Feature::Falling, 1));
+        SetPattern(CandlePattern::HangingMan, i, hasPrevious and Has(Feature::HammerShape) and Has(Feature::Rising, 1));
+        SetPattern(CandlePattern::InvertedHammer, i, hasPrevious and Has(Feature::InvertedShape) and Has(Feature::Falling, 1));
+        SetPattern(CandlePattern::ShootingStar, i, hasPrevious and Has(Feature::InvertedShape) and Has(Feature::Rising, 1));
+        SetPattern(CandlePattern::BullishMarubozu, i, Has(Feature::Marubozu) and Has(Feature::Bullish));
+        SetPattern(CandlePattern::BearishMarubozu, i, Has(Feature::Marubozu) and Has(Feature::Bearish));
+
+        if (hasPrevious)
+        {
+          SetPattern(CandlePattern::BullishEngulfing, i, Has(Feature::Bullish) and Has(Feature::Engulfs) and Has(Feature::Bearish, 1));
+          SetPattern(CandlePattern::BearishEngulfing, i, Has(Feature::Bearish) and Has(Feature::Engulfs) and Has(Feature::Bullish, 1));
+          SetPattern(CandlePattern::BullishHarami, i, Has(Feature::Bullish) and Has(Feature::Inside) and Has(Feature::Bearish, 1) and Has(Feature::LongBody, 1));
+          SetPattern(CandlePattern::BearishHarami, i, Has(Feature::Bearish) and Has(Feature::Inside) and Has(Feature::Bullish, 1) and Has(Feature::LongBody, 1));
+        }
+        if (hasTwoPrevious)
+        {
+          SetPattern(CandlePattern::MorningStar, i, Has(Feature::Bullish) and Has(Feature::AboveMidpoint) and Has(Feature::SmallBody, 1)
+                     and Has(Feature::GapDown, 1) and Has(Feature::Bearish, 2) and Has(Feature::LongBody, 2));
+          SetPattern(CandlePattern::EveningStar, i, Has(Feature::Bearish) and Has(Feature::BelowMidpoint) and Has(Feature::SmallBody, 1)
+                     and Has(Feature::GapUp, 1) and Has(Feature::Bullish, 2) and Has(Feature::LongBody, 2));
+
+          bool soldiers = true, crows = true;
+          for (size_t back = 0; back < 3; ++back)
+          {
+            soldiers = soldiers and Has(Feature::Bullish, back) and Has(Feature::LongBody, back);
+            crows = crows and Has(Feature::Bearish, back) and Has(Feature::LongBody, back);
+            if (back < 2)
+            {
+              soldiers = soldiers and Has(Feature::HigherClose, back) and Has(Feature::OpensInBody, back);
+              crows = crows and Has(Feature::LowerClose, back) and Has(Feature::OpensInBody, back);
+            }
+          }
+          SetPattern(CandlePattern::ThreeWhiteSoldiers, i, soldiers);
+          SetPattern(CandlePattern::ThreeBlackCrows, i, crows);
+        }
+
+        SetPattern(CandlePattern::BreakoutHigh, i, Has(Feature::NewHigh));
+        SetPattern(CandlePattern::BreakdownLow, i, Has(Feature::NewLow));
+
+        if (Has(Feature::SwingHigh))
+        {
+          const size_t pivot = i - PatternScanner::SwingBars;
+          SetPattern(CandlePattern::DoubleTop, i, lastSwingHigh != None and IsDoubleExtreme(bars, lastSwingHigh, pivot, true));
+          lastSwingHigh = pivot;
+        }
+        if (Has(Feature::SwingLow))
+        {
+          const size_t pivot = i - PatternScanner::SwingBars;
+          SetPattern(CandlePattern::DoubleBottom, i, lastSwingLow != None and IsDoubleExtreme(bars, lastSwingLow, pivot, false));
+          lastSwingLow = pivot;
+        }
+      }
+    }
+
+    result.elapsedMs = timer.ElapsedMilliseconds();
+  }
+
+  template<typename T>
+  static BarColumns<T> GetBarColumns(const ScreenerColumns<T>& columns)
+  {
+    return {columns.opens.data(), columns.highs.data(), columns.lows.data(), columns.closes.data()};
+  }
+
+  PatternMask PatternScanResult::GetMask(size_t bar) const
+  {
+    PatternMask mask = 0;
+    for (size_t pattern = 0; pattern < CandlePatternCount; ++pattern)
+    {
+      mask |= static_cast<PatternMask>((columns[pattern][bar / 64] >> (bar % 64)) & 1) << pattern;
+    }
+    return mask;
+  }
+
+  size_t PatternScanResult::Count(CandlePattern pattern) const
+  {
+    size_t count = 0;
+    for (uint64_t word : columns[static_cast<size_t>(pattern)])
+    {
+      count += static_cast<size_t>(std::popcount(word));
+    }
+    return count;
+  }
+
+  void PatternScanner::Scan(const ScreenerUniverse& universe, PatternScanResult& result)
+  {
+    IK_PERFORMANCE_FUNC("PatternScanner::Scan");
+
+    if (!universe.HasColumns())
+    {
+      IK_LOG_ERROR("PatternScanner", "Compact universe has no bar columns, build universe with float precision");
+      return;
+    }
+
+    if (universe.precision == IndicatorPrecision::Float32)
+    {
+      ScanColumns(GetBarColumns(universe.columns32), universe.offsets, result);
+    }
+    else
+    {
+      ScanColumns(GetBarColumns(universe.columns), universe.offsets, result);
+    }
+  }
+
+  void PatternScanner::Scan(const StockData& stockData, PatternScanResult& result)
+  {
+    IK_PERFORMANCE_FUNC("PatternScanner::Scan");
+    KanViz::Timer timer;
+
+    const auto& history = stockData.candleHistory;
+    const size_t count = history.size();
+    const size_t scanned = result.Symbols() == 1 ? result.Bars() : 0;
+
+    // Patterns end at their last bar and read only previous bars, so bars before first changed one keep their masks
+    const bool sameSeries = scanned > 0 and count >= scanned and result.symbol == stockData.symbol and result.revision == stockData.revision
+    and IsSameCandle(history.front(), result.first) and (scanned < 2 or IsSameCandle(history[scanned - 2], result.lastClosed));
+    const size_t changed = !sameSeries ? 0 : IsSameCandle(history[scanned - 1], result.last) ? scanned : scanned - 1;
+
+    // Window starts MaxLookback bars before first changed bar, at word boundary so its words copy into result
+    const size_t windowStart = (changed > MaxLookback ? changed - MaxLookback : 0) & ~size_t(63);
+    thread_local ScreenerColumns<double> columns;
+    thread_local PatternScanResult window;
+    columns.Clear();
+    columns.Reserve(count - windowStart);
+    for (size_t i = windowStart; i < count; ++i)
+    {
+      const CandleData& candle = history[i];
+      columns.Append(candle.open, candle.high, candle.low, candle.close, static_cast<double>(candle.volume));
+    }
+    ScanColumns(GetBarColumns(columns), {0, count - windowStart}, window);
+
+    // Words from first changed bar are taken from window, bits below it keep earlier masks
+    const size_t words = (count + 63) / 64;
+    const size_t firstWord = changed / 64;
+    const uint64_t keepMask = (uint64_t(1) << (changed % 64)) - 1;
+    for (size_t pattern = 0; pattern < CandlePatternCount; ++pattern)
+    {
+      std::vector<uint64_t>& column = result.columns[pattern];
+      const std::vector<uint64_t>& windowColumn = window.columns[pattern];
+      column.resize(words, 0);
+      for (size_t word = firstWord; word < words; ++word)
+      {
+        const uint64_t bits = windowColumn[word - windowStart / 64];
+        column[word] = word == firstWord ? (column[word] & keepMask) | (bits & ~keepMask) : bits;
+      }
+    }
+
+    result.offsets.assign({0, count});
+    result.symbol = stockData.symbol;
+    result.revision = stockData.revision;
+    result.first = count > 0 ? history.front() : CandleData {};
+    result.last = count > 0 ? history.back() : CandleData {};
+    result.lastClosed = count > 1 ? history[count - 2] : CandleData {};
+    result.rescannedBars = count - changed;
+    result.elapsedMs = timer.ElapsedMilliseconds();
+  }
+
+  void PatternScanner::ScanReference(const ScreenerUniverse& universe, PatternScanResult& result)
+  {
+    IK_PERFORMANCE_FUNC("PatternScanner::ScanReference");
+
+    if (!universe.HasColumns())
+    {
+      IK_LOG_ERROR("PatternScanner", "Compact universe has no bar columns, build universe with float precision");
+      return;
+    }
+
+    if (universe.precision == IndicatorPrecision::Float32)
+    {
+      ScanColumnsReference(GetBarColumns(universe.columns32), universe.offsets, result);
+    }
+    else
+    {
+      ScanColumnsReference(GetBarColumns(universe.columns), universe.offsets, result);
+    }
+  }
+
+  size_t PatternScanner::CountMismatches(const PatternScanResult& result, const PatternScanResult& reference)
+  {
+    if (result.offsets != reference.offsets)
+    {
+      return std::max(result.Bars(), reference.Bars());
+    }
+
+    // Bars with any differing pattern bit
+    size_t mismatches = 0;
+    const size_t words = result.columns[0].size();
+    for (size_t word = 0; word < words; ++word)
+    {
+      uint64_t difference = 0;
+      for (size_t pattern = 0; pattern < CandlePatternCount; ++pattern)
+      {
+        difference |= result.columns[pattern][word] ^ reference.columns[pattern][word];
+      }
+      mismatches += static_cast<size_t>(std::popcount(difference));
+    }
+    return mismatches;
+  }
+
+  std::string_view PatternScanner::GetName(CandlePattern pattern)
+  {
+    switch (pattern)
+    {
+      case CandlePattern::Doji:               return "Doji";
+      case CandlePattern::Hammer:             return "Hammer";
+      case CandlePattern::HangingMan:         return "Hanging Man";
+      case CandlePattern::InvertedHammer:     return "Inverted Hammer";
+      case CandlePattern::ShootingStar:       return "Shooting Star";
+      case CandlePattern::BullishMarubozu:    return "Bullish Marubozu";
+      case CandlePattern::BearishMarubozu:    return "Bearish Marubozu";
+      case CandlePattern::BullishEngulfing:   return "Bullish Engulfing";
+      case CandlePattern::BearishEngulfing:   return "Bearish Engulfing";
+      case CandlePattern::BullishHarami:      return "Bullish Harami";
+      case CandlePattern::BearishHarami:      return "Bearish Harami";
+      case CandlePattern::MorningStar:        return "Morning Star";
+      case CandlePattern::EveningStar:        return "Evening Star";
+      case CandlePattern::ThreeWhiteSoldiers: return "Three White Soldiers";
+      case CandlePattern::ThreeBlackCrows:    return "Three Black Crows";
+      case CandlePattern::BreakoutHigh:       return "Breakout";
+      case CandlePattern::BreakdownLow:       return "Breakdown";
+      case CandlePattern::DoubleTop:          return "Double Top";
+      case CandlePattern::DoubleBottom:       return "Double Bottom";
+      default: return "";
+    }
+  }
+
+  int PatternScanner::GetBias(CandlePattern pattern)
+  {
+    switch (pattern)
+    {
+      case CandlePattern::Hammer:
+      case CandlePattern::InvertedHammer:
+      case CandlePattern::BullishMarubozu:
+      case CandlePattern::BullishEngulfing:
+      case CandlePattern::BullishHarami:
+      case CandlePattern::MorningStar:
+      case CandlePattern::ThreeWhiteSoldiers:
+      case CandlePattern::BreakoutHigh:
+      case CandlePattern::DoubleBottom:
+        return 1;
+      case CandlePattern::HangingMan:
+      case CandlePattern::ShootingStar:
+      case CandlePattern::BearishMarubozu:
+      case CandlePattern::BearishEngulfing:
+      case CandlePattern::BearishHarami:
+      case CandlePattern::EveningStar:
+      case CandlePattern::ThreeBlackCrows:
+      case CandlePattern::BreakdownLow:
+      case CandlePattern::DoubleTop:
+        return -1;
+      default:
+        return 0;
+    }
+  }
+
+  std::string PatternScanner::FormatMask(PatternMask mask)
+  {
+    std::string names;
+    for (size_t pattern = 0; pattern < CandlePatternCount; ++pattern)
+    {
+      if (mask & Bit(static_cast<CandlePattern>(pattern)))
+      {
+        names += (names.empty() ? "" : ", ") + std::string(GetName(static_cast<CandlePattern>(pattern)));
+      }
+    }
+    return names;
+  }
+} // namespace KanVest
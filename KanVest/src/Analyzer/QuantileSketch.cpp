@@ -0,0 +1,312 @@
+//
+//  QuantileSketch.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "QuantileSketch.hpp"
+
+namespace KanVest
+{
+  static constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+  // Capacity shrinks by this factor per level below top level
+  static constexpr double CapacityDecay = 2.0 / 3.0;
+  static constexpr size_t MinCapacity = 2;
+
+  static bool IsSameCandle(const CandleData& a, const CandleData& b)
+  {
+    return a.timestamp == b.timestamp and a.open == b.open and a.high == b.high and a.low == b.low and a.close == b.close and a.volume == b.volume;
+  }
+
+  // Quantile Sketch -------------------------------------------------------------------------------------------------
+  QuantileSketch::QuantileSketch(uint32_t k)
+  : m_k(std::max<uint32_t>(k, 8))
+  {
+    Clear();
+  }
+
+  void QuantileSketch::Clear()
+  {
+    m_count = 0;
+    m_retained = 0;
+    m_min = m_max = NaN;
+    m_levels.assign(1, {});
+    m_levels[0].reserve(m_k);
+    m_totalCapacity = GetCapacity(0);
+  }
+
+  void QuantileSketch::Update(double value)
+  {
+    if (std::isnan(value))
+    {
+      return;
+    }
+
+    m_min = m_count ? std::min(m_min, value) : value;
+    m_max = m_count ? std::max(m_max, value) : value;
+    m_count++;
+
+    m_levels[0].push_back(static_cast<float>(value));
+    if (++m_retained >= m_totalCapacity)
+    {
+      Compact();
+    }
+  }
+
+  void QuantileSketch::Merge(const QuantileSketch& other)
+  {
+    if (other.IsEmpty())
+    {
+      return;
+    }
+
+    m_min = m_count ? std::min(m_min, other.m_min) : other.m_min;
+    m_max = m_count ? std::max(m_max, other.m_max) : other.m_max;
+    m_count += other.m_count;
+
+    // Values keep their weight: level h of other goes to level h
+    while (m_levels.size() < other.m_levels.size())
+    {
+      m_levels.emplace_back();
+    }
+    for (size_t level = 0; level < other.m_levels.size(); ++level)
+    {
+      m_levels[level].insert(m_levels[level].end(), other.m_levels[level].begin(), other.m_levels[level].end());
+      m_retained += other.m_levels[level].size();
+    }
+
+    m_totalCapacity = 0;
+    for (size_t level = 0; level < m_levels.size(); ++level)
+    {
+      m_totalCapacity += GetCapacity(level);
+    }
+    while (m_retained >= m_totalCapacity)
+    {
+      Compact();
+    }
+  }
+
+  void QuantileSketch::Compact()
+  {
+    // Retained over total capacity means some level is at its capacity
+    for (size_t level = 0; level < m_levels.size(); ++level)
+    {
+      if (m_levels[level].size() < GetCapacity(level))
+      {
+        continue;
+      }
+
+      // New top level shifts capacity of all levels below it
+      if (level + 1 == m_levels.size())
+      {
+        m_levels.emplace_back();
+        m_totalCapacity = 0;
+        for (size_t h = 0; h < m_levels.size(); ++h)
+        {
+          m_totalCapacity += GetCapacity(h);
+        }
+      }
+
+      auto& values = m_levels[level];
+      auto& next = m_levels[level + 1];
+      std::sort(values.begin(), values.end());
+
+      // Odd value stays at its level, random half of sorted pairs is promoted with double weight
+      m_random ^= m_random << 13;
+      m_random ^= m_random >> 7;
+      m_random ^= m_random << 17;
+      const size_t keep = values.size() % 2;
+      const size_t offset = m_random & 1;
+      const size_t before = next.size();
+      for (size_t i = keep + offset; i < values.size(); i += 2)
+      {
+        next.push_back(values[i]);
+      }
+      m_retained -= values.size() - keep - (next.size() - before);
+      values.resize(keep);
+
+      // Level narrows as levels are added above it, memory of its former width is released
+      if (values.capacity() > 2 * GetCapacity(level))
+      {
+        values.shrink_to_fit();
+      }
+      return;
+    }
+  }
+
+  double QuantileSketch::GetQuantile(double fraction) const
+  {
+    std::vector<double> values;
+    GetQuantiles({fraction}, values);
+    return values.front();
+  }
+
+  void QuantileSketch::GetQuantiles(const std::vector<double>& fractions, std::vector<double>& values) const
+  {
+    values.assign(fractions.size(), NaN);
+    if (IsEmpty())
+    {
+      return;
+    }
+
+    // Retained values with their weight, sorted once
+    std::vector<std::pair<float, uint64_t>> weighted;
+    weighted.reserve(m_retained);
+    for (size_t level = 0; level < m_levels.size(); ++level)
+    {
+      for (float value : m_levels[level])
+      {
+        weighted.emplace_back(value, uint64_t(1) << level);
+      }
+    }
+    std::sort(weighted.begin(), weighted.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    for (size_t i = 0; i < fractions.size(); ++i)
+    {
+      const double fraction = fractions[i];
+      if (fraction <= 0.0 or fraction >= 1.0)
+      {
+        values[i] = fraction <= 0.0 ? m_min : m_max;
+        continue;
+      }
+
+      const double target = fraction * static_cast<double>(m_count);
+      uint64_t cumulative = 0;
+      for (const auto& [value, weight] : weighted)
+      {
+        cumulative += weight;
+        if (static_cast<double>(cumulative) >= target)
+        {
+          values[i] = value;
+          break;
+        }
+      }
+    }
+  }
+
+  double QuantileSketch::GetRank(double value) const
+  {
+    if (IsEmpty() or std::isnan(value))
+    {
+      return NaN;
+    }
+
+    const float key = static_cast<float>(value);
+    uint64_t below = 0;
+    for (size_t level = 0; level < m_levels.size(); ++level)
+    {
+      const auto& values = m_levels[level];
+      below += static_cast<uint64_t>(std::count_if(values.begin(), values.end(), [key](float item) { return item <= key; })) << level;
+    }
+    return static_cast<double>(below) / static_cast<double>(m_count);
+  }
+
+  size_t QuantileSketch::GetMemoryUsage() const
+  {
+    size_t bytes = sizeof(*this) + m_levels.capacity() * sizeof(std::vector<float>);
+    for (const auto& values : m_levels)
+    {
+      bytes += values.capacity() * sizeof(float);
+    }
+    return bytes;
+  }
+
+  size_t QuantileSketch::GetCapacity(size_t level) const
+  {
+    const double depth = static_cast<double>(m_levels.size() - 1 - level);
+    return std::max(MinCapacity, static_cast<size_t>(std::ceil(m_k * std::pow(CapacityDecay, depth))));
+  }
+
+  // Distribution Analysis -------------------------------------------------------------------------------------------
+  size_t DistributionAnalysis::Sync(const StockData& data)
+  {
+    IK_PERFORMANCE_FUNC("DistributionAnalysis::Sync");
+
+    const auto& history = data.candleHistory;
+    const size_t n = history.size();
+    const size_t closed = n > 0 ? n - 1 : 0;
+
+    // Closed candles are final, revision of them rebuilds
+    const bool sameSeries = m_inserted > 0 and closed >= m_inserted and m_symbol == data.symbol and m_range == data.range
+    and m_granularity == data.dataGranularity and history.front().timestamp == m_firstTimestamp and IsSameCandle(history[m_inserted - 1], m_lastInserted);
+
+    if (!sameSeries)
+    {
+      m_symbol = data.symbol;
+      m_range = data.range;
+      m_granularity = data.dataGranularity;
+      m_firstTimestamp = n > 0 ? history.front().timestamp : 0;
+      m_inserted = 0;
+      for (auto& sketch : m_sketches)
+      {
+        sketch.Clear();
+      }
+    }
+
+    const size_t inserted = closed - m_inserted;
+    for (size_t i = m_inserted; i < closed; ++i)
+    {
+      Insert(history, i);
+    }
+    m_inserted = closed;
+    if (closed > 0)
+    {
+      m_lastInserted = history[closed - 1];
+    }
+
+    for (size_t metric = 0; metric < m_latest.size(); ++metric)
+    {
+      m_latest[metric] = n > 0 ? GetValue(static_cast<DistributionMetric>(metric), history[n - 1], n > 1 ? &history[n - 2] : nullptr) : NaN;
+    }
+    return inserted;
+  }
+
+  void DistributionAnalysis::Insert(const std::vector<CandleData>& history, size_t index)
+  {
+    const CandleData* previous = index > 0 ? &history[index - 1] : nullptr;
+    for (size_t metric = 0; metric < m_sketches.size(); ++metric)
+    {
+      m_sketches[metric].Update(GetValue(static_cast<DistributionMetric>(metric), history[index], previous));
+    }
+  }
+
+  double DistributionAnalysis::GetLatestPercentile(DistributionMetric metric) const
+  {
+    const double rank = GetSketch(metric).GetRank(GetLatestValue(metric));
+    return std::isnan(rank) ? NaN : rank * 100.0;
+  }
+
+  size_t DistributionAnalysis::GetMemoryUsage() const
+  {
+    size_t bytes = sizeof(*this) - sizeof(m_sketches);
+    for (const auto& sketch : m_sketches)
+    {
+      bytes += sketch.GetMemoryUsage();
+    }
+    return bytes;
+  }
+
+  double DistributionAnalysis::GetValue(DistributionMetric metric, const CandleData& candle, const CandleData* previous)
+  {
+    switch (metric)
+    {
+      case DistributionMetric::Return: return previous and previous->close > 0.0 ? (candle.close / previous->close - 1.0) * 100.0 : NaN;
+      case DistributionMetric::Volume: return static_cast<double>(candle.volume);
+      case DistributionMetric::Range:  return candle.close > 0.0 ? (candle.high - candle.low) / candle.close * 100.0 : NaN;
+      default: return NaN;
+    }
+  }
+
+  std::string_view DistributionAnalysis::GetName(DistributionMetric metric)
+  {
+    switch (metric)
+    {
+      case DistributionMetric::Return: return "Return";
+      case DistributionMetric::Volume: return "Volume";
+      case DistributionMetric::Range:  return "Range";
+      default: return "";
+    }
+  }
+} // namespace KanVest
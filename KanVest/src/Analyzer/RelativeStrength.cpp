@@ -0,0 +1,344 @@
+//
+//  RelativeStrength.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "RelativeStrength.hpp"
+
+#include "Stock/StockUtils.hpp"
+
+namespace KanVest
+{
+  static constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+  // Benchmark Cache -------------------------------------------------------------------------------------------------
+  bool BenchmarkCache::Update(const StockData& stockData)
+  {
+    const auto& history = stockData.candleHistory;
+    if (!stockData.IsValid() or history.empty())
+    {
+      return false;
+    }
+
+    const std::string key = Utils::NormalizeSymbol(stockData.symbol);
+    {
+      std::scoped_lock lock(s_mutex);
+      if (auto it = s_cache.find(key); it != s_cache.end())
+      {
+        const Entry& entry = it->second;
+        if (entry.size == history.size() and entry.firstTimestamp == history.front().timestamp and entry.lastTimestamp == history.back().timestamp and
+            entry.lastClose == history.back().close and entry.series->dataGranularity == stockData.dataGranularity)
+        {
+          return false;
+        }
+      }
+    }
+
+    IK_PERFORMANCE_FUNC("BenchmarkCache::Update");
+
+    // Readers keep the previous series alive until they drop it
+    auto series = std::make_shared<BenchmarkSeries>();
+    series->symbol = key;
+    series->dataGranularity = stockData.dataGranularity;
+    series->keys.reserve(history.size());
+    series->closes.reserve(history.size());
+    for (const auto& candle : history)
+    {
+      const int64_t joinKey = RelativeStrength::GetJoinKey(candle.timestamp, stockData.dataGranularity);
+
+      // Forming bar of same bucket replaces the previous one, keys stay strictly ascending
+      if (!series->keys.empty() and series->keys.back() == joinKey)
+      {
+        series->closes.back() = candle.close;
+        continue;
+      }
+      series->keys.push_back(joinKey);
+      series->closes.push_back(candle.close);
+    }
+
+    std::scoped_lock lock(s_mutex);
+    series->version = ++s_version;
+    s_cache[key] = {history.size(), history.front().timestamp, history.back().timestamp, history.back().close, std::move(series)};
+    return true;
+  }
+
+  std::shared_ptr<const BenchmarkSeries> BenchmarkCache::Get(const std::string& symbol)
+  {
+    std::scoped_lock lock(s_mutex);
+    auto it = s_cache.find(Utils::NormalizeSymbol(symbol));
+    return it != s_cache.end() ? it->second.series : nullptr;
+  }
+
+  void BenchmarkCache::Clear()
+  {
+    std::scoped_lock lock(s_mutex);
+    s_cache.clear();
+  }
+
+  // Relative Strength -----------------------------------------------------------------------------------------------
+  template<typename T>
+  bool RelativeStrength::Compute(const uint32_t* timestamps, const T* closes, size_t count, const std::string& dataGranularity,
+                                 const BenchmarkSeries& benchmark, RelativeStrengthSeries& output, size_t begin)
+  {
+    // Values before begin are kept only if they were joined with same benchmark series
+    if (output.benchmark != benchmark.symbol or output.benchmarkVersion != benchmark.version)
+    {
+      begin = 0;
+    }
+    begin = std::min({begin, count, output.ratio.size()});
+
+    // Bars aligned in dropped tail are counted again
+    if (begin == 0)
+    {
+      output.alignedBars = 0;
+    }
+    for (size_t i = begin; begin > 0 and i < output.ratio.size(); ++i)
+    {
+      output.alignedBars -= !std::isnan(output.ratio[i]);
+    }
+
+    output.benchmark = benchmark.symbol;
+    output.benchmarkVersion = benchmark.version;
+    output.ratio.resize(begin);
+    output.mansfield.resize(begin);
+    output.ratio.resize(count, NaN);
+    output.mansfield.resize(count, NaN);
+    if (count == 0 or benchmark.closes.empty() or benchmark.dataGranularity != dataGranularity)
+    {
+      return false;
+    }
+
+    // As of merge join: both sides ascending, benchmark cursor only moves forward
+    const int64_t* keys = benchmark.keys.data();
+    const size_t benchmarkCount = benchmark.keys.size();
+    const size_t period = GetMansfieldPeriod(dataGranularity);
+    const auto timeframe = GetJoinTimeframe(dataGranularity);
+    auto GetKey = [&timeframe, timestamps](size_t i) {
+      return timeframe ? MultiTimeframeAnalyzer::GetBucket(*timeframe, timestamps[i]) : static_cast<int64_t>(timestamps[i]);
+    };
+
+    size_t cursor = 0, first = count, valid = 0;
+    double base = 0.0, sum = 0.0;
+    if (begin > 0)
+    {
+      // Cursor after benchmark bars at or before last kept bar, window holds kept ratios of bars since begin - period
+      cursor = static_cast<size_t>(std::upper_bound(keys, keys + benchmarkCount, GetKey(begin - 1)) - keys);
+      if (output.alignedBars > 0)
+      {
+        first = output.firstAligned;
+        base = output.base;
+        for (size_t i = std::max(first, begin > period ? begin - period : 0); i < begin; ++i)
+        {
+          if (!std::isnan(output.ratio[i]))
+          {
+            sum += output.ratio[i];
+            valid++;
+          }
+        }
+      }
+    }
+
+    for (size_t i = begin; i < count; ++i)
+    {
+      // Average window slides over bars since first aligned bar, bars without ratio are skipped
+      if (first < count and i >= first + period and !std::isnan(output.ratio[i - period]))
+      {
+        sum -= output.ratio[i - period];
+        valid--;
+      }
+
+      const int64_t key = GetKey(i);
+      while (cursor < benchmarkCount and keys[cursor] <= key)
+      {
+        ++cursor;
+      }
+      const double close = static_cast<double>(closes[i]);
+      if (cursor == 0 or !(close > 0.0) or !(benchmark.closes[cursor - 1] > 0.0))
+      {
+        continue;
+      }
+
+      const double ratio = close / benchmark.closes[cursor - 1];
+      if (first == count)
+      {
+        first = i;
+        base = ratio;
+      }
+      output.ratio[i] = ratio / base;
+      output.alignedBars++;
+
+      // Moving average of ratio, expanding until period is filled
+      sum += output.ratio[i];
+      valid++;
+      output.mansfield[i] = (output.ratio[i] / (sum / static_cast<double>(valid)) - 1.0) * 100.0;
+    }
+
+    output.firstAligned = first;
+    output.base = base;
+    return output.alignedBars > 0;
+  }
+
+  template bool RelativeStrength::Compute<double>(const uint32_t*, const double*, size_t, const std::string&, const BenchmarkSeries&, RelativeStrengthSeries&,
+                                                  size_t);
+  template bool RelativeStrength::Compute<float>(const uint32_t*, const float*, size_t, const std::string&, const BenchmarkSeries&, RelativeStrengthSeries&,
+                                                 size_t);
+
+  bool RelativeStrength::Compute(const StockData& stockData, const CandleColumns& columns, const BenchmarkSeries& benchmark, RelativeStrengthSeries& output,
+                                 size_t begin)
+  {
+    IK_PERFORMANCE_FUNC("RelativeStrength::Compute");
+    return Compute(columns.timestamps.data(), columns.closes.data(), columns.Size(), stockData.dataGranularity, benchmark, output, begin);
+  }
+
+  void RelativeStrength::Rank(const ScreenerUniverse& universe, const std::string& dataGranularity, const std::vector<std::string>& sectors,
+                              const std::string& benchmark, RelativeStrengthRanking& ranking)
+  {
+    IK_PERFORMANCE_FUNC("RelativeStrength::Rank");
+    KanViz::Timer timer;
+
+    ranking.benchmark = Utils::NormalizeSymbol(benchmark);
+    ranking.entries.clear();
+    ranking.bars = universe.TotalBars();
+
+    if (!universe.HasColumns())
+    {
+      IK_LOG_ERROR("RelativeStrength", "Compact universe has no bar columns, build universe with float precision");
+      return;
+    }
+
+    const auto benchmarkSeries = BenchmarkCache::Get(benchmark);
+    if (!benchmarkSeries)
+    {
+      IK_LOG_WARN("RelativeStrength", "Benchmark {0} is not cached", benchmark);
+      return;
+    }
+
+    // Sector series resolved once per sector, not per symbol
+    std::unordered_map<std::string, std::shared_ptr<const BenchmarkSeries>> sectorSeries;
+    for (const auto& sector : sectors)
+    {
+      if (!sector.empty() and !sectorSeries.contains(sector))
+      {
+        sectorSeries[sector] = BenchmarkCache::Get(sector);
+      }
+    }
+
+    RelativeStrengthSeries series;
+    auto ComputeSymbol = [&](const auto& columns, size_t symbol, const BenchmarkSeries& against) {
+      const size_t offset = universe.offsets[symbol];
+      Compute(universe.timestamps.data() + offset, columns.closes.data() + offset, universe.Bars(symbol), dataGranularity, against, series);
+      return series.LastMansfield();
+    };
+
+    ranking.entries.resize(universe.Size());
+    for (size_t symbol = 0; symbol < universe.Size(); ++symbol)
+    {
+      RelativeStrengthEntry& entry = ranking.entries[symbol];
+      entry = {};
+      entry.symbol = universe.symbols[symbol];
+      entry.sector = symbol < sectors.size() ? sectors[symbol] : "";
+
+      auto ComputeEntry = [&](const auto& columns) {
+        entry.mansfield = ComputeSymbol(columns, symbol, *benchmarkSeries);
+        entry.ratio = series.LastRatio();
+        if (auto it = sectorSeries.find(entry.sector); it != sectorSeries.end() and it->second)
+        {
+          entry.sectorMansfield = ComputeSymbol(columns, symbol, *it->second);
+        }
+      };
+      universe.precision == IndicatorPrecision::Float32 ? ComputeEntry(universe.columns32) : ComputeEntry(universe.columns);
+    }
+
+    // Benchmark itself and symbols without aligned bars are not ranked
+    std::vector<size_t> order;
+    order.reserve(ranking.entries.size());
+    for (size_t i = 0; i < ranking.entries.size(); ++i)
+    {
+      if (!std::isnan(ranking.entries[i].mansfield) and Utils::NormalizeSymbol(ranking.entries[i].symbol) != ranking.benchmark)
+      {
+        order.push_back(i);
+      }
+    }
+
+    // Percentile 1 (weakest) to 99 (strongest) within each group of ordered entries
+    auto AssignPercentiles = [&](size_t begin, size_t end, int RelativeStrengthEntry::*percentile) {
+      const size_t count = end - begin;
+      for (size_t rank = 0; rank < count; ++rank)
+      {
+        ranking.entries[order[begin + rank]].*percentile = count > 1 ? 1 + static_cast<int>(std::lround(98.0 * static_cast<double>(rank) / static_cast<double>(count - 1))) : 99;
+      }
+    };
+
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return ranking.entries[a].mansfield < ranking.entries[b].mansfield; });
+    AssignPercentiles(0, order.size(), &RelativeStrengthEntry::percentile);
+
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return ranking.entries[a].sector < ranking.entries[b].sector; });
+    for (size_t begin = 0; begin < order.size();)
+    {
+      size_t end = begin;
+      while (end < order.size() and ranking.entries[order[end]].sector == ranking.entries[order[begin]].sector)
+      {
+        ++end;
+      }
+      if (!ranking.entries[order[begin]].sector.empty())
+      {
+        AssignPercentiles(begin, end, &RelativeStrengthEntry::sectorPercentile);
+      }
+      begin = end;
+    }
+
+    // Strongest first, unranked last
+    std::sort(ranking.entries.begin(), ranking.entries.end(), [](const RelativeStrengthEntry& a, const RelativeStrengthEntry& b) {
+      return a.percentile != b.percentile ? a.percentile > b.percentile : a.mansfield > b.mansfield;
+    });
+
+    ranking.elapsedMs = timer.ElapsedMilliseconds();
+    IK_LOG_DEBUG("RelativeStrength", "Ranked {0} symbols ({1} bars) against {2} in {3:.3f} ms", order.size(), ranking.bars, ranking.benchmark, ranking.elapsedMs);
+  }
+
+  int64_t RelativeStrength::GetJoinKey(uint32_t timestamp, const std::string& dataGranularity)
+  {
+    const auto timeframe = GetJoinTimeframe(dataGranularity);
+    return timeframe ? MultiTimeframeAnalyzer::GetBucket(*timeframe, timestamp) : static_cast<int64_t>(timestamp);
+  }
+
+  std::optional<Timeframe> RelativeStrength::GetJoinTimeframe(const std::string& dataGranularity)
+  {
+    if (dataGranularity == "1d")
+    {
+      return Timeframe::Day1;
+    }
+    if (dataGranularity == "5d" or dataGranularity == "1wk")
+    {
+      return Timeframe::Week1;
+    }
+    if (dataGranularity == "1mo" or dataGranularity == "3mo")
+    {
+      return Timeframe::Month1;
+    }
+    return std::nullopt;
+  }
+
+  size_t RelativeStrength::GetMansfieldPeriod(const std::string& dataGranularity)
+  {
+    if (dataGranularity == "1d")
+    {
+      return 250;
+    }
+    if (dataGranularity == "5d" or dataGranularity == "1wk")
+    {
+      return 52;
+    }
+    if (dataGranularity == "1mo")
+    {
+      return 12;
+    }
+    if (dataGranularity == "3mo")
+    {
+      return 4;
+    }
+    return 200;
+  }
+} // namespace KanVest
@@ -0,0 +1,913 @@
+//
+//  Screener.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "Screener.hpp"
+
+#include "Stock/CorporateAction.hpp"
+
+#include "Analyzer/Indicators/StreamingIndicators.hpp"
+#include "Analyzer/Indicators/CompactIndicators.hpp"
+#include "Analyzer/Indicators/MovingAverageKernel.hpp"
+
+#include <latch>
+
+namespace KanVest
+{
+  static constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+  static bool IsTrue(double value)
+  {
+    return !std::isnan(value) and value != 0.0;
+  }
+
+  // ScreenerParser --------------------------------------------------------------------------------------------------
+  /// Recursive descent parser of filter expression, lowest precedence first:
+  /// or -> and -> not -> comparison -> sum -> product -> unary -> primary
+  class ScreenerParser
+  {
+  public:
+    ScreenerParser(const std::string& text, ScreenerFilter& filter)
+    : m_text(text), m_filter(filter)
+    {
+    }
+
+    bool Parse()
+    {
+      Next();
+      if (!ParseOr())
+      {
+        return false;
+      }
+      if (m_token.type != TokenType::End)
+      {
+        return Fail("Unexpected '" + m_token.text + "'");
+      }
+      return true;
+    }
+
+  private:
+    enum class TokenType {End, Number, Identifier, Symbol};
+
+    struct Token
+    {
+      TokenType type = TokenType::End;
+      std::string text;
+      double number = 0.0;
+    };
+
+    void Next()
+    {
+      while (m_position < m_text.size() and std::isspace(static_cast<unsigned char>(m_text[m_position])))
+      {
+        m_position++;
+      }
+
+      m_token = {};
+      if (m_position >= m_text.size())
+      {
+        return;
+      }
+
+      const char c = m_text[m_position];
+      if (std::isdigit(static_cast<unsigned char>(c)) or c == '.')
+      {
+        size_t length = 0;
+        m_token.type = TokenType::Number;
+        m_token.number = std::stod(m_text.substr(m_position), &length);
+        m_token.text = m_text.substr(m_position, length);
+        m_position += length;
+      }
+      else if (std::isalpha(static_cast<unsigned char>(c)) or c == '_')
+      {
+        const size_t start = m_position;
+        while (m_position < m_text.size() and (std::isalnum(static_cast<unsigned char>(m_text[m_position])) or m_text[m_position] == '_'))
+        {
+          m_position++;
+        }
+        m_token.type = TokenType::Identifier;
+        m_token.text = m_text.substr(start, m_position - start);
+        std::transform(m_token.text.begin(), m_token.text.end(), m_token.text.begin(), [](unsigned char ch) { return std::toupper(ch); });
+      }
+      else
+      {
+        // Two character operators first
+        static const std::array<std::string, 6> TwoCharSymbols = {"<=", ">=", "==", "!=", "&&", "||"};
+        m_token.type = TokenType::Symbol;
+        m_token.text = std::string(1, c);
+        for (const auto& symbol : TwoCharSymbols)
+        {
+          if (m_text.compare(m_position, 2, symbol) == 0)
+          {
+            m_token.text = symbol;
+            break;
+          }
+        }
+        m_position += m_token.text.size();
+      }
+    }
+
+    bool Accept(const char* text)
+    {
+      if (m_token.type != TokenType::Number and m_token.text == text)
+      {
+        Next();
+        return true;
+      }
+      return false;
+    }
+
+    bool Fail(const std::string& error)
+    {
+      if (m_filter.m_error.empty())
+      {
+        m_filter.m_error = error;
+      }
+      return false;
+    }
+
+    void Emit(ScreenerFilter::OpCode code)
+    {
+      m_filter.m_program.push_back({code});
+    }
+
+    bool ParseOr()
+    {
+      if (!ParseAnd())
+      {
+        return false;
+      }
+      while (Accept("OR") or Accept("||"))
+      {
+        if (!ParseAnd())
+        {
+          return false;
+        }
+        Emit(ScreenerFilter::OpCode::Or);
+      }
+      return true;
+    }
+
+    bool ParseAnd()
+    {
+      if (!ParseNot())
+      {
+        return false;
+      }
+      while (Accept("AND") or Accept("&&"))
+      {
+        if (!ParseNot())
+        {
+          return false;
+        }
+        Emit(ScreenerFilter::OpCode::And);
+      }
+      return true;
+    }
+
+    bool ParseNot()
+    {
+      if (Accept("NOT") or Accept("!"))
+      {
+        if (!ParseNot())
+        {
+          return false;
+        }
+        Emit(ScreenerFilter::OpCode::Not);
+        return true;
+      }
+      return ParseComparison();
+    }
+
+    bool ParseComparison()
+    {
+      if (!ParseSum())
+      {
+        return false;
+      }
+
+      static const std::array<std::pair<const char*, ScreenerFilter::OpCode>, 6> Comparisons = {{
+        {"<=", ScreenerFilter::OpCode::LessEqual}, {">=", ScreenerFilter::OpCode::GreaterEqual},
+        {"==", ScreenerFilter::OpCode::Equal}, {"!=", ScreenerFilter::OpCode::NotEqual},
+        {"<", ScreenerFilter::OpCode::Less}, {">", ScreenerFilter::OpCode::Greater}
+      }};
+      for (const auto& [text, code] : Comparisons)
+      {
+        if (Accept(text))
+        {
+          if (!ParseSum())
+          {
+            return false;
+          }
+          Emit(code);
+          return true;
+        }
+      }
+      return true;
+    }
+
+    bool ParseSum()
+    {
+      if (!ParseProduct())
+      {
+        return false;
+      }
+      while (true)
+      {
+        const ScreenerFilter::OpCode code = m_token.text == "+" ? ScreenerFilter::OpCode::Add : ScreenerFilter::OpCode::Subtract;
+        if (!Accept("+") and !Accept("-"))
+        {
+          return true;
+        }
+        if (!ParseProduct())
+        {
+          return false;
+        }
+        Emit(code);
+      }
+    }
+
+    bool ParseProduct()
+    {
+      if (!ParseUnary())
+      {
+        return false;
+      }
+      while (true)
+      {
+        const ScreenerFilter::OpCode code = m_token.text == "*" ? ScreenerFilter::OpCode::Multiply : ScreenerFilter::OpCode::Divide;
+        if (!Accept("*") and !Accept("/"))
+        {
+          return true;
+        }
+        if (!ParseUnary())
+        {
+          return false;
+        }
+        Emit(code);
+      }
+    }
+
+    bool ParseUnary()
+    {
+      if (Accept("-"))
+      {
+        if (!ParseUnary())
+        {
+          return false;
+        }
+        Emit(ScreenerFilter::OpCode::Negate);
+        return true;
+      }
+      return ParsePrimary();
+    }
+
+    bool ParsePrimary()
+    {
+      if (m_token.type == TokenType::Number)
+      {
+        m_filter.m_program.push_back({ScreenerFilter::OpCode::Constant, 0, m_token.number});
+        Next();
+        return true;
+      }
+
+      if (Accept("("))
+      {
+        if (!ParseOr())
+        {
+          return false;
+        }
+        if (!Accept(")"))
+        {
+          return Fail("Missing ')'");
+        }
+        return true;
+      }
+
+      if (m_token.type == TokenType::Identifier)
+      {
+        std::optional<ScreenerOperand> operand = ParseOperand(m_token.text);
+        if (!operand)
+        {
+          return Fail("Unknown value '" + m_token.text + "'");
+        }
+        Next();
+
+        // Operands are deduplicated, so each value is computed once per symbol
+        auto& operands = m_filter.m_operands;
+        auto it = std::find(operands.begin(), operands.end(), *operand);
+        if (it == operands.end())
+        {
+          if (operands.size() == ScreenerFilter::MaxOperands)
+          {
+            return Fail("Too many values in expression");
+          }
+          it = operands.insert(operands.end(), *operand);
+        }
+        m_filter.m_program.push_back({ScreenerFilter::OpCode::Operand, static_cast<uint32_t>(it - operands.begin())});
+        return true;
+      }
+
+      return Fail(m_token.type == TokenType::End ? "Unexpected end of expression" : "Unexpected '" + m_token.text + "'");
+    }
+
+    static std::optional<ScreenerOperand> ParseOperand(const std::string& name)
+    {
+      using Type = ScreenerOperand::Type;
+      static const std::array<std::pair<const char*, Type>, 7> Values = {{
+        {"PRICE", Type::Price}, {"CHANGE", Type::Change}, {"OPEN", Type::Open}, {"HIGH", Type::High},
+        {"LOW", Type::Low}, {"CLOSE", Type::Close}, {"VOLUME", Type::Volume}
+      }};
+      static const std::array<std::pair<const char*, Type>, 8> Indicators = {{
+        {"DMA", Type::SMA}, {"SMA", Type::SMA}, {"EMA", Type::EMA}, {"RSI", Type::RSI}, {"ATR", Type::ATR},
+        {"HHV", Type::HighestHigh}, {"LLV", Type::LowestLow}, {"AVGVOL", Type::AverageVolume}
+      }};
+
+      for (const auto& [prefix, type] : Values)
+      {
+        if (name == prefix)
+        {
+          return ScreenerOperand{type, 0, name};
+        }
+      }
+
+      // Indicator is prefix followed by period, e.g. DMA200
+      for (const auto& [prefix, type] : Indicators)
+      {
+        const std::string_view view(name);
+        const size_t length = std::strlen(prefix);
+        if (view.size() > length and view.substr(0, length) == prefix and
+            std::all_of(view.begin() + static_cast<std::ptrdiff_t>(length), view.end(), [](unsigned char c) { return std::isdigit(c); }))
+        {
+          const int period = std::atoi(name.c_str() + length);
+          if (period < 1 or period > 5000)
+          {
+            return std::nullopt;
+          }
+          return ScreenerOperand{type, period, name};
+        }
+      }
+      return std::nullopt;
+    }
+
+    const std::string& m_text;
+    ScreenerFilter& m_filter;
+
+    size_t m_position = 0;
+    Token m_token;
+  };
+
+  // ScreenerFilter --------------------------------------------------------------------------------------------------
+  ScreenerFilter ScreenerFilter::Compile(const std::string& expression)
+  {
+    ScreenerFilter filter;
+    filter.m_expression = expression;
+
+    try
+    {
+      ScreenerParser parser(expression, filter);
+      if (!parser.Parse())
+      {
+        filter.m_program.clear();
+        return filter;
+      }
+    }
+    catch (const std::exception&)
+    {
+      filter.m_error = "Invalid number in expression";
+      filter.m_program.clear();
+      return filter;
+    }
+
+    // Evaluation stack is fixed size, so check depth once here
+    size_t depth = 0, maxDepth = 0;
+    for (const auto& instruction : filter.m_program)
+    {
+      const bool push = instruction.code == OpCode::Constant or instruction.code == OpCode::Operand;
+      const bool unary = instruction.code == OpCode::Negate or instruction.code == OpCode::Not;
+      depth = push ? depth + 1 : unary ? depth : depth - 1;
+      maxDepth = std::max(maxDepth, depth);
+    }
+    if (maxDepth > MaxStackDepth)
+    {
+      filter.m_error = "Expression is too deep";
+      filter.m_program.clear();
+    }
+    return filter;
+  }
+
+  bool ScreenerFilter::Evaluate(const double* values) const
+  {
+    double stack[MaxStackDepth];
+    size_t top = 0;
+
+    for (const auto& instruction : m_program)
+    {
+      switch (instruction.code)
+      {
+        case OpCode::Constant: stack[top++] = instruction.constant;           continue;
+        case OpCode::Operand:  stack[top++] = values[instruction.operand];    continue;
+        case OpCode::Negate:   stack[top - 1] = -stack[top - 1];              continue;
+        case OpCode::Not:      stack[top - 1] = IsTrue(stack[top - 1]) ? 0.0 : 1.0; continue;
+        default: break;
+      }
+
+      const double b = stack[--top];
+      const double a = stack[top - 1];
+      const bool available = !std::isnan(a) and !std::isnan(b);
+
+      double result = 0.0;
+      switch (instruction.code)
+      {
+        case OpCode::Add:          result = a + b; break;
+        case OpCode::Subtract:     result = a - b; break;
+        case OpCode::Multiply:     result = a * b; break;
+        case OpCode::Divide:       result = b != 0.0 ? a / b : NaN; break;
+        case OpCode::Less:         result = a < b; break;
+        case OpCode::LessEqual:    result = a <= b; break;
+        case OpCode::Greater:      result = a > b; break;
+        case OpCode::GreaterEqual: result = a >= b; break;
+        case OpCode::Equal:        result = a == b; break;
+        case OpCode::NotEqual:     result = available and a != b; break;
+        case OpCode::And:          result = IsTrue(a) and IsTrue(b); break;
+        case OpCode::Or:           result = IsTrue(a) or IsTrue(b); break;
+        default: break;
+      }
+      stack[top - 1] = result;
+    }
+    return top == 1 and IsTrue(stack[0]);
+  }
+
+  // ScreenerUniverse ------------------------------------------------------------------------------------------------
+  bool ScreenerUniverse::Add(const StockData& stockData)
+  {
+    const auto adjusted = AdjustmentEngine::HasActions(stockData.symbol) ? AdjustmentEngine::GetAdjustedColumns(stockData) : nullptr;
+
+    // Compact series is built first, history that does not fit is not added at all
+    if (precision == IndicatorPrecision::Compact)
+    {
+      CompactCandleSeries series;
+      if (!(adjusted ? CompactCandleSeries::Build(*adjusted, series) : CompactCandleSeries::Build(stockData.candleHistory, series)))
+      {
+        IK_LOG_WARN("Screener", "History of {0} can not be stored in compact universe", stockData.symbol);
+        return false;
+      }
+      compact.push_back(std::move(series));
+    }
+
+    symbols.push_back(stockData.symbol);
+    livePrices.push_back(stockData.livePrice);
+    changePercents.push_back(stockData.changePercent);
+    for (const auto& candle : stockData.candleHistory)
+    {
+      timestamps.push_back(candle.timestamp);
+    }
+
+    auto AppendHistory = [&stockData, &adjusted](auto& target) {
+      if (adjusted)
+      {
+        for (size_t i = 0; i < adjusted->closes.size(); ++i)
+        {
+          target.Append(adjusted->opens[i], adjusted->highs[i], adjusted->lows[i], adjusted->closes[i], static_cast<double>(adjusted->volumes[i]));
+        }
+      }
+      else
+      {
+        for (const auto& candle : stockData.candleHistory)
+        {
+          target.Append(candle.open, candle.high, candle.low, candle.close, static_cast<double>(candle.volume));
+        }
+      }
+      return target.closes.size();
+    };
+
+    switch (precision)
+    {
+      case IndicatorPrecision::Float32: offsets.push_back(AppendHistory(columns32)); break;
+      case IndicatorPrecision::Compact: offsets.push_back(offsets.back() + compact.back().Size()); break;
+      default:                          offsets.push_back(AppendHistory(columns)); break;
+    }
+    return true;
+  }
+
+  void ScreenerUniverse::Reserve(size_t symbolCount, size_t barCount)
+  {
+    symbols.reserve(symbolCount);
+    livePrices.reserve(symbolCount);
+    changePercents.reserve(symbolCount);
+    offsets.reserve(symbolCount + 1);
+    timestamps.reserve(barCount);
+
+    switch (precision)
+    {
+      case IndicatorPrecision::Float32: columns32.Reserve(barCount); break;
+      case IndicatorPrecision::Compact: compact.reserve(symbolCount); break;
+      default:                          columns.Reserve(barCount); break;
+    }
+  }
+
+  void ScreenerUniverse::Clear()
+  {
+    symbols.clear();
+    livePrices.clear();
+    changePercents.clear();
+    offsets.assign(1, 0);
+    timestamps.clear();
+
+    columns.Clear();
+    columns32.Clear();
+    compact.clear();
+  }
+
+  size_t ScreenerUniverse::GetBarMemoryUsage() const
+  {
+    auto ColumnsMemory = [](const auto& target) {
+      return (target.opens.capacity() + target.highs.capacity() + target.lows.capacity() + target.closes.capacity() + target.volumes.capacity()) *
+      sizeof(target.closes[0]);
+    };
+
+    size_t bytes = timestamps.capacity() * sizeof(uint32_t) + ColumnsMemory(columns) + ColumnsMemory(columns32);
+    for (const auto& series : compact)
+    {
+      bytes += series.GetMemoryUsage();
+    }
+    return bytes;
+  }
+
+  // Screener --------------------------------------------------------------------------------------------------------
+  void Screener::Initialize(uint32_t threadCount)
+  {
+    IK_PROFILE();
+    s_threads = threadCount ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+    s_workerPool.Start(s_threads);
+  }
+
+  void Screener::Shutdown()
+  {
+    IK_PROFILE();
+    s_workerPool.Stop();
+  }
+
+  /// This function computes the last value of operand from columns of storage type, sums are accumulated in double
+  template<typename T>
+  static double ComputeOperandValue(const ScreenerOperand& operand, const ScreenerUniverse& universe, const ScreenerColumns<T>& columns, size_t symbol)
+  {
+    using Type = ScreenerOperand::Type;
+
+    const size_t begin = universe.offsets[symbol];
+    const size_t count = universe.Bars(symbol);
+    const size_t period = static_cast<size_t>(operand.period);
+
+    const T* opens = columns.opens.data() + begin;
+    const T* highs = columns.highs.data() + begin;
+    const T* lows = columns.lows.data() + begin;
+    const T* closes = columns.closes.data() + begin;
+    const T* volumes = columns.volumes.data() + begin;
+
+    switch (operand.type)
+    {
+      case Type::Price:
+      {
+        const double livePrice = universe.livePrices[symbol];
+        return livePrice > 0.0 ? livePrice : count ? closes[count - 1] : NaN;
+      }
+      case Type::Change: return universe.changePercents[symbol];
+      case Type::Open:   return count ? opens[count - 1] : NaN;
+      case Type::High:   return count ? highs[count - 1] : NaN;
+      case Type::Low:    return count ? lows[count - 1] : NaN;
+      case Type::Close:  return count ? closes[count - 1] : NaN;
+      case Type::Volume: return count ? volumes[count - 1] : NaN;
+      default: break;
+    }
+
+    if (count < period)
+    {
+      return NaN;
+    }
+
+    switch (operand.type)
+    {
+      case Type::SMA:
+      case Type::AverageVolume:
+      {
+        const T* values = operand.type == Type::SMA ? closes : volumes;
+        double sum = 0.0;
+        for (size_t i = count - period; i < count; ++i)
+        {
+          sum += values[i];
+        }
+        return sum / static_cast<double>(period);
+      }
+      case Type::EMA:
+      {
+        // Seeded with first close, same as MovingAverage
+        const double multiplier = 2.0 / (period + 1.0);
+        double ema = static_cast<double>(closes[0]);
+        for (size_t i = 1; i < count; ++i)
+        {
+          ema = (static_cast<double>(closes[i]) - ema) * multiplier + ema;
+        }
+        return ema;
+      }
+      case Type::RSI:
+      {
+        StreamingRSI rsi(period);
+        double value = NaN;
+        for (size_t i = 0; i < count; ++i)
+        {
+          value = rsi.Append(closes[i]);
+        }
+        return value;
+      }
+      case Type::ATR:
+      {
+        // Wilder smoothing seeded with average of first period true ranges, same as IndicatorGraph
+        auto TrueRange = [&](size_t i) {
+          const double high = static_cast<double>(highs[i]), low = static_cast<double>(lows[i]);
+          if (i == 0)
+          {
+            return high - low;
+          }
+          const double previousClose = static_cast<double>(closes[i - 1]);
+          return std::max({high - low, std::abs(high - previousClose), std::abs(low - previousClose)});
+        };
+        double atr = 0.0;
+        for (size_t i = 0; i < period; ++i)
+        {
+          atr += TrueRange(i);
+        }
+        atr /= static_cast<double>(period);
+        for (size_t i = period; i < count; ++i)
+        {
+          atr = (atr * (period - 1) + TrueRange(i)) / period;
+        }
+        return atr;
+      }
+      case Type::HighestHigh:
+        return *std::max_element(highs + (count - period), highs + count);
+      case Type::LowestLow:
+        return *std::min_element(lows + (count - period), lows + count);
+      default:
+        return NaN;
+    }
+  }
+
+  /// This function computes the last value of operand from compact series. Close sums and extremes stay in fixed point,
+  /// recursive indicators decode one price at a time
+  static double ComputeCompactOperandValue(const ScreenerOperand& operand, const ScreenerUniverse& universe, size_t symbol)
+  {
+    using Type = ScreenerOperand::Type;
+
+    const CompactCandleSeries& series = universe.compact[symbol];
+    const CompactCandleView view(series);
+    const size_t count = series.Size();
+    const size_t period = static_cast<size_t>(operand.period);
+
+    switch (operand.type)
+    {
+      case Type::Price:
+      {
+        const double livePrice = universe.livePrices[symbol];
+        return livePrice > 0.0 ? livePrice : count ? view.Close(count - 1) : NaN;
+      }
+      case Type::Change: return universe.changePercents[symbol];
+      case Type::Open:   return count ? view.Open(count - 1) : NaN;
+      case Type::High:   return count ? view.High(count - 1) : NaN;
+      case Type::Low:    return count ? view.Low(count - 1) : NaN;
+      case Type::Close:  return count ? view.Close(count - 1) : NaN;
+      case Type::Volume: return count ? view.Volume(count - 1) : NaN;
+      default: break;
+    }
+
+    if (count < period)
+    {
+      return NaN;
+    }
+
+    switch (operand.type)
+    {
+      case Type::SMA:
+      {
+        const int64_t sum = CompactIndicators::LastCloseSum(series, period);
+        return sum < 0 ? NaN : series.ToPrice(sum) / static_cast<double>(period);
+      }
+      case Type::AverageVolume:
+      {
+        double sum = 0.0;
+        for (size_t i = count - period; i < count; ++i)
+        {
+          sum += view.Volume(i);
+        }
+        return sum / static_cast<double>(period);
+      }
+      case Type::EMA:
+      {
+        const double multiplier = 2.0 / (period + 1.0);
+        double ema = view.Close(0);
+        for (size_t i = 1; i < count; ++i)
+        {
+          ema = (view.Close(i) - ema) * multiplier + ema;
+        }
+        return ema;
+      }
+      case Type::RSI:
+      {
+        StreamingRSI rsi(period);
+        double value = NaN;
+        for (size_t i = 0; i < count; ++i)
+        {
+          value = rsi.Append(view.Close(i));
+        }
+        return value;
+      }
+      case Type::ATR:
+      {
+        // True range in fixed point, same smoothing as float kernels
+        auto TrueRange = [&](size_t i) {
+          const int64_t high = series[i].high, low = series[i].low;
+          if (i == 0)
+          {
+            return high - low;
+          }
+          const int64_t previousClose = series[i - 1].close;
+          return std::max({high - low, std::abs(high - previousClose), std::abs(low - previousClose)});
+        };
+        double atr = 0.0;
+        for (size_t i = 0; i < period; ++i)
+        {
+          atr += static_cast<double>(TrueRange(i));
+        }
+        atr /= static_cast<double>(period);
+        for (size_t i = period; i < count; ++i)
+        {
+          atr = (atr * (period - 1) + static_cast<double>(TrueRange(i))) / period;
+        }
+        return series.ToPrice(1) * atr;
+      }
+      case Type::HighestHigh:
+        return series.ToPrice(CompactIndicators::HighestHigh(series, period));
+      case Type::LowestLow:
+        return series.ToPrice(CompactIndicators::LowestLow(series, period));
+      default:
+        return NaN;
+    }
+  }
+
+  /// This function computes the last EMA of symbols [begin, end) with multi symbol kernel. Kernel advances lanes of same
+  /// length together, so symbols are grouped by bar count. Symbols without period bars get NaN
+  template<typename T>
+  static void ComputeEMABlock(const ScreenerUniverse& universe, const ScreenerColumns<T>& columns, int period, size_t begin, size_t end,
+                              double* output, size_t stride)
+  {
+    thread_local std::vector<size_t> order;
+    thread_local std::vector<const T*> closes;
+    thread_local BasicIndicatorMatrix<T> matrix;
+
+    order.clear();
+    for (size_t symbol = begin; symbol < end; ++symbol)
+    {
+      const size_t count = universe.Bars(symbol);
+      if (count == 0 or count < static_cast<size_t>(period))
+      {
+        output[(symbol - begin) * stride] = NaN;
+        continue;
+      }
+      order.push_back(symbol);
+    }
+    std::stable_sort(order.begin(), order.end(), [&universe](size_t a, size_t b) { return universe.Bars(a) < universe.Bars(b); });
+
+    for (size_t first = 0; first < order.size();)
+    {
+      const size_t count = universe.Bars(order[first]);
+      size_t last = first;
+      closes.clear();
+      for (; last < order.size() and universe.Bars(order[last]) == count; ++last)
+      {
+        closes.push_back(columns.closes.data() + universe.offsets[order[last]]);
+      }
+
+      MovingAverageKernel::ComputeEMAAcrossSymbols(closes, count, period, matrix);
+      for (size_t lane = first; lane < last; ++lane)
+      {
+        output[(order[lane] - begin) * stride] = static_cast<double>(matrix.At(lane - first, count - 1));
+      }
+      first = last;
+    }
+  }
+
+  double Screener::ComputeOperand(const ScreenerOperand& operand, const ScreenerUniverse& universe, size_t symbol)
+  {
+    switch (universe.precision)
+    {
+      case IndicatorPrecision::Float32: return ComputeOperandValue(operand, universe, universe.columns32, symbol);
+      case IndicatorPrecision::Compact: return ComputeCompactOperandValue(operand, universe, symbol);
+      default:                          return ComputeOperandValue(operand, universe, universe.columns, symbol);
+    }
+  }
+
+  uint32_t Screener::ParallelFor(size_t count, const std::function<void(size_t, size_t)>& task)
+  {
+    const size_t blockCount = (count + BlockSize - 1) / BlockSize;
+
+    // Blocks are claimed from shared counter by caller and helper tasks. Helper that starts late (or is discarded by pool)
+    // finds no block left and touches nothing else, so caller never waits for a task that cannot run
+    struct SharedState
+    {
+      std::atomic<size_t> nextBlock = 0;
+      std::latch done;
+      explicit SharedState(size_t count) : done(static_cast<std::ptrdiff_t>(count)) {}
+    };
+    auto state = std::make_shared<SharedState>(blockCount);
+
+    std::function<void()> ClaimBlocks = [state, blockCount, count, &task]() {
+      for (size_t block = state->nextBlock++; block < blockCount; block = state->nextBlock++)
+      {
+        task(block * BlockSize, std::min(count, (block + 1) * BlockSize));
+        state->done.count_down();
+      }
+    };
+
+    uint32_t helpers = 0;
+    if (s_workerPool.IsRunning() and blockCount > 1)
+    {
+      const size_t helperCount = std::min<size_t>(s_threads, blockCount - 1);
+      for (size_t i = 0; i < helperCount; ++i)
+      {
+        helpers += s_workerPool.Submit(FetchPriority::Interactive, ClaimBlocks) ? 1 : 0;
+      }
+    }
+    ClaimBlocks();
+    state->done.wait();
+    return helpers + 1;
+  }
+
+  ScreenerResult Screener::Run(const ScreenerFilter& filter, const ScreenerUniverse& universe)
+  {
+    IK_PERFORMANCE_FUNC("Screener::Run");
+
+    ScreenerResult result;
+    if (!filter.IsValid())
+    {
+      return result;
+    }
+
+    KanViz::Timer timer;
+
+    const auto& operands = filter.GetOperands();
+    const size_t operandCount = operands.size();
+    const size_t symbolCount = universe.Size();
+
+    // Output is allocated once, blocks write disjoint rows
+    std::vector<double> values(symbolCount * operandCount);
+    std::vector<uint8_t> passed(symbolCount, 0);
+
+    // EMA operands of column universe are computed per block by multi symbol kernel, others per symbol
+    auto IsBlockOperand = [&universe](const ScreenerOperand& operand) { return operand.type == ScreenerOperand::Type::EMA and universe.HasColumns(); };
+
+    const uint32_t threads = ParallelFor(symbolCount, [&](size_t begin, size_t end) {
+      for (size_t operand = 0; operand < operandCount; ++operand)
+      {
+        if (IsBlockOperand(operands[operand]))
+        {
+          double* output = values.data() + begin * operandCount + operand;
+          universe.precision == IndicatorPrecision::Float32
+          ? ComputeEMABlock(universe, universe.columns32, operands[operand].period, begin, end, output, operandCount)
+          : ComputeEMABlock(universe, universe.columns, operands[operand].period, begin, end, output, operandCount);
+        }
+      }
+
+      for (size_t symbol = begin; symbol < end; ++symbol)
+      {
+        double* row = values.data() + symbol * operandCount;
+        for (size_t operand = 0; operand < operandCount; ++operand)
+        {
+          if (!IsBlockOperand(operands[operand]))
+          {
+            row[operand] = ComputeOperand(operands[operand], universe, symbol);
+          }
+        }
+        passed[symbol] = filter.Evaluate(row);
+      }
+    });
+
+    for (size_t symbol = 0; symbol < symbolCount; ++symbol)
+    {
+      if (passed[symbol])
+      {
+        const double* row = values.data() + symbol * operandCount;
+        result.matches.push_back({universe.symbols[symbol], std::vector<double>(row, row + operandCount)});
+      }
+    }
+
+    result.stats.symbols = symbolCount;
+    result.stats.bars = universe.TotalBars();
+    result.stats.matches = result.matches.size();
+    result.stats.barBytes = universe.GetBarMemoryUsage();
+    result.stats.threads = threads;
+    result.stats.elapsedMs = timer.ElapsedMilliseconds();
+    return result;
+  }
+} // namespace KanVest
@@ -0,0 +1,506 @@
+//
+//  Seasonality.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "Seasonality.hpp"
+
+#include "Analyzer/MultiTimeframe.hpp"
+
+#include "Stock/StockUtils.hpp"
+
+namespace KanVest
+{
+  static constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+  static constexpr int64_t SecondsPerDay = 86400;
+
+  // Offset of each group in bucket array, in order of SeasonalityGroup
+  static constexpr std::array<size_t, static_cast<size_t>(SeasonalityGroup::Count) + 1> GroupOffsets = {
+    0, 12, 12 + 5, 12 + 5 + 31, 12 + 5 + 31 + 3, 12 + 5 + 31 + 3 + SeasonalityAggregates::SlotCount
+  };
+
+  // Holiday buckets
+  static constexpr size_t NormalSession = 0, PreHoliday = 1, PostHoliday = 2;
+
+  static bool IsSameCandle(const CandleColumns& columns, size_t index, const CandleData& candle)
+  {
+    return columns.timestamps[index] == candle.timestamp and columns.opens[index] == candle.open and columns.highs[index] == candle.high and
+    columns.lows[index] == candle.low and columns.closes[index] == candle.close and columns.volumes[index] == candle.volume;
+  }
+
+  /// This function returns true if granularity is in minutes or hours
+  static bool IsIntraday(const std::string& granularity)
+  {
+    return granularity.ends_with('m') or granularity.ends_with('h');
+  }
+
+  /// This function returns the weekday index of day, Monday to Friday count one each and weekend shares next Monday's.
+  /// Weekdays without session between two trading days are holidays
+  static int64_t GetWeekdayIndex(int64_t day)
+  {
+    // Day 0 (1970-01-01) is Thursday, weeks start on Monday
+    const int64_t shifted = day + 3;
+    return (shifted / 7) * 5 + std::min<int64_t>(shifted % 7, 5);
+  }
+
+  // Seasonality Bucket ----------------------------------------------------------------------------------------------
+  void SeasonalityBucket::Add(double value)
+  {
+    count++;
+    positives += value > 0.0;
+    sum += value;
+    sumSquares += value * value;
+  }
+
+  double SeasonalityBucket::AverageReturn() const
+  {
+    return count ? std::expm1(sum / count) * 100.0 : NaN;
+  }
+
+  double SeasonalityBucket::TotalReturn() const
+  {
+    return count ? std::expm1(sum) * 100.0 : NaN;
+  }
+
+  double SeasonalityBucket::WinRate() const
+  {
+    return count ? 100.0 * positives / count : NaN;
+  }
+
+  double SeasonalityBucket::Deviation() const
+  {
+    if (count < 2)
+    {
+      return NaN;
+    }
+    const double mean = sum / count;
+    return std::sqrt(std::max(0.0, (sumSquares - mean * sum) / (count - 1))) * 100.0;
+  }
+
+  // Seasonality Aggregates ------------------------------------------------------------------------------------------
+  size_t SeasonalityAggregates::Sync(const StockData& data, const CandleColumns& columns)
+  {
+    IK_PERFORMANCE_FUNC("SeasonalityAggregates::Sync");
+
+    const size_t n = columns.Size();
+    const bool intraday = IsIntraday(data.dataGranularity);
+    const size_t closed = n > 0 and (intraday or data.dataGranularity == "1d") ? n - 1 : 0;
+
+    // Closed candles are final, revision of them rebuilds
+    const bool sameSeries = m_inserted > 0 and closed >= m_inserted and m_symbol == data.symbol and m_range == data.range
+    and m_granularity == data.dataGranularity and columns.timestamps.front() == m_firstTimestamp and IsSameCandle(columns, m_inserted - 1, m_lastInserted);
+
+    if (!sameSeries)
+    {
+      Clear();
+      m_symbol = data.symbol;
+      m_range = data.range;
+      m_granularity = data.dataGranularity;
+      m_firstTimestamp = n > 0 ? columns.timestamps.front() : 0;
+    }
+
+    const size_t inserted = closed - m_inserted;
+    const uint32_t* timestamps = columns.timestamps.data();
+    const double* opens = columns.opens.data();
+    const double* closes = columns.closes.data();
+    for (size_t i = m_inserted; i < closed; ++i)
+    {
+      Insert(timestamps[i], opens[i], closes[i], intraday);
+    }
+    m_inserted = closed;
+    if (closed > 0)
+    {
+      const size_t last = closed - 1;
+      m_lastInserted = {columns.opens[last], columns.closes[last], columns.highs[last], columns.lows[last], columns.highs[last] - columns.lows[last],
+        static_cast<uint32_t>(columns.volumes[last]), columns.timestamps[last]};
+    }
+    return inserted;
+  }
+
+  void SeasonalityAggregates::Clear()
+  {
+    m_inserted = 0;
+    m_lastInserted = {};
+    m_day = -1;
+    m_dayClose = m_previousDayClose = m_lastClose = 0.0;
+    m_postHoliday = false;
+    m_days = 0;
+    m_firstYear = 0;
+    m_buckets.fill({});
+    m_yearMonth.clear();
+  }
+
+  void SeasonalityAggregates::Insert(uint32_t timestamp, double open, double close, bool intraday)
+  {
+    const int64_t seconds = static_cast<int64_t>(timestamp);
+    const int64_t day = MultiTimeframeAnalyzer::GetBucket(Timeframe::Day1, timestamp);
+    const bool sameDay = day == m_day;
+    if (!sameDay)
+    {
+      if (m_day >= 0)
+      {
+        CloseDay(day);
+      }
+      m_day = day;
+    }
+
+    // Slot return from previous candle of same session, first candle of session from its open so overnight gap is excluded
+    if (intraday and close > 0.0)
+    {
+      const double base = sameDay ? m_lastClose : open;
+      const int64_t sessionSeconds = seconds % SecondsPerDay - MultiTimeframeAnalyzer::SessionOpenSeconds;
+      if (base > 0.0 and sessionSeconds >= 0 and sessionSeconds < static_cast<int64_t>(SlotCount * SlotSeconds))
+      {
+        Bucket(SeasonalityGroup::TimeOfDay, static_cast<size_t>(sessionSeconds / SlotSeconds)).Add(std::log(close / base));
+      }
+    }
+
+    m_dayClose = close;
+    m_lastClose = close;
+  }
+
+  void SeasonalityAggregates::CloseDay(int64_t nextDay)
+  {
+    const bool preHoliday = GetWeekdayIndex(nextDay) - GetWeekdayIndex(m_day) > 1;
+    if (m_previousDayClose > 0.0 and m_dayClose > 0.0)
+    {
+      const double value = std::log(m_dayClose / m_previousDayClose);
+      const std::chrono::year_month_day date {std::chrono::sys_days {std::chrono::days {m_day}}};
+      const int year = static_cast<int>(date.year());
+      const size_t month = static_cast<unsigned>(date.month()) - 1;
+      const size_t weekday = static_cast<size_t>((m_day + 3) % 7);
+
+      Bucket(SeasonalityGroup::Month, month).Add(value);
+      if (weekday < 5)
+      {
+        Bucket(SeasonalityGroup::Weekday, weekday).Add(value);
+      }
+      Bucket(SeasonalityGroup::DayOfMonth, static_cast<unsigned>(date.day()) - 1).Add(value);
+
+      // Session between two holidays counts as both
+      if (preHoliday)
+      {
+        Bucket(SeasonalityGroup::Holiday, PreHoliday).Add(value);
+      }
+      if (m_postHoliday)
+      {
+        Bucket(SeasonalityGroup::Holiday, PostHoliday).Add(value);
+      }
+      if (!preHoliday and !m_postHoliday)
+      {
+        Bucket(SeasonalityGroup::Holiday, NormalSession).Add(value);
+      }
+
+      if (m_yearMonth.empty())
+      {
+        m_firstYear = year;
+      }
+      const size_t index = static_cast<size_t>(year - m_firstYear) * 12 + month;
+      if (index >= m_yearMonth.size())
+      {
+        m_yearMonth.resize((index / 12 + 1) * 12);
+      }
+      m_yearMonth[index].Add(value);
+      m_days++;
+    }
+
+    m_postHoliday = preHoliday;
+    m_previousDayClose = m_dayClose;
+  }
+
+  SeasonalityBucket& SeasonalityAggregates::Bucket(SeasonalityGroup group, size_t index)
+  {
+    return m_buckets[GroupOffsets[static_cast<size_t>(group)] + index];
+  }
+
+  std::span<const SeasonalityBucket> SeasonalityAggregates::GetBuckets(SeasonalityGroup group) const
+  {
+    return {m_buckets.data() + GroupOffsets[static_cast<size_t>(group)], GetBucketCount(group)};
+  }
+
+  const SeasonalityBucket* SeasonalityAggregates::GetYearMonth(int year, size_t month) const
+  {
+    if (m_yearMonth.empty() or year < m_firstYear or month >= 12)
+    {
+      return nullptr;
+    }
+    const size_t index = static_cast<size_t>(year - m_firstYear) * 12 + month;
+    return index < m_yearMonth.size() ? &m_yearMonth[index] : nullptr;
+  }
+
+  bool SeasonalityAggregates::Save(const std::filesystem::path& filePath) const
+  {
+    IK_PERFORMANCE_FUNC("SeasonalityAggregates::Save");
+
+    // Buckets of each table are packed in one scalar, yaml parses it as single value
+    auto EmitBuckets = [](YAML::Emitter& out, const char* key, std::span<const SeasonalityBucket> buckets) {
+      std::string text;
+      text.reserve(buckets.size() * 48);
+      char item[96];
+      for (const auto& bucket : buckets)
+      {
+        std::snprintf(item, sizeof(item), "%u %u %.17g %.17g ", bucket.count, bucket.positives, bucket.sum, bucket.sumSquares);
+        text += item;
+      }
+      out << YAML::Key << key << YAML::Value << text;
+    };
+
+    YAML::Emitter out;
+    out.SetDoublePrecision(std::numeric_limits<double>::max_digits10);
+    out << YAML::BeginMap;
+    out << YAML::Key << "Seasonality" << YAML::Value << YAML::BeginMap;
+    out << YAML::Key << "Symbol" << YAML::Value << m_symbol;
+    out << YAML::Key << "Range" << YAML::Value << m_range;
+    out << YAML::Key << "Interval" << YAML::Value << m_granularity;
+    out << YAML::Key << "FirstTimestamp" << YAML::Value << m_firstTimestamp;
+    out << YAML::Key << "Inserted" << YAML::Value << m_inserted;
+    out << YAML::Key << "LastInserted" << YAML::Value << YAML::Flow << YAML::BeginSeq << m_lastInserted.timestamp << m_lastInserted.open
+    << m_lastInserted.high << m_lastInserted.low << m_lastInserted.close << m_lastInserted.volume << YAML::EndSeq;
+    out << YAML::Key << "Day" << YAML::Value << m_day;
+    out << YAML::Key << "DayClose" << YAML::Value << m_dayClose;
+    out << YAML::Key << "PreviousDayClose" << YAML::Value << m_previousDayClose;
+    out << YAML::Key << "PostHoliday" << YAML::Value << m_postHoliday;
+    out << YAML::Key << "LastClose" << YAML::Value << m_lastClose;
+    out << YAML::Key << "Days" << YAML::Value << m_days;
+    out << YAML::Key << "FirstYear" << YAML::Value << m_firstYear;
+    EmitBuckets(out, "Buckets", m_buckets);
+    EmitBuckets(out, "YearMonth", m_yearMonth);
+    out << YAML::EndMap;
+    out << YAML::EndMap;
+
+    std::ofstream fout(filePath);
+    if (!fout)
+    {
+      IK_LOG_WARN("Seasonality", "Can not write seasonality file {0}", filePath.string());
+      return false;
+    }
+    fout << out.c_str();
+    return fout.good();
+  }
+
+  bool SeasonalityAggregates::Load(const std::filesystem::path& filePath)
+  {
+    IK_PERFORMANCE_FUNC("SeasonalityAggregates::Load");
+
+    if (!std::filesystem::exists(filePath))
+    {
+      return false;
+    }
+
+    auto ReadBuckets = [](const YAML::Node& node, std::vector<SeasonalityBucket>& buckets) {
+      buckets.clear();
+      const char* cursor = node.Scalar().c_str();
+      while (true)
+      {
+        char* end = nullptr;
+        SeasonalityBucket bucket;
+        bucket.count = static_cast<uint32_t>(std::strtoul(cursor, &end, 10));
+        if (end == cursor)
+        {
+          return;
+        }
+        bucket.positives = static_cast<uint32_t>(std::strtoul(end, &end, 10));
+        bucket.sum = std::strtod(end, &end);
+        bucket.sumSquares = std::strtod(end, &end);
+        buckets.push_back(bucket);
+        cursor = end;
+      }
+    };
+
+    // File is a cache, anything unreadable is rebuilt from history
+    try
+    {
+      const YAML::Node root = YAML::LoadFile(filePath.string())["Seasonality"];
+      if (!root)
+      {
+        return false;
+      }
+
+      SeasonalityAggregates loaded;
+      loaded.m_symbol = root["Symbol"].as<std::string>();
+      loaded.m_range = root["Range"].as<std::string>();
+      loaded.m_granularity = root["Interval"].as<std::string>();
+      loaded.m_firstTimestamp = root["FirstTimestamp"].as<uint32_t>();
+      loaded.m_inserted = root["Inserted"].as<size_t>();
+
+      const YAML::Node& last = root["LastInserted"];
+      loaded.m_lastInserted.timestamp = last[0].as<uint32_t>();
+      loaded.m_lastInserted.open = last[1].as<double>();
+      loaded.m_lastInserted.high = last[2].as<double>();
+      loaded.m_lastInserted.low = last[3].as<double>();
+      loaded.m_lastInserted.close = last[4].as<double>();
+      loaded.m_lastInserted.volume = last[5].as<uint32_t>();
+      loaded.m_lastInserted.range = loaded.m_lastInserted.high - loaded.m_lastInserted.low;
+
+      loaded.m_day = root["Day"].as<int64_t>();
+      loaded.m_dayClose = root["DayClose"].as<double>();
+      loaded.m_previousDayClose = root["PreviousDayClose"].as<double>();
+      loaded.m_postHoliday = root["PostHoliday"].as<bool>();
+      loaded.m_lastClose = root["LastClose"].as<double>();
+      loaded.m_days = root["Days"].as<uint32_t>();
+      loaded.m_firstYear = root["FirstYear"].as<int>();
+
+      std::vector<SeasonalityBucket> buckets;
+      ReadBuckets(root["Buckets"], buckets);
+      ReadBuckets(root["YearMonth"], loaded.m_yearMonth);
+      if (buckets.size() != loaded.m_buckets.size() or loaded.m_yearMonth.size() % 12 != 0)
+      {
+        return false;
+      }
+      std::copy(buckets.begin(), buckets.end(), loaded.m_buckets.begin());
+
+      *this = std::move(loaded);
+      return true;
+    }
+    catch (const YAML::Exception& exception)
+    {
+      IK_LOG_WARN("Seasonality", "Can not read seasonality file {0} : {1}", filePath.string(), exception.what());
+      return false;
+    }
+  }
+
+  size_t SeasonalityAggregates::GetBucketCount(SeasonalityGroup group)
+  {
+    const size_t index = static_cast<size_t>(group);
+    return index < static_cast<size_t>(SeasonalityGroup::Count) ? GroupOffsets[index + 1] - GroupOffsets[index] : 0;
+  }
+
+  std::string_view SeasonalityAggregates::GetName(SeasonalityGroup group)
+  {
+    switch (group)
+    {
+      case SeasonalityGroup::Month:       return "Month";
+      case SeasonalityGroup::Weekday:     return "Weekday";
+      case SeasonalityGroup::DayOfMonth:  return "Day";
+      case SeasonalityGroup::Holiday:     return "Holiday";
+      case SeasonalityGroup::TimeOfDay:   return "Intraday";
+      default: return "";
+    }
+  }
+
+  std::string SeasonalityAggregates::GetLabel(SeasonalityGroup group, size_t index)
+  {
+    static constexpr std::array<const char*, 12> Months = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+    static constexpr std::array<const char*, 5> Weekdays = {"Mon", "Tue", "Wed", "Thu", "Fri"};
+    static constexpr std::array<const char*, 3> Sessions = {"Normal", "Pre-Holiday", "Post-Holiday"};
+
+    if (index >= GetBucketCount(group))
+    {
+      return "";
+    }
+    switch (group)
+    {
+      case SeasonalityGroup::Month:       return Months[index];
+      case SeasonalityGroup::Weekday:     return Weekdays[index];
+      case SeasonalityGroup::DayOfMonth:  return std::to_string(index + 1);
+      case SeasonalityGroup::Holiday:     return Sessions[index];
+      case SeasonalityGroup::TimeOfDay:
+      {
+        const uint32_t minutes = static_cast<uint32_t>(index) * SlotSeconds / 60 + 9 * 60 + 15;
+        char label[6];
+        std::snprintf(label, sizeof(label), "%02u:%02u", minutes / 60, minutes % 60);
+        return label;
+      }
+      default: return "";
+    }
+  }
+
+  // Seasonality Store -----------------------------------------------------------------------------------------------
+  void SeasonalityStore::SetDirectory(const std::filesystem::path& directory)
+  {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error)
+    {
+      IK_LOG_WARN("Seasonality", "Can not create seasonality directory {0}, aggregates are not persisted", directory.string());
+      return;
+    }
+
+    std::scoped_lock lock(s_mutex);
+    s_directory = directory;
+    if (!s_running)
+    {
+      s_running = true;
+      s_writer = std::thread(WriterLoop);
+    }
+  }
+
+  void SeasonalityStore::Shutdown()
+  {
+    {
+      std::scoped_lock lock(s_mutex);
+      s_running = false;
+    }
+    s_condition.notify_all();
+    if (s_writer.joinable())
+    {
+      s_writer.join();
+    }
+  }
+
+  bool SeasonalityStore::Save(const StockData& data, const SeasonalityAggregates& aggregates)
+  {
+    // File belongs to time candles of base symbol, aggregates of tagged series (e.g. Renko bars) would replace them
+    std::scoped_lock lock(s_mutex);
+    if (!s_running or s_directory.empty() or data.symbol.empty() or Utils::HasSeriesTag(data.symbol))
+    {
+      return false;
+    }
+
+    // Latest aggregates replace the ones not yet written
+    s_pending[GetFilePath(data.symbol, data.range, data.dataGranularity).string()] = aggregates;
+    s_condition.notify_one();
+    return true;
+  }
+
+  void SeasonalityStore::WriterLoop()
+  {
+    std::unique_lock lock(s_mutex);
+    while (s_running or !s_pending.empty())
+    {
+      s_condition.wait(lock, [] { return !s_running or !s_pending.empty(); });
+
+      // Saves within delay are coalesced, shutdown writes at once
+      s_condition.wait_for(lock, SaveDelay, [] { return !s_running; });
+
+      auto pending = std::move(s_pending);
+      s_pending.clear();
+      lock.unlock();
+      for (const auto& [filePath, aggregates] : pending)
+      {
+        aggregates.Save(filePath);
+      }
+      lock.lock();
+    }
+  }
+
+  bool SeasonalityStore::Load(const std::string& symbol, const std::string& range, const std::string& interval, SeasonalityAggregates& aggregates)
+  {
+    std::filesystem::path filePath;
+    {
+      std::scoped_lock lock(s_mutex);
+      if (s_directory.empty() or symbol.empty())
+      {
+        return false;
+      }
+
+      // Aggregates still waiting for writer are newer than file
+      filePath = GetFilePath(symbol, range, interval);
+      if (auto it = s_pending.find(filePath.string()); it != s_pending.end())
+      {
+        aggregates = it->second;
+        return true;
+      }
+    }
+    return aggregates.Load(filePath);
+  }
+
+  std::filesystem::path SeasonalityStore::GetFilePath(const std::string& symbol, const std::string& range, const std::string& interval)
+  {
+    std::string name = Utils::GetBaseSymbol(symbol) + "_" + range + "_" + interval + ".yaml";
+    std::replace_if(name.begin(), name.end(), [](unsigned char ch) { return !std::isalnum(ch) and ch != '.' and ch != '_' and ch != '-'; }, '_');
+    return s_directory / name;
+  }
+} // namespace KanVest
@@ -0,0 +1,508 @@
+//
+//  DaemonServer.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "DaemonServer.hpp"
+
+#include "Daemon/KanVestDaemon.hpp"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#include <charconv>
+
+namespace KanVest
+{
+  static std::string FormatReport(const DaemonSymbolReport& report)
+  {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << report.symbol << " name=" << report.shortName << " price=" << report.livePrice << " change%=" << report.changePercent
+    << " score=" << report.score << " rsi=" << report.rsi << " volatility%=" << report.volatility << " atr%=" << report.atrPercent << " candles=" << report.candles << " last=" << report.lastCandleTimestamp;
+    return oss.str();
+  }
+
+  static std::string FormatStats(const DaemonStats& stats)
+  {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << "symbols=" << stats.symbols << " ready=" << stats.readySymbols << " warm=" << (stats.warm ? 1 : 0)
+    << " startup_ms=" << stats.startupMs << " rss_mb=" << stats.residentMemoryMB
+    << " cpu%=" << stats.cpuPercent << " cpu%_per_100=" << stats.cpuPercentPer100 << " analyses=" << stats.analysisCount;
+    return oss.str();
+  }
+
+  static std::string FormatScreen(const ScreenerFilter& filter, const ScreenerResult& result)
+  {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << "matches=" << result.stats.matches << " symbols=" << result.stats.symbols << " bars=" << result.stats.bars
+    << " bar_bytes=" << result.stats.barBytes << " threads=" << result.stats.threads << " ms=" << result.stats.elapsedMs << "\n";
+    for (const auto& match : result.matches)
+    {
+      oss << match.symbol;
+      for (size_t i = 0; i < match.values.size(); ++i)
+      {
+        oss << " " << filter.GetOperands()[i].name << "=" << match.values[i];
+      }
+      oss << "\n";
+    }
+    return oss.str();
+  }
+
+  static std::string FormatPrecision(const PrecisionErrorStats& stats)
+  {
+    std::ostringstream oss;
+    oss << std::scientific << std::setprecision(2);
+    oss << "precision=" << GetPrecisionName(Daemon::GetScreenerPrecision())
+    << " series=" << stats.series << " values=" << stats.values << " max_rel_error=" << stats.maxRelativeError
+    << " worst=" << stats.worstIndicator << " max_rsi_error=" << stats.maxRSIError
+    << " within_bounds=" << (IndicatorPrecisionHarness::IsWithinBounds(stats) ? 1 : 0)
+    << std::fixed << " float64_ms=" << stats.float64Ms << " float32_ms=" << stats.float32Ms << " speedup=" << stats.Speedup();
+    return oss.str();
+  }
+
+  static std::string FormatVolatility(const VolatilityBenchmarkStats& stats)
+  {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(3);
+    oss << "series=" << stats.series << " bars=" << stats.bars << " fused_ms=" << stats.fusedMs << " separate_ms=" << stats.separateMs
+    << " speedup=" << stats.Speedup() << std::scientific << std::setprecision(2) << " max_difference=" << stats.maxDifference
+    << " max_atr_error=" << stats.maxATRError;
+    return oss.str();
+  }
+
+  static std::string FormatTimeframes(const MultiTimeframeBenchmarkStats& stats)
+  {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(3);
+    oss << "series=" << stats.series << " bars=" << stats.bars << " timeframes=" << stats.timeframes << " single_pass_ms=" << stats.singlePassMs
+    << " sequential_ms=" << stats.sequentialMs << " speedup=" << stats.Speedup() << " update_ms=" << stats.updateMs
+    << std::scientific << std::setprecision(2) << " max_difference=" << stats.maxDifference;
+    return oss.str();
+  }
+
+  static std::string FormatPatterns(const DaemonPatternReport& report)
+  {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << "symbols=" << report.symbols << " bars=" << report.bars << " ms=" << report.elapsedMs << " mbars/s=" << report.barsPerSecond / 1e6
+    << " latest=" << report.latest.size();
+    if (report.verified)
+    {
+      oss << " reference_ms=" << report.referenceMs << " mismatches=" << report.mismatches;
+    }
+    oss << "\n";
+    for (const auto& [symbol, mask] : report.latest)
+    {
+      oss << symbol << " " << PatternScanner::FormatMask(mask) << "\n";
+    }
+    return oss.str();
+  }
+
+  static std::string FormatRelativeStrength(const RelativeStrengthRanking& ranking)
+  {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << "benchmark=" << ranking.benchmark << " symbols=" << ranking.entries.size() << " bars=" << ranking.bars << " ms=" << ranking.elapsedMs << "\n";
+    for (const auto& entry : ranking.entries)
+    {
+      oss << entry.symbol << " percentile=" << entry.percentile << " mansfield=" << entry.mansfield << " ratio=" << entry.ratio;
+      if (!entry.sector.empty())
+      {
+        oss << " sector=" << entry.sector << " sector_percentile=" << entry.sectorPercentile << " sector_mansfield=" << entry.sectorMansfield;
+      }
+      oss << "\n";
+    }
+    return oss.str();
+  }
+
+  static std::string FormatFactors(const FactorResult& result)
+  {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << "symbols=" << result.stats.symbols << " scored=" << result.stats.scored << " factors=" << result.stats.factors << " threads=" << result.stats.threads
+    << std::setprecision(3) << " ms=" << result.stats.elapsedMs << " compute_ms=" << result.stats.computeMs << " normalize_ms=" << result.stats.normalizeMs
+    << " rank_ms=" << result.stats.rankMs << "\n" << std::setprecision(2);
+    for (const auto& leader : result.leaderboard)
+    {
+      oss << leader.rank << " " << leader.name << " score=" << leader.composite;
+      for (size_t factor = 0; factor < leader.zScores.size(); ++factor)
+      {
+        oss << " " << result.factorNames[factor] << "=" << leader.zScores[factor];
+      }
+      oss << "\n";
+    }
+    return oss.str();
+  }
+
+  static std::string FormatDistribution(const DaemonDistributionReport& report)
+  {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(4);
+    oss << "metric=" << DistributionAnalysis::GetName(report.metric) << " symbols=" << report.symbols << " values=" << report.values
+    << " retained=" << report.retained << " sketch_bytes=" << report.sketchBytes << " ms=" << report.mergeMs;
+    for (size_t i = 0; i < report.fractions.size(); ++i)
+    {
+      oss << " p" << std::lround(report.fractions[i] * 100.0) << "=" << report.quantiles[i];
+    }
+    oss << "\n" << std::setprecision(2);
+    for (const auto& [symbol, value, percentile] : report.latest)
+    {
+      oss << symbol << " last=" << value << " percentile=" << percentile << "\n";
+    }
+    return oss.str();
+  }
+
+  static std::string FormatBacktest(const BacktestResult& result)
+  {
+    const BacktestMetrics& metrics = result.metrics;
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << "equity=" << metrics.finalEquity << " return%=" << metrics.totalReturnPercent << " max_dd%=" << metrics.maxDrawdownPercent
+    << " sharpe=" << metrics.sharpe << " trades=" << metrics.trades << " win%=" << metrics.winRatePercent << " charges=" << metrics.charges
+    << " bars=" << result.stats.simulatedBars << " ms=" << result.stats.elapsedMs;
+    return oss.str();
+  }
+
+  static std::string FormatSweep(const BacktestSweepResult& result)
+  {
+    static constexpr size_t MaxCombinations = 10;
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << "combinations=" << result.combinations.size() << " bars=" << result.stats.simulatedBars << " threads=" << result.stats.threads
+    << " indicator_ms=" << result.stats.indicatorMs << " ms=" << result.stats.elapsedMs << " bars/s=" << result.stats.BarsPerSecond() << "\n";
+    for (size_t i = 0; i < std::min(MaxCombinations, result.combinations.size()); ++i)
+    {
+      const auto& combination = result.combinations[i];
+      for (size_t p = 0; p < combination.parameters.size(); ++p)
+      {
+        oss << (p ? "," : "") << combination.parameters[p];
+      }
+      const BacktestMetrics& metrics = combination.metrics;
+      oss << " return%=" << metrics.totalReturnPercent << " max_dd%=" << metrics.maxDrawdownPercent << " sharpe=" << metrics.sharpe
+      << " trades=" << metrics.trades << " win%=" << metrics.winRatePercent << "\n";
+    }
+    return oss.str();
+  }
+
+  /// This function parses the swept parameters "name=first:last:step,name=first:last:step"
+  /// - Parameters:
+  ///   - text: parameters text
+  ///   - parameters: parsed parameters output
+  static bool ParseSweepParameters(const std::string& text, std::vector<BacktestParameter>& parameters)
+  {
+    std::istringstream iss(text);
+    std::string token;
+    while (std::getline(iss, token, ','))
+    {
+      const size_t equal = token.find('=');
+      if (equal == 0 or equal == std::string::npos)
+      {
+        return false;
+      }
+
+      BacktestParameter& parameter = parameters.emplace_back();
+      parameter.name = token.substr(0, equal);
+
+      const std::string range = token.substr(equal + 1);
+      int consumed = 0;
+      if (std::sscanf(range.c_str(), "%lf:%lf:%lf%n", &parameter.first, &parameter.last, &parameter.step, &consumed) != 3 or
+          static_cast<size_t>(consumed) != range.size())
+      {
+        return false;
+      }
+    }
+    return !parameters.empty();
+  }
+
+  bool DaemonServer::Start(const std::string& socketPath)
+  {
+    s_socketPath = socketPath;
+
+    sockaddr_un address {};
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+      IK_LOG_ERROR("DaemonServer", "Socket path is too long : {0}", socketPath);
+      return false;
+    }
+
+    s_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (s_socket < 0)
+    {
+      IK_LOG_ERROR("DaemonServer", "Failed to create socket");
+      return false;
+    }
+
+    // Remove stale socket of previous run
+    unlink(socketPath.c_str());
+
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    if (bind(s_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 or listen(s_socket, 16) < 0)
+    {
+      IK_LOG_ERROR("DaemonServer", "Failed to bind socket at {0}", socketPath);
+      close(s_socket);
+      s_socket = -1;
+      return false;
+    }
+
+    IK_LOG_INFO("DaemonServer", "Listening at {0}", socketPath);
+
+    s_running = true;
+    s_acceptThread = std::thread(AcceptLoop);
+    return true;
+  }
+
+  void DaemonServer::Stop()
+  {
+    s_running = false;
+    if (s_acceptThread.joinable())
+    {
+      s_acceptThread.join();
+    }
+
+    if (s_socket >= 0)
+    {
+      close(s_socket);
+      s_socket = -1;
+      unlink(s_socketPath.c_str());
+    }
+  }
+
+  void DaemonServer::AcceptLoop()
+  {
+    while (s_running)
+    {
+      // Poll with timeout so that stop request is not blocked by accept
+      pollfd listener { s_socket, POLLIN, 0 };
+      if (poll(&listener, 1, 200 /* Milisecond */) <= 0)
+      {
+        continue;
+      }
+
+      int client = accept(s_socket, nullptr, nullptr);
+      if (client < 0)
+      {
+        continue;
+      }
+
+      // Read single request line
+      std::string request;
+      char buffer[256];
+      while (request.find('\n') == std::string::npos and request.size() < 1024)
+      {
+        ssize_t bytes = read(client, buffer, sizeof(buffer));
+        if (bytes <= 0)
+        {
+          break;
+        }
+        request.append(buffer, static_cast<size_t>(bytes));
+      }
+
+      if (size_t end = request.find_first_of("\r\n"); end != std::string::npos)
+      {
+        request.resize(end);
+      }
+
+      // Request must not end accept thread, failure of one command is reported to its client
+      std::string response;
+      try
+      {
+        response = HandleRequest(request) + "\n";
+      }
+      catch (const std::exception& exception)
+      {
+        IK_LOG_ERROR("DaemonServer", "Request '{0}' failed: {1}", request, exception.what());
+        response = std::string("ERROR ") + exception.what() + "\n";
+      }
+
+      const char* data = response.data();
+      size_t remaining = response.size();
+      while (remaining > 0)
+      {
+        ssize_t bytes = write(client, data, remaining);
+        if (bytes <= 0)
+        {
+          break;
+        }
+        data += bytes;
+        remaining -= static_cast<size_t>(bytes);
+      }
+      close(client);
+    }
+  }
+
+  std::string DaemonServer::HandleRequest(const std::string& request)
+  {
+    std::istringstream iss(request);
+    std::string command, argument;
+    iss >> command >> argument;
+
+    std::transform(command.begin(), command.end(), command.begin(), [](unsigned char c) { return std::toupper(c); });
+    std::transform(argument.begin(), argument.end(), argument.begin(), [](unsigned char c) { return std::toupper(c); });
+
+    if (command == "LIST")
+    {
+      std::string response;
+      for (const auto& report : Daemon::GetReports())
+      {
+        response += FormatReport(report) + "\n";
+      }
+      return response;
+    }
+
+    if (command == "GET")
+    {
+      if (auto report = Daemon::GetReport(argument); report)
+      {
+        return FormatReport(*report);
+      }
+      return "ERROR unknown symbol " + argument;
+    }
+
+    if (command == "STATS")
+    {
+      return FormatStats(Daemon::GetStats());
+    }
+
+    if (command == "SCREEN")
+    {
+      // Expression is rest of request, not only first word
+      const std::string expression = request.substr(request.find_first_not_of(" \t") + command.size());
+
+      const ScreenerFilter filter = ScreenerFilter::Compile(expression);
+      if (!filter.IsValid())
+      {
+        return "ERROR " + (filter.GetError().empty() ? std::string("empty expression") : filter.GetError());
+      }
+      return FormatScreen(filter, Daemon::Screen(filter));
+    }
+
+    if (command == "BACKTEST")
+    {
+      // BACKTEST <SYMBOL> <ENTRY> ; <EXIT>
+      std::istringstream strategyStream(request.substr(request.find_first_not_of(" \t") + command.size()));
+      std::string symbol, strategy;
+      strategyStream >> symbol;
+      std::getline(strategyStream, strategy);
+
+      const size_t separator = strategy.find(';');
+      if (argument.empty() or separator == std::string::npos)
+      {
+        return "ERROR usage BACKTEST <SYMBOL> <ENTRY> ; <EXIT>";
+      }
+
+      const BacktestResult result = Daemon::Backtest(argument, strategy.substr(0, separator), strategy.substr(separator + 1));
+      if (!result.error.empty())
+      {
+        return "ERROR " + result.error;
+      }
+      return FormatBacktest(result);
+    }
+
+    if (command == "SWEEP")
+    {
+      // SWEEP <SYMBOL> <NAME>=<FIRST>:<LAST>:<STEP>[,...] <ENTRY> ; <EXIT>, names are used as {NAME} in expressions
+      std::istringstream strategyStream(request.substr(request.find_first_not_of(" \t") + command.size()));
+      std::string symbol, parametersText, strategy;
+      strategyStream >> symbol >> parametersText;
+      std::getline(strategyStream, strategy);
+
+      std::vector<BacktestParameter> parameters;
+      const size_t separator = strategy.find(';');
+      if (argument.empty() or separator == std::string::npos or !ParseSweepParameters(parametersText, parameters))
+      {
+        return "ERROR usage SWEEP <SYMBOL> <NAME>=<FIRST>:<LAST>:<STEP>[,...] <ENTRY> ; <EXIT>";
+      }
+
+      const BacktestSweepResult result = Daemon::Sweep(argument, strategy.substr(0, separator), strategy.substr(separator + 1), parameters);
+      if (!result.error.empty())
+      {
+        return "ERROR " + result.error;
+      }
+      return FormatSweep(result);
+    }
+
+    if (command == "PRECISION")
+    {
+      // PRECISION [FLOAT32 | FLOAT64 | COMPACT], reports float32 deviation over universe before switching
+      if (argument == "FLOAT32" or argument == "FLOAT64" or argument == "COMPACT")
+      {
+        Daemon::SetScreenerPrecision(argument == "FLOAT32" ? IndicatorPrecision::Float32 : argument == "COMPACT" ? IndicatorPrecision::Compact
+                                     : IndicatorPrecision::Float64);
+      }
+      else if (!argument.empty())
+      {
+        return "ERROR usage PRECISION [FLOAT32 | FLOAT64 | COMPACT]";
+      }
+      return FormatPrecision(Daemon::CheckPrecision());
+    }
+
+    if (command == "VOLATILITY")
+    {
+      return FormatVolatility(Daemon::BenchmarkVolatility());
+    }
+
+    if (command == "TIMEFRAMES")
+    {
+      return FormatTimeframes(Daemon::BenchmarkTimeframes());
+    }
+
+    if (command == "PATTERNS")
+    {
+      // PATTERNS [VERIFY], verify compares bit parallel scan with scalar reference
+      if (!argument.empty() and argument != "VERIFY")
+      {
+        return "ERROR usage PATTERNS [VERIFY]";
+      }
+      return FormatPatterns(Daemon::ScanPatterns(argument == "VERIFY"));
+    }
+
+    if (command == "FACTORS")
+    {
+      // FACTORS [N], top N symbols by composite factor score. Number out of range is rejected, not thrown
+      size_t topN = 0;
+      if (!argument.empty())
+      {
+        const char* end = argument.data() + argument.size();
+        if (auto [parsed, error] = std::from_chars(argument.data(), end, topN); error != std::errc() or parsed != end)
+        {
+          return "ERROR usage FACTORS [N]";
+        }
+      }
+      return FormatFactors(Daemon::ScoreFactors(topN));
+    }
+
+    if (command == "QUANTILES")
+    {
+      // QUANTILES [RETURN | VOLUME | RANGE], universe quantiles and rank of last candle in history of each symbol
+      for (size_t index = 0; index < static_cast<size_t>(DistributionMetric::Count); ++index)
+      {
+        const DistributionMetric metric = static_cast<DistributionMetric>(index);
+        std::string name(DistributionAnalysis::GetName(metric));
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::toupper(c); });
+        if (argument == name or (argument.empty() and metric == DistributionMetric::Return))
+        {
+          return FormatDistribution(Daemon::GetDistribution(metric));
+        }
+      }
+      return "ERROR usage QUANTILES [RETURN | VOLUME | RANGE]";
+    }
+
+    if (command == "RS")
+    {
+      return FormatRelativeStrength(Daemon::GetRelativeStrength());
+    }
+
+    return "ERROR unknown command. Use LIST, GET <SYMBOL>, SCREEN <EXPRESSION>, BACKTEST <SYMBOL> <ENTRY> ; <EXIT>, "
+    "SWEEP <SYMBOL> <NAME>=<FIRST>:<LAST>:<STEP>[,...] <ENTRY> ; <EXIT>, PRECISION [FLOAT32 | FLOAT64], "
+    "VOLATILITY, TIMEFRAMES, PATTERNS [VERIFY], FACTORS [N], QUANTILES [RETURN | VOLUME | RANGE], RS or STATS";
+  }
+} // namespace KanVest
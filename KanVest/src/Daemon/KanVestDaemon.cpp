@@ -0,0 +1,701 @@
+//
+//  KanVestDaemon.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "KanVestDaemon.hpp"
+
+#include "Daemon/DaemonServer.hpp"
+
+#include "Stock/StockManager.hpp"
+#include "Stock/CorporateAction.hpp"
+#include "Stock/StockUtils.hpp"
+
+#include <sys/resource.h>
+
+#ifdef __APPLE__
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace KanVest
+{
+  static double GetProcessCpuSeconds()
+  {
+    rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+    static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+  }
+
+  static double GetResidentMemoryMB()
+  {
+#ifdef __APPLE__
+    mach_task_basic_info info {};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+    {
+      return 0.0;
+    }
+    return static_cast<double>(info.resident_size) / (1024.0 * 1024.0);
+#else
+    // statm reports total and resident sizes in pages
+    std::ifstream statm("/proc/self/statm");
+    size_t totalPages = 0, residentPages = 0;
+    if (!(statm >> totalPages >> residentPages))
+    {
+      return 0.0;
+    }
+    return static_cast<double>(residentPages) * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+#endif
+  }
+
+  DaemonSpecification Daemon::LoadSpecification(const std::filesystem::path& universeFilePath)
+  {
+    DaemonSpecification specification;
+
+    if (!std::filesystem::exists(universeFilePath))
+    {
+      IK_LOG_ERROR("Daemon", "Universe file {0} does not exist", universeFilePath.string());
+      return specification;
+    }
+
+    YAML::Node root = YAML::LoadFile(universeFilePath.string());
+
+    if (auto range = root["Range"]; range)
+    {
+      specification.range = API_Provider::GetRangeEnumFromString(range.as<std::string>());
+    }
+    if (auto interval = root["Interval"]; interval)
+    {
+      specification.interval = API_Provider::GetIntervalEnumFromString(interval.as<std::string>());
+    }
+    if (auto fetchDelay = root["FetchDelayMs"]; fetchDelay)
+    {
+      specification.fetchDelayMs = fetchDelay.as<int>();
+    }
+    if (auto pollDelay = root["PollDelayMs"]; pollDelay)
+    {
+      specification.pollDelayMs = pollDelay.as<int>();
+    }
+    if (auto statsInterval = root["StatsIntervalSec"]; statsInterval)
+    {
+      specification.statsIntervalSec = statsInterval.as<int>();
+    }
+    if (auto socketPath = root["SocketPath"]; socketPath)
+    {
+      specification.socketPath = socketPath.as<std::string>();
+    }
+    if (auto corporateActions = root["CorporateActions"]; corporateActions)
+    {
+      specification.corporateActionsPath = corporateActions.as<std::string>();
+    }
+    if (auto precision = root["ScreenerPrecision"]; precision)
+    {
+      const std::string name = KanViz::Utils::String::ToUpper(precision.as<std::string>());
+      specification.screenerPrecision = name == "FLOAT32" ? IndicatorPrecision::Float32 : name == "COMPACT" ? IndicatorPrecision::Compact
+      : IndicatorPrecision::Float64;
+    }
+
+    for (const auto& symbolNode : root["Symbols"])
+    {
+      specification.symbols.emplace_back(KanViz::Utils::String::ToUpper(symbolNode.as<std::string>()));
+    }
+
+    if (auto benchmark = root["Benchmark"]; benchmark)
+    {
+      specification.benchmark = KanViz::Utils::String::ToUpper(benchmark.as<std::string>());
+    }
+    // Sectors : sector index -> list of its symbols
+    for (const auto& sectorNode : root["Sectors"])
+    {
+      const std::string sector = KanViz::Utils::String::ToUpper(sectorNode.first.as<std::string>());
+      for (const auto& symbolNode : sectorNode.second)
+      {
+        specification.sectors[Utils::NormalizeSymbol(KanViz::Utils::String::ToUpper(symbolNode.as<std::string>()))] = sector;
+      }
+    }
+
+    // Factors : name -> weight in composite, e.g. MOM120: 1.0, VOL20: -0.5
+    if (auto factors = root["Factors"]; factors)
+    {
+      specification.factors.factors.clear();
+      for (const auto& factorNode : factors)
+      {
+        const std::string name = factorNode.first.as<std::string>();
+        if (auto factor = FactorPipeline::ParseFactor(name, factorNode.second.as<double>()); factor)
+        {
+          specification.factors.factors.push_back(*factor);
+        }
+        else
+        {
+          IK_LOG_WARN("Daemon", "Unknown factor {0}", name);
+        }
+      }
+    }
+    if (auto leaderboardSize = root["LeaderboardSize"]; leaderboardSize)
+    {
+      specification.factors.topN = leaderboardSize.as<size_t>();
+    }
+
+    return specification;
+  }
+
+  bool Daemon::Initialize(const DaemonSpecification& specification)
+  {
+    IK_PROFILE();
+
+    s_specification = specification;
+    s_screenerPrecision = s_specification.screenerPrecision;
+    if (s_specification.symbols.empty())
+    {
+      IK_LOG_ERROR("Daemon", "No symbol in universe");
+      return false;
+    }
+
+    IK_LOG_INFO("Daemon", "Initializing daemon for {0} symbols", s_specification.symbols.size());
+
+    if (!s_specification.corporateActionsPath.empty())
+    {
+      AdjustmentEngine::Load(s_specification.corporateActionsPath);
+    }
+
+    API_Provider::Initialize(StockAPIProvider::Yahoo);
+    StockManager::Initialize(s_specification.fetchDelayMs);
+    Screener::Initialize();
+    Backtester::Initialize();
+
+    {
+      std::scoped_lock lock(s_mutex);
+      s_reports.clear();
+      s_stats = {};
+      s_stats.symbols = s_specification.symbols.size();
+      s_relativeStrength = {};
+      s_distributions.clear();
+    }
+    s_benchmarkTimestamp = 0;
+    s_rankPending = false;
+    BenchmarkCache::Clear();
+
+    for (const auto& symbol : s_specification.symbols)
+    {
+      StockManager::AddStockDataRequest(symbol, s_specification.range, s_specification.interval);
+    }
+
+    // Benchmark and sector indices are fetched once, shared by every symbol. Compared normalized, so NIFTY in universe
+    // and %5ENSEI as benchmark are one request
+    std::unordered_set<std::string> universe;
+    for (const auto& symbol : s_specification.symbols)
+    {
+      universe.insert(Utils::NormalizeSymbol(symbol));
+    }
+    std::unordered_set<std::string> indices = {Utils::NormalizeSymbol(s_specification.benchmark)};
+    for (const auto& [symbol, sector] : s_specification.sectors)
+    {
+      indices.insert(Utils::NormalizeSymbol(sector));
+    }
+    for (const auto& index : indices)
+    {
+      if (!universe.contains(index))
+      {
+        StockManager::AddStockDataRequest(index, s_specification.range, s_specification.interval);
+      }
+    }
+
+    if (!DaemonServer::Start(s_specification.socketPath))
+    {
+      Backtester::Shutdown();
+      Screener::Shutdown();
+      StockManager::Shutdown();
+      return false;
+    }
+
+    s_statsWindowStart = std::chrono::steady_clock::now();
+    s_statsWindowCpuSec = GetProcessCpuSeconds();
+
+    s_running = true;
+    return true;
+  }
+
+  void Daemon::Run()
+  {
+    auto lastStatsLog = std::chrono::steady_clock::now();
+    while (s_running)
+    {
+      Poll();
+      UpdateStats();
+
+      // Log the statistics periodically
+      auto now = std::chrono::steady_clock::now();
+      if (now - lastStatsLog >= std::chrono::seconds(s_specification.statsIntervalSec))
+      {
+        lastStatsLog = now;
+
+        [[maybe_unused]] DaemonStats stats = GetStats();
+        IK_LOG_INFO("Daemon", "Ready {0}/{1} | Startup {2:.1f} ms | RSS {3:.1f} MB | CPU {4:.2f}% ({5:.2f}% per 100 symbols)",
+                    stats.readySymbols, stats.symbols, stats.startupMs, stats.residentMemoryMB, stats.cpuPercent, stats.cpuPercentPer100);
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(s_specification.pollDelayMs));
+    }
+  }
+
+  void Daemon::Stop()
+  {
+    s_running = false;
+  }
+
+  void Daemon::Shutdown()
+  {
+    IK_PROFILE();
+    IK_LOG_WARN("Daemon", "Shutting down daemon");
+
+    s_running = false;
+    DaemonServer::Stop();
+    Backtester::Shutdown();
+    Screener::Shutdown();
+    StockManager::Shutdown();
+  }
+
+  std::optional<DaemonSymbolReport> Daemon::GetReport(const std::string& symbol)
+  {
+    std::scoped_lock lock(s_mutex);
+    if (auto it = s_reports.find(symbol); it != s_reports.end())
+    {
+      return it->second;
+    }
+    return std::nullopt;
+  }
+
+  std::vector<DaemonSymbolReport> Daemon::GetReports()
+  {
+    std::scoped_lock lock(s_mutex);
+
+    std::vector<DaemonSymbolReport> reports;
+    reports.reserve(s_reports.size());
+    for (const auto& symbol : s_specification.symbols)
+    {
+      if (auto it = s_reports.find(symbol); it != s_reports.end())
+      {
+        reports.push_back(it->second);
+      }
+    }
+    return reports;
+  }
+
+  ScreenerResult Daemon::Screen(const ScreenerFilter& filter)
+  {
+    IK_PERFORMANCE_FUNC("Daemon::Screen");
+
+    ScreenerUniverse universe;
+    BuildUniverse(universe, true);
+
+    ScreenerResult result = Screener::Run(filter, universe);
+    IK_LOG_INFO("Daemon", "Screened {0} symbols ({1} bars, {2}, {3:.2f} MB) in {4:.2f} ms on {5} threads, {6} matches for '{7}'",
+                result.stats.symbols, result.stats.bars, GetPrecisionName(universe.precision), result.stats.barBytes / (1024.0 * 1024.0),
+                result.stats.elapsedMs, result.stats.threads, result.stats.matches, filter.GetExpression());
+    return result;
+  }
+
+  BacktestResult Daemon::Backtest(const std::string& symbol, const std::string& entry, const std::string& exit)
+  {
+    IK_PERFORMANCE_FUNC("Daemon::Backtest");
+
+    StockData stockData = StockManager::GetLatestStockData(symbol);
+    if (!stockData.IsValid())
+    {
+      BacktestResult result;
+      result.error = "No data of symbol " + symbol;
+      return result;
+    }
+    return Backtester::Run(stockData, entry, exit);
+  }
+
+  BacktestSweepResult Daemon::Sweep(const std::string& symbol, const std::string& entry, const std::string& exit,
+                                    const std::vector<BacktestParameter>& parameters)
+  {
+    IK_PERFORMANCE_FUNC("Daemon::Sweep");
+
+    StockData stockData = StockManager::GetLatestStockData(symbol);
+    if (!stockData.IsValid())
+    {
+      BacktestSweepResult result;
+      result.error = "No data of symbol " + symbol;
+      return result;
+    }
+
+    BacktestSweepResult result = Backtester::Sweep(stockData, entry, exit, parameters);
+    if (result.error.empty())
+    {
+      IK_LOG_INFO("Daemon", "Swept {0} combinations of {1} ({2} bars) in {3:.2f} ms (indicators {4:.2f}) on {5} threads, {6:.1f} M bars/s",
+                  result.combinations.size(), symbol, result.stats.simulatedBars, result.stats.elapsedMs, result.stats.indicatorMs,
+                  result.stats.threads, result.stats.BarsPerSecond() / 1e6);
+    }
+    return result;
+  }
+
+  DaemonPatternReport Daemon::ScanPatterns(bool verify)
+  {
+    IK_PERFORMANCE_FUNC("Daemon::ScanPatterns");
+
+    ScreenerUniverse universe;
+    BuildUniverse(universe);
+
+    PatternScanResult scan;
+    PatternScanner::Scan(universe, scan);
+
+    DaemonPatternReport report;
+    report.symbols = universe.Size();
+    report.bars = scan.Bars();
+    report.elapsedMs = scan.elapsedMs;
+    report.barsPerSecond = scan.BarsPerSecond();
+    for (size_t symbol = 0; symbol < universe.Size(); ++symbol)
+    {
+      if (const PatternMask mask = scan.GetLatestMask(symbol); mask != 0)
+      {
+        report.latest.emplace_back(universe.symbols[symbol], mask);
+      }
+    }
+
+    if (verify)
+    {
+      PatternScanResult reference;
+      PatternScanner::ScanReference(universe, reference);
+      report.verified = true;
+      report.mismatches = PatternScanner::CountMismatches(scan, reference);
+      report.referenceMs = reference.elapsedMs;
+    }
+
+    IK_LOG_INFO("Daemon", "Scanned patterns of {0} symbols ({1} bars) in {2:.2f} ms, {3:.1f} M bars/s, {4} symbols with pattern at last candle",
+                report.symbols, report.bars, report.elapsedMs, report.barsPerSecond / 1e6, report.latest.size());
+    return report;
+  }
+
+  FactorResult Daemon::ScoreFactors(size_t topN)
+  {
+    IK_PERFORMANCE_FUNC("Daemon::ScoreFactors");
+
+    ScreenerUniverse universe;
+    BuildUniverse(universe);
+
+    FactorSettings settings = s_specification.factors;
+    settings.topN = topN ? topN : settings.topN;
+
+    FactorResult result;
+    FactorPipeline::Run(universe, settings, result);
+    IK_LOG_INFO("Daemon", "Scored {0} symbols on {1} factors in {2:.3f} ms (compute {3:.3f}, normalize {4:.3f}, rank {5:.3f}) on {6} threads",
+                result.stats.scored, result.stats.factors, result.stats.elapsedMs, result.stats.computeMs, result.stats.normalizeMs, result.stats.rankMs,
+                result.stats.threads);
+    return result;
+  }
+
+  DaemonDistributionReport Daemon::GetDistribution(DistributionMetric metric)
+  {
+    IK_PERFORMANCE_FUNC("Daemon::GetDistribution");
+
+    DaemonDistributionReport report;
+    report.metric = metric;
+
+    KanViz::Timer timer;
+    QuantileSketch universe;
+    {
+      std::scoped_lock lock(s_mutex);
+      for (const auto& symbol : s_specification.symbols)
+      {
+        if (auto it = s_distributions.find(symbol); it != s_distributions.end())
+        {
+          const auto& distribution = it->second;
+          universe.Merge(distribution.GetSketch(metric));
+          report.latest.emplace_back(symbol, distribution.GetLatestValue(metric), distribution.GetLatestPercentile(metric));
+          report.sketchBytes += distribution.GetSketch(metric).GetMemoryUsage();
+        }
+      }
+    }
+    universe.GetQuantiles(report.fractions, report.quantiles);
+    report.mergeMs = timer.ElapsedMilliseconds();
+
+    report.symbols = report.latest.size();
+    report.values = universe.Count();
+    report.retained = universe.Retained();
+    IK_LOG_INFO("Daemon", "Merged {0} distribution of {1} symbols ({2} values) in {3:.3f} ms, median {4:.4f}",
+                DistributionAnalysis::GetName(metric), report.symbols, report.values, report.mergeMs, universe.GetQuantile(0.5));
+    return report;
+  }
+
+  PrecisionErrorStats Daemon::CheckPrecision()
+  {
+    IK_PERFORMANCE_FUNC("Daemon::CheckPrecision");
+
+    PrecisionErrorStats stats;
+    std::vector<double> closes;
+    for (const auto& symbol : s_specification.symbols)
+    {
+      StockData stockData = StockManager::GetLatestStockData(symbol);
+      if (!stockData.IsValid())
+      {
+        continue;
+      }
+
+      closes.clear();
+      if (auto adjusted = AdjustmentEngine::HasActions(symbol) ? AdjustmentEngine::GetAdjustedColumns(stockData) : nullptr)
+      {
+        closes = adjusted->closes;
+      }
+      else
+      {
+        for (const auto& candle : stockData.candleHistory)
+        {
+          closes.push_back(candle.close);
+        }
+      }
+      IndicatorPrecisionHarness::Compare(closes.data(), closes.size(), ValidMovingAveragePeriods, stats);
+    }
+
+    IK_LOG_INFO("Daemon", "Float32 indicators over {0} symbols: max relative error {1:.2e} ({2}), max RSI error {3:.2e}, speedup {4:.2f}x",
+                stats.series, stats.maxRelativeError, stats.worstIndicator, stats.maxRSIError, stats.Speedup());
+    return stats;
+  }
+
+  VolatilityBenchmarkStats Daemon::BenchmarkVolatility()
+  {
+    IK_PERFORMANCE_FUNC("Daemon::BenchmarkVolatility");
+
+    VolatilityBenchmarkStats stats;
+    CandleColumns columns;
+    for (const auto& symbol : s_specification.symbols)
+    {
+      StockData stockData = StockManager::GetLatestStockData(symbol);
+      if (!stockData.IsValid())
+      {
+        continue;
+      }
+
+      columns.Clear();
+      if (auto adjusted = AdjustmentEngine::HasActions(symbol) ? AdjustmentEngine::GetAdjustedColumns(stockData) : nullptr)
+      {
+        columns = *adjusted;
+      }
+      else
+      {
+        for (const auto& candle : stockData.candleHistory)
+        {
+          columns.opens.push_back(candle.open);
+          columns.highs.push_back(candle.high);
+          columns.lows.push_back(candle.low);
+          columns.closes.push_back(candle.close);
+        }
+      }
+      Volatility::Benchmark(columns.opens.data(), columns.highs.data(), columns.lows.data(), columns.closes.data(), columns.Size(), stats);
+    }
+
+    IK_LOG_INFO("Daemon", "Volatility over {0} symbols ({1} bars): fused {2:.3f} ms, separate {3:.3f} ms, speedup {4:.2f}x, max difference {5:.2e}",
+                stats.series, stats.bars, stats.fusedMs, stats.separateMs, stats.Speedup(), stats.maxDifference);
+    return stats;
+  }
+
+  MultiTimeframeBenchmarkStats Daemon::BenchmarkTimeframes()
+  {
+    IK_PERFORMANCE_FUNC("Daemon::BenchmarkTimeframes");
+
+    MultiTimeframeBenchmarkStats stats;
+    for (const auto& symbol : s_specification.symbols)
+    {
+      if (const StockData stockData = StockManager::GetLatestStockData(symbol); stockData.IsValid())
+      {
+        MultiTimeframeAnalyzer::Benchmark(stockData, stats);
+      }
+    }
+
+    IK_LOG_INFO("Daemon", "Timeframes over {0} symbols ({1} bars): single pass {2:.3f} ms, sequential {3:.3f} ms, speedup {4:.2f}x, update {5:.3f} ms, max difference {6:.2e}",
+                stats.series, stats.bars, stats.singlePassMs, stats.sequentialMs, stats.Speedup(), stats.updateMs, stats.maxDifference);
+    return stats;
+  }
+
+  RelativeStrengthRanking Daemon::GetRelativeStrength()
+  {
+    {
+      std::scoped_lock lock(s_mutex);
+      if (!s_relativeStrength.entries.empty())
+      {
+        return s_relativeStrength;
+      }
+    }
+
+    // Not ranked yet (universe still warming up), rank what is available
+    RankRelativeStrength();
+    std::scoped_lock lock(s_mutex);
+    return s_relativeStrength;
+  }
+
+  void Daemon::SetScreenerPrecision(IndicatorPrecision precision)
+  {
+    s_screenerPrecision = precision;
+    IK_LOG_INFO("Daemon", "Screener precision set to {0}", GetPrecisionName(precision));
+  }
+
+  DaemonStats Daemon::GetStats()
+  {
+    std::scoped_lock lock(s_mutex);
+    return s_stats;
+  }
+
+  void Daemon::BuildUniverse(ScreenerUniverse& universe, bool screener)
+  {
+    // Compact universe has no columns, other scans read float64 columns instead
+    const IndicatorPrecision precision = s_screenerPrecision;
+    universe.Clear();
+    universe.precision = (screener or precision != IndicatorPrecision::Compact) ? precision : IndicatorPrecision::Float64;
+    universe.Reserve(s_specification.symbols.size(), 0);
+    for (const auto& symbol : s_specification.symbols)
+    {
+      if (StockData stockData = StockManager::GetLatestStockData(symbol); stockData.IsValid())
+      {
+        universe.Add(stockData);
+      }
+    }
+  }
+
+  bool Daemon::UpdateBenchmarks()
+  {
+    StockData benchmark = StockManager::GetLatestStockData(s_specification.benchmark);
+    if (!benchmark.IsValid() or benchmark.candleHistory.empty())
+    {
+      return false;
+    }
+
+    // Also shared by analysis contexts of each symbol
+    BenchmarkCache::Update(benchmark);
+    std::unordered_set<std::string> updated;
+    for (const auto& [symbol, sector] : s_specification.sectors)
+    {
+      if (updated.insert(sector).second)
+      {
+        BenchmarkCache::Update(StockManager::GetLatestStockData(sector));
+      }
+    }
+
+    const uint32_t lastTimestamp = benchmark.candleHistory.back().timestamp;
+    if (lastTimestamp == s_benchmarkTimestamp)
+    {
+      return false;
+    }
+    s_benchmarkTimestamp = lastTimestamp;
+    return true;
+  }
+
+  void Daemon::RankRelativeStrength()
+  {
+    IK_PERFORMANCE_FUNC("Daemon::RankRelativeStrength");
+
+    ScreenerUniverse universe;
+    BuildUniverse(universe);
+
+    std::vector<std::string> sectors(universe.Size());
+    for (size_t symbol = 0; symbol < universe.Size(); ++symbol)
+    {
+      if (auto it = s_specification.sectors.find(Utils::NormalizeSymbol(universe.symbols[symbol])); it != s_specification.sectors.end())
+      {
+        sectors[symbol] = it->second;
+      }
+    }
+
+    RelativeStrengthRanking ranking;
+    RelativeStrength::Rank(universe, API_Provider::GetIntervalStringFromEnum(s_specification.interval), sectors, s_specification.benchmark, ranking);
+    IK_LOG_INFO("Daemon", "Ranked relative strength of {0} symbols ({1} bars) against {2} in {3:.3f} ms",
+                ranking.entries.size(), ranking.bars, ranking.benchmark, ranking.elapsedMs);
+
+    std::scoped_lock lock(s_mutex);
+    s_relativeStrength = std::move(ranking);
+  }
+
+  void Daemon::Poll()
+  {
+    IK_PERFORMANCE_FUNC("Daemon::Poll");
+
+    // New benchmark candle means previous one closed, ranking is refreshed after symbols are analyzed
+    s_rankPending |= UpdateBenchmarks();
+
+    for (const auto& symbol : s_specification.symbols)
+    {
+      StockData stockData = StockManager::GetLatestStockData(symbol);
+      if (!stockData.IsValid())
+      {
+        continue;
+      }
+
+      const uint32_t lastTimestamp = stockData.candleHistory.empty() ? 0 : stockData.candleHistory.back().timestamp;
+
+      // Skip analysis if nothing changed since last poll
+      {
+        std::scoped_lock lock(s_mutex);
+        if (auto it = s_reports.find(symbol); it != s_reports.end())
+        {
+          const auto& report = it->second;
+          if (report.livePrice == stockData.livePrice and report.candles == stockData.candleHistory.size() and report.lastCandleTimestamp == lastTimestamp)
+          {
+            continue;
+          }
+        }
+      }
+
+      // Each symbol has its own context, UI analyzer state is not touched
+      AnalysisContext& context = s_contexts[symbol];
+      context.Analyze(stockData);
+
+      DaemonSymbolReport report;
+      report.symbol = symbol;
+      report.shortName = stockData.shortName;
+      report.livePrice = stockData.livePrice;
+      report.changePercent = stockData.changePercent;
+      report.score = context.GetReport().score;
+      report.rsi = context.GetRSI().last;
+      report.volatility = context.GetVolatility().Latest(VolatilityEstimator::YangZhang);
+      report.atrPercent = stockData.livePrice > 0.0 ? 100.0 * context.GetVolatility().LatestATR() / stockData.livePrice : report.atrPercent;
+      report.candles = stockData.candleHistory.size();
+      report.lastCandleTimestamp = lastTimestamp;
+      report.analyzedAt = std::chrono::steady_clock::now();
+
+      std::scoped_lock lock(s_mutex);
+      s_reports[symbol] = std::move(report);
+      s_distributions[symbol] = context.GetDistribution();
+      s_stats.analysisCount++;
+    }
+
+    if (s_rankPending and GetStats().warm)
+    {
+      s_rankPending = false;
+      RankRelativeStrength();
+    }
+  }
+
+  void Daemon::UpdateStats()
+  {
+    std::scoped_lock lock(s_mutex);
+
+    s_stats.readySymbols = s_reports.size();
+    if (!s_stats.warm and s_stats.readySymbols == s_stats.symbols)
+    {
+      s_stats.warm = true;
+      s_stats.startupMs = s_launchTimer.ElapsedMilliseconds();
+      IK_LOG_INFO("Daemon", "Universe of {0} symbols is warm in {1:.1f} ms", s_stats.symbols, s_stats.startupMs);
+    }
+
+    s_stats.residentMemoryMB = GetResidentMemoryMB();
+
+    // CPU usage over stats window
+    auto now = std::chrono::steady_clock::now();
+    double wallSec = std::chrono::duration<double>(now - s_statsWindowStart).count();
+    if (wallSec >= static_cast<double>(s_specification.statsIntervalSec))
+    {
+      double cpuSec = GetProcessCpuSeconds();
+      s_stats.cpuPercent = 100.0 * (cpuSec - s_statsWindowCpuSec) / wallSec;
+      s_stats.cpuPercentPer100 = s_stats.symbols ? s_stats.cpuPercent * 100.0 / static_cast<double>(s_stats.symbols) : 0.0;
+
+      s_statsWindowStart = now;
+      s_statsWindowCpuSec = cpuSec;
+    }
+  }
+} // namespace KanVest
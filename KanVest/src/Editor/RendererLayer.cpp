@@ -12,10 +12,15 @@
 #include "URL_API/API_Provider.hpp"
 
 #include "Stock/StockManager.hpp"
+#include "Stock/CorporateAction.hpp"
+
+#include "Analyzer/Seasonality.hpp"
 
 namespace KanVest
 {
   static const std::filesystem::path KanVestResourcePath = "../../../KanVest/Resources";
+  static const std::filesystem::path CorporateActionsFilePath = "../../../KanVest/UserData/CorporateActions.yaml";
+  static const std::filesystem::path SeasonalityDirectoryPath = "../../../KanVest/UserData/Seasonality";
   
   // Kretor Resource Path
 #define KanVestResourcePath(path) std::filesystem::absolute(KanVestResourcePath / path)
@@ -148,6 +153,9 @@ namespace KanVest
     // Intialize KanVest Data
     KanVest::UI::Panel::SetShadowTextureId(KanVasX::UI::GetTextureID(m_shadowTexture->GetRendererID()));
     
+    AdjustmentEngine::Load(CorporateActionsFilePath);
+    SeasonalityStore::SetDirectory(SeasonalityDirectoryPath);
+
     API_Provider::Initialize(StockAPIProvider::Yahoo);
     StockManager::Initialize(10 /* Milisecond */);
   }
@@ -158,6 +166,7 @@ namespace KanVest
     IK_LOG_WARN("RendererLayer", "Detaching '{0}' Layer from application", GetName());
     
     StockManager::Shutdown();
+    SeasonalityStore::Shutdown();
   }
   
   void RendererLayer::OnUpdate(const KanViz::TimeStep& ts)
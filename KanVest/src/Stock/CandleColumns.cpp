@@ -0,0 +1,52 @@
+//
+//  CandleColumns.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "CandleColumns.hpp"
+
+namespace KanVest
+{
+  void CandleColumns::Reserve(size_t size)
+  {
+    timestamps.reserve(size);
+    opens.reserve(size);
+    highs.reserve(size);
+    lows.reserve(size);
+    closes.reserve(size);
+    volumes.reserve(size);
+  }
+
+  void CandleColumns::Clear()
+  {
+    timestamps.clear();
+    opens.clear();
+    highs.clear();
+    lows.clear();
+    closes.clear();
+    volumes.clear();
+  }
+
+  void CandleColumns::Append(const std::vector<CandleData>& candles, size_t begin)
+  {
+    const size_t count = candles.size();
+    begin = std::min({begin, count, Size()});
+    timestamps.resize(count);
+    opens.resize(count);
+    highs.resize(count);
+    lows.resize(count);
+    closes.resize(count);
+    volumes.resize(count);
+    for (size_t i = begin; i < count; ++i)
+    {
+      timestamps[i] = candles[i].timestamp;
+      opens[i] = candles[i].open;
+      highs[i] = candles[i].high;
+      lows[i] = candles[i].low;
+      closes[i] = candles[i].close;
+      volumes[i] = candles[i].volume;
+    }
+  }
+} // namespace KanVest
@@ -0,0 +1,188 @@
+//
+//  CompactCandle.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "CompactCandle.hpp"
+
+namespace KanVest
+{
+  // Candidate scales: 0.05 tick, paise, and finer for indices / low priced instruments
+  static constexpr int32_t PriceScales[] = {20, 100, 1000, 10000};
+
+  /// This function returns the smallest price scale that stores every price exactly and keeps the largest price in int32
+  /// - Parameter visitPrices: calls the visitor with every price, stops and returns false when visitor returns false
+  template<typename VisitPrices>
+  static int32_t SelectPriceScale(VisitPrices&& visitPrices)
+  {
+    double maxPrice = 0.0;
+    visitPrices([&maxPrice](double price) {
+      maxPrice = std::max(maxPrice, std::abs(price));
+      return true;
+    });
+
+    int32_t selectedScale = 1;
+    for (int32_t scale : PriceScales)
+    {
+      // Stop if max price does not fit in int32 with this scale
+      if (maxPrice * scale >= static_cast<double>(std::numeric_limits<int32_t>::max()))
+      {
+        break;
+      }
+      selectedScale = scale;
+
+      const bool exact = visitPrices([scale](double price) {
+        const double scaled = price * scale;
+        return std::abs(scaled - std::round(scaled)) < 1e-4;
+      });
+      if (exact)
+      {
+        break;
+      }
+    }
+    return selectedScale;
+  }
+
+  void CompactCandleSeries::Reset(int32_t priceScale, uint32_t baseTimestamp)
+  {
+    m_priceScale = priceScale;
+    m_inversePriceScale = 1.0 / priceScale;
+    m_baseTimestamp = baseTimestamp;
+    m_candles.clear();
+    m_volumeOverflow.clear();
+  }
+
+  bool CompactCandleSeries::Build(const std::vector<CandleData>& history, CompactCandleSeries& series)
+  {
+    IK_PERFORMANCE_FUNC("CompactCandleSeries::Build");
+
+    const int32_t priceScale = SelectPriceScale([&history](auto&& visitor) {
+      return std::all_of(history.begin(), history.end(), [&visitor](const CandleData& candle) {
+        return visitor(candle.open) and visitor(candle.high) and visitor(candle.low) and visitor(candle.close);
+      });
+    });
+    series.Reset(priceScale, history.empty() ? 0 : history.front().timestamp);
+
+    series.m_candles.reserve(history.size());
+    for (const auto& candle : history)
+    {
+      if (!series.Append(candle.timestamp, candle.open, candle.high, candle.low, candle.close, candle.volume))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool CompactCandleSeries::Build(const CandleColumns& columns, CompactCandleSeries& series)
+  {
+    IK_PERFORMANCE_FUNC("CompactCandleSeries::Build");
+
+    const size_t count = columns.Size();
+    const int32_t priceScale = SelectPriceScale([&columns, count](auto&& visitor) {
+      for (size_t i = 0; i < count; ++i)
+      {
+        if (!visitor(columns.opens[i]) or !visitor(columns.highs[i]) or !visitor(columns.lows[i]) or !visitor(columns.closes[i]))
+        {
+          return false;
+        }
+      }
+      return true;
+    });
+    series.Reset(priceScale, count ? columns.timestamps.front() : 0);
+
+    series.m_candles.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (!series.Append(columns.timestamps[i], columns.opens[i], columns.highs[i], columns.lows[i], columns.closes[i], columns.volumes[i]))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool CompactCandleSeries::ToFixed(double price, int32_t& fixed) const
+  {
+    const double scaled = std::round(price * m_priceScale);
+    if (!std::isfinite(scaled) or scaled > static_cast<double>(std::numeric_limits<int32_t>::max()) or
+        scaled < static_cast<double>(std::numeric_limits<int32_t>::min()))
+    {
+      return false;
+    }
+    fixed = static_cast<int32_t>(scaled);
+    return true;
+  }
+
+  bool CompactCandleSeries::Append(uint32_t timestamp, double open, double high, double low, double close, uint64_t volume)
+  {
+    if (m_candles.empty() and m_baseTimestamp == 0)
+    {
+      m_baseTimestamp = timestamp;
+    }
+
+    // Delta is unsigned, older candle would wrap around
+    if (timestamp < m_baseTimestamp)
+    {
+      IK_LOG_WARN("CompactCandle", "Candle {0} is older than series base timestamp {1}", timestamp, m_baseTimestamp);
+      return false;
+    }
+
+    CompactCandle candle;
+    if (!ToFixed(open, candle.open) or !ToFixed(high, candle.high) or !ToFixed(low, candle.low) or !ToFixed(close, candle.close))
+    {
+      IK_LOG_WARN("CompactCandle", "Candle {0} has price that does not fit price scale {1}", timestamp, m_priceScale);
+      return false;
+    }
+    candle.timeDelta = timestamp - m_baseTimestamp;
+
+    if (volume >= VolumeEscape)
+    {
+      candle.volume = VolumeEscape;
+      m_volumeOverflow.emplace_back(static_cast<uint32_t>(m_candles.size()), volume);
+    }
+    else
+    {
+      candle.volume = static_cast<uint32_t>(volume);
+    }
+
+    m_candles.push_back(candle);
+    return true;
+  }
+
+  uint64_t CompactCandleSeries::GetVolume(size_t index) const
+  {
+    const uint32_t volume = m_candles[index].volume;
+    if (volume != VolumeEscape)
+    {
+      return volume;
+    }
+
+    // Overflow table is sorted by index as candles are only appended
+    auto it = std::lower_bound(m_volumeOverflow.begin(), m_volumeOverflow.end(), static_cast<uint32_t>(index),
+                               [](const auto& entry, uint32_t value) { return entry.first < value; });
+    return (it != m_volumeOverflow.end() and it->first == index) ? it->second : VolumeEscape;
+  }
+
+  CandleData CompactCandleSeries::Decode(size_t index) const
+  {
+    const CompactCandle& compact = m_candles[index];
+
+    CandleData candle;
+    candle.open = ToPrice(compact.open);
+    candle.high = ToPrice(compact.high);
+    candle.low = ToPrice(compact.low);
+    candle.close = ToPrice(compact.close);
+    candle.range = ToPrice(static_cast<int64_t>(compact.high) - compact.low);
+    candle.volume = static_cast<uint32_t>(std::min<uint64_t>(GetVolume(index), std::numeric_limits<uint32_t>::max()));
+    candle.timestamp = m_baseTimestamp + compact.timeDelta;
+    return candle;
+  }
+
+  size_t CompactCandleSeries::GetMemoryUsage() const
+  {
+    return sizeof(*this) + m_candles.capacity() * sizeof(CompactCandle) + m_volumeOverflow.capacity() * sizeof(m_volumeOverflow[0]);
+  }
+} // namespace KanVest
@@ -0,0 +1,261 @@
+//
+//  CorporateAction.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "CorporateAction.hpp"
+
+#include "Stock/StockParser.hpp"
+#include "Stock/StockUtils.hpp"
+
+#include <unordered_set>
+
+namespace KanVest
+{
+  double CorporateAction::GetPriceFactor() const
+  {
+    if (from <= 0.0 or to <= 0.0)
+    {
+      return 1.0;
+    }
+
+    switch (type)
+    {
+      case CorporateActionType::Split: return from / to;
+      case CorporateActionType::Bonus: return from / (from + to);
+      default:
+        return 1.0;
+    }
+  }
+
+  void AdjustmentEngine::Load(const std::filesystem::path& filePath)
+  {
+    if (!std::filesystem::exists(filePath))
+    {
+      IK_LOG_WARN("AdjustmentEngine", "Corporate action file {0} does not exist", filePath.string());
+      return;
+    }
+
+    YAML::Node root = YAML::LoadFile(filePath.string());
+
+    std::vector<std::pair<std::string, CorporateAction>> actions;
+    for (const auto& actionNode : root["CorporateActions"])
+    {
+      CorporateAction action;
+      action.type = actionNode["Type"].as<std::string>() == "Bonus" ? CorporateActionType::Bonus : CorporateActionType::Split;
+      action.exDate = static_cast<uint32_t>(StockParser::ParseDateYYYYMMDD(actionNode["ExDate"].as<std::string>()));
+      action.from = actionNode["From"].as<double>();
+      action.to = actionNode["To"].as<double>();
+
+      actions.emplace_back(actionNode["Symbol"].as<std::string>(), action);
+    }
+
+    AddActions(actions);
+    IK_LOG_INFO("AdjustmentEngine", "Loaded {0} corporate actions", actions.size());
+  }
+
+  void AdjustmentEngine::AddAction(const std::string& symbol, const CorporateAction& action)
+  {
+    AddActions({{symbol, action}});
+  }
+
+  void AdjustmentEngine::AddActions(const std::vector<std::pair<std::string, CorporateAction>>& actions)
+  {
+    std::scoped_lock lock(s_mutex);
+
+    std::unordered_set<std::string> touchedSymbols;
+    for (const auto& [symbol, action] : actions)
+    {
+      std::string key = Utils::NormalizeSymbol(symbol);
+      s_actions[key].push_back(action);
+      touchedSymbols.insert(std::move(key));
+    }
+
+    // Keep actions sorted and bump version once per touched symbol. Other symbol caches stay valid
+    for (const auto& key : touchedSymbols)
+    {
+      auto& symbolActions = s_actions[key];
+      std::stable_sort(symbolActions.begin(), symbolActions.end(), [](const auto& a, const auto& b) { return a.exDate < b.exDate; });
+      s_versions[key]++;
+      s_cache.erase(key);
+    }
+  }
+
+  bool AdjustmentEngine::HasActions(const std::string& symbol)
+  {
+    std::scoped_lock lock(s_mutex);
+    return s_actions.contains(Utils::NormalizeSymbol(Utils::GetBaseSymbol(symbol)));
+  }
+
+  uint64_t AdjustmentEngine::GetVersion(const std::string& symbol)
+  {
+    std::scoped_lock lock(s_mutex);
+    auto it = s_versions.find(Utils::NormalizeSymbol(Utils::GetBaseSymbol(symbol)));
+    return it != s_versions.end() ? it->second : 0;
+  }
+
+  std::shared_ptr<const CandleColumns> AdjustmentEngine::GetAdjustedColumns(const StockData& stockData)
+  {
+    // Tagged series (e.g. Heikin Ashi bars) take actions of base symbol, but its revision is not of base series so
+    // adjusted columns are cached under full symbol
+    const std::string key = Utils::NormalizeSymbol(stockData.symbol);
+    const std::string actionKey = Utils::NormalizeSymbol(Utils::GetBaseSymbol(stockData.symbol));
+    const auto& history = stockData.candleHistory;
+
+    std::vector<CorporateAction> actions;
+    std::shared_ptr<const CandleColumns> cached;
+    std::shared_ptr<CandleColumns> owned;
+    uint64_t version = 0;
+    {
+      std::scoped_lock lock(s_mutex);
+
+      auto actionsItr = s_actions.find(actionKey);
+      if (actionsItr == s_actions.end() or history.empty())
+      {
+        return nullptr;
+      }
+      version = s_versions[actionKey];
+
+      // Same revision means candles before cached last one are unchanged, only tail is checked
+      if (auto cacheItr = s_cache.find(key); cacheItr != s_cache.end())
+      {
+        const CacheEntry& entry = cacheItr->second;
+        if (entry.version == version and entry.revision == stockData.revision and stockData.revision != 0 and
+            entry.columns->Size() <= history.size())
+        {
+          if (entry.columns->Size() == history.size() and entry.lastTimestamp == history.back().timestamp and entry.lastClose == history.back().close)
+          {
+            s_stats.cacheHits++;
+            return entry.columns;
+          }
+          cached = entry.columns;
+
+          // Columns held by cache alone are taken out of it and adjusted in place, no reader can see them change
+          if (cached.use_count() == 2)
+          {
+            owned = std::const_pointer_cast<CandleColumns>(std::move(cached));
+            s_cache.erase(cacheItr);
+          }
+        }
+      }
+      actions = actionsItr->second;
+    }
+
+    IK_PERFORMANCE_FUNC("AdjustmentEngine::GetAdjustedColumns");
+    KanViz::Timer timer;
+
+    // Columns shared with readers are copied before tail is adjusted. Last cached candle may have been forming
+    std::shared_ptr<CandleColumns> columns = std::move(owned);
+    if (!columns)
+    {
+      columns = cached ? std::make_shared<CandleColumns>(*cached) : std::make_shared<CandleColumns>();
+      columns->Reserve(history.size());
+    }
+    const size_t begin = columns->Size() > 0 ? columns->Size() - 1 : 0;
+    columns->timestamps.resize(begin);
+    columns->opens.resize(begin);
+    columns->highs.resize(begin);
+    columns->lows.resize(begin);
+    columns->closes.resize(begin);
+    columns->volumes.resize(begin);
+    for (size_t i = begin; i < history.size(); ++i)
+    {
+      const auto& candle = history[i];
+      columns->timestamps.push_back(candle.timestamp);
+      columns->opens.push_back(candle.open);
+      columns->highs.push_back(candle.high);
+      columns->lows.push_back(candle.low);
+      columns->closes.push_back(candle.close);
+      columns->volumes.push_back(candle.volume);
+    }
+    Adjust(*columns, actions, begin);
+
+    double elapsed = timer.ElapsedMicroseconds();
+
+    std::scoped_lock lock(s_mutex);
+    s_cache[key] = {version, stockData.revision, history.back().timestamp, history.back().close, columns};
+
+    s_stats.adjustedSeries++;
+    s_stats.adjustedBars += history.size() - begin;
+    s_stats.adjustMicroseconds += elapsed;
+    return columns;
+  }
+
+  bool AdjustmentEngine::GetAdjustedStockData(const StockData& stockData, StockData& adjustedData, size_t begin)
+  {
+    auto columns = GetAdjustedColumns(stockData);
+    if (!columns)
+    {
+      return false;
+    }
+
+    // Candles before begin are already adjusted in output, only changed tail is written
+    const auto& history = stockData.candleHistory;
+    auto& adjustedHistory = adjustedData.candleHistory;
+    begin = std::min({begin, history.size(), adjustedHistory.size()});
+
+    Utils::CopyStockInfo(stockData, adjustedData);
+    adjustedHistory.resize(history.size());
+    for (size_t i = begin; i < history.size(); ++i)
+    {
+      auto& candle = adjustedHistory[i];
+      candle = history[i];
+      candle.open = columns->opens[i];
+      candle.high = columns->highs[i];
+      candle.low = columns->lows[i];
+      candle.close = columns->closes[i];
+      candle.range = candle.high - candle.low;
+      candle.volume = static_cast<uint32_t>(std::min<uint64_t>(columns->volumes[i], std::numeric_limits<uint32_t>::max()));
+    }
+    return true;
+  }
+
+  void AdjustmentEngine::Adjust(CandleColumns& columns, const std::vector<CorporateAction>& actions, size_t begin)
+  {
+    const auto& timestamps = columns.timestamps;
+
+    // Segment [start of action k-1, start of action k) gets product of factors of actions k..last,
+    // so every bar is touched exactly once whatever the number of actions
+    double cumulativeFactor = 1.0;
+    for (size_t k = actions.size(); k-- > 0;)
+    {
+      cumulativeFactor *= actions[k].GetPriceFactor();
+
+      size_t segmentEnd = static_cast<size_t>(std::lower_bound(timestamps.begin(), timestamps.end(), actions[k].exDate) - timestamps.begin());
+      size_t segmentBegin = begin;
+      if (k > 0)
+      {
+        segmentBegin = std::max(begin, static_cast<size_t>(std::lower_bound(timestamps.begin(), timestamps.end(), actions[k - 1].exDate) - timestamps.begin()));
+      }
+
+      if (segmentBegin >= segmentEnd or cumulativeFactor == 1.0)
+      {
+        continue;
+      }
+
+      // All fields of bar in one pass over segment, prices and volume share the factor
+      const double volumeFactor = 1.0 / cumulativeFactor;
+      double* opens = columns.opens.data();
+      double* highs = columns.highs.data();
+      double* lows = columns.lows.data();
+      double* closes = columns.closes.data();
+      uint64_t* volumes = columns.volumes.data();
+      for (size_t i = segmentBegin; i < segmentEnd; ++i)
+      {
+        opens[i] *= cumulativeFactor;
+        highs[i] *= cumulativeFactor;
+        lows[i] *= cumulativeFactor;
+        closes[i] *= cumulativeFactor;
+        volumes[i] = static_cast<uint64_t>(std::llround(static_cast<double>(volumes[i]) * volumeFactor));
+      }
+    }
+  }
+
+  AdjustmentStats AdjustmentEngine::GetStats()
+  {
+    std::scoped_lock lock(s_mutex);
+    return s_stats;
+  }
+} // namespace KanVest
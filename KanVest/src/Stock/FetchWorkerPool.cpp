@@ -0,0 +1,156 @@
+//
+//  FetchWorkerPool.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "FetchWorkerPool.hpp"
+
+namespace KanVest
+{
+  double WorkerPoolMetrics::LatencyPercentileMs(double percentile) const
+  {
+    uint64_t total = std::accumulate(latencyHistogram.begin(), latencyHistogram.end(), uint64_t(0));
+    if (total == 0)
+    {
+      return 0.0;
+    }
+
+    const double target = static_cast<double>(total) * std::clamp(percentile, 0.0, 100.0) / 100.0;
+    uint64_t count = 0;
+    for (size_t i = 0; i < LatencyBuckets; ++i)
+    {
+      count += latencyHistogram[i];
+      if (static_cast<double>(count) >= target)
+      {
+        return static_cast<double>(1ull << i);
+      }
+    }
+    return static_cast<double>(1ull << (LatencyBuckets - 1));
+  }
+
+  FetchWorkerPool::~FetchWorkerPool()
+  {
+    Stop();
+  }
+
+  void FetchWorkerPool::Start(uint32_t threadCount)
+  {
+    if (m_running)
+    {
+      return;
+    }
+
+    if (threadCount == 0)
+    {
+      // Fetch is network bound, few more threads than cores keep the sockets busy
+      threadCount = std::clamp(std::thread::hardware_concurrency() * 2, 4u, 16u);
+    }
+
+    IK_LOG_INFO("FetchWorkerPool", "Starting fetch worker pool with {0} threads", threadCount);
+
+    {
+      std::scoped_lock lock(m_mutex);
+      m_metrics = {};
+      m_metrics.threads = threadCount;
+      m_metrics.threadsCreated = threadCount;
+      m_startTime = std::chrono::steady_clock::now();
+    }
+
+    m_running = true;
+    m_threads.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+    {
+      m_threads.emplace_back(&FetchWorkerPool::WorkerThread, this);
+    }
+  }
+
+  void FetchWorkerPool::Stop()
+  {
+    {
+      std::scoped_lock lock(m_mutex);
+      if (!m_running)
+      {
+        return;
+      }
+      m_running = false;
+      m_queue = {};
+    }
+    m_condition.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+      if (thread.joinable())
+      {
+        thread.join();
+      }
+    }
+    m_threads.clear();
+  }
+
+  bool FetchWorkerPool::Submit(FetchPriority priority, Task task, Task onComplete)
+  {
+    {
+      std::scoped_lock lock(m_mutex);
+      if (!m_running)
+      {
+        return false;
+      }
+      m_queue.push({priority, m_sequence++, std::chrono::steady_clock::now(), std::move(task), std::move(onComplete)});
+      m_metrics.tasksSubmitted++;
+    }
+    m_condition.notify_one();
+    return true;
+  }
+
+  WorkerPoolMetrics FetchWorkerPool::GetMetrics() const
+  {
+    std::scoped_lock lock(m_mutex);
+
+    WorkerPoolMetrics metrics = m_metrics;
+    metrics.queueDepth = m_queue.size();
+    metrics.uptimeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count();
+    return metrics;
+  }
+
+  void FetchWorkerPool::WorkerThread()
+  {
+    while (true)
+    {
+      QueuedTask queuedTask;
+      {
+        std::unique_lock lock(m_mutex);
+        m_condition.wait(lock, [this]() { return !m_running or !m_queue.empty(); });
+        if (!m_running)
+        {
+          return;
+        }
+
+        // priority_queue::top is const, task is moved out before pop
+        queuedTask = std::move(const_cast<QueuedTask&>(m_queue.top()));
+        m_queue.pop();
+      }
+
+      auto startTime = std::chrono::steady_clock::now();
+      queuedTask.task();
+      if (queuedTask.onComplete)
+      {
+        queuedTask.onComplete();
+      }
+      auto endTime = std::chrono::steady_clock::now();
+
+      const double latencyMs = std::chrono::duration<double, std::milli>(endTime - queuedTask.submitTime).count();
+      size_t bucket = 0;
+      while (bucket + 1 < WorkerPoolMetrics::LatencyBuckets and static_cast<double>(1ull << bucket) < latencyMs)
+      {
+        bucket++;
+      }
+
+      std::scoped_lock lock(m_mutex);
+      m_metrics.tasksCompleted++;
+      m_metrics.busySeconds += std::chrono::duration<double>(endTime - startTime).count();
+      m_metrics.latencyHistogram[bucket]++;
+    }
+  }
+} // namespace KanVest
@@ -13,14 +13,13 @@
 
 namespace KanVest
 {
-  void StockManager::Initialize(int milliseconds)
+  void StockManager::Initialize(int milliseconds, uint32_t workerThreads)
   {
+    s_updateDelayMs = milliseconds;
+    s_workerPool.Start(workerThreads);
+
     s_running = true;
     s_worker = std::thread(WorkerLoop);
-    
-    s_updateDelayMs = milliseconds;
-    
-    AddStockDataRequest("Nifty", Range::_1Y, Interval::_1D);
   }
   
   void StockManager::Shutdown()
@@ -30,76 +29,350 @@ namespace KanVest
     {
       s_worker.join();
     }
+    s_workerPool.Stop();
+
+    // Queued fetches are discarded by pool, reschedule them on next initialize
+    {
+      std::scoped_lock lock(s_mutex);
+      for (auto& [symbol, request] : s_stockDataRequests)
+      {
+        request.pending = false;
+      }
+    }
+
+    [[maybe_unused]] FetchStats stats = GetFetchStats();
+    IK_LOG_INFO("StockManager", "Fetch requests {0} | Network fetches {1} | Coalesced {2} ({3:.1f}% duplicate without single flight)",
+                stats.requests, stats.networkFetches, stats.coalesced, stats.DuplicateRate());
+
+    [[maybe_unused]] WorkerPoolMetrics metrics = GetWorkerPoolMetrics();
+    IK_LOG_INFO("StockManager", "Fetch tasks {0} | Threads created {1} ({2:.2f} per minute) | Latency p50 {3} ms p95 {4} ms p99 {5} ms | Utilization {6:.1f}%",
+                metrics.tasksCompleted, metrics.threadsCreated, metrics.ThreadCreationsPerMinute(), metrics.LatencyPercentileMs(50.0),
+                metrics.LatencyPercentileMs(95.0), metrics.LatencyPercentileMs(99.0), metrics.Utilization());
   }
   
   void StockManager::AddStockDataRequest(const std::string& symbol, Range range, Interval interval)
   {
+    // Requests are keyed by normalized symbol, so every spelling (NIFTY, %5ENSEI, tcs, TCS.NS) shares one request
+    const std::string key = Utils::NormalizeSymbol(symbol);
     std::scoped_lock lock(s_mutex);
-    s_stockDataRequests[symbol] = { symbol, range, interval, StockData(symbol), std::chrono::steady_clock::now() };
+
+    auto& request = s_stockDataRequests[key];
+    request.symbol = key;
+    request.range = range;
+    request.interval = interval;
+    request.cachedData = {};
+    request.cachedData.symbol = key;
+    request.lastUpdated = std::chrono::steady_clock::now();
+    request.pending = false;
+    request.replay = false;
+    request.generation++;
+
+    // User is waiting for this symbol, fetch ahead of periodic refreshes
+    ScheduleFetch(request, FetchPriority::Interactive);
   }
 
   StockData StockManager::GetLatestStockData(const std::string &symbol)
   {
+    const std::string key = Utils::NormalizeSymbol(symbol);
     std::scoped_lock lock(s_mutex);
     
     // Return Empty Stock if no cache is present
-    if (s_stockDataRequests.count(symbol) == 0)
+    auto it = s_stockDataRequests.find(key);
+    if (it == s_stockDataRequests.end())
     {
       static StockData EmptyStockData;
       return EmptyStockData;
     }
     
     // Return data from cache
-    return s_stockDataRequests[symbol].cachedData;
+    return it->second.cachedData;
+  }
+
+  uint64_t StockManager::BeginReplay(const std::string& symbol, StockData stockData)
+  {
+    const std::string key = Utils::NormalizeSymbol(symbol);
+    std::scoped_lock lock(s_mutex);
+
+    // New generation drops fetch in flight, replay request is never scheduled
+    auto [it, inserted] = s_stockDataRequests.try_emplace(key);
+    auto& request = it->second;
+    if (inserted)
+    {
+      // Live data fetched on end of replay
+      request.symbol = key;
+      request.range = API_Provider::GetRangeEnumFromString(stockData.range);
+      request.interval = API_Provider::GetIntervalEnumFromString(stockData.dataGranularity);
+    }
+    request.cachedData = std::move(stockData);
+    request.cachedData.revision = ++s_revision;
+    request.replay = true;
+    request.pending = false;
+    request.generation++;
+    return request.cachedData.revision;
+  }
+
+  bool StockManager::AppendReplayCandles(const std::string& symbol, std::span<const CandleData> candles, double prevClose)
+  {
+    std::scoped_lock lock(s_mutex);
+
+    auto it = s_stockDataRequests.find(Utils::NormalizeSymbol(symbol));
+    if (it == s_stockDataRequests.end() or !it->second.replay)
+    {
+      return false;
+    }
+
+    StockData& data = it->second.cachedData;
+    data.candleHistory.insert(data.candleHistory.end(), candles.begin(), candles.end());
+    if (!data.candleHistory.empty())
+    {
+      const CandleData& last = data.candleHistory.back();
+      data.prevClose = prevClose;
+      data.livePrice = last.close;
+      data.change = data.livePrice - data.prevClose;
+      data.changePercent = data.prevClose > 0.0 ? data.change / data.prevClose * 100.0 : 0.0;
+      data.volume = last.volume;
+    }
+    return true;
+  }
+
+  void StockManager::EndReplay(const std::string& symbol)
+  {
+    std::scoped_lock lock(s_mutex);
+
+    // Replayed data is shown until live data arrives
+    if (auto it = s_stockDataRequests.find(Utils::NormalizeSymbol(symbol)); it != s_stockDataRequests.end() and it->second.replay)
+    {
+      it->second.replay = false;
+      it->second.generation++;
+      ScheduleFetch(it->second, FetchPriority::Interactive);
+    }
+  }
+
+  std::vector<std::string> StockManager::GetRequestedSymbols()
+  {
+    std::scoped_lock lock(s_mutex);
+
+    std::vector<std::string> symbols;
+    symbols.reserve(s_stockDataRequests.size());
+    for (const auto& [symbol, request] : s_stockDataRequests)
+    {
+      symbols.push_back(symbol);
+    }
+    std::sort(symbols.begin(), symbols.end());
+    return symbols;
   }
 
   void StockManager::WorkerLoop()
   {
     while (s_running)
     {
-      auto UpdateStockData = [](std::unordered_map<std::string, StockRequest>& data) {
-        std::vector<std::tuple<std::string, Range, Interval>> jobs;
-        
+      {
+        // Refresh each symbol independently once its last fetch is older than update delay
+        std::scoped_lock lock(s_mutex);
+        const auto refreshTime = std::chrono::steady_clock::now() - std::chrono::milliseconds(s_updateDelayMs.load());
+        for (auto& [symbol, request] : s_stockDataRequests)
         {
-          // Copy work out quickly
-          std::scoped_lock lock(s_mutex);
-          for (auto& [symbol, req] : data)
+          if (!request.pending and !request.replay and request.lastUpdated <= refreshTime)
           {
-            jobs.emplace_back(symbol, req.range, req.interval);
+            ScheduleFetch(request, FetchPriority::Refresh);
           }
         }
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(std::clamp(s_updateDelayMs.load(), 1, 100)));
+    }
+  }
+
+  void StockManager::ScheduleFetch(StockRequest& request, FetchPriority priority)
+  {
+    if (request.pending)
+    {
+      return;
+    }
+    auto newData = std::make_shared<StockData>();
+    request.pending = s_workerPool.Submit(priority, [newData, symbol = request.symbol, range = request.range, interval = request.interval]() {
+      *newData = FetchShared(symbol, range, interval);
+    }, [newData, symbol = request.symbol, generation = request.generation]() {
+      std::scoped_lock lock(s_mutex);
+      if (auto it = s_stockDataRequests.find(symbol); it != s_stockDataRequests.end() and it->second.generation == generation)
+      {
+        // Revision is kept while history only grows, tail of series tells the change
+        newData->revision = ExtendsHistory(it->second.cachedData, *newData) ? it->second.cachedData.revision : ++s_revision;
+        it->second.cachedData = std::move(*newData);
+        it->second.lastUpdated = std::chrono::steady_clock::now();
+        it->second.pending = false;
+      }
+    });
+  }
 
-        // Store futures to avoid [[nodiscard]] warning ---
-        std::vector<std::future<void>> futures;
-        futures.reserve(jobs.size());
+  StockData StockManager::FetchShared(const std::string& symbol, Range range, Interval interval)
+  {
+    const std::string key = Utils::NormalizeSymbol(symbol);
 
-        // Launch one async fetch per symbol
-        for (auto& [symbol, range, interval] : jobs)
+    std::promise<StockData> promise;
+    std::shared_future<StockData> result;
+
+    std::unique_lock lock(s_inFlightMutex);
+    s_fetchStats.requests++;
+
+    // Join in flight fetch of same or superset range
+    for (const auto& inFlight : s_inFlightFetches[key])
+    {
+      if (inFlight.interval == interval and RangeCovers(inFlight.range, range))
+      {
+        s_fetchStats.coalesced++;
+        result = inFlight.result;
+        const bool sameRange = inFlight.range == range;
+
+        // Leader needs lock to complete the fetch
+        lock.unlock();
+        if (!sameRange)
         {
-          futures.emplace_back(std::async(std::launch::async, [symbol, range, interval, &data]()
-                                          {
-            StockData newData = Fetch(symbol, range, interval);
-            
-            // Update cached data
-            {
-              std::scoped_lock lock(s_mutex);
-              if (auto it = data.find(symbol); it != data.end())
-              {
-                it->second.cachedData = newData;
-              }
-            }
-          }));
+          return TrimToRange(result.get(), symbol, range);
         }
-        
-        // Futures go out of scope → destructor waits or is fire-and-forget
-        // (std::launch::async ensures the task runs)
-        std::this_thread::sleep_for(std::chrono::milliseconds(s_updateDelayMs.load()));
+
+        // Leader may have requested with different spelling of symbol
+        StockData data = result.get();
+        data.symbol = symbol;
+        return data;
+      }
+    }
+
+    // This caller is leader for the key
+    result = promise.get_future().share();
+    s_inFlightFetches[key].push_back({range, interval, result});
+    s_fetchStats.networkFetches++;
+    lock.unlock();
+
+    StockData data = Fetch(symbol, range, interval);
+    promise.set_value(data);
+
+    {
+      std::scoped_lock completeLock(s_inFlightMutex);
+      auto& inFlightFetches = s_inFlightFetches[key];
+      // Only one fetch per range and interval can be in flight for key
+      std::erase_if(inFlightFetches, [range, interval](const InFlightFetch& inFlight) { return inFlight.range == range and inFlight.interval == interval; });
+      if (inFlightFetches.empty())
+      {
+        s_inFlightFetches.erase(key);
+      }
+    }
+    return data;
+  }
+
+  FetchStats StockManager::GetFetchStats()
+  {
+    std::scoped_lock lock(s_inFlightMutex);
+    return s_fetchStats;
+  }
+
+  WorkerPoolMetrics StockManager::GetWorkerPoolMetrics()
+  {
+    return s_workerPool.GetMetrics();
+  }
+
+  bool StockManager::ExtendsHistory(const StockData& previous, const StockData& data)
+  {
+    const auto& before = previous.candleHistory;
+    const auto& after = data.candleHistory;
+    if (before.empty() or after.size() < before.size())
+    {
+      return false;
+    }
+    return std::equal(before.begin(), before.end() - 1, after.begin(), [](const CandleData& a, const CandleData& b) {
+      return a.timestamp == b.timestamp and a.volume == b.volume and a.open == b.open and a.high == b.high and a.low == b.low and a.close == b.close;
+    });
+  }
+
+  bool StockManager::RangeCovers(Range superset, Range subset)
+  {
+    if (superset == subset or superset == Range::_MAX)
+    {
+      return true;
+    }
+
+    // Year to date can be shorter than a month, only full years are safe supersets
+    if (superset == Range::_YTD)
+    {
+      return false;
+    }
+    if (subset == Range::_YTD)
+    {
+      return superset == Range::_1Y or superset == Range::_5Y;
+    }
+    return static_cast<int>(superset) > static_cast<int>(subset);
+  }
+
+  StockData StockManager::TrimToRange(const StockData& stockData, const std::string& symbol, Range range)
+  {
+    StockData trimmedData = stockData;
+    trimmedData.symbol = symbol;
+    trimmedData.range = API_Provider::GetRangeStringFromEnum(range);
+
+    auto& history = trimmedData.candleHistory;
+    if (history.empty() or range == Range::_MAX)
+    {
+      return trimmedData;
+    }
+
+    // Day ranges count trading days back from last candle
+    if (range == Range::_1D or range == Range::_5D)
+    {
+      const int tradingDays = range == Range::_1D ? 1 : 5;
+      auto DayOf = [](uint32_t timestamp) {
+        time_t time = static_cast<time_t>(timestamp);
+        std::tm localTime {};
+        localtime_r(&time, &localTime);
+        return localTime.tm_year * 400 + localTime.tm_yday;
       };
-      
-      UpdateStockData(s_stockDataRequests);
+
+      int days = 1;
+      size_t first = history.size() - 1;
+      int currentDay = DayOf(history[first].timestamp);
+      while (first > 0)
+      {
+        int day = DayOf(history[first - 1].timestamp);
+        if (day != currentDay and ++days > tradingDays)
+        {
+          break;
+        }
+        currentDay = day;
+        first--;
+      }
+      history.erase(history.begin(), history.begin() + static_cast<std::ptrdiff_t>(first));
+      return trimmedData;
     }
+
+    // Calendar ranges relative to last candle
+    time_t lastTime = static_cast<time_t>(history.back().timestamp);
+    std::tm start {};
+    localtime_r(&lastTime, &start);
+    start.tm_hour = 0;
+    start.tm_min = 0;
+    start.tm_sec = 0;
+
+    switch (range)
+    {
+      case Range::_1MO: start.tm_mon -= 1;  break;
+      case Range::_6MO: start.tm_mon -= 6;  break;
+      case Range::_1Y:  start.tm_year -= 1; break;
+      case Range::_5Y:  start.tm_year -= 5; break;
+      case Range::_YTD:
+        start.tm_mon = 0;
+        start.tm_mday = 1;
+        break;
+      default:
+        break;
+    }
+    start.tm_isdst = -1;
+    const uint32_t startTimestamp = static_cast<uint32_t>(std::mktime(&start));
+
+    auto firstInRange = std::lower_bound(history.begin(), history.end(), startTimestamp,
+                                         [](const CandleData& candle, uint32_t value) { return candle.timestamp < value; });
+    history.erase(history.begin(), firstInRange);
+    return trimmedData;
   }
-  
+
   StockData StockManager::Fetch(const std::string& stockSymbolName, Range range, Interval interval)
   {
     static StockData EmotyData;
@@ -116,7 +389,8 @@ namespace KanVest
       return EmotyData;
     }
     
-    StockData finalData(stockSymbolName);
+    StockData finalData;
+    finalData.symbol = stockSymbolName;
     
     // --- Basic Info ---
     finalData.currency        = StockParser::StockParser::ExtractString(response, apiKeys.currency);
@@ -11,6 +11,11 @@ namespace KanVest::Utils
 {
   std::string NormalizeSymbol(const std::string& input)
   {
+    if (const size_t tag = input.find(SeriesTagSeparator); tag != std::string::npos)
+    {
+      return NormalizeSymbol(input.substr(0, tag)) + input.substr(tag);
+    }
+
     std::string symbol = input;
     std::transform(symbol.begin(), symbol.end(), symbol.begin(), [](unsigned char c) { return std::toupper(c); });
     
@@ -19,6 +24,16 @@ namespace KanVest::Utils
     {
       return "%5ENSEI";
     }
+
+    // Index symbols (e.g. ^NSEBANK, ^CNXIT) are URL encoded and have no exchange suffix
+    if (symbol.starts_with("^"))
+    {
+      return "%5E" + symbol.substr(1);
+    }
+    if (symbol.starts_with("%5E"))
+    {
+      return symbol;
+    }
     
     // Add .NS if not present
     if (symbol.find('.') == std::string::npos)
@@ -29,16 +44,49 @@ namespace KanVest::Utils
     return symbol;
   }
   
+  std::string GetBaseSymbol(const std::string& symbol)
+  {
+    return symbol.substr(0, symbol.find(SeriesTagSeparator));
+  }
+
+  bool HasSeriesTag(const std::string& symbol)
+  {
+    return symbol.find(SeriesTagSeparator) != std::string::npos;
+  }
+
+  void CopyStockInfo(const StockData& source, StockData& destination)
+  {
+    destination.symbol = source.symbol;
+    destination.currency = source.currency;
+    destination.exchangeName = source.exchangeName;
+    destination.shortName = source.shortName;
+    destination.longName = source.longName;
+    destination.instrumentType = source.instrumentType;
+    destination.timezone = source.timezone;
+    destination.range = source.range;
+    destination.dataGranularity = source.dataGranularity;
+
+    destination.livePrice = source.livePrice;
+    destination.prevClose = source.prevClose;
+    destination.change = source.change;
+    destination.changePercent = source.changePercent;
+    destination.volume = source.volume;
+
+    destination.fiftyTwoHigh = source.fiftyTwoHigh;
+    destination.fiftyTwoLow = source.fiftyTwoLow;
+    destination.dayHigh = source.dayHigh;
+    destination.dayLow = source.dayLow;
+
+    destination.revision = source.revision;
+  }
+
   std::vector<CandleData> FilterTradingDays(const std::vector<CandleData>& history)
   {
     std::vector<CandleData> filtered;
     
     for (const auto& h : history)
     {
-      time_t t = static_cast<time_t>(h.timestamp);
-      struct tm* tm_info = localtime(&t);
-      int wday = tm_info->tm_wday; // 0 = Sunday, 6 = Saturday
-      if (wday != 0 && wday != 6)
+      if (IsTradingDay(h.timestamp))
       {
         filtered.push_back(h);
       }
@@ -46,4 +94,13 @@ namespace KanVest::Utils
     
     return filtered;
   }
+
+  bool IsTradingDay(uint32_t timestamp)
+  {
+    time_t t = static_cast<time_t>(timestamp);
+    struct tm tm_info{};
+    localtime_r(&t, &tm_info);
+    int wday = tm_info.tm_wday; // 0 = Sunday, 6 = Saturday
+    return wday != 0 && wday != 6;
+  }
 } // namespace KanVest
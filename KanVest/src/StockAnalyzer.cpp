@@ -7,16 +7,32 @@
 
 #include "StockAnalyzer.hpp"
 
-#include "UI/UI_Utils.hpp"
+#include "Analyzer/ScoreColors.hpp"
+
+#include "Stock/CorporateAction.hpp"
+#include "Stock/StockUtils.hpp"
 
 namespace KanVest
 {
   struct ScoreResult
   {
     float score;
-    std::vector<std::pair<ImU32, std::string>> explanation;
+    std::vector<std::pair<uint32_t, std::string>> explanation;
   };
 
+  static bool IsSameCandle(const CandleData& a, const CandleData& b)
+  {
+    return a.timestamp == b.timestamp and a.open == b.open and a.high == b.high and a.low == b.low and a.close == b.close and a.volume == b.volume;
+  }
+
+  /// This function formats value with two decimals. Analyzer is linked in daemon too, so UI formatters are not used
+  static std::string FormatValue(double value)
+  {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.2f", value);
+    return buffer;
+  }
+
   inline bool Near(double a, double b, double threshold = 0.0015)
   {
     return std::abs(a - b) / b < threshold;
@@ -34,7 +50,7 @@ namespace KanVest
     
     if (maMap.empty())
     {
-      result.explanation.push_back({KanVasX::Color::Red,"Insufficient data to evaluate trend strength."});
+      result.explanation.push_back({ScoreColor::Loss,"Insufficient data to evaluate trend strength."});
       return result;
     }
     
@@ -44,13 +60,11 @@ namespace KanVest
     int aboveShort = 0, aboveMedium = 0, aboveLong = 0;
     int positiveSlope = 0, negativeSlope = 0;
     
+    // Values of each period are (previous, current) average
     for (const auto& [period, values] : maMap)
     {
-      if (values.size() < 2)
-        continue;
-      
-      double ma     = values.back();
-      double prev   = values[values.size() - 2];
+      double ma     = values[1];
+      double prev   = values[0];
       double w      = MAWeight(period);
       totalWeight  += w;
       
@@ -99,17 +113,17 @@ namespace KanVest
     // Explanation
     // ----------------------------
     std::string explaintion = "";
-    ImU32 color = KanVasX::Color::White;
+    uint32_t color = ScoreColor::Neutral;
     
     explaintion = "Trend Overview: ";
     if (aboveLong >= 2)
     {
-      color = UI::Utils::StockProfitColor;
+      color = ScoreColor::Profit;
       explaintion += "The price is trading above most long-term averages, indicating a strong structural trend.\n";
     }
     else
     {
-      color = UI::Utils::StockLossColor;
+      color = ScoreColor::Loss;
       explaintion += "The price is struggling to remain above long-term averages, suggesting weaker structure.\n";
     }
     result.explanation.push_back({color, explaintion});
@@ -117,12 +131,12 @@ namespace KanVest
     explaintion = "Short-Term View: ";
     if (aboveShort >= 1)
     {
-      color = UI::Utils::StockProfitColor;
+      color = ScoreColor::Profit;
       explaintion += "Short-term momentum remains constructive with recent buying interest.\n";
     }
     else
     {
-      color = UI::Utils::StockLossColor;
+      color = ScoreColor::Loss;
       explaintion += "Short-term momentum is weak, indicating hesitation from buyers.\n";
     }
     result.explanation.push_back({color, explaintion});
@@ -130,12 +144,12 @@ namespace KanVest
     explaintion = "Medium-Term View: ";
     if (aboveMedium >= 2)
     {
-      color = UI::Utils::StockProfitColor;
+      color = ScoreColor::Profit;
       explaintion += "Medium-term trend support is present, suggesting the move is not purely short-lived.\n";
     }
     else
     {
-      color = UI::Utils::StockLossColor;
+      color = ScoreColor::Loss;
       explaintion += "Medium-term trend lacks confirmation and may need stabilization.\n";
     }
     result.explanation.push_back({color, explaintion});
@@ -143,17 +157,17 @@ namespace KanVest
     explaintion = "Momentum Insight: ";
     if (positiveSlope > negativeSlope)
     {
-      color = UI::Utils::StockProfitColor;
+      color = ScoreColor::Profit;
       explaintion += "Moving averages are rising, confirming positive momentum.\n";
     }
     else if (positiveSlope == negativeSlope)
     {
-      color = UI::Utils::StockModerateColor;
+      color = ScoreColor::Moderate;
       explaintion += "Momentum is mixed, suggesting consolidation.\n";
     }
     else
     {
-      color = UI::Utils::StockLossColor;
+      color = ScoreColor::Loss;
       explaintion += "Momentum is weakening as several averages lose slope.\n";
     }
     result.explanation.push_back({color, explaintion});
@@ -161,17 +175,17 @@ namespace KanVest
     explaintion = "Actionable Insight: ";
     if (result.score > 6)
     {
-      color = UI::Utils::StockProfitColor;
+      color = ScoreColor::Profit;
       explaintion += "Trend strength favors holding or accumulating on controlled pullbacks.\n";
     }
     else if (result.score > 2)
     {
-      color = UI::Utils::StockModerateColor;
+      color = ScoreColor::Moderate;
       explaintion += "Trend is neutral to mildly positive. Fresh entries should be selective.\n";
     }
     else
     {
-      color = UI::Utils::StockLossColor;
+      color = ScoreColor::Loss;
       explaintion += "Trend strength is limited. Waiting for clearer confirmation may reduce risk.\n";
     }
     result.explanation.push_back({color, explaintion});
@@ -189,7 +203,7 @@ namespace KanVest
     if (rsi.series.size() < 2 || std::isnan(rsi.last))
     {
       result.explanation.push_back({
-        KanVasX::Color::Red,
+        ScoreColor::Loss,
         "Insufficient RSI data to evaluate momentum."
       });
       return result;
@@ -245,28 +259,28 @@ namespace KanVest
     // ----------------------------
     // Explanation
     // ----------------------------
-    ImU32 color = KanVasX::Color::White;
+    uint32_t color = ScoreColor::Neutral;
     std::string explanation;
     
     explanation = "RSI Condition: ";
     if (current < 30.0)
     {
-      color = UI::Utils::StockProfitColor;
+      color = ScoreColor::Profit;
       explanation += "RSI is in oversold territory, often associated with rebound potential.\n";
     }
     else if (current > 70.0)
     {
-      color = UI::Utils::StockLossColor;
+      color = ScoreColor::Loss;
       explanation += "RSI is overbought, increasing the risk of short-term pullback.\n";
     }
     else if (current >= 55.0)
     {
-      color = UI::Utils::StockProfitColor;
+      color = ScoreColor::Profit;
       explanation += "RSI is in a bullish range, supporting upward momentum.\n";
     }
     else
     {
-      color = UI::Utils::StockModerateColor;
+      color = ScoreColor::Moderate;
       explanation += "RSI is neutral, offering limited directional edge.\n";
     }
     result.explanation.push_back({ color, explanation });
@@ -274,17 +288,17 @@ namespace KanVest
     explanation = "RSI Momentum: ";
     if (slope > slopeThreshold)
     {
-      color = UI::Utils::StockProfitColor;
+      color = ScoreColor::Profit;
       explanation += "RSI is rising, confirming strengthening momentum.\n";
     }
     else if (slope < -slopeThreshold)
     {
-      color = UI::Utils::StockLossColor;
+      color = ScoreColor::Loss;
       explanation += "RSI is declining, signaling fading momentum.\n";
     }
     else
     {
-      color = UI::Utils::StockModerateColor;
+      color = ScoreColor::Moderate;
       explanation += "RSI momentum is flat, suggesting consolidation.\n";
     }
     result.explanation.push_back({ color, explanation });
@@ -292,59 +306,451 @@ namespace KanVest
     explanation = "Actionable Insight: ";
     if (result.score > 6.0f)
     {
-      color = UI::Utils::StockProfitColor;
+      color = ScoreColor::Profit;
       explanation += "Momentum conditions are favorable. Trend-following setups are supported.\n";
     }
     else if (result.score > 2.0f)
     {
-      color = UI::Utils::StockModerateColor;
+      color = ScoreColor::Moderate;
       explanation += "Momentum is mixed. Entries should prioritize confirmation.\n";
     }
     else
     {
-      color = UI::Utils::StockLossColor;
+      color = ScoreColor::Loss;
       explanation += "Momentum signal is weak or stretched. Caution is advised.\n";
     }
     result.explanation.push_back({ color, explanation });
-    
+
     return result;
   }
 
-  void Analyzer::AnalzeStock(const StockData& stockData)
+  ScoreResult ComputeVolatilitySummary(const VolatilitySeries& volatility, double price)
   {
+    // Volatility has no direction, it explains risk but does not move the score
+    ScoreResult result { 0.0f, {} };
+
+    const double yangZhang = volatility.Latest(VolatilityEstimator::YangZhang);
+    if (std::isnan(yangZhang))
+    {
+      result.explanation.push_back({ScoreColor::Loss, "Insufficient data to evaluate volatility."});
+      return result;
+    }
+
+    const double percentile = volatility.GetLatestPercentile(VolatilityEstimator::YangZhang);
+    const double closeToClose = volatility.Latest(VolatilityEstimator::CloseToClose);
+    const double parkinson = volatility.Latest(VolatilityEstimator::Parkinson);
+
+    uint32_t color = ScoreColor::Neutral;
+    std::string explanation;
+
+    explanation = "Volatility Level: Annualized volatility is " + FormatValue(yangZhang) + "%, higher than " + FormatValue(percentile) + "% of its history. ";
+    if (percentile > 80.0)
+    {
+      color = ScoreColor::Loss;
+      explanation += "Volatility is elevated, expect wider swings.\n";
+    }
+    else if (percentile < 20.0)
+    {
+      color = ScoreColor::Profit;
+      explanation += "Volatility is compressed, which often precedes expansion.\n";
+    }
+    else
+    {
+      color = ScoreColor::Moderate;
+      explanation += "Volatility is in its normal range.\n";
+    }
+    result.explanation.push_back({ color, explanation });
+
+    explanation = "Volatility Source: ";
+    color = ScoreColor::Moderate;
+    if (closeToClose > 1.25 * parkinson)
+    {
+      explanation += "Close to close moves exceed intraday ranges, gaps between sessions drive the volatility.\n";
+    }
+    else if (parkinson > 1.25 * closeToClose)
+    {
+      explanation += "Intraday ranges exceed net moves, price swings but reverts within sessions.\n";
+    }
+    else
+    {
+      explanation += "Gaps and intraday ranges are consistent.\n";
+    }
+    result.explanation.push_back({ color, explanation });
+
+    const double atr = volatility.LatestATR();
+    if (!std::isnan(atr) and price > 0.0)
+    {
+      explanation = "Risk Sizing: ATR(" + std::to_string(volatility.atrPeriod) + ") is " + FormatValue(atr) + " (" + FormatValue(100.0 * atr / price)
+      + "% of price). Stop beyond 2 ATR is " + FormatValue(200.0 * atr / price) + "% away.\n";
+      result.explanation.push_back({ ScoreColor::Moderate, explanation });
+    }
+
+    return result;
+  }
+
+  void AnalysisContext::Analyze(const StockData& rawStockData)
+  {
+    // First candle changed since last analysis. Closed candles are final under same revision and actions, so only last
+    // analyzed candle (may have been forming) and appended ones are analyzed again
+    const auto& history = rawStockData.candleHistory;
+    const uint64_t actionVersion = AdjustmentEngine::GetVersion(rawStockData.symbol);
+    const size_t analyzed = m_analyzed;
+    const bool sameSeries = analyzed > 0 and history.size() >= analyzed and m_symbol == rawStockData.symbol and m_range == rawStockData.range
+    and m_granularity == rawStockData.dataGranularity and m_revision == rawStockData.revision and m_actionVersion == actionVersion
+    and IsSameCandle(history.front(), m_first) and (analyzed < 2 or IsSameCandle(history[analyzed - 2], m_lastClosed));
+    const size_t changed = !sameSeries ? 0 : IsSameCandle(history[analyzed - 1], m_last) ? analyzed : analyzed - 1;
+
+    m_symbol = rawStockData.symbol;
+    m_range = rawStockData.range;
+    m_granularity = rawStockData.dataGranularity;
+    m_revision = rawStockData.revision;
+    m_actionVersion = actionVersion;
+    m_analyzed = history.size();
+    if (!history.empty())
+    {
+      m_first = history.front();
+      m_lastClosed = history.size() >= 2 ? history[history.size() - 2] : CandleData {};
+      m_last = history.back();
+    }
+
+    // Indicators run on split / bonus adjusted history. Symbols without actions are analyzed in place, adjusted
+    // copy is kept by context so its memory is reused and only changed candles are adjusted into it
+    const bool adjusted = AdjustmentEngine::HasActions(rawStockData.symbol) and AdjustmentEngine::GetAdjustedStockData(rawStockData, m_adjustedData, changed);
+    const StockData& stockData = adjusted ? m_adjustedData : rawStockData;
+    if (!adjusted and !m_adjustedData.candleHistory.empty())
+    {
+      m_adjustedData = {};
+    }
+
+    // Changed candles are transposed into columns, column based analyses read contiguous fields
+    m_columns.Append(stockData.candleHistory, changed);
+
     // Reset report data
-    s_stockReport.score = 50.0f;
-    s_stockReport.summary.clear();
+    m_report.score = 50.0f;
+    m_report.summary.clear();
     
     // Technical data
-    s_maResults = MovingAverage::Compute(stockData);
-    s_rsiSeries = RSI::Compute(stockData);
+    m_indicators.Sync(stockData);
+
+    // Chart averages are evaluated lazily over shown window, chunks before first changed candle stay cached
+    m_movingAverages.SetInput(stockData);
+
+    // Graph indicators are evaluated lazily by whoever shows them, from first changed candle
+    m_indicatorGraph.SetInput(m_columns, changed);
+
+    // Higher timeframes derived from same candles, all evaluated in one traversal
+    MultiTimeframeAnalyzer::Analyze(stockData, MultiTimeframeAnalyzer::GetTimeframes(stockData.dataGranularity), MovingAverage::GetActivePeriods(stockData.range),
+                                    m_multiTimeframe);
+
+    // Candlestick and chart patterns of whole history, last candle is shown
+    PatternScanner::Scan(stockData, m_patterns);
+
+    // VWAP and volume profile advance only by appended / forming candles
+    m_volume.Sync(stockData);
+
+    // Relative strength against shared benchmark series, changed candles are joined while benchmark is unchanged
+    if (auto benchmark = BenchmarkCache::Get(std::string(RelativeStrength::DefaultBenchmark)); benchmark and benchmark->symbol != Utils::NormalizeSymbol(stockData.symbol))
+    {
+      RelativeStrength::Compute(stockData, m_columns, *benchmark, m_relativeStrength, changed);
+    }
+    else
+    {
+      m_relativeStrength = {};
+    }
+
+    // Distribution sketches take only candles closed since last analysis
+    m_distribution.Sync(stockData);
+
+    // Seasonality aggregates take only closed candles too, file is rewritten by store writer when they change
+    if (m_seasonality.Sync(stockData, m_columns) > 0)
+    {
+      SeasonalityStore::Save(stockData, m_seasonality);
+    }
+
+    // ATR and all volatility estimators from one pass over changed OHLC
+    Volatility::Compute(stockData, m_columns, m_volatility, Volatility::DefaultWindow, Volatility::DefaultATRPeriod, changed);
+
+    const MAResult& maResults = m_indicators.GetMAResult();
+    const RSISeries& rsiSeries = m_indicators.GetRSI();
     
     // Score
-    auto UpdateSummaryData = [](TechnicalIndicators tag, const ScoreResult& result) {
-      s_stockReport.score += result.score;
-      s_stockReport.summary[tag] = result.explanation;
+    auto UpdateSummaryData = [this](TechnicalIndicators tag, const ScoreResult& result) {
+      m_report.score += result.score;
+      m_report.summary[tag] = result.explanation;
     };
     
-    UpdateSummaryData(TechnicalIndicators::DMA, ComputeMAScore(TechnicalIndicators::DMA, stockData.livePrice, s_maResults.dmaValues));
-    UpdateSummaryData(TechnicalIndicators::EMA, ComputeMAScore(TechnicalIndicators::EMA, stockData.livePrice, s_maResults.emaValues));
-    UpdateSummaryData(TechnicalIndicators::RSI, ComputeRSIScore(s_rsiSeries));
+    UpdateSummaryData(TechnicalIndicators::DMA, ComputeMAScore(TechnicalIndicators::DMA, stockData.livePrice, maResults.dmaValues));
+    UpdateSummaryData(TechnicalIndicators::EMA, ComputeMAScore(TechnicalIndicators::EMA, stockData.livePrice, maResults.emaValues));
+    UpdateSummaryData(TechnicalIndicators::RSI, ComputeRSIScore(rsiSeries));
+    UpdateSummaryData(TechnicalIndicators::Volatility, ComputeVolatilitySummary(m_volatility, stockData.livePrice));
+  }
+
+  size_t AnalysisContext::GetMemoryUsage() const
+  {
+    size_t bytes = sizeof(*this) - sizeof(m_indicators) - sizeof(m_indicatorGraph) + m_indicators.GetMemoryUsage() + m_indicatorGraph.GetMemoryUsage();
+    bytes += m_movingAverages.GetMemoryUsage() - sizeof(m_movingAverages);
+    bytes += m_adjustedData.candleHistory.capacity() * sizeof(CandleData);
+    for (const auto& analysis : m_multiTimeframe.timeframes)
+    {
+      bytes += sizeof(analysis) + analysis.bars.capacity() * sizeof(CandleData) + analysis.barIndex.capacity() * sizeof(uint32_t)
+      + (analysis.rsi.capacity() + analysis.state.closedSums.capacity()) * sizeof(double);
+      for (size_t p = 0; p < analysis.sma.size(); ++p)
+      {
+        bytes += (analysis.sma[p].capacity() + analysis.ema[p].capacity()) * sizeof(double);
+      }
+    }
+    for (const auto& column : m_patterns.columns)
+    {
+      bytes += column.capacity() * sizeof(uint64_t);
+    }
+    bytes += m_patterns.offsets.capacity() * sizeof(size_t);
+    bytes += m_volume.GetMemoryUsage() - sizeof(m_volume);
+    bytes += m_distribution.GetMemoryUsage() - sizeof(m_distribution);
+    bytes += m_seasonality.GetMemoryUsage() - sizeof(m_seasonality);
+    bytes += (m_columns.opens.capacity() + m_columns.highs.capacity() + m_columns.lows.capacity() + m_columns.closes.capacity()) * sizeof(double);
+    bytes += m_columns.timestamps.capacity() * sizeof(uint32_t) + m_columns.volumes.capacity() * sizeof(uint64_t);
+    bytes += m_volatility.GetMemoryUsage() - sizeof(m_volatility);
+    bytes += m_relativeStrength.benchmark.capacity() + (m_relativeStrength.ratio.capacity() + m_relativeStrength.mansfield.capacity()) * sizeof(double);
+    for (const auto& [tag, explanation] : m_report.summary)
+    {
+      for (const auto& [color, text] : explanation)
+      {
+        bytes += sizeof(color) + sizeof(text) + text.capacity();
+      }
+    }
+    return bytes;
+  }
+
+  uint64_t AnalysisCache::HashSeries(const StockData& stockData)
+  {
+    uint64_t hash = 14695981039346656037ull;
+    auto Mix = [&hash](uint64_t value) {
+      hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    };
+
+    Mix(std::hash<std::string>{}(stockData.range));
+    Mix(std::hash<std::string>{}(stockData.dataGranularity));
+    Mix(std::bit_cast<uint64_t>(stockData.livePrice));
+    Mix(AdjustmentEngine::GetVersion(stockData.symbol));
+
+    // Relative strength is computed against cached benchmark, new benchmark candles invalidate context too
+    auto benchmark = BenchmarkCache::Get(std::string(RelativeStrength::DefaultBenchmark));
+    Mix(benchmark ? benchmark->version : 0);
+
+    // Candles only change at tail while revision is same, history is never walked
+    const auto& candles = stockData.candleHistory;
+    Mix(stockData.revision);
+    Mix(candles.size());
+    if (!candles.empty())
+    {
+      const CandleData& first = candles.front();
+      const CandleData& last = candles.back();
+      Mix((static_cast<uint64_t>(first.timestamp) << 32) | last.timestamp);
+      Mix(last.volume);
+      Mix(std::bit_cast<uint64_t>(last.open));
+      Mix(std::bit_cast<uint64_t>(last.high));
+      Mix(std::bit_cast<uint64_t>(last.low));
+      Mix(std::bit_cast<uint64_t>(last.close));
+    }
+    return hash;
+  }
+
+  AnalysisContext& AnalysisCache::Analyze(const StockData& stockData)
+  {
+    IK_PERFORMANCE_FUNC("AnalysisCache::Analyze");
+    KanViz::Timer timer;
+
+    // Indicators evaluated lazily since last request grew previous context
+    auto UpdateBytes = [this](Entry& entry) {
+      m_stats.bytesUsed -= entry.bytes;
+      entry.bytes = sizeof(Entry) + entry.key.capacity() + entry.context.GetMemoryUsage();
+      m_stats.bytesUsed += entry.bytes;
+    };
+    if (!m_entries.empty())
+    {
+      UpdateBytes(m_entries.front());
+    }
+
+    // Key is series and indicator parameters of its range
+    std::string key = stockData.symbol + "|" + stockData.range + "|" + stockData.dataGranularity + "|MA";
+    for (int period : MovingAverage::GetActivePeriods(stockData.range))
+    {
+      key += ":" + std::to_string(period);
+    }
+    key += "|RSI:14";
+
+    const uint64_t seriesHash = HashSeries(stockData);
+    bool hit = false;
+    if (auto it = m_index.find(key); it != m_index.end())
+    {
+      m_entries.splice(m_entries.begin(), m_entries, it->second);
+      Entry& entry = m_entries.front();
+      if (entry.seriesHash == seriesHash)
+      {
+        hit = true;
+        m_stats.hits++;
+      }
+      else
+      {
+        entry.context.Analyze(stockData);
+        entry.seriesHash = seriesHash;
+        m_stats.updates++;
+      }
+    }
+    else
+    {
+      Entry& entry = m_entries.emplace_front();
+      entry.key = std::move(key);
+      entry.seriesHash = seriesHash;
+      entry.context.Analyze(stockData);
+      m_index[entry.key] = m_entries.begin();
+      m_stats.misses++;
+    }
+
+    Entry& entry = m_entries.front();
+    if (!hit)
+    {
+      UpdateBytes(entry);
+      Evict();
+    }
+
+    // Running average latency
+    m_stats.lastLatencyUs = timer.ElapsedMicroseconds();
+    if (hit)
+    {
+      m_stats.hitLatencyUs += (m_stats.lastLatencyUs - m_stats.hitLatencyUs) / static_cast<double>(m_stats.hits);
+    }
+    else
+    {
+      m_stats.missLatencyUs += (m_stats.lastLatencyUs - m_stats.missLatencyUs) / static_cast<double>(m_stats.updates + m_stats.misses);
+    }
+    return entry.context;
+  }
+
+  void AnalysisCache::SetBudget(size_t bytes)
+  {
+    m_budget = bytes;
+    m_stats.budgetBytes = bytes;
+    Evict();
+  }
+
+  void AnalysisCache::Clear()
+  {
+    m_entries.clear();
+    m_index.clear();
+    m_stats.entries = 0;
+    m_stats.bytesUsed = 0;
+  }
+
+  void AnalysisCache::Evict()
+  {
+    m_stats.budgetBytes = m_budget;
+    while (m_stats.bytesUsed > m_budget and m_entries.size() > 1)
+    {
+      const Entry& entry = m_entries.back();
+      m_stats.bytesUsed -= entry.bytes;
+      m_index.erase(entry.key);
+      m_entries.pop_back();
+      m_stats.evictions++;
+    }
+    m_stats.entries = m_entries.size();
+  }
+
+  void Analyzer::AnalzeStock(const StockData& stockData)
+  {
+    s_activeContext = &s_cache.Analyze(stockData);
+  }
+
+  void Analyzer::SetCacheBudget(size_t bytes)
+  {
+    s_cache.SetBudget(bytes);
+  }
+
+  const AnalysisCacheStats& Analyzer::GetCacheStats()
+  {
+    return s_cache.GetStats();
   }
   
   const StockReport& Analyzer::GetReport()
   {
-    return s_stockReport;
+    static const StockReport EmptyReport;
+    return s_activeContext ? s_activeContext->GetReport() : EmptyReport;
   }
   const std::map<int, std::vector<double>>& Analyzer::GetDMAValues()
   {
-    return s_maResults.dmaValues;
+    static const MAResult EmptyResult;
+    return s_activeContext ? s_activeContext->GetDMAValues() : EmptyResult.dmaValues;
   }
   const std::map<int, std::vector<double>>& Analyzer::GetEMAValues()
   {
-    return s_maResults.emaValues;
+    static const MAResult EmptyResult;
+    return s_activeContext ? s_activeContext->GetEMAValues() : EmptyResult.emaValues;
+  }
+  const std::vector<double>& Analyzer::GetMovingAverage(MovingAverageType type, int period, size_t begin, size_t end)
+  {
+    static const std::vector<double> EmptyValues;
+    return s_activeContext ? s_activeContext->GetMovingAverage(type, period, begin, end) : EmptyValues;
+  }
+  const MovingAverageCacheStats& Analyzer::GetMovingAverageStats()
+  {
+    static const MovingAverageCacheStats EmptyStats;
+    return s_activeContext ? s_activeContext->GetMovingAverageStats() : EmptyStats;
+  }
+  const std::vector<double>& Analyzer::GetIndicator(const std::string& name)
+  {
+    static const std::vector<double> EmptyValues;
+    return s_activeContext ? s_activeContext->GetIndicator(name) : EmptyValues;
+  }
+  const IndicatorGraphStats& Analyzer::GetIndicatorGraphStats()
+  {
+    static const IndicatorGraphStats EmptyStats;
+    return s_activeContext ? s_activeContext->GetIndicatorGraphStats() : EmptyStats;
+  }
+  const MultiTimeframeReport& Analyzer::GetMultiTimeframeReport()
+  {
+    static const MultiTimeframeReport EmptyReport;
+    return s_activeContext ? s_activeContext->GetMultiTimeframeReport() : EmptyReport;
+  }
+
+  PatternMask Analyzer::GetLatestPatterns()
+  {
+    return s_activeContext ? s_activeContext->GetLatestPatterns() : 0;
+  }
+  const VolumeAnalysis& Analyzer::GetVolumeAnalysis()
+  {
+    static const VolumeAnalysis EmptyAnalysis;
+    return s_activeContext ? s_activeContext->GetVolumeAnalysis() : EmptyAnalysis;
+  }
+  void Analyzer::SetVWAPAnchor(VWAPAnchor anchor, size_t bar)
+  {
+    if (s_activeContext)
+    {
+      s_activeContext->SetVWAPAnchor(anchor, bar);
+    }
+  }
+  const RelativeStrengthSeries& Analyzer::GetRelativeStrength()
+  {
+    static const RelativeStrengthSeries EmptySeries;
+    return s_activeContext ? s_activeContext->GetRelativeStrength() : EmptySeries;
+  }
+  const DistributionAnalysis& Analyzer::GetDistribution()
+  {
+    static const DistributionAnalysis EmptyAnalysis;
+    return s_activeContext ? s_activeContext->GetDistribution() : EmptyAnalysis;
+  }
+  const SeasonalityAggregates& Analyzer::GetSeasonality()
+  {
+    static const SeasonalityAggregates EmptyAggregates;
+    return s_activeContext ? s_activeContext->GetSeasonality() : EmptyAggregates;
+  }
+  const VolatilitySeries& Analyzer::GetVolatility()
+  {
+    static const VolatilitySeries EmptySeries;
+    return s_activeContext ? s_activeContext->GetVolatility() : EmptySeries;
   }
   const RSISeries& Analyzer::GetRSI()
   {
-    return s_rsiSeries;
+    static const RSISeries EmptySeries;
+    return s_activeContext ? s_activeContext->GetRSI() : EmptySeries;
   }
 } // namespace KanVest
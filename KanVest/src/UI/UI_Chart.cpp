@@ -12,6 +12,7 @@
 #include "Stock/StockUtils.hpp"
 
 #include "Analyzer/StockAnalyzer.hpp"
+#include "Analyzer/BarReplay.hpp"
 #include "Analyzer/Indicators/MovingAverage.hpp"
 
 namespace KanVest
@@ -51,9 +52,112 @@ namespace KanVest
     }
     
     ShowController(stockData);
+
+    // Transform time candles incrementally, only changed tail bars are written and analyzed
+    if (s_barSettings.type != BarType::Time)
+    {
+      s_barTransformer.SetSettings(s_barSettings);
+      if (s_barTransformer.Sync(stockData) > 0 or s_analyzedBarType != s_barSettings.type)
+      {
+        if (s_barTransformer.ToStockData(stockData, s_barStockData) > 0 or s_analyzedBarType != s_barSettings.type)
+        {
+          Analyzer::AnalzeStock(s_barStockData);
+        }
+        s_analyzedBarType = s_barSettings.type;
+      }
+      PLotChart(s_barStockData);
+      return;
+    }
+
+    if (s_analyzedBarType != BarType::Time)
+    {
+      Analyzer::AnalzeStock(stockData);
+      s_analyzedBarType = BarType::Time;
+    }
     PLotChart(stockData);
   }
   
+  void Chart::SyncSeries(const StockData& stockData)
+  {
+    const auto& history = stockData.candleHistory;
+    const size_t n = history.size();
+    ChartSeries& series = s_series;
+
+    auto IsSameCandle = [](const CandleData& a, const CandleData& b) {
+      return a.timestamp == b.timestamp and a.open == b.open and a.high == b.high and a.low == b.low and a.close == b.close and a.volume == b.volume;
+    };
+
+    // Closed candles are final, revision of them (or other series, bar type) rebuilds
+    const bool sameSeries = series.consumed > 0 and n > series.consumed and series.symbol == stockData.symbol and series.range == stockData.range
+    and series.interval == stockData.dataGranularity and history.front().timestamp == series.firstTimestamp
+    and IsSameCandle(history[series.consumed - 1], series.lastConsumed);
+    if (!sameSeries)
+    {
+      series.symbol = stockData.symbol;
+      series.range = stockData.range;
+      series.interval = stockData.dataGranularity;
+      series.firstTimestamp = n > 0 ? history.front().timestamp : 0;
+      series.consumed = series.closedRows = 0;
+      series.closedLow = DBL_MAX;
+      series.closedHigh = -DBL_MAX;
+      series.closedMaxVolume = 1.0;
+    }
+
+    // Row of last (forming) candle is rewritten
+    auto Resize = [&series](size_t rows) {
+      series.candles.resize(rows);
+      series.xs.resize(rows);
+      series.opens.resize(rows);
+      series.highs.resize(rows);
+      series.lows.resize(rows);
+      series.closes.resize(rows);
+      series.volumes.resize(rows);
+    };
+    Resize(series.closedRows);
+
+    for (size_t i = series.consumed; i < n; ++i)
+    {
+      const CandleData& candle = history[i];
+      if (!Utils::IsTradingDay(candle.timestamp))
+      {
+        continue;
+      }
+
+      series.xs.push_back(static_cast<double>(series.candles.size()));
+      series.candles.push_back(candle);
+      series.opens.push_back(candle.open);
+      series.highs.push_back(candle.high);
+      series.lows.push_back(candle.low);
+      series.closes.push_back(candle.close);
+      series.volumes.push_back(static_cast<double>(candle.volume));
+
+      if (i + 1 < n)
+      {
+        series.closedLow = std::min(series.closedLow, candle.low);
+        series.closedHigh = std::max(series.closedHigh, candle.high);
+        series.closedMaxVolume = std::max(series.closedMaxVolume, static_cast<double>(candle.volume));
+        series.closedRows = series.candles.size();
+      }
+    }
+    if (n > 0)
+    {
+      series.consumed = n - 1;
+      series.lastConsumed = n > 1 ? history[n - 2] : CandleData {};
+    }
+
+    // Limits of closed candles are kept, forming candle is added to them
+    series.ymin = series.closedLow;
+    series.ymax = series.closedHigh;
+    series.maxVolume = series.closedMaxVolume;
+    if (series.candles.size() > series.closedRows)
+    {
+      const CandleData& last = series.candles.back();
+      series.ymin = std::min(series.ymin, last.low);
+      series.ymax = std::max(series.ymax, last.high);
+      series.maxVolume = std::max(series.maxVolume, static_cast<double>(last.volume));
+    }
+  }
+
   void Chart::ShowController(const StockData& stockData)
   {
     if (!stockData.IsValid())
@@ -96,13 +200,26 @@ namespace KanVest
     {
       s_plotType = (PlotType)currentPlotType;
     }
+
+    // Bar type selector --------------------------------------------------------------------
+    ImGui::SameLine();
+    KanVasX::UI::ShiftCursorX(10.0f);
+
+    int32_t currentBarType = (int32_t)s_barSettings.type;
+    static std::vector<std::string> barTypeOptions = {"Time", "Heikin Ashi", "Renko", "Range", "Candle Count"};
+
+    ImGui::SetNextItemWidth(100.0f);
+    if (KanVasX::UI::DropMenu("##BarType", barTypeOptions, &currentBarType, frameRounding))
+    {
+      s_barSettings.type = (BarType)currentBarType;
+    }
     
     // Technicals ----------------------------------------------------------------------------
     ImGui::SameLine();
     KanVasX::UI::ShiftCursor({20.0f, 5.0f});
 
     int32_t currentIndicator = 0; // No need to set the drop menu since we support multiple Indicators
-    static std::vector<std::string> indicatorOptions = {"Indicator", "Moving Average", "Moving Average Exponential"};
+    static std::vector<std::string> indicatorOptions = {"Indicator", "Moving Average", "Moving Average Exponential", "Bollinger Bands", "VWAP", "Volume Profile"};
 
     ImGui::SetNextItemWidth(100.0f);
     if (KanVasX::UI::DropMenu("##Indicator", indicatorOptions, &currentIndicator, frameRounding))
@@ -168,11 +285,33 @@ namespace KanVest
       {
         case Indicator::DMA: Fill_MA_UI_Data(true);  break;
         case Indicator::EMA: Fill_MA_UI_Data(false); break;
+        case Indicator::Bollinger: s_showBollinger = true; break;
+        case Indicator::VWAP: s_showVWAP = true; break;
+        case Indicator::VolumeProfile: s_showVolumeProfile = true; break;
         default:
           break;
       }
     }
     
+    // Replay -------------------------------------------------------------------------------
+    ImGui::SameLine();
+    KanVasX::UI::ShiftCursorX(10.0f);
+
+    const bool replaying = BarReplay::IsActive() and BarReplay::GetSymbol() == stockData.symbol;
+    if (KanVasX::UI::DrawButton(replaying ? "Live##Replay" : "Replay##Replay", nullptr, replaying ? KanVasX::Color::Button : KanVasX::Color::BackgroundDark,
+                                replaying ? KanVasX::Color::Text : KanVasX::Color::TextMuted, false, frameRounding, {70, 30}))
+    {
+      if (replaying)
+      {
+        BarReplay::Stop();
+      }
+      else
+      {
+        BarReplay::Start(stockData, stockData.candleHistory.size() / 2);
+      }
+    }
+    KanVasX::UI::Tooltip(replaying ? "Stop replay and show live data" : "Replay second half of loaded candles");
+
     // Interval Controller -------------------------------------------------------------------
     ImGui::SameLine();
 
@@ -195,6 +334,49 @@ namespace KanVest
       ImGui::SameLine();
     }
     ImGui::NewLine();
+
+    if (replaying)
+    {
+      ShowReplayController();
+    }
+  }
+
+  void Chart::ShowReplayController()
+  {
+    static constexpr ImVec2 buttonSize = {50, 30};
+    static constexpr float frameRounding = 10.0f;
+
+    if (KanVasX::UI::DrawButton(BarReplay::IsPlaying() ? "Pause##Replay" : "Play##Replay", nullptr, KanVasX::Color::Button, KanVasX::Color::Text, false,
+                                frameRounding, buttonSize))
+    {
+      BarReplay::SetPlaying(!BarReplay::IsPlaying());
+    }
+    ImGui::SameLine();
+    if (KanVasX::UI::DrawButton(">|##Replay", nullptr, KanVasX::Color::BackgroundDark, KanVasX::Color::Text, false, frameRounding, buttonSize))
+    {
+      BarReplay::Step();
+    }
+    KanVasX::UI::Tooltip("Next candle");
+
+    // Speed in candles per second, logarithmic so 1x and 1000x are both reachable
+    ImGui::SameLine();
+    float speed = static_cast<float>(BarReplay::GetSpeed());
+    ImGui::SetNextItemWidth(200.0f);
+    if (ImGui::SliderFloat("##ReplaySpeed", &speed, static_cast<float>(BarReplay::MinSpeed), static_cast<float>(BarReplay::MaxSpeed), "%.0fx",
+                           ImGuiSliderFlags_Logarithmic))
+    {
+      BarReplay::SetSpeed(speed);
+    }
+    KanVasX::UI::Tooltip("Candles per second");
+
+    // Progress and cost of replay
+    const ReplayStats& stats = BarReplay::GetStats();
+    ImGui::SameLine();
+    KanVasX::UI::ShiftCursorX(10.0f);
+    char text[192];
+    std::snprintf(text, sizeof(text), "%zu / %zu | %.0f candles/s | frame %.2f ms (max %.2f) | update %.3f ms, %.1f us per candle", stats.position, stats.total,
+                  stats.barsPerSecond, stats.frameMs, stats.maxFrameMs, stats.lastUpdateMs, stats.updateUsPerBar);
+    KanVasX::UI::Text(Font(Medium), text, Align::Left, {0.0f, 5.0f}, KanVasX::Color::TextMuted);
   }
   
   void Chart::PLotChart(const StockData &stockData)
@@ -229,36 +411,18 @@ namespace KanVest
       s_lastInterval = stockData.dataGranularity;
     }
 
-    std::vector<CandleData> filteredDaysCandles = Utils::FilterTradingDays(candleHistory);
-
-    // Axis data vector
-    std::vector<double> xs, opens, highs, lows, closes, volumes;
-
-    // Limit range for price and volume
-    double ymin = DBL_MAX;
-    double ymax = -DBL_MAX;
-    double maxVolume = 1.0;
-
-    // Store data for each plot volume and price
-    for (size_t i = 0; i < filteredDaysCandles.size(); ++i)
+    // Plot columns advance only by candles changed since last frame
+    SyncSeries(stockData);
+    const ChartSeries& series = s_series;
+    const std::vector<double>& xs = series.xs;
+    if (xs.empty())
     {
-      const auto& c = filteredDaysCandles[i];
-      
-      xs.push_back((double)i);
-      opens.push_back(c.open);
-      highs.push_back(c.high);
-      lows.push_back(c.low);
-      closes.push_back(c.close);
-      volumes.push_back((double)c.volume);
-      
-      ymin = std::min(ymin, c.low);
-      ymax = std::max(ymax, c.high);
-      maxVolume = std::max(maxVolume, (double)c.volume);
+      return;
     }
 
     // Shift Y axis to cover previous price in chart in case of gap opening
-    ymin = std::min(ymin, stockData.prevClose);
-    ymax = std::max(ymax, stockData.prevClose);
+    const double ymin = std::min(series.ymin, stockData.prevClose);
+    const double ymax = std::max(series.ymax, stockData.prevClose);
     
     // Range for volume bar --------------------------------
     static double visibleYMin = 0.0f;
@@ -267,12 +431,6 @@ namespace KanVest
     double volBottom = visibleYMin;
     double volTop = visibleYMin + (visibleYMax - visibleYMin) * 0.22;
 
-    std::vector<double> volumeY;
-    for (double v : volumes)
-    {
-      volumeY.push_back(volBottom + (v / maxVolume) * (volTop - volBottom));
-    }
-
     // Label string vector
     std::vector<std::string> labelStrings;
     std::vector<const char*> labelPtrs;
@@ -280,13 +438,13 @@ namespace KanVest
     
     // Label string limit
     const int targetLabels = 10;
-    const size_t n = filteredDaysCandles.size();
+    const size_t n = series.candles.size();
     const size_t labelStep = std::max<size_t>(1, (n + targetLabels - 1) / targetLabels);
     
     for (size_t i = 0; i < n; i += labelStep)
     {
       char buf[64];
-      GetTimeString(buf, 64, filteredDaysCandles[i].timestamp, stockData.range);
+      GetTimeString(buf, 64, series.candles[i].timestamp, stockData.range);
       labelStrings.emplace_back(buf);
       labelPositions.push_back((double)i);
     }
@@ -307,11 +465,19 @@ namespace KanVest
       ImPlot::SetupAxes("", "", ImPlotAxisFlags_NoGridLines, ImPlotAxisFlags_NoGridLines);
 
       ImGuiCond cond = s_stockChanged ? ImGuiCond_Always : ImGuiCond_Once;
-      
-      ImPlot::SetupAxisLimits(ImAxis_X1, xMin, xMax, cond);
+
+      // Replay keeps last candle in view with zoom of last frame
+      if (BarReplay::IsPlaying() and BarReplay::GetSymbol() == stockData.symbol and s_visibleWidth > 0.0)
+      {
+        ImPlot::SetupAxisLimits(ImAxis_X1, std::max(xMin, xMax + 1.0 - s_visibleWidth), xMax + 1.0, ImGuiCond_Always);
+      }
+      else
+      {
+        ImPlot::SetupAxisLimits(ImAxis_X1, xMin, xMax, cond);
+      }
       ImPlot::SetupAxisLimits(ImAxis_Y1, ymin, ymax, ImGuiCond_Always);
       
-      ImPlot::SetupAxisLimitsConstraints(ImAxis_X1, xMin, xMax);
+      ImPlot::SetupAxisLimitsConstraints(ImAxis_X1, xMin, xMax + 1.0);
       ImPlot::SetupAxisLimitsConstraints(ImAxis_Y1, ymin, ymax);
 
       if (!labelPositions.empty())
@@ -322,13 +488,19 @@ namespace KanVest
       // Compute candle width based on zoom size
       ComputeCandleWidth(xs);
 
+      // Only candles in view are drawn
+      const ImPlotRect view = ImPlot::GetPlotLimits();
+      s_visibleWidth = view.X.Size();
+      s_visibleBegin = static_cast<size_t>(std::clamp(std::floor(view.X.Min), 0.0, static_cast<double>(xs.size())));
+      s_visibleEnd = static_cast<size_t>(std::clamp(std::ceil(view.X.Max) + 1.0, 0.0, static_cast<double>(xs.size())));
+
       switch (s_plotType)
       {
         case PlotType::Line:
-          ShowLinePlot(stockData, xs, closes);
+          ShowLinePlot(stockData, xs, series.closes);
           break;
         case PlotType::Candle:
-          ShowCandlePlot(stockData, xs, closes, opens, highs, lows);
+          ShowCandlePlot(stockData, xs, series.closes, series.opens, series.highs, series.lows);
           break;
         default:
           break;
@@ -338,15 +510,15 @@ namespace KanVest
       ImPlotRect limits = ImPlot::GetPlotLimits();
       visibleYMin = limits.Y.Min;
       visibleYMax = limits.Y.Max;
-      ShowVolumes(xs, volumeY, opens, closes, volBottom);
+      ShowVolumes(series, volBottom, volTop);
 
       // Helpers
-      ShowTooltip(stockData, filteredDaysCandles);
+      ShowTooltip(stockData, series.candles);
       ShowReferenceLine(stockData.prevClose, ymin, ymax, xs, Color::Text);
       ShowCrossHair(xs, ymin, ymax);
 
-      // Show technicals
-      auto ShowTechnical = [xs](const std::string& title, const std::map<int, std::vector<double>>& MA_Data, std::unordered_map<int /* Period */, MovingAverage_UI_Data>& MA_UI_data)
+      // Show technicals, only enabled averages are evaluated
+      auto ShowTechnical = [&xs](const std::string& title, MovingAverageType type, std::unordered_map<int /* Period */, MovingAverage_UI_Data>& MA_UI_data)
       {
         for (auto& [period, data] : MA_UI_data)
         {
@@ -355,7 +527,7 @@ namespace KanVest
             continue;
           }
           ShowMAControler(title, MA_UI_data, period);
-          ShowMAPlot(data, MA_Data, xs);
+          ShowMAPlot(data, type, xs);
           ImGui::SameLine();
         }
       };
@@ -363,11 +535,34 @@ namespace KanVest
       const auto& cursorPos = ImPlot::GetPlotPos();
       
       ImGui::SetCursorScreenPos({cursorPos.x + 10.0f, cursorPos.y + 10.0f});
-      ShowTechnical("DMA", Analyzer::GetDMAValues(), s_DMA_UI_Data);
+      ShowTechnical("DMA", MovingAverageType::Simple, s_DMA_UI_Data);
       ImGui::NewLine();
       
       ImGui::SetCursorScreenPos({cursorPos.x + 10.0f, cursorPos.y + 40.0f});
-      ShowTechnical("EMA", Analyzer::GetEMAValues(), s_EMA_UI_Data);
+      ShowTechnical("EMA", MovingAverageType::Exponential, s_EMA_UI_Data);
+      ImGui::NewLine();
+
+      // Bands are evaluated by indicator graph only while shown
+      if (s_showBollinger)
+      {
+        ImGui::SetCursorScreenPos({cursorPos.x + 10.0f, cursorPos.y + 70.0f});
+        ShowBollingerControler();
+        ShowBollingerPlot(xs);
+      }
+
+      // VWAP and profile are kept incrementally by analyzer, chart only draws them
+      if (s_showVWAP)
+      {
+        ImGui::SetCursorScreenPos({cursorPos.x + 10.0f, cursorPos.y + 100.0f});
+        ShowVWAPControler();
+        ShowVWAPPlot(xs);
+      }
+      if (s_showVolumeProfile)
+      {
+        ImGui::SetCursorScreenPos({cursorPos.x + 10.0f, cursorPos.y + 130.0f});
+        ShowVolumeProfileControler();
+        ShowVolumeProfile();
+      }
 
       ImPlot::EndPlot();
     }
@@ -407,9 +602,12 @@ namespace KanVest
   void Chart::ShowCandlePlot(const StockData&, const std::vector<double>& xs, const std::vector<double>& closes, const std::vector<double>& opens,
                              const std::vector<double>& highs, const std::vector<double>& lows)
   {
+    const size_t begin = std::min(s_visibleBegin, xs.size());
+    const size_t end = std::clamp(s_visibleEnd, begin, xs.size());
+
     ImVec4 col4 = ImGui::ColorConvertU32ToFloat4(Color::Null);
     ImPlot::SetNextLineStyle(col4, 2.0f);
-    ImPlot::PlotLine("", xs.data(), closes.data(), (int)xs.size());
+    ImPlot::PlotLine("", xs.data() + begin, closes.data() + begin, static_cast<int>(end - begin));
     
     ImDrawList* dl = ImPlot::GetPlotDrawList();
 
@@ -417,7 +615,7 @@ namespace KanVest
     ImVec2 plotMin = ImPlot::PlotToPixels(plot.Min());
     ImVec2 plotMax = ImPlot::PlotToPixels(plot.Max());
 
-    for (size_t i = 0; i < xs.size(); ++i)
+    for (size_t i = begin; i < end; ++i)
     {
       ImU32 color = (closes[i] >= opens[i]) ? UI::Utils::StockProfitColor : UI::Utils::StockLossColor;
       
@@ -444,18 +642,21 @@ namespace KanVest
     }
   }
   
-  void Chart::ShowVolumes(const std::vector<double>& xs, const std::vector<double>& volumeY, const std::vector<double>& opens,
-                          const std::vector<double>& closes, double volBottom)
+  void Chart::ShowVolumes(const ChartSeries& series, double volBottom, double volTop)
   {
+    const size_t begin = std::min(s_visibleBegin, series.xs.size());
+    const size_t end = std::clamp(s_visibleEnd, begin, series.xs.size());
+
     ImDrawList* dl = ImPlot::GetPlotDrawList();
-    for (size_t i = 0; i < xs.size(); i++)
+    for (size_t i = begin; i < end; i++)
     {
       // Volume color = candle color
-      ImU32 color = (closes[i] >= opens[i]) ? Color::Alpha(UI::Utils::StockProfitColor, 0.5f) : Color::Alpha(UI::Utils::StockLossColor, 0.5f);
+      ImU32 color = (series.closes[i] >= series.opens[i]) ? Color::Alpha(UI::Utils::StockProfitColor, 0.5f) : Color::Alpha(UI::Utils::StockLossColor, 0.5f);
       
       // Convert center X to pixels
-      ImVec2 pBase   = ImPlot::PlotToPixels(xs[i], volBottom);
-      ImVec2 pVolume = ImPlot::PlotToPixels(xs[i], volumeY[i]);
+      const double volumeY = volBottom + (series.volumes[i] / series.maxVolume) * (volTop - volBottom);
+      ImVec2 pBase   = ImPlot::PlotToPixels(series.xs[i], volBottom);
+      ImVec2 pVolume = ImPlot::PlotToPixels(series.xs[i], volumeY);
       
       // Rectangle pixel coords
       ImVec2 a(pBase.x - s_candleWidth, pVolume.y);
@@ -587,14 +788,237 @@ namespace KanVest
     }
   }
   
-  void Chart::ShowMAPlot(const MovingAverage_UI_Data& MA_UI_Data, const std::map<int, std::vector<double>>& MA_Data, const std::vector<double> &xs)
+  void Chart::ShowMAPlot(const MovingAverage_UI_Data& MA_UI_Data, MovingAverageType type, const std::vector<double> &xs)
+  {
+    // Visible candles and warm up only, pan and zoom evaluate chunks not cached yet
+    const auto& values = Analyzer::GetMovingAverage(type, MA_UI_Data.period, s_visibleBegin, s_visibleEnd);
+    const size_t end = std::min({s_visibleEnd, values.size(), xs.size()});
+    if (s_visibleBegin >= end)
+    {
+      return;
+    }
+
+    ImVec4 col4 = {MA_UI_Data.color.r, MA_UI_Data.color.g, MA_UI_Data.color.b, MA_UI_Data.color.a};
+    ImPlot::SetNextLineStyle(col4, 2.0f);
+    ImPlot::PlotLine("", xs.data() + s_visibleBegin, values.data() + s_visibleBegin, static_cast<int>(end - s_visibleBegin));
+  }
+
+  void Chart::ShowBollingerPlot(const std::vector<double> &xs)
+  {
+    static const ImVec4 BandColor = {0.35f, 0.55f, 0.95f, 1.0f};
+
+    const auto& upper = Analyzer::GetIndicator("BollingerUpper(20,2)");
+    const auto& lower = Analyzer::GetIndicator("BollingerLower(20,2)");
+    const auto& middle = Analyzer::GetIndicator("SMA(20)");
+    if (upper.size() < xs.size() or lower.size() < xs.size() or middle.size() < xs.size())
+    {
+      return;
+    }
+
+    const int count = static_cast<int>(xs.size());
+    ImPlot::SetNextFillStyle(BandColor, 0.08f);
+    ImPlot::PlotShaded("##BollingerFill", xs.data(), upper.data(), lower.data(), count);
+
+    ImPlot::SetNextLineStyle(BandColor, 1.5f);
+    ImPlot::PlotLine("##BollingerUpper", xs.data(), upper.data(), count);
+    ImPlot::SetNextLineStyle(BandColor, 1.5f);
+    ImPlot::PlotLine("##BollingerLower", xs.data(), lower.data(), count);
+    ImPlot::SetNextLineStyle({BandColor.x, BandColor.y, BandColor.z, 0.6f}, 1.0f);
+    ImPlot::PlotLine("##BollingerMiddle", xs.data(), middle.data(), count);
+  }
+
+  void Chart::ShowBollingerControler()
+  {
+    ImGui::PushID("Bollinger");
+    
+    // Rectangle
+    {
+      KanVasX::UI::DrawFilledRect(Color::Button, {145.0f, 25.0f});
+    }
+
+    // Cross Button
+    {
+      if (KanVasX::UI::DrawButton("X", Font(Bold), Color::BackgroundLight, Color::DarkRed, false, 10.0f, {25.0f, 25.0f}))
+      {
+        s_showBollinger = false;
+      }
+    }
+    
+    // Title
+    {
+      ImGui::SameLine();
+      KanVasX::UI::Text(Font(FixedWidthHeader_12), "BB 20, 2", Align::Left, {0.0f, 4.0f});
+    }
+    
+    ImGui::PopID();
+  }
+
+  void Chart::ShowVWAPPlot(const std::vector<double> &xs)
+  {
+    static const ImVec4 VWAPColor = {0.95f, 0.75f, 0.25f, 1.0f};
+
+    const VWAPSeries& series = Analyzer::GetVolumeAnalysis().GetVWAP();
+    if (series.vwap.size() < xs.size() or xs.empty())
+    {
+      return;
+    }
+
+    // Bands at 1 and 2 deviations, NaN before anchor bar leaves them empty
+    const size_t count = xs.size();
+    std::vector<double> upper1(count), lower1(count), upper2(count), lower2(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      upper1[i] = series.vwap[i] + series.deviation[i];
+      lower1[i] = series.vwap[i] - series.deviation[i];
+      upper2[i] = series.vwap[i] + 2.0 * series.deviation[i];
+      lower2[i] = series.vwap[i] - 2.0 * series.deviation[i];
+    }
+
+    ImPlot::SetNextFillStyle(VWAPColor, 0.05f);
+    ImPlot::PlotShaded("##VWAPFill2", xs.data(), upper2.data(), lower2.data(), static_cast<int>(count));
+    ImPlot::SetNextFillStyle(VWAPColor, 0.08f);
+    ImPlot::PlotShaded("##VWAPFill1", xs.data(), upper1.data(), lower1.data(), static_cast<int>(count));
+
+    ImPlot::SetNextLineStyle({VWAPColor.x, VWAPColor.y, VWAPColor.z, 0.4f}, 1.0f);
+    ImPlot::PlotLine("##VWAPUpper2", xs.data(), upper2.data(), static_cast<int>(count), ImPlotLineFlags_SkipNaN);
+    ImPlot::SetNextLineStyle({VWAPColor.x, VWAPColor.y, VWAPColor.z, 0.4f}, 1.0f);
+    ImPlot::PlotLine("##VWAPLower2", xs.data(), lower2.data(), static_cast<int>(count), ImPlotLineFlags_SkipNaN);
+    ImPlot::SetNextLineStyle(VWAPColor, 2.0f);
+    ImPlot::PlotLine("##VWAP", xs.data(), series.vwap.data(), static_cast<int>(count), ImPlotLineFlags_SkipNaN);
+
+    // Double click anchors VWAP at hovered candle
+    if (ImPlot::IsPlotHovered() and ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
+    {
+      const int idx = std::clamp((int)std::round(ImPlot::GetPlotMousePos().x), 0, (int)count - 1);
+      Analyzer::SetVWAPAnchor(VWAPAnchor::Bar, static_cast<size_t>(idx));
+    }
+  }
+
+  void Chart::ShowVWAPControler()
+  {
+    ImGui::PushID("VWAP");
+    
+    // Rectangle
+    {
+      KanVasX::UI::DrawFilledRect(Color::Button, {170.0f, 25.0f});
+    }
+
+    // Cross Button
+    {
+      if (KanVasX::UI::DrawButton("X", Font(Bold), Color::BackgroundLight, Color::DarkRed, false, 10.0f, {25.0f, 25.0f}))
+      {
+        s_showVWAP = false;
+      }
+    }
+    
+    // Title
+    {
+      ImGui::SameLine();
+      KanVasX::UI::Text(Font(FixedWidthHeader_12), "VWAP", Align::Left, {0.0f, 4.0f});
+    }
+
+    // Anchor, Bar anchor is set by double click on chart
+    {
+      static std::vector<std::string> anchorOptions = {"Session", "Week", "Month", "Bar"};
+      const VolumeAnalysis& volume = Analyzer::GetVolumeAnalysis();
+      int32_t anchorIdx = static_cast<int32_t>(volume.GetAnchor());
+
+      ImGui::SameLine();
+      ImGui::SetNextItemWidth(70.0f);
+      if (KanVasX::UI::DropMenu("##VWAPAnchor", anchorOptions, &anchorIdx))
+      {
+        Analyzer::SetVWAPAnchor(static_cast<VWAPAnchor>(anchorIdx), volume.GetAnchorBar());
+      }
+    }
+    
+    ImGui::PopID();
+  }
+
+  void Chart::ShowVolumeProfile()
   {
-    if (auto itr = MA_Data.find(MA_UI_Data.period); itr != MA_Data.end())
+    const VolumeAnalysis& volume = Analyzer::GetVolumeAnalysis();
+    const VolumeProfile& profile = volume.GetProfile();
+    const VolumeProfileLevels& levels = volume.GetLevels();
+    const std::vector<double>& volumes = profile.GetVolumes();
+    if (volumes.empty() or levels.totalVolume <= 0.0)
     {
-      ImVec4 col4 = {MA_UI_Data.color.r, MA_UI_Data.color.g, MA_UI_Data.color.b, MA_UI_Data.color.a};
-      ImPlot::SetNextLineStyle(col4, 2.0f);
-      ImPlot::PlotLine("", xs.data(), itr->second.data(), static_cast<int>(xs.size()));
+      return;
+    }
+
+    // Histogram on right edge of plot, bins merged so each row is at least 2 pixels high
+    const ImVec2 plotPos = ImPlot::GetPlotPos();
+    const ImVec2 plotSize = ImPlot::GetPlotSize();
+    const float right = plotPos.x + plotSize.x;
+    const float width = plotSize.x * 0.2f;
+
+    const float binPixels = std::fabs(ImPlot::PlotToPixels(0.0, profile.GetBinLow(1)).y - ImPlot::PlotToPixels(0.0, profile.GetBinLow(0)).y);
+    const size_t rowBins = std::max<size_t>(1, static_cast<size_t>(std::ceil(2.0f / std::max(binPixels, 0.01f))));
+
+    std::vector<double> rows;
+    rows.reserve(volumes.size() / rowBins + 1);
+    double maxRow = 0.0;
+    for (size_t bin = 0; bin < volumes.size(); bin += rowBins)
+    {
+      double row = 0.0;
+      for (size_t k = bin; k < std::min(bin + rowBins, volumes.size()); ++k)
+      {
+        row += std::max(0.0, volumes[k]);
+      }
+      rows.push_back(row);
+      maxRow = std::max(maxRow, row);
     }
+
+    ImDrawList* dl = ImPlot::GetPlotDrawList();
+    for (size_t row = 0; row < rows.size(); ++row)
+    {
+      if (rows[row] <= 0.0)
+      {
+        continue;
+      }
+
+      const double low = profile.GetBinLow(row * rowBins);
+      const double high = profile.GetBinLow(std::min((row + 1) * rowBins, volumes.size()));
+      const bool inValueArea = low < levels.valueAreaHigh and high > levels.valueAreaLow;
+      const ImU32 color = Color::Alpha(Color::Text, inValueArea ? 0.35f : 0.15f);
+
+      const float top = ImPlot::PlotToPixels(0.0, high).y;
+      const float bottom = ImPlot::PlotToPixels(0.0, low).y;
+      dl->AddRectFilled({right - width * static_cast<float>(rows[row] / maxRow), top + 0.5f}, {right, bottom - 0.5f}, color);
+    }
+
+    // Point of control across the chart
+    const ImPlotRect limits = ImPlot::GetPlotLimits();
+    DrawDashedHLine(levels.pointOfControl, limits.X.Min, limits.X.Max, Color::Alpha(Color::Text, 0.6f), 1.0f, 6.0f, 4.0f);
+  }
+
+  void Chart::ShowVolumeProfileControler()
+  {
+    ImGui::PushID("VolumeProfile");
+    
+    // Rectangle
+    {
+      KanVasX::UI::DrawFilledRect(Color::Button, {320.0f, 25.0f});
+    }
+
+    // Cross Button
+    {
+      if (KanVasX::UI::DrawButton("X", Font(Bold), Color::BackgroundLight, Color::DarkRed, false, 10.0f, {25.0f, 25.0f}))
+      {
+        s_showVolumeProfile = false;
+      }
+    }
+    
+    // Title
+    {
+      const VolumeProfileLevels& levels = Analyzer::GetVolumeAnalysis().GetLevels();
+      std::string title = "VP POC " + UI::Utils::FormatDoubleToString(levels.pointOfControl) + "  VA " + UI::Utils::FormatDoubleToString(levels.valueAreaLow)
+      + " - " + UI::Utils::FormatDoubleToString(levels.valueAreaHigh);
+
+      ImGui::SameLine();
+      KanVasX::UI::Text(Font(FixedWidthHeader_12), title, Align::Left, {0.0f, 4.0f});
+    }
+    
+    ImGui::PopID();
   }
 
   void Chart::ShowMAControler(const std::string& title, std::unordered_map<int /* Period */, MovingAverage_UI_Data>& MA_UI_data, int period)
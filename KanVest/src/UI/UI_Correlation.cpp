@@ -0,0 +1,133 @@
+//
+//  UI_Correlation.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "UI_Correlation.hpp"
+
+#include "UI/UI_Utils.hpp"
+
+#include "Stock/StockManager.hpp"
+
+namespace KanVest
+{
+#define Font(font) KanVest::UI::Font::Get(KanVest::UI::FontType::font)
+
+  using Align = KanVasX::UI::AlignX;
+  using Color = KanVasX::Color;
+
+  // Watchlist is synchronized at most once per interval, engine applies only new bars
+  static constexpr double SyncIntervalSeconds = 1.0;
+
+  void UI_Correlation::ShowHeatmap(const StockData& stockData)
+  {
+    IK_PERFORMANCE_FUNC("UI_Correlation::ShowHeatmap");
+
+    // Window selection
+    static constexpr std::array<size_t, 4> Windows = {20, 60, 120, 250};
+    float buttonSize = (ImGui::GetContentRegionAvail().x / Windows.size()) - 10.0f;
+
+    KanVasX::UI::ShiftCursor({2.0f, 5.0f});
+    for (size_t i = 0; i < Windows.size(); ++i)
+    {
+      const size_t window = Windows[i];
+      const auto& buttonColor = s_engine.GetWindow() == window ? Color::Button : Color::Background;
+      if (KanVasX::UI::DrawButton(std::to_string(window) + " Bars", Font(Medium), buttonColor, Color::TextBright, false, 10.0f, {buttonSize, 30}))
+      {
+        s_engine.SetWindow(window);
+        s_syncRequired = true;
+      }
+      KanVasX::UI::Tooltip("Correlation of log returns over last " + std::to_string(window) + " bars");
+      KanVasX::UI::DrawItemActivityOutline();
+      if (i + 1 < Windows.size())
+      {
+        ImGui::SameLine();
+      }
+    }
+
+    // Synchronize engine with watchlist
+    if (s_syncRequired or s_syncTimer.ElapsedSeconds() >= SyncIntervalSeconds)
+    {
+      std::vector<StockData> stocks;
+      for (const auto& symbol : StockManager::GetRequestedSymbols())
+      {
+        StockData data = StockManager::GetLatestStockData(symbol);
+        if (data.IsValid() and data.dataGranularity == stockData.dataGranularity)
+        {
+          stocks.push_back(std::move(data));
+        }
+      }
+
+      if (s_engine.Sync(stocks) or s_syncRequired)
+      {
+        s_labels.clear();
+        s_labelPointers.clear();
+        for (const auto& symbol : s_engine.GetSymbols())
+        {
+          s_labels.push_back(symbol.ends_with(".NS") ? symbol.substr(0, symbol.size() - 3) : symbol);
+        }
+        for (const auto& label : s_labels)
+        {
+          s_labelPointers.push_back(label.c_str());
+        }
+      }
+      s_syncRequired = false;
+      s_syncTimer.Reset();
+    }
+
+    const size_t n = s_engine.Size();
+    if (n < 2)
+    {
+      KanVasX::UI::Text(Font(Header_22), "Search two or more stocks of same interval to see correlation", Align::Center, {0, 10.0f}, Color::Text);
+      return;
+    }
+
+    const auto& correlation = s_engine.GetCorrelation();
+
+    // Ticks at cell centers, heatmap row 0 is drawn at top
+    std::vector<double> xTicks(n), yTicks(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      xTicks[i] = static_cast<double>(i) + 0.5;
+      yTicks[i] = static_cast<double>(n - i) - 0.5;
+    }
+
+    static constexpr float ScaleWidth = 70.0f;
+    const ImVec2 available = ImGui::GetContentRegionAvail();
+    const double extent = static_cast<double>(n);
+
+    ImPlot::PushColormap(ImPlotColormap_RdBu);
+    if (ImPlot::BeginPlot("##CorrelationHeatmap", ImVec2(available.x - ScaleWidth, available.y), ImPlotFlags_NoLegend | ImPlotFlags_NoMouseText))
+    {
+      const ImPlotAxisFlags axisFlags = ImPlotAxisFlags_Lock | ImPlotAxisFlags_NoGridLines | ImPlotAxisFlags_NoTickMarks;
+      ImPlot::SetupAxes(nullptr, nullptr, axisFlags, axisFlags);
+      ImPlot::SetupAxisLimits(ImAxis_X1, 0, extent, ImGuiCond_Always);
+      ImPlot::SetupAxisLimits(ImAxis_Y1, 0, extent, ImGuiCond_Always);
+      ImPlot::SetupAxisTicks(ImAxis_X1, xTicks.data(), static_cast<int>(n), s_labelPointers.data());
+      ImPlot::SetupAxisTicks(ImAxis_Y1, yTicks.data(), static_cast<int>(n), s_labelPointers.data());
+
+      // Cell values are readable only for small watchlist
+      ImPlot::PlotHeatmap("##Correlation", correlation.data(), static_cast<int>(n), static_cast<int>(n), -1.0, 1.0, n <= 12 ? "%.2f" : nullptr,
+                          ImPlotPoint(0, 0), ImPlotPoint(extent, extent));
+
+      // Hovered pair
+      if (ImPlot::IsPlotHovered())
+      {
+        const ImPlotPoint mouse = ImPlot::GetPlotMousePos();
+        const int column = static_cast<int>(mouse.x);
+        const int row = static_cast<int>(n) - 1 - static_cast<int>(mouse.y);
+        if (column >= 0 and row >= 0 and column < static_cast<int>(n) and row < static_cast<int>(n))
+        {
+          ImGui::SetTooltip("%s / %s : %.2f", s_labelPointers[static_cast<size_t>(row)], s_labelPointers[static_cast<size_t>(column)],
+                            correlation[static_cast<size_t>(row) * n + static_cast<size_t>(column)]);
+        }
+      }
+      ImPlot::EndPlot();
+    }
+    ImGui::SameLine();
+    ImPlot::ColormapScale("##CorrelationScale", -1.0, 1.0, ImVec2(ScaleWidth - 10.0f, available.y));
+    ImPlot::PopColormap();
+  }
+} // namespace KanVest
@@ -8,13 +8,18 @@
 #include "UI_KanVestPanel.hpp"
 
 #include "Stock/StockManager.hpp"
+#include "Stock/StockUtils.hpp"
 
 #include "Analyzer/StockAnalyzer.hpp"
+#include "Analyzer/BarReplay.hpp"
 
 #include "UI/UI_Utils.hpp"
 #include "UI/UI_Chart.hpp"
 #include "UI/UI_MovingAverage.hpp"
 #include "UI/UI_Momentum.hpp"
+#include "UI/UI_Correlation.hpp"
+#include "UI/UI_Seasonality.hpp"
+#include "UI/UI_Volatility.hpp"
 
 namespace KanVest::UI
 {
@@ -37,6 +42,14 @@ namespace KanVest::UI
     // Update selected stock data
     UpdateSelectedStock();
 
+    // Replayed candles due in this frame are appended and analyzed before stock data is read. Replay ends if other
+    // stock is selected, analyzer serves one stock at a time
+    if (BarReplay::IsActive() and BarReplay::GetSymbol() != s_selectedStockSymbol)
+    {
+      BarReplay::Stop();
+    }
+    BarReplay::Update();
+
     // Get Stock Data
     StockData stockData = StockManager::GetLatestStockData(s_selectedStockSymbol);
     
@@ -49,10 +62,26 @@ namespace KanVest::UI
       s_lastInterval = stockData.dataGranularity;
     }
 
-    // Analyze Stock
-    if (s_stockChanged)
+    // Benchmark is fetched at range and interval of stock, relative strength joins bars of same granularity
+    const std::string benchmarkSymbol(KanVest::Utils::BenchmarkSymbol);
+    StockData benchmarkData = StockManager::GetLatestStockData(benchmarkSymbol);
+    if (s_stockChanged and stockData.IsValid() and (benchmarkData.range != stockData.range or benchmarkData.dataGranularity != stockData.dataGranularity))
+    {
+      StockManager::AddStockDataRequest(benchmarkSymbol, API_Provider::GetRangeEnumFromString(stockData.range),
+                                        API_Provider::GetIntervalEnumFromString(stockData.dataGranularity));
+    }
+
+    // Benchmark series is cached once and shared by every stock, rebuilt only when index candles change
+    const bool benchmarkChanged = benchmarkData.dataGranularity == stockData.dataGranularity and BenchmarkCache::Update(benchmarkData);
+
+    // Analyze Stock. Revisited series with unchanged candles are served from analysis cache
+    if (s_stockChanged or benchmarkChanged)
     {
       Analyzer::AnalzeStock(stockData);
+
+      [[maybe_unused]] const auto& cacheStats = Analyzer::GetCacheStats();
+      IK_LOG_DEBUG("Panel", "Analyzed {0} in {1:.1f} us | Cache hit rate {2:.1f}% | {3} entries {4:.2f} MB",
+                   stockData.symbol, cacheStats.lastLatencyUs, cacheStats.HitRate(), cacheStats.entries, cacheStats.bytesUsed / (1024.0 * 1024.0));
     }
 
     // Show Stock Data
@@ -79,6 +108,33 @@ namespace KanVest::UI
         KanVasX::ScopedColor childBgColor(ImGuiCol_ChildBg, Color::Null);
         ImGui::BeginChild(" Stock - Search ", ImVec2(availableX * 0.39f, ImGui::GetContentRegionAvail().y));
         {
+          // Watchlist correlation or seasonality of selected stock
+          static constexpr std::array<const char*, 2> Heatmaps = {"Correlation", "Seasonality"};
+          float buttonSize = (ImGui::GetContentRegionAvail().x / Heatmaps.size()) - 10.0f;
+          KanVasX::UI::ShiftCursor({2.0f, 5.0f});
+          for (size_t i = 0; i < Heatmaps.size(); ++i)
+          {
+            const bool selected = s_showSeasonality == (i == 1);
+            if (KanVasX::UI::DrawButton(Heatmaps[i], Font(Medium), selected ? Color::Button : Color::Background,
+                                        Color::TextBright, false, 10.0f, {buttonSize, 30}))
+            {
+              s_showSeasonality = i == 1;
+            }
+            KanVasX::UI::DrawItemActivityOutline();
+            if (i + 1 < Heatmaps.size())
+            {
+              ImGui::SameLine();
+            }
+          }
+
+          if (s_showSeasonality)
+          {
+            UI_Seasonality::ShowHeatmap(stockData);
+          }
+          else
+          {
+            UI_Correlation::ShowHeatmap(stockData);
+          }
         }
         ImGui::EndChild();
       }
@@ -240,7 +296,7 @@ namespace KanVest::UI
       return;
     }
     
-    enum class TechnicalTab {DMA, EMA, RSI, Max};
+    enum class TechnicalTab {DMA, EMA, RSI, Volatility, Max};
     static TechnicalTab tab = TechnicalTab::DMA;
 
     float availX = ImGui::GetContentRegionAvail().x;
@@ -260,7 +316,8 @@ namespace KanVest::UI
     KanVasX::UI::ShiftCursor({2.0f, 5.0f});
     TechnicalButton("DMA", TechnicalTab::DMA, "Daily Moving Average"); ImGui::SameLine();
     TechnicalButton("EMA", TechnicalTab::EMA, "Exponantial Moving Average"); ImGui::SameLine();
-    TechnicalButton("RSI", TechnicalTab::RSI, "Relative Strength Indicator");
+    TechnicalButton("RSI", TechnicalTab::RSI, "Relative Strength Indicator"); ImGui::SameLine();
+    TechnicalButton("VOL", TechnicalTab::Volatility, "ATR and Volatility Estimators");
 
     if (tab == TechnicalTab::DMA)
     {
@@ -274,6 +331,10 @@ namespace KanVest::UI
     {
       UI_Momentum::ShowRSI(stockData);
     }
+    else if (tab == TechnicalTab::Volatility)
+    {
+      UI_Volatility::ShowVolatility(stockData);
+    }
   }
   
   void Panel::ShowStockAnalyzer(const StockData& stockData)
@@ -323,5 +384,70 @@ namespace KanVest::UI
       KanVasX::UI::ShiftCursorX(20.0f);
       ImGui::ProgressBar(fraction, ImVec2(ImGui::GetContentRegionAvail().x - 20.0f, 0), "");
     }
+
+    // Trend of each timeframe derived from same candles
+    const auto& multiTimeframe = Analyzer::GetMultiTimeframeReport();
+    KanVasX::UI::ShiftCursorX(20.0f);
+    for (const auto& analysis : multiTimeframe.timeframes)
+    {
+      const ImU32 trendColor = analysis.trend > 0 ? Utils::StockProfitColor : analysis.trend < 0 ? Utils::StockLossColor : Utils::StockModerateColor;
+      const std::string trendString = std::string(MultiTimeframeAnalyzer::GetName(analysis.timeframe)) +
+      (analysis.trend > 0 ? " Bullish" : analysis.trend < 0 ? " Bearish" : " Mixed");
+      KanVasX::UI::Text(KanVest::UI::Font::Get(KanVest::UI::FontType::Medium), trendString, KanVasX::UI::AlignX::Left, {0, 5.0f}, trendColor);
+      ImGui::SameLine(0.0f, 20.0f);
+    }
+    if (!multiTimeframe.timeframes.empty())
+    {
+      KanVasX::UI::Text(KanVest::UI::Font::Get(KanVest::UI::FontType::Medium), multiTimeframe.IsConfirmed() ? "All timeframes confirm" : "Timeframes diverge",
+                        KanVasX::UI::AlignX::Right, {-20.0f, 5.0f}, multiTimeframe.IsConfirmed() ? KanVasX::Color::TextBright : KanVasX::Color::Text);
+    }
+
+    // Patterns ending at last candle, colored by bias
+    if (const PatternMask patterns = Analyzer::GetLatestPatterns(); patterns != 0)
+    {
+      KanVasX::UI::ShiftCursorX(20.0f);
+      KanVasX::UI::Text(KanVest::UI::Font::Get(KanVest::UI::FontType::Medium), "Patterns", KanVasX::UI::AlignX::Left, {0, 5.0f}, KanVasX::Color::Text);
+      for (size_t index = 0; index < CandlePatternCount; ++index)
+      {
+        const CandlePattern pattern = static_cast<CandlePattern>(index);
+        if (patterns & (1u << index))
+        {
+          const int bias = PatternScanner::GetBias(pattern);
+          ImGui::SameLine(0.0f, 20.0f);
+          KanVasX::UI::Text(KanVest::UI::Font::Get(KanVest::UI::FontType::Medium), std::string(PatternScanner::GetName(pattern)), KanVasX::UI::AlignX::Left,
+                            {0, 5.0f}, bias > 0 ? Utils::StockProfitColor : bias < 0 ? Utils::StockLossColor : Utils::StockModerateColor);
+        }
+      }
+    }
+
+    // Relative strength against NIFTY 50, Mansfield RS above zero outperforms
+    if (const auto& relativeStrength = Analyzer::GetRelativeStrength(); !std::isnan(relativeStrength.LastMansfield()))
+    {
+      const double mansfield = relativeStrength.LastMansfield();
+      KanVasX::UI::ShiftCursorX(20.0f);
+      KanVasX::UI::Text(KanVest::UI::Font::Get(KanVest::UI::FontType::Medium), "RS vs NIFTY", KanVasX::UI::AlignX::Left, {0, 5.0f}, KanVasX::Color::Text);
+      ImGui::SameLine(0.0f, 20.0f);
+      KanVasX::UI::Text(KanVest::UI::Font::Get(KanVest::UI::FontType::Medium), "Mansfield " + Utils::FormatDoubleToString(mansfield) + " | Ratio " +
+                        Utils::FormatDoubleToString(relativeStrength.LastRatio()), KanVasX::UI::AlignX::Left, {0, 5.0f},
+                        mansfield > 0.0 ? Utils::StockProfitColor : mansfield < 0.0 ? Utils::StockLossColor : Utils::StockModerateColor);
+    }
+
+    // Percentile of last candle in closed history of symbol, from quantile sketches
+    if (const auto& distribution = Analyzer::GetDistribution(); !distribution.GetSketch(DistributionMetric::Volume).IsEmpty())
+    {
+      KanVasX::UI::ShiftCursorX(20.0f);
+      KanVasX::UI::Text(KanVest::UI::Font::Get(KanVest::UI::FontType::Medium), "History Rank", KanVasX::UI::AlignX::Left, {0, 5.0f}, KanVasX::Color::Text);
+      for (size_t index = 0; index < static_cast<size_t>(DistributionMetric::Count); ++index)
+      {
+        const DistributionMetric metric = static_cast<DistributionMetric>(index);
+        if (const double percentile = distribution.GetLatestPercentile(metric); !std::isnan(percentile))
+        {
+          ImGui::SameLine(0.0f, 20.0f);
+          KanVasX::UI::Text(KanVest::UI::Font::Get(KanVest::UI::FontType::Medium), std::string(DistributionAnalysis::GetName(metric)) + " " +
+                            Utils::FormatDoubleToString(percentile) + "%", KanVasX::UI::AlignX::Left, {0, 5.0f},
+                            percentile >= 90.0 ? KanVasX::Color::TextBright : KanVasX::Color::Text);
+        }
+      }
+    }
   }
 } // namespace KanVest::UI
@@ -0,0 +1,246 @@
+//
+//  UI_Seasonality.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "UI_Seasonality.hpp"
+
+#include "UI/UI_Utils.hpp"
+
+#include "Analyzer/StockAnalyzer.hpp"
+
+namespace KanVest
+{
+#define Font(font) KanVest::UI::Font::Get(KanVest::UI::FontType::font)
+
+  using Align = KanVasX::UI::AlignX;
+  using Color = KanVasX::Color;
+
+  void UI_Seasonality::ShowHeatmap(const StockData& stockData)
+  {
+    IK_PERFORMANCE_FUNC("UI_Seasonality::ShowHeatmap");
+
+    // View selection, month profile is the average row of heatmap so it has no button
+    static constexpr std::array<SeasonalityGroup, 5> Views = {
+      SeasonalityGroup::Count, SeasonalityGroup::Weekday, SeasonalityGroup::DayOfMonth, SeasonalityGroup::Holiday, SeasonalityGroup::TimeOfDay
+    };
+    float buttonSize = (ImGui::GetContentRegionAvail().x / Views.size()) - 10.0f;
+
+    KanVasX::UI::ShiftCursor({2.0f, 5.0f});
+    for (size_t i = 0; i < Views.size(); ++i)
+    {
+      const SeasonalityGroup view = Views[i];
+      const std::string label = view == SeasonalityGroup::Count ? "Year x Month" : std::string(SeasonalityAggregates::GetName(view));
+      if (KanVasX::UI::DrawButton(label, Font(Medium), s_view == view ? Color::Button : Color::Background, Color::TextBright, false, 10.0f, {buttonSize, 30}))
+      {
+        s_view = view;
+      }
+      KanVasX::UI::DrawItemActivityOutline();
+      if (i + 1 < Views.size())
+      {
+        ImGui::SameLine();
+      }
+    }
+
+    // Aggregates of analyzed stock, else saved aggregates of selected series until its history arrives
+    const SeasonalityAggregates* aggregates = &Analyzer::GetSeasonality();
+    if (aggregates->Days() == 0)
+    {
+      if (const std::string key = stockData.symbol + "|" + stockData.range + "|" + stockData.dataGranularity; key != s_storedKey)
+      {
+        s_storedKey = key;
+        s_stored.Clear();
+        SeasonalityStore::Load(stockData.symbol, stockData.range, stockData.dataGranularity, s_stored);
+      }
+      aggregates = &s_stored;
+    }
+
+    if (aggregates->Days() == 0)
+    {
+      KanVasX::UI::Text(Font(Header_22), "Seasonality needs daily or intraday history of two or more days", Align::Center, {0, 10.0f}, Color::Text);
+      return;
+    }
+
+    if (s_view == SeasonalityGroup::Count)
+    {
+      ShowYearMonth(*aggregates);
+    }
+    else
+    {
+      ShowProfile(*aggregates, s_view);
+    }
+  }
+
+  void UI_Seasonality::ShowYearMonth(const SeasonalityAggregates& aggregates)
+  {
+    static constexpr size_t Months = 12;
+
+    // Rows are years with latest at top and average of each month at bottom
+    const size_t years = aggregates.Years();
+    const size_t rows = years + 1;
+    std::vector<double> values(rows * Months, 0.0);
+    double extent = 0.0;
+    for (size_t row = 0; row < years; ++row)
+    {
+      const int year = aggregates.FirstYear() + static_cast<int>(years - 1 - row);
+      for (size_t month = 0; month < Months; ++month)
+      {
+        const SeasonalityBucket* bucket = aggregates.GetYearMonth(year, month);
+        if (bucket and bucket->count)
+        {
+          values[row * Months + month] = bucket->TotalReturn();
+          extent = std::max(extent, std::abs(values[row * Months + month]));
+        }
+      }
+    }
+    const auto monthBuckets = aggregates.GetBuckets(SeasonalityGroup::Month);
+    for (size_t month = 0; month < Months; ++month)
+    {
+      // Average month compounded from average day, same scale as year cells
+      const SeasonalityBucket& bucket = monthBuckets[month];
+      if (bucket.count)
+      {
+        const double daysPerMonth = static_cast<double>(bucket.count) / std::max<size_t>(years, 1);
+        values[years * Months + month] = std::expm1(bucket.sum / bucket.count * daysPerMonth) * 100.0;
+      }
+    }
+    extent = std::max(extent, 1.0);
+
+    std::vector<std::string> rowLabels;
+    std::vector<const char*> rowPointers, columnPointers;
+    for (size_t row = 0; row < years; ++row)
+    {
+      rowLabels.push_back(std::to_string(aggregates.FirstYear() + static_cast<int>(years - 1 - row)));
+    }
+    rowLabels.push_back("Avg");
+    for (const auto& label : rowLabels)
+    {
+      rowPointers.push_back(label.c_str());
+    }
+    std::array<std::string, Months> monthLabels;
+    for (size_t month = 0; month < Months; ++month)
+    {
+      monthLabels[month] = SeasonalityAggregates::GetLabel(SeasonalityGroup::Month, month);
+      columnPointers.push_back(monthLabels[month].c_str());
+    }
+
+    // Ticks at cell centers, heatmap row 0 is drawn at top
+    std::vector<double> xTicks(Months), yTicks(rows);
+    for (size_t i = 0; i < Months; ++i)
+    {
+      xTicks[i] = static_cast<double>(i) + 0.5;
+    }
+    for (size_t i = 0; i < rows; ++i)
+    {
+      yTicks[i] = static_cast<double>(rows - i) - 0.5;
+    }
+
+    static constexpr float ScaleWidth = 70.0f;
+    const ImVec2 available = ImGui::GetContentRegionAvail();
+
+    ImPlot::PushColormap(ImPlotColormap_RdBu);
+    if (ImPlot::BeginPlot("##SeasonalityHeatmap", ImVec2(available.x - ScaleWidth, available.y), ImPlotFlags_NoLegend | ImPlotFlags_NoMouseText))
+    {
+      const ImPlotAxisFlags axisFlags = ImPlotAxisFlags_Lock | ImPlotAxisFlags_NoGridLines | ImPlotAxisFlags_NoTickMarks;
+      ImPlot::SetupAxes(nullptr, nullptr, axisFlags, axisFlags);
+      ImPlot::SetupAxisLimits(ImAxis_X1, 0, static_cast<double>(Months), ImGuiCond_Always);
+      ImPlot::SetupAxisLimits(ImAxis_Y1, 0, static_cast<double>(rows), ImGuiCond_Always);
+      ImPlot::SetupAxisTicks(ImAxis_X1, xTicks.data(), static_cast<int>(Months), columnPointers.data());
+      ImPlot::SetupAxisTicks(ImAxis_Y1, yTicks.data(), static_cast<int>(rows), rowPointers.data());
+
+      // Cell values are readable only for few years
+      ImPlot::PlotHeatmap("##Seasonality", values.data(), static_cast<int>(rows), static_cast<int>(Months), -extent, extent, rows <= 12 ? "%.1f" : nullptr,
+                          ImPlotPoint(0, 0), ImPlotPoint(static_cast<double>(Months), static_cast<double>(rows)));
+
+      // Hovered cell
+      if (ImPlot::IsPlotHovered())
+      {
+        const ImPlotPoint mouse = ImPlot::GetPlotMousePos();
+        const int column = static_cast<int>(mouse.x);
+        const int row = static_cast<int>(rows) - 1 - static_cast<int>(mouse.y);
+        if (column >= 0 and row >= 0 and column < static_cast<int>(Months) and row < static_cast<int>(rows))
+        {
+          const size_t month = static_cast<size_t>(column);
+          const SeasonalityBucket* bucket = static_cast<size_t>(row) < years ? aggregates.GetYearMonth(aggregates.FirstYear() + static_cast<int>(years - 1) - row, month)
+          : &monthBuckets[month];
+          if (bucket and bucket->count)
+          {
+            ImGui::SetTooltip("%s %s : %.2f%% | %u days, %.0f%% up, day avg %.3f%%", rowPointers[static_cast<size_t>(row)], columnPointers[month],
+                              values[static_cast<size_t>(row) * Months + month], bucket->count, bucket->WinRate(), bucket->AverageReturn());
+          }
+        }
+      }
+      ImPlot::EndPlot();
+    }
+    ImGui::SameLine();
+    ImPlot::ColormapScale("##SeasonalityScale", -extent, extent, ImVec2(ScaleWidth - 10.0f, available.y), "%.1f%%");
+    ImPlot::PopColormap();
+  }
+
+  void UI_Seasonality::ShowProfile(const SeasonalityAggregates& aggregates, SeasonalityGroup group)
+  {
+    const auto buckets = aggregates.GetBuckets(group);
+    if (std::none_of(buckets.begin(), buckets.end(), [](const SeasonalityBucket& bucket) { return bucket.count > 0; }))
+    {
+      KanVasX::UI::Text(Font(Header_22), group == SeasonalityGroup::TimeOfDay ? "Time of day profile needs intraday history" : "No returns in this profile",
+                        Align::Center, {0, 10.0f}, Color::Text);
+      return;
+    }
+
+    const size_t count = buckets.size();
+    std::vector<double> positions(count), averages(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      positions[i] = static_cast<double>(i);
+      averages[i] = buckets[i].count ? buckets[i].AverageReturn() : 0.0;
+    }
+
+    // Labels of every slot do not fit, intraday shows each half hour
+    const size_t labelStep = group == SeasonalityGroup::TimeOfDay ? 6 : 1;
+    std::vector<double> ticks;
+    std::vector<std::string> labels;
+    std::vector<const char*> labelPointers;
+    for (size_t i = 0; i < count; i += labelStep)
+    {
+      ticks.push_back(static_cast<double>(i));
+      labels.push_back(SeasonalityAggregates::GetLabel(group, i));
+    }
+    for (const auto& label : labels)
+    {
+      labelPointers.push_back(label.c_str());
+    }
+
+    if (ImPlot::BeginPlot("##SeasonalityProfile", ImGui::GetContentRegionAvail(), ImPlotFlags_NoLegend | ImPlotFlags_NoMouseText))
+    {
+      ImPlot::SetupAxes(nullptr, "Avg Return %", ImPlotAxisFlags_NoGridLines, ImPlotAxisFlags_AutoFit);
+      ImPlot::SetupAxisLimits(ImAxis_X1, -0.5, static_cast<double>(count) - 0.5, ImGuiCond_Always);
+      ImPlot::SetupAxisTicks(ImAxis_X1, ticks.data(), static_cast<int>(ticks.size()), labelPointers.data());
+
+      // Gains and losses drawn as separate series so each has its color
+      std::vector<double> gains(count), losses(count);
+      for (size_t i = 0; i < count; ++i)
+      {
+        gains[i] = std::max(averages[i], 0.0);
+        losses[i] = std::min(averages[i], 0.0);
+      }
+      ImPlot::SetNextFillStyle(ImGui::ColorConvertU32ToFloat4(UI::Utils::StockProfitColor));
+      ImPlot::PlotBars("##Gains", positions.data(), gains.data(), static_cast<int>(count), 0.7);
+      ImPlot::SetNextFillStyle(ImGui::ColorConvertU32ToFloat4(UI::Utils::StockLossColor));
+      ImPlot::PlotBars("##Losses", positions.data(), losses.data(), static_cast<int>(count), 0.7);
+
+      if (ImPlot::IsPlotHovered())
+      {
+        const int index = static_cast<int>(std::round(ImPlot::GetPlotMousePos().x));
+        if (index >= 0 and index < static_cast<int>(count) and buckets[static_cast<size_t>(index)].count)
+        {
+          const SeasonalityBucket& bucket = buckets[static_cast<size_t>(index)];
+          ImGui::SetTooltip("%s : avg %.3f%% | %u returns, %.0f%% up, deviation %.3f%%", SeasonalityAggregates::GetLabel(group, static_cast<size_t>(index)).c_str(),
+                            bucket.AverageReturn(), bucket.count, bucket.WinRate(), bucket.Deviation());
+        }
+      }
+      ImPlot::EndPlot();
+    }
+  }
+} // namespace KanVest
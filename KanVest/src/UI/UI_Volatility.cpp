@@ -0,0 +1,108 @@
+//
+//  UI_Volatility.cpp
+//  KanVest
+//
+//  Created by Ashish . on 18/10/26.
+//
+
+#include "UI_Volatility.hpp"
+
+#include "UI/UI_Utils.hpp"
+
+#include "Analyzer/StockAnalyzer.hpp"
+
+namespace KanVest
+{
+#define Font(font) KanVest::UI::Font::Get(KanVest::UI::FontType::font)
+
+  using Align = KanVasX::UI::AlignX;
+  using Color = KanVasX::Color;
+
+  void UI_Volatility::ShowVolatility(const StockData& stockData)
+  {
+    IK_PERFORMANCE_FUNC("UI_Volatility::ShowVolatility");
+
+    if (!stockData.IsValid())
+    {
+      KanVasX::UI::Text(Font(Header_24), "No data for stock", Align::Left, {10.0f, 0.0f}, Color::Error);
+      return;
+    }
+
+    const VolatilitySeries& volatility = Analyzer::GetVolatility();
+    const double yangZhang = volatility.Latest(VolatilityEstimator::YangZhang);
+    if (std::isnan(yangZhang))
+    {
+      KanVasX::UI::Text(Font(Header_22), "Volatility needs " + std::to_string(volatility.window + 1) + " candles", Align::Center, {0, 0}, Color::Error);
+      return;
+    }
+
+    // Latest ATR and estimators, colored by percentile in own history
+    const double percentile = volatility.GetLatestPercentile(VolatilityEstimator::YangZhang);
+    const ImU32 levelColor = percentile > 80.0 ? UI::Utils::StockLossColor : percentile < 20.0 ? UI::Utils::StockProfitColor : UI::Utils::StockModerateColor;
+    const std::string header = "Volatility " + UI::Utils::FormatDoubleToString(yangZhang) + "% : " + UI::Utils::FormatDoubleToString(percentile) + " Percentile";
+    KanVasX::UI::Text(Font(Header_22), header, Align::Center, {0, 0}, levelColor);
+    KanVasX::UI::Tooltip("Annualized Yang-Zhang volatility of last " + std::to_string(volatility.window) + " candles");
+
+    auto ShowRow = [](const std::string& title, const std::string& value, ImU32 color) {
+      KanVasX::UI::Text(Font(Regular), title, Align::Left, {20.0f, 5.0f}, Color::White);
+      ImGui::SameLine();
+      KanVasX::UI::Text(Font(Regular), value, Align::Right, {-20.0f, 0.0f}, color);
+    };
+
+    {
+      KanVasX::ScopedColor childBgColor(ImGuiCol_ChildBg, Color::BackgroundLight);
+      ImGui::BeginChild("##VolatilityValues", {ImGui::GetContentRegionAvail().x, 160}, true);
+
+      const double atr = volatility.LatestATR();
+      if (!std::isnan(atr) and stockData.livePrice > 0.0)
+      {
+        ShowRow("ATR(" + std::to_string(volatility.atrPeriod) + ")", UI::Utils::FormatDoubleToString(atr) + " (" + UI::Utils::FormatDoubleToString(100.0 * atr / stockData.livePrice)
+                + "%)", Color::White);
+      }
+      for (size_t i = 0; i < static_cast<size_t>(VolatilityEstimator::Count); ++i)
+      {
+        const auto estimator = static_cast<VolatilityEstimator>(i);
+        const double value = volatility.Latest(estimator);
+        const double estimatorPercentile = volatility.GetLatestPercentile(estimator);
+        const ImU32 color = estimatorPercentile > 80.0 ? UI::Utils::StockLossColor : estimatorPercentile < 20.0 ? UI::Utils::StockProfitColor : Color::White;
+        ShowRow(std::string(Volatility::GetName(estimator)), UI::Utils::FormatDoubleToString(value) + "%", color);
+      }
+      ImGui::EndChild();
+    }
+
+    // Yang-Zhang and close to close history, gap between them shows how much open gaps add
+    const auto& yangZhangSeries = volatility.Get(VolatilityEstimator::YangZhang);
+    const auto& closeToCloseSeries = volatility.Get(VolatilityEstimator::CloseToClose);
+    const size_t count = yangZhangSeries.size();
+    if (ImPlot::BeginPlot("##VolatilityPlot", ImVec2(-1, 250)))
+    {
+      std::vector<double> x(count);
+      for (size_t i = 0; i < count; ++i)
+      {
+        x[i] = static_cast<double>(i);
+      }
+
+      ImPlot::SetupAxis(ImAxis_X1, nullptr, ImPlotAxisFlags_NoTickLabels | ImPlotAxisFlags_Lock);
+      ImPlot::SetupAxis(ImAxis_Y1, "%", ImPlotAxisFlags_AutoFit);
+      ImPlot::SetupAxisLimits(ImAxis_X1, 0, static_cast<double>(count - 1), ImGuiCond_Always);
+
+      ImPlot::PushStyleColor(ImPlotCol_Line, levelColor);
+      ImPlot::PlotLine("Yang-Zhang", x.data(), yangZhangSeries.data(), static_cast<int>(count));
+      ImPlot::PopStyleColor();
+      ImPlot::PushStyleColor(ImPlotCol_Line, Color::Cyan);
+      ImPlot::PlotLine("Close-Close", x.data(), closeToCloseSeries.data(), static_cast<int>(count));
+      ImPlot::PopStyleColor();
+
+      ImPlot::EndPlot();
+    }
+
+    const auto& analyzerResult = Analyzer::GetReport();
+    if (auto it = analyzerResult.summary.find(TechnicalIndicators::Volatility); it != analyzerResult.summary.end())
+    {
+      for (const auto& [color, summary] : it->second)
+      {
+        KanVasX::UI::Text(Font(Regular), summary, Align::Left, {0, 0}, color);
+      }
+    }
+  }
+} // namespace KanVest